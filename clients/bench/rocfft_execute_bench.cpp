@@ -0,0 +1,248 @@
+/******************************************************************************
+* Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Microbenchmark for the host-side cost of executing a plan.  A stub
+// launcher stands in for the kernels, so this measures only the work
+// done per rocfft_execute to set up each kernel's arguments: working
+// out each kernel's buffers from its operating buffers on every
+// execution (as executing a plan used to), against patching user
+// pointers into a launch program that was built when the plan was
+// created.  Both use the library's own SetupLaunchPtrs and
+// ResolveLaunchStep.
+//
+// usage: rocfft_execute_bench [iterations]
+
+#include "kernel_launch.h"
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock                 bench_clock;
+typedef std::chrono::duration<double, std::micro> usec;
+
+// the parts of a plan node that buffer resolution looks at
+struct bench_node
+{
+    OperatingBuffer   obIn;
+    OperatingBuffer   obOut;
+    rocfft_array_type inArrayType;
+    rocfft_array_type outArrayType;
+    size_t            iOffset;
+    size_t            oOffset;
+    UserCallbacks     callbacks;
+};
+
+// single-precision complex elements
+static const size_t complexTSize = sizeof(float) * 2;
+
+struct bench_plan
+{
+    std::string             name;
+    std::vector<bench_node> nodes;
+    size_t                  tmpWorkBufSize  = 1 << 20;
+    size_t                  copyWorkBufSize = 1 << 20;
+    hipDeviceProp_t         deviceProp      = {};
+};
+
+// what a launch does with its arguments, so that resolving them
+// can't be optimized away
+static size_t launch_checksum = 0;
+
+// stands in for a kernel launcher
+static void stub_launch(const void* data_p, void* back_p)
+{
+    auto data = static_cast<const DeviceCallIn*>(data_p);
+    launch_checksum += reinterpret_cast<size_t>(data->bufIn[0])
+                       + reinterpret_cast<size_t>(data->bufOut[0]) + data->gridParam.b_x;
+    static_cast<DeviceCallOut*>(back_p)->err = 0;
+}
+static volatile DevFnCall launcher = stub_launch;
+
+static void legacy_execute(bench_plan&                   plan,
+                           const std::vector<GridParam>& gridParams,
+                           void*                         in_buffer[],
+                           void*                         out_buffer[],
+                           void*                         work,
+                           const UserCallbacks&          callbacks)
+{
+    // callbacks were assigned to the load and store nodes first
+    plan.nodes.front().callbacks.load_cb_fn = callbacks.load_cb_fn;
+    plan.nodes.back().callbacks.store_cb_fn = callbacks.store_cb_fn;
+
+    for(size_t i = 0; i < plan.nodes.size(); ++i)
+    {
+        const auto& node = plan.nodes[i];
+
+        // work out the launch step from scratch, as execution used to
+        launch_step_t step;
+        SetupLaunchPtrs(node.obIn,
+                        node.inArrayType,
+                        node.iOffset,
+                        plan.tmpWorkBufSize,
+                        plan.copyWorkBufSize,
+                        complexTSize,
+                        step.bufIn);
+        SetupLaunchPtrs(node.obOut,
+                        node.outArrayType,
+                        node.oOffset,
+                        plan.tmpWorkBufSize,
+                        plan.copyWorkBufSize,
+                        complexTSize,
+                        step.bufOut);
+        step.gridParam = gridParams[i];
+
+        // device properties were copied into each kernel's arguments
+        hipDeviceProp_t prop = plan.deviceProp;
+        DeviceCallIn    data;
+        ResolveLaunchStep(step, &prop, nullptr, in_buffer, out_buffer, work, data);
+        data.callbacks = node.callbacks;
+
+        DeviceCallOut back;
+        launcher(&data, &back);
+    }
+}
+
+static std::vector<launch_step_t> build_program(const bench_plan&             plan,
+                                                const std::vector<GridParam>& gridParams)
+{
+    std::vector<launch_step_t> program(plan.nodes.size());
+    for(size_t i = 0; i < plan.nodes.size(); ++i)
+    {
+        const auto& node = plan.nodes[i];
+        SetupLaunchPtrs(node.obIn,
+                        node.inArrayType,
+                        node.iOffset,
+                        plan.tmpWorkBufSize,
+                        plan.copyWorkBufSize,
+                        complexTSize,
+                        program[i].bufIn);
+        SetupLaunchPtrs(node.obOut,
+                        node.outArrayType,
+                        node.oOffset,
+                        plan.tmpWorkBufSize,
+                        plan.copyWorkBufSize,
+                        complexTSize,
+                        program[i].bufOut);
+        program[i].fn        = launcher;
+        program[i].gridParam = gridParams[i];
+    }
+    return program;
+}
+
+static void program_execute(const bench_plan&                 plan,
+                            const std::vector<launch_step_t>& program,
+                            void*                             in_buffer[],
+                            void*                             out_buffer[],
+                            void*                             work,
+                            const UserCallbacks&              callbacks)
+{
+    for(size_t i = 0; i < program.size(); ++i)
+    {
+        const auto& step = program[i];
+
+        DeviceCallIn data;
+        ResolveLaunchStep(step, &plan.deviceProp, nullptr, in_buffer, out_buffer, work, data);
+        if(i == 0)
+            data.callbacks.load_cb_fn = callbacks.load_cb_fn;
+        if(i + 1 == program.size())
+            data.callbacks.store_cb_fn = callbacks.store_cb_fn;
+
+        DeviceCallOut back;
+        step.fn(&data, &back);
+    }
+}
+
+// buffer assignments of some typical plans
+static std::vector<bench_plan> bench_plans()
+{
+    const auto ci = rocfft_array_type_complex_interleaved;
+    const auto cp = rocfft_array_type_complex_planar;
+
+    std::vector<bench_plan> plans(4);
+    plans[0].name  = "1D single kernel";
+    plans[0].nodes = {{OB_USER_IN, OB_USER_OUT, ci, ci, 0, 0, {}}};
+
+    plans[1].name  = "2D row/column";
+    plans[1].nodes = {{OB_USER_IN, OB_TEMP, ci, ci, 0, 0, {}},
+                      {OB_TEMP, OB_USER_OUT, ci, ci, 0, 0, {}}};
+
+    plans[2].name  = "3D planar";
+    plans[2].nodes = {{OB_USER_IN, OB_TEMP, cp, cp, 0, 0, {}},
+                      {OB_TEMP, OB_USER_OUT, cp, cp, 0, 0, {}},
+                      {OB_USER_OUT, OB_TEMP, cp, cp, 0, 0, {}},
+                      {OB_TEMP, OB_USER_OUT, cp, cp, 0, 0, {}}};
+
+    plans[3].name  = "1D Bluestein";
+    plans[3].nodes = {{OB_USER_IN, OB_TEMP_BLUESTEIN, ci, ci, 0, 4096, {}},
+                      {OB_TEMP_BLUESTEIN, OB_TEMP_BLUESTEIN, ci, ci, 0, 0, {}},
+                      {OB_TEMP_BLUESTEIN, OB_TEMP_BLUESTEIN, ci, ci, 4096, 4096, {}},
+                      {OB_TEMP_BLUESTEIN, OB_TEMP_BLUESTEIN, ci, ci, 0, 0, {}},
+                      {OB_TEMP_BLUESTEIN, OB_TEMP_BLUESTEIN, ci, ci, 0, 0, {}},
+                      {OB_TEMP_BLUESTEIN, OB_USER_OUT, ci, ci, 8192, 0, {}}};
+    return plans;
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        size_t iterations = argc > 1 ? std::stoul(argv[1]) : 1000000;
+
+        std::vector<char> in(64), out(64), work(64);
+        void*             in_buffer[2]  = {in.data(), in.data() + 32};
+        void*             out_buffer[2] = {out.data(), out.data() + 32};
+        UserCallbacks     callbacks;
+
+        std::cout << iterations << " iterations, ns per execute" << std::endl;
+        std::cout << "plan\tkernels\tper-execute\tprogram" << std::endl;
+        for(auto& plan : bench_plans())
+        {
+            std::vector<GridParam> gridParams(plan.nodes.size());
+            auto                   program = build_program(plan, gridParams);
+
+            auto start = bench_clock::now();
+            for(size_t i = 0; i < iterations; ++i)
+                legacy_execute(plan, gridParams, in_buffer, out_buffer, work.data(), callbacks);
+            auto legacy = usec(bench_clock::now() - start).count() * 1000.0 / iterations;
+
+            start = bench_clock::now();
+            for(size_t i = 0; i < iterations; ++i)
+                program_execute(plan, program, in_buffer, out_buffer, work.data(), callbacks);
+            auto precomputed = usec(bench_clock::now() - start).count() * 1000.0 / iterations;
+
+            std::cout << plan.name << "\t" << plan.nodes.size() << "\t" << legacy << "\t"
+                      << precomputed << std::endl;
+        }
+        // print the accumulated result so the launches can't be
+        // optimized away
+        std::cout << "checksum: " << launch_checksum << std::endl;
+        return 0;
+    }
+    catch(std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
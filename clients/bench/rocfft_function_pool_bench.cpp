@@ -0,0 +1,153 @@
+// Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Microbenchmark for the kernel function pool.  Measures the latency
+// of the first plan created by a process (which pays for any
+// one-time setup of the pool), and the cost of the lookups that
+// plan creation does against the pool.
+//
+// usage: rocfft_function_pool_bench [lookup iterations]
+
+#include "function_pool.h"
+#include "rocfft.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock                 bench_clock;
+typedef std::chrono::duration<double, std::micro> usec;
+
+// create and destroy a 1D single-precision plan, returning how long
+// creation took
+static double time_plan_create(size_t length)
+{
+    rocfft_plan plan  = nullptr;
+    auto        start = bench_clock::now();
+    if(rocfft_plan_create(&plan,
+                          rocfft_placement_notinplace,
+                          rocfft_transform_type_complex_forward,
+                          rocfft_precision_single,
+                          1,
+                          &length,
+                          1,
+                          nullptr)
+       != rocfft_status_success)
+        throw std::runtime_error("rocfft_plan_create failed");
+    auto end = bench_clock::now();
+    rocfft_plan_destroy(plan);
+    return usec(end - start).count();
+}
+
+// run "fn" over every key "iterations" times, returning the average
+// time per call in nanoseconds
+template <typename Tfn>
+static double time_lookups(const std::vector<FMKey>& keys, size_t iterations, Tfn fn)
+{
+    auto start = bench_clock::now();
+    for(size_t i = 0; i < iterations; ++i)
+        for(const auto& key : keys)
+            fn(key);
+    auto end = bench_clock::now();
+    return usec(end - start).count() * 1000.0 / (iterations * keys.size());
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        size_t iterations = argc > 1 ? std::stoul(argv[1]) : 1000;
+
+        // nothing has touched the library yet, so the first plan is
+        // created from a cold process.  setup is timed along with it,
+        // since a real application pays for both before its first
+        // plan is ready.
+        auto setup_start = bench_clock::now();
+        rocfft_setup();
+        auto   setup = usec(bench_clock::now() - setup_start).count();
+        double first = time_plan_create(64);
+        std::cout << "rocfft_setup:       " << setup << " us" << std::endl;
+        std::cout << "first plan create:  " << first << " us" << std::endl;
+        std::cout << "cold first plan:    " << setup + first << " us" << std::endl;
+        std::cout << "second plan create: " << time_plan_create(64) << " us" << std::endl;
+
+        // collect every 1D key in the pool, and the same number of
+        // keys that are not in the pool
+        std::vector<FMKey> hits;
+        std::vector<FMKey> misses;
+        for(auto precision : {rocfft_precision_single, rocfft_precision_double})
+        {
+            size_t largest = function_pool::get_largest_length(precision);
+            for(auto scheme : {CS_KERNEL_STOCKHAM,
+                               CS_KERNEL_STOCKHAM_BLOCK_CC,
+                               CS_KERNEL_STOCKHAM_BLOCK_RC,
+                               CS_KERNEL_STOCKHAM_BLOCK_CR})
+            {
+                for(auto length : function_pool::get_lengths(precision, scheme))
+                {
+                    hits.push_back(fpkey(length, precision, scheme));
+                    misses.push_back(fpkey(largest + length, precision, scheme));
+                }
+            }
+        }
+        if(hits.empty())
+            throw std::runtime_error("function pool is empty");
+
+        size_t found = 0;
+        auto   has_hit
+            = time_lookups(hits, iterations, [&](const FMKey& key) {
+                  found += function_pool::has_function(key);
+              });
+        auto has_miss
+            = time_lookups(misses, iterations, [&](const FMKey& key) {
+                  found += function_pool::has_function(key);
+              });
+        auto get_kernel
+            = time_lookups(hits, iterations, [&](const FMKey& key) {
+                  found += function_pool::get_kernel(key).factors.size();
+              });
+
+        auto start = bench_clock::now();
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            found += function_pool::get_largest_length(rocfft_precision_single);
+            found += function_pool::get_lengths(rocfft_precision_single, CS_KERNEL_STOCKHAM).size();
+        }
+        auto lengths = usec(bench_clock::now() - start).count() * 1000.0 / iterations;
+
+        std::cout << hits.size() << " keys, " << iterations << " iterations" << std::endl;
+        std::cout << "has_function (hit):  " << has_hit << " ns" << std::endl;
+        std::cout << "has_function (miss): " << has_miss << " ns" << std::endl;
+        std::cout << "get_kernel:          " << get_kernel << " ns" << std::endl;
+        std::cout << "get_lengths + get_largest_length: " << lengths << " ns" << std::endl;
+        // print the accumulated result so the lookups can't be
+        // optimized away
+        std::cout << "checksum: " << found << std::endl;
+
+        rocfft_cleanup();
+        return 0;
+    }
+    catch(std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,127 @@
+// Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Benchmark of plan creation from multiple threads.  Each thread
+// creates a plan of a different large length at the same time, so
+// that twiddle tables for distinct lengths are created concurrently.
+// Ideally the time to create all the plans stays flat as the number
+// of threads grows.
+//
+// usage: rocfft_plan_create_bench [max threads]
+
+#include "rocfft.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::steady_clock                 bench_clock;
+typedef std::chrono::duration<double, std::milli> msec;
+
+// distinct large lengths of the form 2^a * 3^b * 5^c, so every
+// thread needs its own twiddle tables.  Smallest lengths come
+// first, so the runs with few threads stay quick.
+static std::vector<size_t> bench_lengths(size_t count)
+{
+    std::vector<size_t> lengths;
+    for(size_t pow3 = 1; pow3 <= 27; pow3 *= 3)
+        for(size_t pow5 = 1; pow5 <= 25; pow5 *= 5)
+            for(size_t pow2 = size_t(1) << 16; pow2 <= (size_t(1) << 20); pow2 *= 2)
+                lengths.push_back(pow2 * pow3 * pow5);
+    std::sort(lengths.begin(), lengths.end());
+    lengths.resize(std::min(count, lengths.size()));
+    return lengths;
+}
+
+// create one plan per length, each on its own thread, returning the
+// time taken to create all of them
+static double create_plans(const std::vector<size_t>& lengths)
+{
+    std::vector<rocfft_plan>   plans(lengths.size(), nullptr);
+    std::vector<rocfft_status> status(lengths.size(), rocfft_status_success);
+    std::vector<std::thread>   threads;
+
+    auto start = bench_clock::now();
+    for(size_t i = 0; i < lengths.size(); ++i)
+    {
+        threads.emplace_back([&, i]() {
+            status[i] = rocfft_plan_create(&plans[i],
+                                           rocfft_placement_notinplace,
+                                           rocfft_transform_type_complex_forward,
+                                           rocfft_precision_double,
+                                           1,
+                                           &lengths[i],
+                                           1,
+                                           nullptr);
+        });
+    }
+    for(auto& t : threads)
+        t.join();
+    auto elapsed = msec(bench_clock::now() - start).count();
+
+    std::string failed;
+    for(size_t i = 0; i < lengths.size(); ++i)
+    {
+        if(status[i] != rocfft_status_success)
+            failed += " " + std::to_string(lengths[i]) + " (status " + std::to_string(status[i])
+                      + ")";
+        if(plans[i])
+            rocfft_plan_destroy(plans[i]);
+    }
+    if(!failed.empty())
+        throw std::runtime_error("plan creation failed for length" + failed);
+    return elapsed;
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        size_t max_threads = argc > 1 ? std::stoul(argv[1])
+                                      : std::max(std::thread::hardware_concurrency(), 1u);
+
+        rocfft_setup();
+
+        // warm up, so that one-time setup isn't counted in the
+        // single-threaded time
+        create_plans(bench_lengths(1));
+
+        std::cout << "threads\ttotal ms\tms per plan" << std::endl;
+        for(size_t nthreads = 1; nthreads <= max_threads; nthreads *= 2)
+        {
+            auto lengths = bench_lengths(nthreads);
+            auto elapsed = create_plans(lengths);
+            std::cout << lengths.size() << "\t" << elapsed << "\t" << elapsed / lengths.size()
+                      << std::endl;
+        }
+
+        rocfft_cleanup();
+        return 0;
+    }
+    catch(std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Benchmark of host-side twiddle table generation.  Compares the
+// library's reduced, multithreaded generation against computing
+// each entry directly with a single thread.
+//
+// usage: rocfft_twiddle_bench [length ...]
+
+#include "twiddles.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock                 bench_clock;
+typedef std::chrono::duration<double, std::milli> msec;
+
+template <typename T>
+static void bench_length(size_t length)
+{
+    std::vector<T> table(length);
+
+    auto start = bench_clock::now();
+    twiddle_octant<T> twiddle(length, length);
+    twiddle_fill(table.data(), length, [&](size_t i) { return twiddle(i); });
+    auto reduced = msec(bench_clock::now() - start).count();
+
+    const double TWO_PI = -6.283185307179586476925286766559;
+    start               = bench_clock::now();
+    for(size_t i = 0; i < length; ++i)
+    {
+        table[i].x = cos(TWO_PI * i / length);
+        table[i].y = sin(TWO_PI * i / length);
+    }
+    auto direct = msec(bench_clock::now() - start).count();
+
+    std::cout << length << "\t" << reduced << " ms\t" << direct << " ms" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<size_t> lengths;
+    for(int i = 1; i < argc; ++i)
+        lengths.push_back(std::stoul(argv[i]));
+    if(lengths.empty())
+        lengths = {4096, 1 << 16, 1 << 20, 1 << 24};
+
+    std::cout << "threads: " << std::thread::hardware_concurrency() << std::endl;
+    for(const char* precision : {"single", "double"})
+    {
+        std::cout << precision << "\nlength\tlibrary\tdirect" << std::endl;
+        for(auto length : lengths)
+        {
+            if(precision == std::string("single"))
+                bench_length<float2>(length);
+            else
+                bench_length<double2>(length);
+        }
+    }
+    return 0;
+}
@@ -128,9 +128,13 @@ public:
     size_t workbuffersize = 0;
 
     // run testing load/store callbacks
-    bool                    run_callbacks   = false;
-    static constexpr double load_cb_scalar  = 0.457813941;
-    static constexpr double store_cb_scalar = 0.391504938;
+    bool run_callbacks = false;
+    // with run_callbacks, whether to set each of the testing
+    // callbacks.  The library runs its default for one that isn't set.
+    bool                    run_load_callback  = true;
+    bool                    run_store_callback = true;
+    static constexpr double load_cb_scalar     = 0.457813941;
+    static constexpr double store_cb_scalar    = 0.391504938;
 
     fft_params(){};
     virtual ~fft_params(){};
@@ -352,7 +356,13 @@ public:
         }
 
         if(run_callbacks)
+        {
             ret += "_CB";
+            if(!run_store_callback)
+                ret += "_load";
+            else if(!run_load_callback)
+                ret += "_store";
+        }
 
         return ret;
     }
@@ -459,7 +469,12 @@ public:
         ooffset = vector_parser(vals, "ooffset", pos);
 
         if(pos < vals.size())
-            run_callbacks = vals[pos] == "CB";
+            run_callbacks = vals[pos++] == "CB";
+        if(run_callbacks && pos < vals.size())
+        {
+            run_load_callback  = vals[pos] == "load";
+            run_store_callback = vals[pos] == "store";
+        }
     }
 
     // Stream output operator (for gtest, etc).
@@ -272,14 +272,16 @@ public:
                              void* store_cb_host,
                              void* store_cb_data) override
     {
-        if(run_callbacks)
+        if(run_callbacks && run_load_callback)
         {
             auto roc_status
                 = rocfft_execution_info_set_load_callback(info, &load_cb_host, &load_cb_data, 0);
             if(roc_status != rocfft_status_success)
                 return fft_status_from_rocfftparams(roc_status);
-
-            roc_status
+        }
+        if(run_callbacks && run_store_callback)
+        {
+            auto roc_status
                 = rocfft_execution_info_set_store_callback(info, &store_cb_host, &store_cb_data, 0);
             if(roc_status != rocfft_status_success)
                 return fft_status_from_rocfftparams(roc_status);
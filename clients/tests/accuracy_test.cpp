@@ -78,6 +78,35 @@ __device__ auto load_callback_dev_float2  = load_callback<float2>;
 __device__ auto load_callback_dev_double  = load_callback<double>;
 __device__ auto load_callback_dev_double2 = load_callback<double2>;
 
+// planar callbacks get a struct of pointers to the real and
+// imaginary planes in place of the data pointer
+template <typename Tplanes, typename Tdata>
+__host__ __device__ Tdata
+    load_callback_planar(const Tplanes* planes, size_t offset, void* cbdata, void* sharedMem)
+{
+    auto  testdata = static_cast<const callback_test_data*>(cbdata);
+    Tdata elem;
+    // multiply each element by scalar
+    if(planes->real == testdata->base)
+    {
+        elem.x = planes->real[offset];
+        elem.y = planes->imag[offset];
+        return multiply_by_scalar(elem, testdata->scalar);
+    }
+    else
+    {
+        // wrong base address passed, return something obviously wrong
+        elem.x = planes->real[0];
+        elem.y = planes->imag[0];
+        return elem;
+    }
+}
+
+__device__ auto load_callback_planar_dev_float2
+    = load_callback_planar<rocfft_planar_float, float2>;
+__device__ auto load_callback_planar_dev_double2
+    = load_callback_planar<rocfft_planar_double, double2>;
+
 void* get_load_callback_host(fft_array_type itype, fft_precision precision)
 {
     void* load_callback_host = nullptr;
@@ -117,8 +146,26 @@ void* get_load_callback_host(fft_array_type itype, fft_precision precision)
             return load_callback_host;
         }
     }
+    case fft_array_type_complex_planar:
+    case fft_array_type_hermitian_planar:
+    {
+        switch(precision)
+        {
+        case fft_precision_single:
+            EXPECT_EQ(hipMemcpyFromSymbol(&load_callback_host,
+                                          HIP_SYMBOL(load_callback_planar_dev_float2),
+                                          sizeof(void*)),
+                      hipSuccess);
+            return load_callback_host;
+        case fft_precision_double:
+            EXPECT_EQ(hipMemcpyFromSymbol(&load_callback_host,
+                                          HIP_SYMBOL(load_callback_planar_dev_double2),
+                                          sizeof(void*)),
+                      hipSuccess);
+            return load_callback_host;
+        }
+    }
     default:
-        // planar is unsupported for now
         return load_callback_host;
     }
 }
@@ -140,6 +187,25 @@ __device__ auto store_callback_dev_float2  = store_callback<float2>;
 __device__ auto store_callback_dev_double  = store_callback<double>;
 __device__ auto store_callback_dev_double2 = store_callback<double2>;
 
+template <typename Tplanes, typename Tdata>
+__host__ __device__ static void store_callback_planar(
+    const Tplanes* planes, size_t offset, Tdata element, void* cbdata, void* sharedMem)
+{
+    auto testdata = static_cast<callback_test_data*>(cbdata);
+    // add scalar to each element
+    if(planes->real == testdata->base)
+    {
+        auto result          = add_scalar(element, testdata->scalar);
+        planes->real[offset] = result.x;
+        planes->imag[offset] = result.y;
+    }
+    // otherwise, wrong base address passed, just don't write
+}
+__device__ auto store_callback_planar_dev_float2
+    = store_callback_planar<rocfft_planar_float, float2>;
+__device__ auto store_callback_planar_dev_double2
+    = store_callback_planar<rocfft_planar_double, double2>;
+
 void* get_store_callback_host(fft_array_type otype, fft_precision precision)
 {
     void* store_callback_host = nullptr;
@@ -182,8 +248,26 @@ void* get_store_callback_host(fft_array_type otype, fft_precision precision)
             return store_callback_host;
         }
     }
+    case fft_array_type_complex_planar:
+    case fft_array_type_hermitian_planar:
+    {
+        switch(precision)
+        {
+        case fft_precision_single:
+            EXPECT_EQ(hipMemcpyFromSymbol(&store_callback_host,
+                                          HIP_SYMBOL(store_callback_planar_dev_float2),
+                                          sizeof(void*)),
+                      hipSuccess);
+            return store_callback_host;
+        case fft_precision_double:
+            EXPECT_EQ(hipMemcpyFromSymbol(&store_callback_host,
+                                          HIP_SYMBOL(store_callback_planar_dev_double2),
+                                          sizeof(void*)),
+                      hipSuccess);
+            return store_callback_host;
+        }
+    }
     default:
-        // planar is unsupported for now
         return store_callback_host;
     }
 }
@@ -191,7 +275,7 @@ void* get_store_callback_host(fft_array_type otype, fft_precision precision)
 // Apply store callback if necessary
 void apply_store_callback(const fft_params& params, fftw_data_t& output)
 {
-    if(!params.run_callbacks)
+    if(!params.run_callbacks || !params.run_store_callback)
         return;
 
     // we're applying callbacks to FFTW input/output which we can
@@ -201,10 +285,13 @@ void apply_store_callback(const fft_params& params, fftw_data_t& output)
     cbdata.scalar = params.store_cb_scalar;
     cbdata.base   = output.front().data();
 
+    // FFTW's copy of planar data is interleaved
     switch(params.otype)
     {
     case fft_array_type_complex_interleaved:
     case fft_array_type_hermitian_interleaved:
+    case fft_array_type_complex_planar:
+    case fft_array_type_hermitian_planar:
     {
         switch(params.precision)
         {
@@ -267,7 +354,7 @@ void apply_store_callback(const fft_params& params, fftw_data_t& output)
 // apply load callback if necessary
 void apply_load_callback(const fft_params& params, fftw_data_t& input)
 {
-    if(!params.run_callbacks)
+    if(!params.run_callbacks || !params.run_load_callback)
         return;
     // we're applying callbacks to FFTW input/output which we can
     // assume is contiguous and non-planar
@@ -276,10 +363,13 @@ void apply_load_callback(const fft_params& params, fftw_data_t& input)
     cbdata.scalar = params.load_cb_scalar;
     cbdata.base   = input.front().data();
 
+    // FFTW's copy of planar data is interleaved
     switch(params.itype)
     {
     case fft_array_type_complex_interleaved:
     case fft_array_type_hermitian_interleaved:
+    case fft_array_type_complex_planar:
+    case fft_array_type_hermitian_planar:
     {
         switch(params.precision)
         {
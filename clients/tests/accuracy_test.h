@@ -108,10 +108,12 @@ struct last_cpu_fft_cache
 {
     // keys to the cache
     std::vector<size_t> length;
-    size_t              nbatch         = 0;
-    fft_transform_type  transform_type = fft_transform_type_complex_forward;
-    bool                run_callbacks  = false;
-    fft_precision       precision      = fft_precision_single;
+    size_t              nbatch             = 0;
+    fft_transform_type  transform_type     = fft_transform_type_complex_forward;
+    bool                run_callbacks      = false;
+    bool                run_load_callback  = true;
+    bool                run_store_callback = true;
+    fft_precision       precision          = fft_precision_single;
 
     // FFTW input/output
     fftw_data_t cpu_input;
@@ -368,22 +370,7 @@ inline auto param_generator_base(const std::vector<fft_transform_type>&   type_r
                                             param.ioffset        = ioffset;
                                             param.ooffset        = ooffset;
 
-                                            if(run_callbacks)
-                                            {
-                                                // add a test if both input and output support callbacks
-                                                if(param.itype != fft_array_type_complex_planar
-                                                   && param.itype != fft_array_type_hermitian_planar
-                                                   && param.otype != fft_array_type_complex_planar
-                                                   && param.otype
-                                                          != fft_array_type_hermitian_planar)
-                                                {
-                                                    param.run_callbacks = true;
-                                                }
-                                                else
-                                                {
-                                                    continue;
-                                                }
-                                            }
+                                            param.run_callbacks = run_callbacks;
                                             if(param.valid(0))
                                             {
                                                 params.push_back(param);
@@ -747,7 +734,9 @@ inline void fft_vs_reference_impl(Tparams& params)
     bool                     run_fftw = true;
     if(last_cpu_fft_data.length == params.length
        && last_cpu_fft_data.transform_type == params.transform_type
-       && last_cpu_fft_data.run_callbacks == params.run_callbacks)
+       && last_cpu_fft_data.run_callbacks == params.run_callbacks
+       && last_cpu_fft_data.run_load_callback == params.run_load_callback
+       && last_cpu_fft_data.run_store_callback == params.run_store_callback)
     {
         if(last_cpu_fft_data.nbatch >= params.nbatch)
         {
@@ -1098,11 +1087,13 @@ inline void fft_vs_reference_impl(Tparams& params)
         << params.str();
 
     // store cpu output in cache
-    last_cpu_fft_data.length         = params.length;
-    last_cpu_fft_data.nbatch         = params.nbatch;
-    last_cpu_fft_data.transform_type = params.transform_type;
-    last_cpu_fft_data.run_callbacks  = params.run_callbacks;
-    last_cpu_fft_data.precision      = params.precision;
+    last_cpu_fft_data.length             = params.length;
+    last_cpu_fft_data.nbatch             = params.nbatch;
+    last_cpu_fft_data.transform_type     = params.transform_type;
+    last_cpu_fft_data.run_callbacks      = params.run_callbacks;
+    last_cpu_fft_data.run_load_callback  = params.run_load_callback;
+    last_cpu_fft_data.run_store_callback = params.run_store_callback;
+    last_cpu_fft_data.precision          = params.precision;
     last_cpu_fft_data.cpu_output.swap(cpu_output);
     last_cpu_fft_data.cpu_input.swap(cpu_input);
 }
@@ -343,6 +343,46 @@ INSTANTIATE_TEST_SUITE_P(
                                              true)),
     accuracy_test::TestName);
 
+// Batched real transforms of odd lengths pack two sequences into one
+// complex transform, once there is enough work to pay for the
+// packing.  Odd batch counts leave the last pair half empty, which
+// the main tests' batch range doesn't cover.
+const static std::vector<size_t> odd_range_for_pair   = {3375, 4913, 10007};
+const static std::vector<size_t> batch_range_for_pair = {3, 5};
+INSTANTIATE_TEST_SUITE_P(
+    odd_1D_real_odd_batch,
+    accuracy_test,
+    ::testing::ValuesIn(param_generator_real(generate_lengths({odd_range_for_pair}),
+                                             precision_range,
+                                             batch_range_for_pair,
+                                             stride_range,
+                                             stride_range,
+                                             ioffset_range_zero,
+                                             ooffset_range_zero,
+                                             place_range,
+                                             true)),
+    accuracy_test::TestName);
+
+// Odd lengths with a single-kernel Stockham FFT are computed without
+// a complex temp buffer when out-of-place, and through the complex
+// embedding when in-place.  Cover both placements, with a single
+// batch so the batched pair transform isn't used.
+const static std::vector<size_t> odd_range_single_kernel
+    = {9, 15, 21, 25, 27, 45, 49, 75, 81, 121, 125, 243, 343, 625, 729, 2187};
+INSTANTIATE_TEST_SUITE_P(
+    odd_1D_real_single_kernel,
+    accuracy_test,
+    ::testing::ValuesIn(param_generator_real(generate_lengths({odd_range_single_kernel}),
+                                             precision_range,
+                                             {1},
+                                             stride_range,
+                                             stride_range,
+                                             ioffset_range_zero,
+                                             ooffset_range_zero,
+                                             place_range,
+                                             true)),
+    accuracy_test::TestName);
+
 // Create an array parameters for strided 2D batched transforms.
 inline auto
     param_generator_complex_1d_batched_2d(const std::vector<std::vector<size_t>>&  v_lengths,
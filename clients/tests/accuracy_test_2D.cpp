@@ -216,3 +216,20 @@ INSTANTIATE_TEST_SUITE_P(len1_swap_2D,
                              place_range,
                              true)),
                          accuracy_test::TestName);
+
+// Batched real transforms with an odd fastest dimension pack two
+// sequences into one complex transform.  Odd batch counts leave the
+// last pair half empty.
+INSTANTIATE_TEST_SUITE_P(odd_2D_real_batch,
+                         accuracy_test,
+                         ::testing::ValuesIn(param_generator_real(
+                             generate_lengths({{45, 125}, {81, 125}}),
+                             precision_range,
+                             {3, 4},
+                             stride_range,
+                             stride_range,
+                             ioffset_range_zero,
+                             ooffset_range_zero,
+                             place_range,
+                             true)),
+                         accuracy_test::TestName);
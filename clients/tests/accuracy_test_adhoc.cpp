@@ -36,6 +36,14 @@ std::vector<std::vector<size_t>> adhoc_sizes = {
     // SBRC 192 with special param
     {192, 192, 192},
     {192, 84, 84},
+
+    // 2D_RTRT whose first transpose isn't fused into the length 240
+    // row FFT, and gets a non-default runtime-compiled tile:
+    // 16x16 tiles that evenly divide 240x48, then 32x32 (single)
+    // and 16x16 tiles with partial tiles at the matrix edges
+    {240, 48},
+    {240, 20},
+    {240, 12},
 };
 
 const static std::vector<std::vector<size_t>> stride_range = {{1}};
@@ -0,0 +1,264 @@
+// Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "../../shared/gpubuf.h"
+#include "accuracy_test.h"
+#include "rocfft.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <gtest/gtest.h>
+#include <hip/hip_runtime.h>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+// value the output buffer is filled with, to check that nothing
+// outside the problems is written
+static const double UNTOUCHED = 1234.5;
+
+// stride and distance of a problem's input or output, with the
+// defaults of rocfft_grouped_problem resolved
+static size_t problem_stride(size_t stride)
+{
+    return stride ? stride : 1;
+}
+
+static size_t problem_dist(size_t length, size_t stride, size_t dist)
+{
+    return dist ? dist : length * problem_stride(stride);
+}
+
+// one past the last element a problem's input or output uses
+static size_t problem_end(const rocfft_grouped_problem& p, bool output)
+{
+    size_t stride = problem_stride(output ? p.out_stride : p.in_stride);
+    size_t dist   = problem_dist(p.length, stride, output ? p.out_distance : p.in_distance);
+    size_t offset = output ? p.out_offset : p.in_offset;
+    return offset + (p.batch - 1) * dist + (p.length - 1) * stride + 1;
+}
+
+// naive DFT of every transform in a problem, from x into y
+static void grouped_reference(const rocfft_grouped_problem&            p,
+                              int                                      sign,
+                              const std::vector<std::complex<double>>& x,
+                              std::vector<std::complex<double>>&       y)
+{
+    size_t in_stride  = problem_stride(p.in_stride);
+    size_t out_stride = problem_stride(p.out_stride);
+    size_t in_dist    = problem_dist(p.length, in_stride, p.in_distance);
+    size_t out_dist   = problem_dist(p.length, out_stride, p.out_distance);
+    for(size_t b = 0; b < p.batch; ++b)
+    {
+        for(size_t k = 0; k < p.length; ++k)
+        {
+            std::complex<double> sum = 0.0;
+            for(size_t j = 0; j < p.length; ++j)
+            {
+                double angle = sign * 2.0 * M_PI * static_cast<double>((j * k) % p.length)
+                               / p.length;
+                sum += x[p.in_offset + b * in_dist + j * in_stride]
+                       * std::complex<double>(std::cos(angle), std::sin(angle));
+            }
+            y[p.out_offset + b * out_dist + k * out_stride] = sum;
+        }
+    }
+}
+
+// Lay out a mixed group one after another in the buffers, with gaps
+// between problems.  Out-of-place outputs get padded distances, so
+// that they're laid out differently from the inputs.
+static std::vector<rocfft_grouped_problem> grouped_layout(rocfft_result_placement placement)
+{
+    struct shape
+    {
+        size_t length;
+        size_t batch;
+        size_t stride;
+        size_t dist;
+    };
+    // batches aren't multiples of the transforms per block, so the
+    // last block of each problem is partial.  The strided length 16
+    // problem interleaves its transforms, and goes in a bin of its
+    // own apart from the unit-stride length 16 problem.
+    const std::vector<shape> shapes = {{16, 7, 0, 0},
+                                       {8, 5, 0, 0},
+                                       {64, 3, 0, 0},
+                                       {16, 3, 3, 1},
+                                       {81, 1, 0, 0},
+                                       {8, 2, 0, 0}};
+
+    std::vector<rocfft_grouped_problem> problems;
+    size_t                              in_end  = 0;
+    size_t                              out_end = 0;
+    for(const auto& s : shapes)
+    {
+        rocfft_grouped_problem p = {};
+        p.length                 = s.length;
+        p.batch                  = s.batch;
+        p.in_stride              = s.stride;
+        p.in_distance            = s.dist;
+        p.in_offset              = in_end + 5;
+        if(placement == rocfft_placement_inplace)
+        {
+            p.out_stride   = p.in_stride;
+            p.out_distance = p.in_distance;
+            p.out_offset   = p.in_offset;
+        }
+        else
+        {
+            p.out_stride   = s.stride;
+            p.out_distance = s.stride > 1 ? s.dist : s.length + 3;
+            p.out_offset   = out_end + 2;
+        }
+        problems.push_back(p);
+        in_end  = problem_end(p, false);
+        out_end = problem_end(p, true);
+    }
+    return problems;
+}
+
+// run a grouped plan and compare every problem against the naive
+// reference
+template <typename Tfloat>
+static void grouped_test(rocfft_transform_type type, rocfft_result_placement placement)
+{
+    const auto precision
+        = std::is_same<Tfloat, float>::value ? rocfft_precision_single : rocfft_precision_double;
+    const double tolerance = std::is_same<Tfloat, float>::value ? 1e-5 : 1e-12;
+    const int    sign      = type == rocfft_transform_type_complex_forward ? -1 : 1;
+
+    auto   problems = grouped_layout(placement);
+    size_t in_size  = 0;
+    size_t out_size = 0;
+    for(const auto& p : problems)
+    {
+        in_size  = std::max(in_size, problem_end(p, false));
+        out_size = std::max(out_size, problem_end(p, true));
+    }
+    if(placement == rocfft_placement_inplace)
+        in_size = out_size = std::max(in_size, out_size);
+
+    std::vector<std::complex<Tfloat>> input(in_size);
+    std::mt19937                      gen(42);
+    std::uniform_real_distribution<>  dis(-1.0, 1.0);
+    for(auto& val : input)
+        val = {static_cast<Tfloat>(dis(gen)), static_cast<Tfloat>(dis(gen))};
+
+    std::vector<std::complex<double>> x(input.begin(), input.end());
+    std::vector<std::complex<double>> expected(out_size, UNTOUCHED);
+    if(placement == rocfft_placement_inplace)
+        expected = x;
+    for(const auto& p : problems)
+        grouped_reference(p, sign, x, expected);
+
+    rocfft_plan plan = nullptr;
+    ASSERT_EQ(rocfft_plan_create_grouped(
+                  &plan, placement, type, precision, problems.size(), problems.data()),
+              rocfft_status_success);
+
+    const size_t elem = sizeof(std::complex<Tfloat>);
+    gpubuf       ibuf;
+    gpubuf       obuf;
+    ASSERT_EQ(ibuf.alloc(in_size * elem), hipSuccess);
+    ASSERT_EQ(hipMemcpy(ibuf.data(), input.data(), in_size * elem, hipMemcpyHostToDevice),
+              hipSuccess);
+    void* in_ptr  = ibuf.data();
+    void* out_ptr = ibuf.data();
+    if(placement == rocfft_placement_notinplace)
+    {
+        std::vector<std::complex<Tfloat>> fill(out_size, static_cast<Tfloat>(UNTOUCHED));
+        ASSERT_EQ(obuf.alloc(out_size * elem), hipSuccess);
+        ASSERT_EQ(hipMemcpy(obuf.data(), fill.data(), out_size * elem, hipMemcpyHostToDevice),
+                  hipSuccess);
+        out_ptr = obuf.data();
+    }
+
+    ASSERT_EQ(rocfft_execute(plan, &in_ptr, &out_ptr, nullptr), rocfft_status_success);
+
+    std::vector<std::complex<Tfloat>> output(out_size);
+    ASSERT_EQ(hipMemcpy(output.data(), out_ptr, out_size * elem, hipMemcpyDeviceToHost),
+              hipSuccess);
+
+    rocfft_plan_destroy(plan);
+
+    double max_err = 0.0;
+    double max_ref = 0.0;
+    for(size_t i = 0; i < output.size(); ++i)
+    {
+        max_err = std::max(max_err, std::abs(std::complex<double>(output[i]) - expected[i]));
+        max_ref = std::max(max_ref, std::abs(expected[i]));
+    }
+    if(verbose)
+        std::cout << "max error " << max_err << " for max magnitude " << max_ref << std::endl;
+    EXPECT_LE(max_err, tolerance * std::max(max_ref, 1.0))
+        << "type " << type << ", precision " << precision << ", placement " << placement;
+}
+
+TEST(rocfft_UnitTest, grouped_accuracy)
+{
+    for(auto placement : {rocfft_placement_notinplace, rocfft_placement_inplace})
+    {
+        for(auto type : {rocfft_transform_type_complex_forward,
+                         rocfft_transform_type_complex_inverse})
+        {
+            grouped_test<float>(type, placement);
+            grouped_test<double>(type, placement);
+        }
+    }
+}
+
+TEST(rocfft_UnitTest, grouped_callbacks)
+{
+    rocfft_grouped_problem problem = {};
+    problem.length                 = 16;
+    problem.batch                  = 2;
+
+    rocfft_plan plan = nullptr;
+    ASSERT_EQ(rocfft_plan_create_grouped(&plan,
+                                         rocfft_placement_inplace,
+                                         rocfft_transform_type_complex_forward,
+                                         rocfft_precision_single,
+                                         1,
+                                         &problem),
+              rocfft_status_success);
+
+    gpubuf data;
+    ASSERT_EQ(data.alloc(problem.length * problem.batch * sizeof(std::complex<float>)),
+              hipSuccess);
+    void* buffers[] = {data.data()};
+
+    // the grouped kernels don't run callbacks, so they're rejected
+    // rather than ignored
+    rocfft_execution_info info = nullptr;
+    ASSERT_EQ(rocfft_execution_info_create(&info), rocfft_status_success);
+    void* not_a_callback[] = {data.data()};
+    ASSERT_EQ(rocfft_execution_info_set_store_callback(info, not_a_callback, nullptr, 0),
+              rocfft_status_success);
+    EXPECT_EQ(rocfft_execute(plan, buffers, nullptr, info), rocfft_status_invalid_arg_value);
+
+    ASSERT_EQ(rocfft_execution_info_set_store_callback(info, nullptr, nullptr, 0),
+              rocfft_status_success);
+    EXPECT_EQ(rocfft_execute(plan, buffers, nullptr, info), rocfft_status_success);
+    ASSERT_EQ(hipDeviceSynchronize(), hipSuccess);
+
+    rocfft_execution_info_destroy(info);
+    rocfft_plan_destroy(plan);
+}
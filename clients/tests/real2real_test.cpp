@@ -0,0 +1,282 @@
+// Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "../../shared/gpubuf.h"
+#include "accuracy_test.h"
+#include "rocfft.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <hip/hip_runtime.h>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+static const rocfft_transform_type r2r_types[] = {rocfft_transform_type_dct_1,
+                                                  rocfft_transform_type_dct_2,
+                                                  rocfft_transform_type_dct_3,
+                                                  rocfft_transform_type_dct_4,
+                                                  rocfft_transform_type_dst_1,
+                                                  rocfft_transform_type_dst_2,
+                                                  rocfft_transform_type_dst_3,
+                                                  rocfft_transform_type_dst_4};
+
+// naive 1D real-to-real transform of strided x into contiguous y,
+// following FFTW's unnormalized REDFT/RODFT definitions
+static void r2r_reference_1d(rocfft_transform_type type,
+                             size_t                N,
+                             const double*         x,
+                             size_t                stride,
+                             double*               y)
+{
+    const double pi = M_PI;
+    for(size_t k = 0; k < N; ++k)
+    {
+        double sum = 0.0;
+        for(size_t j = 0; j < N; ++j)
+        {
+            double xj = x[j * stride];
+            switch(type)
+            {
+            case rocfft_transform_type_dct_1:
+                if(j == 0 || j == N - 1)
+                    sum += (j == 0 ? 1.0 : (k % 2 ? -1.0 : 1.0)) * xj;
+                else
+                    sum += 2 * xj * std::cos(pi * j * k / (N - 1));
+                break;
+            case rocfft_transform_type_dst_1:
+                sum += 2 * xj * std::sin(pi * (j + 1) * (k + 1) / (N + 1));
+                break;
+            case rocfft_transform_type_dct_2:
+                sum += 2 * xj * std::cos(pi * (j + 0.5) * k / N);
+                break;
+            case rocfft_transform_type_dst_2:
+                sum += 2 * xj * std::sin(pi * (j + 0.5) * (k + 1) / N);
+                break;
+            case rocfft_transform_type_dct_3:
+                sum += (j == 0 ? 1.0 : 2.0) * xj * std::cos(pi * j * (k + 0.5) / N);
+                break;
+            case rocfft_transform_type_dst_3:
+                sum += (j == N - 1 ? (k % 2 ? -1.0 : 1.0)
+                                   : 2.0 * std::sin(pi * (j + 1) * (k + 0.5) / N))
+                       * xj;
+                break;
+            case rocfft_transform_type_dct_4:
+                sum += 2 * xj * std::cos(pi * (j + 0.5) * (k + 0.5) / N);
+                break;
+            case rocfft_transform_type_dst_4:
+                sum += 2 * xj * std::sin(pi * (j + 0.5) * (k + 0.5) / N);
+                break;
+            default:
+                break;
+            }
+        }
+        y[k] = sum;
+    }
+}
+
+// run a contiguous real-to-real transform on the GPU and compare it
+// against the naive reference, applied one dimension at a time
+template <typename Tfloat>
+static void r2r_test(rocfft_transform_type      type,
+                     const std::vector<size_t>& length,
+                     size_t                     batch,
+                     rocfft_result_placement    placement)
+{
+    const auto precision
+        = std::is_same<Tfloat, float>::value ? rocfft_precision_single : rocfft_precision_double;
+    // error grows with the length of the transform
+    const double tolerance = std::is_same<Tfloat, float>::value ? 1e-5 : 1e-10;
+
+    size_t dist = 1;
+    for(auto len : length)
+        dist *= len;
+
+    std::vector<Tfloat>              input(dist * batch);
+    std::mt19937                     gen(42);
+    std::uniform_real_distribution<> dis(-1.0, 1.0);
+    for(auto& val : input)
+        val = dis(gen);
+
+    // reference: each dimension in turn, in-place on a copy
+    std::vector<double> expected(input.begin(), input.end());
+    std::vector<double> row;
+    size_t              stride = 1;
+    for(auto len : length)
+    {
+        row.resize(len);
+        for(size_t offset = 0; offset < expected.size(); ++offset)
+        {
+            // only start from the first element along this dimension
+            if((offset / stride) % len != 0)
+                continue;
+            r2r_reference_1d(type, len, expected.data() + offset, stride, row.data());
+            for(size_t k = 0; k < len; ++k)
+                expected[offset + k * stride] = row[k];
+        }
+        stride *= len;
+    }
+
+    rocfft_plan plan = nullptr;
+    ASSERT_EQ(rocfft_plan_create(&plan,
+                                 placement,
+                                 type,
+                                 precision,
+                                 length.size(),
+                                 length.data(),
+                                 batch,
+                                 nullptr),
+              rocfft_status_success);
+
+    const size_t bytes = input.size() * sizeof(Tfloat);
+    gpubuf       ibuf;
+    gpubuf       obuf;
+    ASSERT_EQ(ibuf.alloc(bytes), hipSuccess);
+    ASSERT_EQ(hipMemcpy(ibuf.data(), input.data(), bytes, hipMemcpyHostToDevice), hipSuccess);
+    void* in_ptr  = ibuf.data();
+    void* out_ptr = ibuf.data();
+    if(placement == rocfft_placement_notinplace)
+    {
+        ASSERT_EQ(obuf.alloc(bytes), hipSuccess);
+        out_ptr = obuf.data();
+    }
+
+    ASSERT_EQ(rocfft_execute(plan, &in_ptr, &out_ptr, nullptr), rocfft_status_success);
+
+    std::vector<Tfloat> output(input.size());
+    ASSERT_EQ(hipMemcpy(output.data(), out_ptr, bytes, hipMemcpyDeviceToHost), hipSuccess);
+
+    rocfft_plan_destroy(plan);
+
+    double max_err = 0.0;
+    double max_ref = 0.0;
+    for(size_t i = 0; i < output.size(); ++i)
+    {
+        max_err = std::max(max_err, std::abs(output[i] - expected[i]));
+        max_ref = std::max(max_ref, std::abs(expected[i]));
+    }
+    if(verbose)
+        std::cout << "max error " << max_err << " for max magnitude " << max_ref << std::endl;
+    EXPECT_LE(max_err, tolerance * std::max(max_ref, 1.0))
+        << "type " << type << ", precision " << precision;
+}
+
+// single and double precision for each test case
+static void r2r_test_precisions(rocfft_transform_type      type,
+                                const std::vector<size_t>& length,
+                                size_t                     batch,
+                                rocfft_result_placement    placement)
+{
+    r2r_test<float>(type, length, batch, placement);
+    r2r_test<double>(type, length, batch, placement);
+}
+
+TEST(rocfft_UnitTest, real2real_1D)
+{
+    // odd and even lengths exercise different FFTs for each type
+    for(auto type : r2r_types)
+    {
+        for(size_t len : {2, 3, 4, 5, 8, 15, 16, 17, 64, 81, 100})
+            r2r_test_precisions(type, {len}, 3, rocfft_placement_notinplace);
+    }
+}
+
+TEST(rocfft_UnitTest, real2real_1D_inplace)
+{
+    for(auto type : r2r_types)
+        r2r_test_precisions(type, {24}, 2, rocfft_placement_inplace);
+}
+
+TEST(rocfft_UnitTest, real2real_2D)
+{
+    for(auto type : r2r_types)
+    {
+        r2r_test_precisions(type, {6, 5}, 2, rocfft_placement_notinplace);
+        r2r_test_precisions(type, {16, 9}, 1, rocfft_placement_inplace);
+    }
+}
+
+TEST(rocfft_UnitTest, real2real_3D)
+{
+    for(auto type : r2r_types)
+        r2r_test_precisions(type, {4, 7, 6}, 2, rocfft_placement_notinplace);
+}
+
+TEST(rocfft_UnitTest, real2real_1D_large)
+{
+    // the FFTs for these don't all fit in one kernel, so some types
+    // use separate pre/post-processing kernels around them
+    for(auto type : r2r_types)
+        r2r_test_precisions(type, {4500}, 1, rocfft_placement_notinplace);
+}
+
+#ifdef ROCFFT_RUNTIME_COMPILE
+// kernel launches of a scheme since statistics were last reset
+static size_t r2r_scheme_launches(const char* scheme)
+{
+    size_t num_schemes = 0;
+    EXPECT_EQ(rocfft_get_scheme_statistics(&num_schemes, nullptr, nullptr, nullptr),
+              rocfft_status_success);
+    std::vector<const char*> schemes(num_schemes);
+    std::vector<size_t>      launches(num_schemes);
+    EXPECT_EQ(rocfft_get_scheme_statistics(&num_schemes, schemes.data(), nullptr, launches.data()),
+              rocfft_status_success);
+    for(size_t i = 0; i < num_schemes; ++i)
+    {
+        if(std::string(schemes[i]) == scheme)
+            return launches[i];
+    }
+    return 0;
+}
+
+TEST(rocfft_UnitTest, real2real_fused)
+{
+    // every dimension's FFT fits in one kernel, so the pre- and
+    // post-processing is done in those kernels' loads and stores
+    ASSERT_EQ(rocfft_reset_statistics(), rocfft_status_success);
+    r2r_test<double>(rocfft_transform_type_dct_2, {64, 16}, 2, rocfft_placement_notinplace);
+    EXPECT_EQ(r2r_scheme_launches("CS_KERNEL_R2R_PRE"), 0u);
+    EXPECT_EQ(r2r_scheme_launches("CS_KERNEL_R2R_POST"), 0u);
+    EXPECT_EQ(r2r_scheme_launches("CS_KERNEL_STOCKHAM"), 2u);
+
+    // fusing into FFTs of more than one kernel isn't done yet, so
+    // those still run separate pre- and post-processing kernels
+    ASSERT_EQ(rocfft_reset_statistics(), rocfft_status_success);
+    r2r_test<double>(rocfft_transform_type_dct_2, {4500}, 1, rocfft_placement_notinplace);
+    EXPECT_EQ(r2r_scheme_launches("CS_KERNEL_R2R_PRE"), 1u);
+    EXPECT_EQ(r2r_scheme_launches("CS_KERNEL_R2R_POST"), 1u);
+}
+#endif
+
+TEST(rocfft_UnitTest, real2real_dct1_length1)
+{
+    // DCT-I is undefined for a single point
+    size_t      length = 1;
+    rocfft_plan plan   = nullptr;
+    EXPECT_EQ(rocfft_plan_create(&plan,
+                                 rocfft_placement_notinplace,
+                                 rocfft_transform_type_dct_1,
+                                 rocfft_precision_double,
+                                 1,
+                                 &length,
+                                 1,
+                                 nullptr),
+              rocfft_status_invalid_dimensions);
+}
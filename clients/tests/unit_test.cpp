@@ -22,14 +22,33 @@
 
 #include "../../shared/environment.h"
 #include "../../shared/gpubuf.h"
+#include "../../shared/twiddle_math.h"
+#include "accuracy_test.h"
+#include "graph_cache.h"
+#include "grouped_plan.h"
 #include "hip/hip_runtime_api.h"
 #include "hip/hip_vector_types.h"
+#include "kargs.h"
+#include "multi_device.h"
+#include "shfl_exchange.h"
+#include "twiddles.h"
+#include <algorithm>
 #include <boost/scope_exit.hpp>
+#include <chrono>
+#include <cmath>
+#include <complex>
 #include <condition_variable>
+#include <cstddef>
+#include <cstring>
 #include <fstream>
 #include <gtest/gtest.h>
+#include <limits>
 #include <mutex>
+#include <numeric>
+#include <random>
 #include <regex>
+#include <set>
+#include <sstream>
 #include <thread>
 #include <vector>
 
@@ -158,6 +177,95 @@ TEST(rocfft_UnitTest, repo_twiddle)
     rocfft_plan_destroy(plan_inverse);
 }
 
+// create and destroy plans in a loop, and check that unused
+// twiddle tables are kept warm while they fit in the budget
+TEST(rocfft_UnitTest, repo_twiddle_keep_warm)
+{
+    size_t old_budget = 0;
+    ASSERT_EQ(rocfft_twiddle_cache_get_usage(&old_budget, nullptr, nullptr, nullptr, nullptr),
+              rocfft_status_success);
+    BOOST_SCOPE_EXIT_ALL(=)
+    {
+        rocfft_twiddle_cache_set_budget(old_budget);
+    };
+
+    // a few small sizes, including one past the large twiddle
+    // threshold
+    const std::vector<size_t> lengths = {64, 4096, 8192};
+
+    auto create_destroy = [&]() {
+        for(auto length : lengths)
+        {
+            for(auto precision : {rocfft_precision_single, rocfft_precision_double})
+            {
+                rocfft_plan plan = nullptr;
+                ASSERT_EQ(rocfft_plan_create(&plan,
+                                             rocfft_placement_notinplace,
+                                             rocfft_transform_type_complex_forward,
+                                             precision,
+                                             1,
+                                             &length,
+                                             1,
+                                             nullptr),
+                          rocfft_status_success);
+                ASSERT_EQ(rocfft_plan_destroy(plan), rocfft_status_success);
+            }
+        }
+    };
+
+    // with no budget, nothing is kept once plans are destroyed
+    ASSERT_EQ(rocfft_twiddle_cache_set_budget(0), rocfft_status_success);
+    size_t unused_bytes = 0;
+    size_t misses_begin = 0;
+    size_t misses_end   = 0;
+    size_t hits_begin   = 0;
+    size_t hits_end     = 0;
+    create_destroy();
+    ASSERT_EQ(
+        rocfft_twiddle_cache_get_usage(nullptr, nullptr, &unused_bytes, nullptr, &misses_begin),
+        rocfft_status_success);
+    EXPECT_EQ(unused_bytes, 0u);
+    create_destroy();
+    ASSERT_EQ(rocfft_twiddle_cache_get_usage(nullptr, nullptr, nullptr, nullptr, &misses_end),
+              rocfft_status_success);
+    EXPECT_GT(misses_end, misses_begin);
+
+    // with a budget, only the first iteration should create tables
+    ASSERT_EQ(rocfft_twiddle_cache_set_budget(1 << 30), rocfft_status_success);
+    create_destroy();
+    ASSERT_EQ(rocfft_twiddle_cache_get_usage(
+                  nullptr, nullptr, &unused_bytes, &hits_begin, &misses_begin),
+              rocfft_status_success);
+    EXPECT_GT(unused_bytes, 0u);
+    for(unsigned int i = 0; i < 3; ++i)
+        create_destroy();
+    ASSERT_EQ(rocfft_twiddle_cache_get_usage(nullptr, nullptr, nullptr, &hits_end, &misses_end),
+              rocfft_status_success);
+    EXPECT_EQ(misses_end, misses_begin);
+    EXPECT_GT(hits_end, hits_begin);
+
+    // statistics count the same tables, without taking the cache's
+    // lock
+    auto check_statistics = [&]() {
+        size_t used_bytes = 0;
+        ASSERT_EQ(
+            rocfft_twiddle_cache_get_usage(nullptr, &used_bytes, &unused_bytes, nullptr, nullptr),
+            rocfft_status_success);
+        rocfft_statistics stats = {sizeof(rocfft_statistics)};
+        ASSERT_EQ(rocfft_get_statistics(&stats), rocfft_status_success);
+        EXPECT_EQ(stats.twiddle_bytes, used_bytes + unused_bytes);
+        EXPECT_EQ(stats.twiddle_tables > 0, stats.twiddle_bytes > 0);
+    };
+    check_statistics();
+
+    // shrinking the budget frees unused tables
+    ASSERT_EQ(rocfft_twiddle_cache_set_budget(0), rocfft_status_success);
+    ASSERT_EQ(rocfft_twiddle_cache_get_usage(nullptr, nullptr, &unused_bytes, nullptr, nullptr),
+              rocfft_status_success);
+    EXPECT_EQ(unused_bytes, 0u);
+    check_statistics();
+}
+
 // RAII object to set an environment variable and restore it to its
 // previous value on destruction
 struct EnvironmentSetTemp
@@ -181,10 +289,11 @@ struct EnvironmentSetTemp
     std::string oldvalue;
 };
 
-// Check whether logs can be emitted from multiple threads properly
+// Check whether logs can be emitted from multiple threads properly,
+// and measure the per-message cost of logging as the number of
+// threads grows
 TEST(rocfft_UnitTest, log_multithreading)
 {
-    static const int   NUM_THREADS          = 10;
     static const int   NUM_ITERS_PER_THREAD = 50;
     static const char* TRACE_FILE           = "trace.log";
 
@@ -202,40 +311,562 @@ TEST(rocfft_UnitTest, log_multithreading)
     EnvironmentSetTemp layer("ROCFFT_LAYER", "1");
     EnvironmentSetTemp tracepath("ROCFFT_LOG_TRACE_PATH", TRACE_FILE);
 
-    rocfft_setup();
-
-    // run a whole bunch of threads in parallel, each one doing
-    // something small that will write to the trace log
-    std::vector<std::thread> threads;
-    threads.reserve(NUM_THREADS);
-    for(int i = 0; i < NUM_THREADS; ++i)
+    for(int num_threads : {1, 2, 4, 8, 16, 32, 64})
     {
-        threads.emplace_back([]() {
-            for(int j = 0; j < NUM_ITERS_PER_THREAD; ++j)
-            {
-                rocfft_plan_description desc;
-                rocfft_plan_description_create(&desc);
-                rocfft_plan_description_destroy(desc);
-            }
-        });
+        rocfft_setup();
+
+        // run a whole bunch of threads in parallel, each one doing
+        // something small that will write to the trace log
+        std::vector<std::thread> threads;
+        threads.reserve(num_threads);
+        auto start = std::chrono::steady_clock::now();
+        for(int i = 0; i < num_threads; ++i)
+        {
+            threads.emplace_back([]() {
+                for(int j = 0; j < NUM_ITERS_PER_THREAD; ++j)
+                {
+                    rocfft_plan_description desc;
+                    rocfft_plan_description_create(&desc);
+                    rocfft_plan_description_destroy(desc);
+                }
+            });
+        }
+
+        for(auto& t : threads)
+        {
+            t.join();
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        rocfft_cleanup();
+
+        // each iteration logs a create and a destroy
+        const size_t num_messages = 2 * num_threads * NUM_ITERS_PER_THREAD;
+        if(verbose)
+            std::cout << num_threads << " threads: "
+                      << std::chrono::duration<double, std::nano>(end - start).count()
+                             / num_messages
+                      << " ns per message" << std::endl;
+
+        // now verify that the trace log has one message per line,
+        // with nothing garbled or lost
+        std::ifstream trace_log(TRACE_FILE);
+        std::string   line;
+        std::regex    validator("^rocfft_(setup|cleanup|plan_description_(create|destroy),"
+                             "description,[x0-9a-fA-F]+)$");
+        size_t        description_lines = 0;
+        while(std::getline(trace_log, line))
+        {
+            bool res = std::regex_match(line, validator);
+            ASSERT_TRUE(res) << "line contains invalid content: " << line;
+            if(line.find("description") != std::string::npos)
+                ++description_lines;
+        }
+        EXPECT_EQ(description_lines, num_messages);
     }
+}
 
-    for(auto& t : threads)
+// Check that ROCFFT_LOG_FORMAT=jsonl writes one JSON object per line
+TEST(rocfft_UnitTest, log_jsonl)
+{
+    static const char* TRACE_FILE = "trace.jsonl";
+
+    BOOST_SCOPE_EXIT_ALL(=)
     {
-        t.join();
-    }
+        rocfft_cleanup();
+        remove(TRACE_FILE);
+        rocfft_setup();
+    };
 
+    rocfft_cleanup();
+    EnvironmentSetTemp layer("ROCFFT_LAYER", "1");
+    EnvironmentSetTemp format("ROCFFT_LOG_FORMAT", "jsonl");
+    EnvironmentSetTemp tracepath("ROCFFT_LOG_TRACE_PATH", TRACE_FILE);
+
+    rocfft_setup();
+    rocfft_plan_description desc;
+    rocfft_plan_description_create(&desc);
+    rocfft_plan_description_destroy(desc);
     rocfft_cleanup();
 
-    // now verify that the trace log has one message per line, with nothing garbled
     std::ifstream trace_log(TRACE_FILE);
     std::string   line;
-    std::regex    validator("^rocfft_(setup|cleanup|plan_description_(create|destroy),"
-                         "description,[x0-9a-fA-F]+)$");
+    std::regex    validator("^\\{\"ts_us\":[0-9]+,\"tid\":[0-9]+,\"event\":\"trace\","
+                         "\"function\":\"rocfft_(setup|cleanup|plan_description_(create|destroy))"
+                         "\",\"args\":\\{(\"description\":\"[x0-9a-fA-F]+\")?\\}\\}$");
+    size_t        lines = 0;
     while(std::getline(trace_log, line))
     {
         bool res = std::regex_match(line, validator);
         ASSERT_TRUE(res) << "line contains invalid content: " << line;
+        ++lines;
+    }
+    // setup, create, destroy, cleanup
+    EXPECT_EQ(lines, 4u);
+}
+
+// Check that records are dropped and counted when a log file can't
+// keep up, and that everything else is written
+TEST(rocfft_UnitTest, log_dropped_records)
+{
+    static const char* TRACE_FILE = "trace_dropped.log";
+    // records a stream's ring holds
+    static const size_t RING_RECORDS = 1024;
+    // iterations to log, which log more records than the ring holds
+    static const size_t ITERS = 2048;
+
+    BOOST_SCOPE_EXIT_ALL(=)
+    {
+        rocfft_cleanup();
+        remove(TRACE_FILE);
+        rocfft_setup();
+    };
+
+    rocfft_cleanup();
+    rocfft_reset_statistics();
+    remove(TRACE_FILE);
+
+    // the log writer holds the file without writing until cleanup,
+    // so this thread's ring fills up and every record after that is
+    // dropped
+    EnvironmentSetTemp layer("ROCFFT_LAYER", "1");
+    EnvironmentSetTemp tracepath("ROCFFT_LOG_TRACE_PATH", TRACE_FILE);
+    EnvironmentSetTemp hold("ROCFFT_LOG_HOLD_WRITES", "1");
+    rocfft_setup();
+
+    for(size_t i = 0; i < ITERS; ++i)
+    {
+        rocfft_plan_description desc;
+        rocfft_plan_description_create(&desc);
+        rocfft_plan_description_destroy(desc);
+    }
+    rocfft_cleanup();
+
+    std::ifstream trace(TRACE_FILE);
+    size_t        lines = 0;
+    for(std::string line; std::getline(trace, line);)
+        ++lines;
+
+    rocfft_statistics stats = {sizeof(rocfft_statistics)};
+    ASSERT_EQ(rocfft_get_statistics(&stats), rocfft_status_success);
+
+    // each iteration logs a create and a destroy, plus setup and
+    // cleanup.  the ring keeps the oldest records, which are written
+    // at cleanup.
+    const size_t num_messages = 2 * ITERS + 2;
+    EXPECT_EQ(lines, RING_RECORDS);
+    EXPECT_EQ(stats.log_records_dropped, num_messages - RING_RECORDS);
+}
+
+TEST(rocfft_UnitTest, plan_phase_timing)
+{
+    static const char* TIMING_FILE = "timing.log";
+
+    BOOST_SCOPE_EXIT_ALL(=)
+    {
+        rocfft_cleanup();
+        remove(TIMING_FILE);
+        rocfft_setup();
+    };
+
+    rocfft_cleanup();
+    EnvironmentSetTemp layer("ROCFFT_LAYER", "64");
+    EnvironmentSetTemp timingpath("ROCFFT_LOG_TIMING_PATH", TIMING_FILE);
+    rocfft_setup();
+
+    size_t      length = 8191;
+    rocfft_plan plan   = nullptr;
+    ASSERT_EQ(rocfft_plan_create(&plan,
+                                 rocfft_placement_inplace,
+                                 rocfft_transform_type_complex_forward,
+                                 rocfft_precision_single,
+                                 1,
+                                 &length,
+                                 1,
+                                 nullptr),
+              rocfft_status_success);
+
+    size_t count = 0;
+    ASSERT_EQ(rocfft_plan_get_phase_count(plan, &count), rocfft_status_success);
+    ASSERT_GT(count, 0u);
+
+    std::set<std::string> names;
+    for(size_t i = 0; i < count; ++i)
+    {
+        const char* name   = nullptr;
+        const char* detail = nullptr;
+        double      ms     = -1.0;
+        ASSERT_EQ(rocfft_plan_get_phase_timing(plan, i, &name, &detail, &ms),
+                  rocfft_status_success);
+        ASSERT_NE(name, nullptr);
+        ASSERT_NE(detail, nullptr);
+        EXPECT_GE(ms, 0.0);
+        names.insert(name);
+    }
+    EXPECT_EQ(names.count("plan_create"), 1u);
+    EXPECT_EQ(names.count("build_tree"), 1u);
+    EXPECT_EQ(rocfft_plan_get_phase_timing(plan, count, nullptr, nullptr, nullptr),
+              rocfft_status_invalid_arg_value);
+    rocfft_plan_destroy(plan);
+    rocfft_cleanup();
+
+    // every phase is logged on its own line
+    std::ifstream timing_log(TIMING_FILE);
+    std::string   line;
+    size_t        lines = 0;
+    while(std::getline(timing_log, line))
+    {
+        EXPECT_EQ(line.compare(0, 5, "plan,"), 0) << "unexpected line: " << line;
+        ++lines;
+    }
+    EXPECT_EQ(lines, count);
+}
+
+TEST(rocfft_UnitTest, chrome_trace)
+{
+    static const char* TRACE_FILE = "trace.json";
+
+    BOOST_SCOPE_EXIT_ALL(=)
+    {
+        rocfft_cleanup();
+        remove(TRACE_FILE);
+        rocfft_setup();
+    };
+
+    rocfft_cleanup();
+    EnvironmentSetTemp layer("ROCFFT_LAYER", "128");
+    EnvironmentSetTemp tracepath("ROCFFT_LOG_CHROME_TRACE_PATH", TRACE_FILE);
+    rocfft_setup();
+
+    size_t      length = 8191;
+    rocfft_plan plan   = nullptr;
+    ASSERT_EQ(rocfft_plan_create(&plan,
+                                 rocfft_placement_inplace,
+                                 rocfft_transform_type_complex_forward,
+                                 rocfft_precision_single,
+                                 1,
+                                 &length,
+                                 1,
+                                 nullptr),
+              rocfft_status_success);
+
+    gpubuf data;
+    ASSERT_EQ(data.alloc(length * 2 * sizeof(float)), hipSuccess);
+    void* buffers[] = {data.data()};
+    ASSERT_EQ(rocfft_execute(plan, buffers, nullptr, nullptr), rocfft_status_success);
+
+    // kernels on a user stream are traced on a track of their own
+    hipStream_t stream = nullptr;
+    ASSERT_EQ(hipStreamCreate(&stream), hipSuccess);
+    rocfft_execution_info info = nullptr;
+    ASSERT_EQ(rocfft_execution_info_create(&info), rocfft_status_success);
+    ASSERT_EQ(rocfft_execution_info_set_stream(info, stream), rocfft_status_success);
+    ASSERT_EQ(rocfft_execute(plan, buffers, nullptr, info), rocfft_status_success);
+    ASSERT_EQ(hipStreamSynchronize(stream), hipSuccess);
+    rocfft_execution_info_destroy(info);
+    ASSERT_EQ(hipStreamDestroy(stream), hipSuccess);
+    rocfft_plan_destroy(plan);
+
+    // trace is written at cleanup
+    rocfft_cleanup();
+
+    std::ifstream     trace_file(TRACE_FILE);
+    std::stringstream trace;
+    trace << trace_file.rdbuf();
+    std::string str = trace.str();
+    EXPECT_EQ(str.compare(0, 16, "{\"traceEvents\":["), 0);
+    // plan creation phases, host launches, GPU kernels and the
+    // execution as a whole
+    for(const char* cat : {"plan", "launch", "kernel", "execute"})
+        EXPECT_NE(str.find(std::string("\"cat\":\"") + cat + "\""), std::string::npos)
+            << "no " << cat << " events";
+    EXPECT_NE(str.find("\"name\":\"plan_create\""), std::string::npos);
+    EXPECT_NE(str.find("GPU (null stream)"), std::string::npos);
+    EXPECT_NE(str.find("GPU (user streams)"), std::string::npos);
+}
+
+// kernels on user streams are profiled without synchronizing, and
+// logged by a later execution or at cleanup
+TEST(rocfft_UnitTest, profile_user_stream)
+{
+    static const char* PROFILE_FILE = "profile.log";
+
+    BOOST_SCOPE_EXIT_ALL(=)
+    {
+        rocfft_cleanup();
+        remove(PROFILE_FILE);
+        rocfft_setup();
+    };
+
+    rocfft_cleanup();
+    EnvironmentSetTemp layer("ROCFFT_LAYER", "4");
+    EnvironmentSetTemp profilepath("ROCFFT_LOG_PROFILE_PATH", PROFILE_FILE);
+    rocfft_setup();
+    ASSERT_EQ(rocfft_reset_statistics(), rocfft_status_success);
+
+    size_t      length = 8191;
+    rocfft_plan plan   = nullptr;
+    ASSERT_EQ(rocfft_plan_create(&plan,
+                                 rocfft_placement_inplace,
+                                 rocfft_transform_type_complex_forward,
+                                 rocfft_precision_single,
+                                 1,
+                                 &length,
+                                 1,
+                                 nullptr),
+              rocfft_status_success);
+
+    hipStream_t stream;
+    ASSERT_EQ(hipStreamCreate(&stream), hipSuccess);
+    rocfft_execution_info info;
+    ASSERT_EQ(rocfft_execution_info_create(&info), rocfft_status_success);
+    ASSERT_EQ(rocfft_execution_info_set_stream(info, stream), rocfft_status_success);
+
+    gpubuf data;
+    ASSERT_EQ(data.alloc(length * 2 * sizeof(float)), hipSuccess);
+    void* buffers[] = {data.data()};
+    for(size_t i = 0; i < 3; ++i)
+        ASSERT_EQ(rocfft_execute(plan, buffers, nullptr, info), rocfft_status_success);
+
+    rocfft_statistics stats = {sizeof(rocfft_statistics)};
+    ASSERT_EQ(rocfft_get_statistics(&stats), rocfft_status_success);
+
+    rocfft_execution_info_destroy(info);
+    rocfft_plan_destroy(plan);
+    rocfft_cleanup();
+    ASSERT_EQ(hipStreamDestroy(stream), hipSuccess);
+
+    // every kernel launch was profiled
+    std::ifstream profile_log(PROFILE_FILE);
+    std::string   line;
+    size_t        kernels = 0;
+    while(std::getline(profile_log, line))
+    {
+        if(line.compare(0, 14, "TransformPowX,") == 0)
+        {
+            EXPECT_NE(line.find(",duration_ms,"), std::string::npos) << line;
+            ++kernels;
+        }
+    }
+    EXPECT_EQ(kernels, stats.kernel_launches);
+}
+
+// Check the events that executions record for
+// rocfft_execution_info_get_events
+TEST(rocfft_UnitTest, execution_events)
+{
+    size_t      length = 8191;
+    rocfft_plan plan   = nullptr;
+    ASSERT_EQ(rocfft_plan_create(&plan,
+                                 rocfft_placement_inplace,
+                                 rocfft_transform_type_complex_forward,
+                                 rocfft_precision_single,
+                                 1,
+                                 &length,
+                                 1,
+                                 nullptr),
+              rocfft_status_success);
+
+    hipStream_t stream;
+    ASSERT_EQ(hipStreamCreate(&stream), hipSuccess);
+    rocfft_execution_info info;
+    ASSERT_EQ(rocfft_execution_info_create(&info), rocfft_status_success);
+    ASSERT_EQ(rocfft_execution_info_set_stream(info, stream), rocfft_status_success);
+
+    gpubuf data;
+    ASSERT_EQ(data.alloc(length * 2 * sizeof(float)), hipSuccess);
+    void* buffers[] = {data.data()};
+
+    // no events by default
+    size_t count = 1;
+    ASSERT_EQ(rocfft_execute(plan, buffers, nullptr, info), rocfft_status_success);
+    ASSERT_EQ(rocfft_execution_info_get_events(info, nullptr, &count), rocfft_status_success);
+    EXPECT_EQ(count, 0u);
+
+    // one completion event, reused by the next execution
+    void* events[64] = {};
+    ASSERT_EQ(rocfft_execution_info_set_event_mode(info, rocfft_event_mode_completion),
+              rocfft_status_success);
+    ASSERT_EQ(rocfft_execute(plan, buffers, nullptr, info), rocfft_status_success);
+    count = 64;
+    ASSERT_EQ(rocfft_execution_info_get_events(info, events, &count), rocfft_status_success);
+    ASSERT_EQ(count, 1u);
+    void* completion = events[0];
+    ASSERT_EQ(rocfft_execute(plan, buffers, nullptr, info), rocfft_status_success);
+    ASSERT_EQ(rocfft_execution_info_get_events(info, events, &count), rocfft_status_success);
+    ASSERT_EQ(count, 1u);
+    EXPECT_EQ(events[0], completion);
+    EXPECT_EQ(hipEventSynchronize(static_cast<hipEvent_t>(events[0])), hipSuccess);
+
+    // one event per kernel launched
+    ASSERT_EQ(rocfft_reset_statistics(), rocfft_status_success);
+    ASSERT_EQ(rocfft_execution_info_set_event_mode(info, rocfft_event_mode_per_kernel),
+              rocfft_status_success);
+    ASSERT_EQ(rocfft_execute(plan, buffers, nullptr, info), rocfft_status_success);
+    rocfft_statistics stats = {sizeof(rocfft_statistics)};
+    ASSERT_EQ(rocfft_get_statistics(&stats), rocfft_status_success);
+    ASSERT_EQ(rocfft_execution_info_get_events(info, nullptr, &count), rocfft_status_success);
+    EXPECT_EQ(count, stats.kernel_launches);
+    EXPECT_GT(count, 1u);
+
+    // too small an array is an error
+    size_t too_small = count - 1;
+    EXPECT_EQ(rocfft_execution_info_get_events(info, events, &too_small),
+              rocfft_status_invalid_arg_value);
+    count = 64;
+    ASSERT_EQ(rocfft_execution_info_get_events(info, events, &count), rocfft_status_success);
+    for(size_t i = 0; i < count; ++i)
+        EXPECT_EQ(hipEventSynchronize(static_cast<hipEvent_t>(events[i])), hipSuccess);
+
+    rocfft_execution_info_destroy(info);
+    rocfft_plan_destroy(plan);
+    ASSERT_EQ(hipStreamDestroy(stream), hipSuccess);
+}
+
+// Destroy an execution info holding events after rocfft_cleanup,
+// then check that later executions still record usable events
+TEST(rocfft_UnitTest, execution_events_after_cleanup)
+{
+    size_t      length = 64;
+    rocfft_plan plan   = nullptr;
+    ASSERT_EQ(rocfft_plan_create(&plan,
+                                 rocfft_placement_inplace,
+                                 rocfft_transform_type_complex_forward,
+                                 rocfft_precision_single,
+                                 1,
+                                 &length,
+                                 1,
+                                 nullptr),
+              rocfft_status_success);
+
+    gpubuf data;
+    ASSERT_EQ(data.alloc(length * 2 * sizeof(float)), hipSuccess);
+    void* buffers[] = {data.data()};
+
+    rocfft_execution_info info;
+    ASSERT_EQ(rocfft_execution_info_create(&info), rocfft_status_success);
+    ASSERT_EQ(rocfft_execution_info_set_event_mode(info, rocfft_event_mode_completion),
+              rocfft_status_success);
+    ASSERT_EQ(rocfft_execute(plan, buffers, nullptr, info), rocfft_status_success);
+    ASSERT_EQ(hipDeviceSynchronize(), hipSuccess);
+    rocfft_plan_destroy(plan);
+
+    // the info's event is destroyed along with it
+    rocfft_cleanup();
+    rocfft_execution_info_destroy(info);
+    rocfft_setup();
+
+    ASSERT_EQ(rocfft_plan_create(&plan,
+                                 rocfft_placement_inplace,
+                                 rocfft_transform_type_complex_forward,
+                                 rocfft_precision_single,
+                                 1,
+                                 &length,
+                                 1,
+                                 nullptr),
+              rocfft_status_success);
+    ASSERT_EQ(rocfft_execution_info_create(&info), rocfft_status_success);
+    ASSERT_EQ(rocfft_execution_info_set_event_mode(info, rocfft_event_mode_completion),
+              rocfft_status_success);
+    ASSERT_EQ(rocfft_execute(plan, buffers, nullptr, info), rocfft_status_success);
+    void*  event = nullptr;
+    size_t count = 1;
+    ASSERT_EQ(rocfft_execution_info_get_events(info, &event, &count), rocfft_status_success);
+    ASSERT_EQ(count, 1u);
+    EXPECT_EQ(hipEventSynchronize(static_cast<hipEvent_t>(event)), hipSuccess);
+
+    rocfft_execution_info_destroy(info);
+    rocfft_plan_destroy(plan);
+}
+
+TEST(rocfft_UnitTest, statistics)
+{
+    ASSERT_EQ(rocfft_reset_statistics(), rocfft_status_success);
+
+    // prime length needs Bluestein, which needs work memory
+    size_t      length = 8191;
+    rocfft_plan plan   = nullptr;
+    ASSERT_EQ(rocfft_plan_create(&plan,
+                                 rocfft_placement_inplace,
+                                 rocfft_transform_type_complex_forward,
+                                 rocfft_precision_single,
+                                 1,
+                                 &length,
+                                 1,
+                                 nullptr),
+              rocfft_status_success);
+
+    gpubuf data;
+    ASSERT_EQ(data.alloc(length * 2 * sizeof(float)), hipSuccess);
+    void*        buffers[]  = {data.data()};
+    const size_t EXECUTIONS = 3;
+    for(size_t i = 0; i < EXECUTIONS; ++i)
+        ASSERT_EQ(rocfft_execute(plan, buffers, nullptr, nullptr), rocfft_status_success);
+    ASSERT_EQ(hipDeviceSynchronize(), hipSuccess);
+    rocfft_plan_destroy(plan);
+
+    rocfft_statistics stats = {sizeof(rocfft_statistics)};
+    ASSERT_EQ(rocfft_get_statistics(&stats), rocfft_status_success);
+    EXPECT_EQ(stats.plans_created, 1u);
+    EXPECT_EQ(stats.plan_create_failures, 0u);
+    EXPECT_EQ(stats.plans_destroyed, 1u);
+    EXPECT_GT(stats.plan_create_ms, 0.0);
+    EXPECT_EQ(std::accumulate(stats.plan_create_histogram,
+                              stats.plan_create_histogram + ROCFFT_STATISTICS_HISTOGRAM_BUCKETS,
+                              size_t(0)),
+              1u);
+    EXPECT_EQ(std::accumulate(stats.rtc_compile_histogram,
+                              stats.rtc_compile_histogram + ROCFFT_STATISTICS_HISTOGRAM_BUCKETS,
+                              size_t(0)),
+              stats.rtc_compiles);
+    EXPECT_EQ(stats.work_buffer_allocs, EXECUTIONS);
+    EXPECT_GT(stats.work_buffer_bytes, 0u);
+    EXPECT_EQ(stats.executions, EXECUTIONS);
+    // Bluestein is several kernels
+    EXPECT_GT(stats.kernel_launches, EXECUTIONS);
+
+    // per-scheme counts add up to the totals
+    size_t num_schemes = 0;
+    ASSERT_EQ(rocfft_get_scheme_statistics(&num_schemes, nullptr, nullptr, nullptr),
+              rocfft_status_success);
+    ASSERT_GT(num_schemes, 0u);
+    std::vector<const char*> schemes(num_schemes);
+    std::vector<size_t>      executions(num_schemes);
+    std::vector<size_t>      launches(num_schemes);
+    ASSERT_EQ(rocfft_get_scheme_statistics(
+                  &num_schemes, schemes.data(), executions.data(), launches.data()),
+              rocfft_status_success);
+    EXPECT_EQ(std::accumulate(executions.begin(), executions.end(), size_t(0)), EXECUTIONS);
+    EXPECT_EQ(std::accumulate(launches.begin(), launches.end(), size_t(0)),
+              stats.kernel_launches);
+    for(size_t i = 0; i < num_schemes; ++i)
+    {
+        if(executions[i])
+            EXPECT_STREQ(schemes[i], "CS_BLUESTEIN");
+    }
+
+    ASSERT_EQ(rocfft_reset_statistics(), rocfft_status_success);
+    ASSERT_EQ(rocfft_get_statistics(&stats), rocfft_status_success);
+    EXPECT_EQ(stats.plans_created, 0u);
+    EXPECT_EQ(stats.plan_create_ms, 0.0);
+    EXPECT_EQ(stats.executions, 0u);
+    EXPECT_EQ(stats.kernel_launches, 0u);
+
+    // a struct from an older header is only filled in up to its size
+    rocfft_statistics older;
+    memset(&older, 0xff, sizeof(older));
+    older.struct_size = offsetof(rocfft_statistics, log_records_dropped);
+    ASSERT_EQ(rocfft_get_statistics(&older), rocfft_status_success);
+    EXPECT_EQ(older.struct_size, offsetof(rocfft_statistics, log_records_dropped));
+    EXPECT_EQ(older.kernel_launches, 0u);
+    EXPECT_EQ(older.log_records_dropped, std::numeric_limits<size_t>::max());
+
+    // sizes that hold no counters, or more than the library knows
+    // about, are rejected
+    for(size_t size : {size_t(0), sizeof(size_t), sizeof(rocfft_statistics) + 1})
+    {
+        stats.struct_size = size;
+        EXPECT_EQ(rocfft_get_statistics(&stats), rocfft_status_invalid_arg_value);
     }
 }
 
@@ -539,3 +1170,865 @@ TEST(rocfft_UnitTest, rtc_helper_crash)
     plan = nullptr;
 }
 #endif
+
+// Emulate on the CPU a Stockham kernel that exchanges data between
+// passes with cross-lane shuffles, exactly the way the generator
+// emits them, and check the result against a naive DFT.
+TEST(rocfft_UnitTest, shfl_exchange_emulation)
+{
+    typedef std::complex<double>                complex_t;
+    typedef std::vector<std::vector<complex_t>> lanes_t;
+
+    const std::vector<std::vector<unsigned int>> factorizations = {
+        {2, 2}, {4, 2}, {2, 2, 2}, {4, 4}, {8, 4}, {4, 8}, {3, 4}, {4, 4, 4}, {8, 8}, {2, 4, 8}};
+
+    for(const auto& factors : factorizations)
+    {
+        unsigned int length = 1;
+        for(auto f : factors)
+            length *= f;
+
+        std::vector<complex_t> input(length);
+        for(unsigned int i = 0; i < length; ++i)
+            input[i] = complex_t(std::cos(0.1 * i * i), std::sin(0.3 * i) - 0.25);
+
+        std::vector<complex_t> expected(length);
+        for(unsigned int k = 0; k < length; ++k)
+            for(unsigned int i = 0; i < length; ++i)
+                expected[k] += input[i] * std::polar(1.0, -2.0 * M_PI * i * k / length);
+
+        for(unsigned int tpt = 1; tpt <= SHFL_EXCHANGE_MAX_THREADS; tpt *= 2)
+        {
+            if(!shfl_exchange_supported(length, factors, tpt))
+                continue;
+            SCOPED_TRACE("length " + std::to_string(length) + " tpt " + std::to_string(tpt));
+
+            const unsigned int nregisters = length / tpt;
+            lanes_t            R(tpt, std::vector<complex_t>(nregisters));
+
+            // load global -> registers for the first pass
+            for(unsigned int thread = 0; thread < tpt; ++thread)
+                for(unsigned int h = 0; h < length / factors[0] / tpt; ++h)
+                    for(unsigned int w = 0; w < factors[0]; ++w)
+                        R[thread][h * factors[0] + w]
+                            = input[thread + h * tpt + w * length / factors[0]];
+
+            unsigned int cumheight = 1;
+            for(unsigned int npass = 0; npass < factors.size(); ++npass)
+            {
+                const unsigned int width = factors[npass];
+                for(unsigned int thread = 0; thread < tpt; ++thread)
+                {
+                    for(unsigned int h = 0; h < length / width / tpt; ++h)
+                    {
+                        const unsigned int tid = thread + h * tpt;
+                        complex_t*         reg = R[thread].data() + h * width;
+
+                        // twiddle, then radix-width butterfly
+                        for(unsigned int w = 1; w < width; ++w)
+                            reg[w] *= std::polar(
+                                1.0, -2.0 * M_PI * (tid % cumheight) * w / (cumheight * width));
+                        std::vector<complex_t> out(width);
+                        for(unsigned int k = 0; k < width; ++k)
+                            for(unsigned int w = 0; w < width; ++w)
+                                out[k] += reg[w] * std::polar(1.0, -2.0 * M_PI * w * k / width);
+                        std::copy(out.begin(), out.end(), reg);
+                    }
+                }
+
+                if(npass == factors.size() - 1)
+                    break;
+
+                // one shuffle per candidate source register; each lane
+                // keeps the value if it came from the register it wants
+                lanes_t exchanged(tpt, std::vector<complex_t>(nregisters));
+                for(unsigned int reg = 0; reg < nregisters; ++reg)
+                {
+                    auto candidates = shfl_exchange_candidates(length, factors, tpt, npass, reg);
+                    for(auto c : candidates)
+                    {
+                        for(unsigned int thread = 0; thread < tpt; ++thread)
+                        {
+                            auto src
+                                = shfl_exchange_source(length, factors, tpt, npass, thread, reg);
+                            ASSERT_LT(src.lane, tpt);
+                            if(src.reg == c)
+                                exchanged[thread][reg] = R[src.lane][c];
+                        }
+                    }
+                }
+                R = exchanged;
+                cumheight *= width;
+            }
+
+            // store registers -> global after the last pass
+            const unsigned int     width = factors.back();
+            std::vector<complex_t> output(length);
+            for(unsigned int thread = 0; thread < tpt; ++thread)
+            {
+                for(unsigned int h = 0; h < length / width / tpt; ++h)
+                {
+                    const unsigned int tid = thread + h * tpt;
+                    for(unsigned int w = 0; w < width; ++w)
+                        output[(tid / cumheight) * (width * cumheight) + tid % cumheight
+                               + w * cumheight]
+                            = R[thread][h * width + w];
+                }
+            }
+
+            for(unsigned int i = 0; i < length; ++i)
+                ASSERT_LT(std::abs(output[i] - expected[i]), 1e-9 * length) << "index " << i;
+        }
+    }
+}
+
+// Check host-side twiddle generation against a long double
+// reference, for numerators that need reducing and for tables big
+// enough to be generated on multiple threads.
+template <typename T>
+static void check_twiddle_accuracy(double tolerance)
+{
+    const long double TWO_PI = 6.283185307179586476925286766559005768L;
+
+    // odd multiplier, so that numerators wrap around the circle many
+    // times and land in every octant
+    const size_t multiplier = 12345;
+
+    for(size_t length : {1, 2, 7, 64, 125, 4096, 255255, 1 << 17})
+    {
+        SCOPED_TRACE("length " + std::to_string(length));
+        std::vector<T> table(length);
+        twiddle_fill(table.data(), length, [=](size_t i) {
+            return twiddle_value<T>(i * multiplier, length);
+        });
+
+        // reflecting first-octant values must give exactly the
+        // same twiddles as evaluating each one
+        twiddle_octant<T> twiddle(length, length);
+        std::vector<T>    reflected(length);
+        twiddle_fill(reflected.data(), length, [&](size_t i) {
+            return twiddle(i * multiplier);
+        });
+
+        double max_err    = 0.0;
+        size_t mismatches = 0;
+        for(size_t i = 0; i < length; ++i)
+        {
+            long double theta = -TWO_PI * ((i * multiplier) % length) / length;
+            max_err = std::max<double>(max_err, std::fabs(table[i].x - std::cos(theta)));
+            max_err = std::max<double>(max_err, std::fabs(table[i].y - std::sin(theta)));
+            if(reflected[i].x != table[i].x || reflected[i].y != table[i].y)
+                ++mismatches;
+        }
+        EXPECT_LE(max_err, tolerance);
+        EXPECT_EQ(mismatches, 0u);
+    }
+}
+
+TEST(rocfft_UnitTest, twiddle_accuracy)
+{
+    check_twiddle_accuracy<double2>(2 * std::numeric_limits<double>::epsilon());
+    check_twiddle_accuracy<float2>(std::numeric_limits<float>::epsilon());
+}
+
+// Check the host-side layout of a plan's kernel argument arena:
+// each node gets its own block, and lengths, strides and distances
+// land where the kernels expect them.
+TEST(rocfft_UnitTest, kargs_arena_layout)
+{
+    kargs_arena arena;
+
+    // 1D node followed by a 3D node
+    auto offset_1D = arena.reserve(KERN_ARGS_BLOCK_SIZE);
+    kargs_fill(arena.host_block(offset_1D), {64}, {1}, {2}, 64, 128);
+    auto offset_3D = arena.reserve(KERN_ARGS_BLOCK_SIZE);
+    kargs_fill(arena.host_block(offset_3D), {8, 16, 32}, {1, 8, 128}, {512, 1, 8}, 4096, 4096);
+
+    EXPECT_EQ(offset_1D, 0u);
+    EXPECT_EQ(offset_3D, static_cast<size_t>(KERN_ARGS_BLOCK_SIZE));
+    EXPECT_EQ(arena.size_bytes(), 2 * KERN_ARGS_BLOCK_SIZE * sizeof(size_t));
+
+    const size_t* block = arena.host_block(offset_1D);
+    EXPECT_EQ(block[0], 64u);
+    EXPECT_EQ(block[KERN_ARGS_ARRAY_WIDTH], 1u);
+    EXPECT_EQ(block[KERN_ARGS_ARRAY_WIDTH + 1], 64u);
+    EXPECT_EQ(block[2 * KERN_ARGS_ARRAY_WIDTH], 2u);
+    EXPECT_EQ(block[2 * KERN_ARGS_ARRAY_WIDTH + 1], 128u);
+    // unused slots are zeroed
+    EXPECT_EQ(block[1], 0u);
+    EXPECT_EQ(block[KERN_ARGS_BLOCK_SIZE - 1], 0u);
+
+    block = arena.host_block(offset_3D);
+    EXPECT_EQ(block[2], 32u);
+    EXPECT_EQ(block[KERN_ARGS_ARRAY_WIDTH + 2], 128u);
+    EXPECT_EQ(block[KERN_ARGS_ARRAY_WIDTH + 3], 4096u);
+    EXPECT_EQ(block[2 * KERN_ARGS_ARRAY_WIDTH], 512u);
+    EXPECT_EQ(block[2 * KERN_ARGS_ARRAY_WIDTH + 3], 4096u);
+
+    // nothing has touched the device yet
+    EXPECT_EQ(arena.alloc_count, 0u);
+    EXPECT_EQ(arena.copy_count, 0u);
+}
+
+// Graph calls that just count what they're asked to do, so that
+// graph_cache can be tested without a device.
+struct mock_graph_ops : public graph_ops
+{
+    bool   capturing    = false;
+    bool   fail_capture = false;
+    bool   fail_update  = false;
+    size_t captures     = 0;
+    size_t instantiates = 0;
+    size_t updates      = 0;
+    size_t launches     = 0;
+    size_t graphs       = 0;
+    size_t execs        = 0;
+    size_t next_handle  = 1;
+
+    bool begin_capture(hipStream_t stream) override
+    {
+        if(capturing)
+            return false;
+        capturing = true;
+        return true;
+    }
+    bool end_capture(hipStream_t stream, hipGraph_t& graph) override
+    {
+        capturing = false;
+        if(fail_capture)
+            return false;
+        ++captures;
+        ++graphs;
+        graph = reinterpret_cast<hipGraph_t>(next_handle++);
+        return true;
+    }
+    bool instantiate(hipGraph_t graph, hipGraphExec_t& exec) override
+    {
+        ++instantiates;
+        ++execs;
+        exec = reinterpret_cast<hipGraphExec_t>(next_handle++);
+        return true;
+    }
+    bool update(hipGraphExec_t exec, hipGraph_t graph) override
+    {
+        if(fail_update)
+            return false;
+        ++updates;
+        return true;
+    }
+    bool launch(hipGraphExec_t exec, hipStream_t stream) override
+    {
+        ++launches;
+        return true;
+    }
+    void destroy_graph(hipGraph_t graph) override
+    {
+        --graphs;
+    }
+    void destroy_exec(hipGraphExec_t exec) override
+    {
+        --execs;
+    }
+};
+
+// Check when graph_cache captures, updates and replays graphs, and
+// when it falls back to launching kernels directly.
+TEST(rocfft_UnitTest, graph_cache_replay)
+{
+    mock_graph_ops ops;
+
+    // count launches that ran directly, and launches that were
+    // captured into a graph
+    size_t eager    = 0;
+    size_t captured = 0;
+    auto   launch   = [&]() { ops.capturing ? ++captured : ++eager; };
+
+    std::vector<char> buffers(16);
+    auto              stream = reinterpret_cast<hipStream_t>(0x100);
+
+    graph_key key;
+    key.in_buffer[0]  = buffers.data();
+    key.out_buffer[0] = buffers.data() + 1;
+    key.work_buffer   = buffers.data() + 2;
+    key.stream        = stream;
+    {
+        graph_cache cache(ops);
+
+        // the null stream is never captured
+        graph_key null_key = key;
+        null_key.stream    = nullptr;
+        EXPECT_EQ(cache.execute(null_key, launch), graph_cache::EAGER);
+        EXPECT_EQ(eager, 1u);
+        EXPECT_EQ(ops.captures, 0u);
+
+        // first execution captures, later ones replay
+        EXPECT_EQ(cache.execute(key, launch), graph_cache::CAPTURED);
+        EXPECT_EQ(captured, 1u);
+        EXPECT_EQ(ops.launches, 1u);
+        for(size_t i = 0; i < 3; ++i)
+            EXPECT_EQ(cache.execute(key, launch), graph_cache::REPLAYED);
+        EXPECT_EQ(captured, 1u);
+        EXPECT_EQ(eager, 1u);
+        EXPECT_EQ(ops.launches, 4u);
+
+        // new buffers update the cached graph instead of
+        // instantiating another
+        graph_key moved     = key;
+        moved.out_buffer[0] = buffers.data() + 3;
+        EXPECT_EQ(cache.execute(moved, launch), graph_cache::UPDATED);
+        EXPECT_EQ(ops.instantiates, 1u);
+        EXPECT_EQ(cache.size(), 1u);
+        EXPECT_EQ(cache.execute(moved, launch), graph_cache::REPLAYED);
+        // the original buffers are no longer cached
+        EXPECT_EQ(cache.execute(key, launch), graph_cache::UPDATED);
+
+        // callbacks launch different kernels, so need their own graph
+        graph_key with_callback            = key;
+        with_callback.callbacks.load_cb_fn = buffers.data() + 4;
+        EXPECT_EQ(cache.execute(with_callback, launch), graph_cache::CAPTURED);
+        EXPECT_EQ(cache.size(), 2u);
+        EXPECT_EQ(cache.execute(key, launch), graph_cache::REPLAYED);
+        EXPECT_EQ(cache.execute(with_callback, launch), graph_cache::REPLAYED);
+
+        // a graph that can't be updated is replaced by a new one
+        ops.fail_update = true;
+        EXPECT_EQ(cache.execute(moved, launch), graph_cache::CAPTURED);
+        EXPECT_EQ(cache.size(), 3u);
+        ops.fail_update = false;
+
+        // if the stream is already capturing (e.g. into the caller's
+        // own graph), kernels are launched into that capture
+        ops.capturing = true;
+
+        graph_key other_stream = key;
+        other_stream.stream    = reinterpret_cast<hipStream_t>(0x200);
+        EXPECT_EQ(cache.execute(other_stream, launch), graph_cache::EAGER);
+        ops.capturing = false;
+
+        // buffers that change on every execution stop being captured,
+        // but cached graphs still replay
+        size_t captures = ops.captures;
+        size_t misses   = 0;
+        for(size_t i = 0; i < 4 * graph_cache::MAX_MISSES; ++i)
+        {
+            graph_key changing    = key;
+            changing.work_buffer  = buffers.data() + 5 + (i % 8);
+            changing.in_buffer[0] = reinterpret_cast<void*>(0x1000 + i);
+            if(cache.execute(changing, launch) == graph_cache::EAGER)
+                ++misses;
+        }
+        EXPECT_LT(ops.captures - captures, 2 * graph_cache::MAX_MISSES);
+        EXPECT_GT(misses, 0u);
+        EXPECT_LE(cache.size(), graph_cache::MAX_GRAPHS);
+
+        // captured graphs are destroyed once instantiated
+        EXPECT_EQ(ops.graphs, 0u);
+    }
+    // and instantiated graphs are destroyed with the cache
+    EXPECT_EQ(ops.execs, 0u);
+
+    // if capture fails, kernels are launched directly from then on
+    {
+        graph_cache cache(ops);
+        ops.fail_capture = true;
+        eager            = 0;
+        EXPECT_EQ(cache.execute(key, launch), graph_cache::EAGER);
+        EXPECT_EQ(eager, 1u);
+        ops.fail_capture = false;
+        EXPECT_EQ(cache.execute(key, launch), graph_cache::EAGER);
+        EXPECT_EQ(eager, 2u);
+        EXPECT_EQ(cache.size(), 0u);
+    }
+}
+
+// Check that a multi-kernel plan replayed from graphs on a user
+// stream gives the same results as launching its kernels directly,
+// including after the buffers change and the graph is updated.
+TEST(rocfft_UnitTest, graph_replay_matches_eager)
+{
+    static const char* TRACE_FILE = "graph_trace.json";
+
+    BOOST_SCOPE_EXIT_ALL(=)
+    {
+        rocfft_cleanup();
+        remove(TRACE_FILE);
+        rocfft_setup();
+    };
+
+    // the Chrome trace says what each execution did with its graph
+    rocfft_cleanup();
+    EnvironmentSetTemp layer("ROCFFT_LAYER", "128");
+    EnvironmentSetTemp tracepath("ROCFFT_LOG_CHROME_TRACE_PATH", TRACE_FILE);
+    rocfft_setup();
+
+    // 2D transforms need several kernels
+    std::vector<size_t> lengths = {64, 96};
+    const size_t        batch   = 2;
+    const size_t        count   = lengths[0] * lengths[1] * batch;
+    const size_t        bytes   = count * sizeof(std::complex<float>);
+
+    rocfft_plan plan = nullptr;
+    ASSERT_EQ(rocfft_plan_create(&plan,
+                                 rocfft_placement_notinplace,
+                                 rocfft_transform_type_complex_forward,
+                                 rocfft_precision_single,
+                                 lengths.size(),
+                                 lengths.data(),
+                                 batch,
+                                 nullptr),
+              rocfft_status_success);
+    size_t work_size = 0;
+    ASSERT_EQ(rocfft_plan_get_work_buffer_size(plan, &work_size), rocfft_status_success);
+    gpubuf work;
+    if(work_size)
+        ASSERT_EQ(work.alloc(work_size), hipSuccess);
+
+    hipStream_t stream = nullptr;
+    ASSERT_EQ(hipStreamCreate(&stream), hipSuccess);
+    rocfft_execution_info replay_info = nullptr;
+    rocfft_execution_info eager_info  = nullptr;
+    for(auto info : {&replay_info, &eager_info})
+    {
+        ASSERT_EQ(rocfft_execution_info_create(info), rocfft_status_success);
+        ASSERT_EQ(rocfft_execution_info_set_stream(*info, stream), rocfft_status_success);
+        if(work_size)
+            ASSERT_EQ(rocfft_execution_info_set_work_buffer(*info, work.data(), work_size),
+                      rocfft_status_success);
+    }
+    ASSERT_EQ(rocfft_execution_info_set_graph_replay(replay_info, 1), rocfft_status_success);
+
+    std::vector<std::vector<std::complex<float>>> inputs(2);
+    std::mt19937                                  gen(1234);
+    std::uniform_real_distribution<float>         dist(-1.0f, 1.0f);
+    for(auto& input : inputs)
+    {
+        input.resize(count);
+        for(auto& x : input)
+            x = {dist(gen), dist(gen)};
+    }
+
+    gpubuf in[2], out[2], eager_out;
+    for(size_t i = 0; i < 2; ++i)
+    {
+        ASSERT_EQ(in[i].alloc(bytes), hipSuccess);
+        ASSERT_EQ(out[i].alloc(bytes), hipSuccess);
+    }
+    ASSERT_EQ(eager_out.alloc(bytes), hipSuccess);
+
+    // which buffers and input each execution uses, and what should
+    // happen to its graph
+    struct run_t
+    {
+        size_t      buffers;
+        size_t      input;
+        const char* graph;
+    };
+    const std::vector<run_t> runs = {{0, 0, "captured"},
+                                     // same buffers, new contents
+                                     {0, 1, "replayed"},
+                                     // new buffers
+                                     {1, 0, "updated"},
+                                     {1, 1, "replayed"},
+                                     {0, 1, "updated"}};
+
+    std::vector<std::complex<float>> replay_result(count), eager_result(count);
+    for(const auto& run : runs)
+    {
+        const auto& input = inputs[run.input];
+
+        void* in_ptr[]  = {in[run.buffers].data()};
+        void* out_ptr[] = {out[run.buffers].data()};
+        ASSERT_EQ(hipMemcpy(in_ptr[0], input.data(), bytes, hipMemcpyHostToDevice), hipSuccess);
+        ASSERT_EQ(rocfft_execute(plan, in_ptr, out_ptr, replay_info), rocfft_status_success);
+        ASSERT_EQ(hipStreamSynchronize(stream), hipSuccess);
+        ASSERT_EQ(hipMemcpy(replay_result.data(), out_ptr[0], bytes, hipMemcpyDeviceToHost),
+                  hipSuccess);
+
+        // the transform may overwrite its input, so start over
+        void* eager_ptr[] = {eager_out.data()};
+        ASSERT_EQ(hipMemcpy(in_ptr[0], input.data(), bytes, hipMemcpyHostToDevice), hipSuccess);
+        ASSERT_EQ(rocfft_execute(plan, in_ptr, eager_ptr, eager_info), rocfft_status_success);
+        ASSERT_EQ(hipStreamSynchronize(stream), hipSuccess);
+        ASSERT_EQ(hipMemcpy(eager_result.data(), eager_ptr[0], bytes, hipMemcpyDeviceToHost),
+                  hipSuccess);
+
+        // the same kernels ran on the same data
+        EXPECT_EQ(memcmp(replay_result.data(), eager_result.data(), bytes), 0)
+            << "graph " << run.graph << " differs from eager execution";
+    }
+
+    rocfft_execution_info_destroy(replay_info);
+    rocfft_execution_info_destroy(eager_info);
+    rocfft_plan_destroy(plan);
+    ASSERT_EQ(hipStreamDestroy(stream), hipSuccess);
+    rocfft_cleanup();
+
+    // only replayed executions say what happened to their graph
+    std::ifstream     trace_file(TRACE_FILE);
+    std::stringstream trace;
+    trace << trace_file.rdbuf();
+    std::string              str = trace.str();
+    std::vector<std::string> graphs;
+    static const std::string graph_field = "\"graph\":\"";
+    for(auto pos = str.find(graph_field); pos != std::string::npos;
+        pos      = str.find(graph_field, pos + 1))
+    {
+        auto begin = pos + graph_field.size();
+        graphs.push_back(str.substr(begin, str.find('"', begin) - begin));
+    }
+    ASSERT_EQ(graphs.size(), runs.size());
+    if(graphs.front() == "eager")
+        GTEST_SKIP() << "graphs can't be captured on this runtime";
+    for(size_t i = 0; i < runs.size(); ++i)
+        EXPECT_EQ(graphs[i], runs[i].graph) << "execution " << i;
+}
+
+// Run a multi-device decomposition's exchanges on host vectors, one
+// per simulated device, and check that data lands where each step
+// of the transform expects it.
+TEST(rocfft_UnitTest, multi_device_decomposition)
+{
+    typedef std::vector<std::vector<size_t>> device_buffers;
+
+    auto exchange = [](const std::vector<md_copy>& copies,
+                       const device_buffers&       src,
+                       device_buffers&             dst) {
+        for(const auto& copy : copies)
+            for(size_t row = 0; row < copy.height; ++row)
+                for(size_t col = 0; col < copy.width; ++col)
+                    dst[copy.dst_device].at(copy.dst_offset + row * copy.dst_pitch + col)
+                        = src[copy.src_device].at(copy.src_offset + row * copy.src_pitch + col);
+    };
+
+    const std::vector<std::pair<std::vector<size_t>, size_t>> problems = {
+        {{5, 3, 7}, 3}, {{8, 6}, 4}, {{64, 5}, 2}, {{4, 3}, 8}, {{1, 16}, 4}};
+    for(const auto& problem : problems)
+    {
+        const auto& lengths = problem.first;
+        auto        dec     = md_decompose(lengths, problem.second);
+        size_t      D       = dec.devices();
+        SCOPED_TRACE("devices " + std::to_string(D) + ", inner " + std::to_string(dec.inner));
+
+        // never more devices than rows or columns to give them
+        EXPECT_LE(D, problem.second);
+        EXPECT_LE(D, lengths.back());
+        EXPECT_LE(D, dec.inner);
+        EXPECT_EQ(dec.rows.back().offset + dec.rows.back().count, lengths.back());
+        EXPECT_EQ(dec.cols.back().offset + dec.cols.back().count, dec.inner);
+
+        // each round sends one block from and to every device
+        ASSERT_EQ(dec.to_columns.size(), D * D);
+        for(size_t round = 0; round < D; ++round)
+        {
+            std::set<size_t> sources, destinations;
+            for(size_t i = round * D; i < (round + 1) * D; ++i)
+            {
+                sources.insert(dec.to_columns[i].src_device);
+                destinations.insert(dec.to_columns[i].dst_device);
+            }
+            EXPECT_EQ(sources.size(), D);
+            EXPECT_EQ(destinations.size(), D);
+        }
+
+        // label every element of the slabs with its global index
+        device_buffers slabs(D), columns(D), result(D);
+        for(size_t d = 0; d < D; ++d)
+        {
+            slabs[d].resize(dec.slab_elements(d));
+            std::iota(slabs[d].begin(), slabs[d].end(), dec.rows[d].offset * dec.inner);
+            columns[d].assign(dec.column_elements(d), SIZE_MAX);
+            result[d].assign(dec.slab_elements(d), SIZE_MAX);
+        }
+
+        // each device gets its columns over the whole slowest dimension
+        exchange(dec.to_columns, slabs, columns);
+        for(size_t d = 0; d < D; ++d)
+            for(size_t row = 0; row < lengths.back(); ++row)
+                for(size_t col = 0; col < dec.cols[d].count; ++col)
+                    ASSERT_EQ(columns[d][row * dec.cols[d].count + col],
+                              row * dec.inner + dec.cols[d].offset + col);
+
+        // and the second exchange puts them back
+        exchange(dec.to_slabs, columns, result);
+        EXPECT_EQ(result, slabs);
+    }
+
+    EXPECT_THROW(md_decompose({16}, 2), std::runtime_error);
+    EXPECT_THROW(md_decompose({16, 16}, 0), std::runtime_error);
+}
+
+// Run a double-precision 2D transform across 'device_ids' and
+// compare it with the same transform on the current device.
+static void check_multi_device_transform(const std::vector<int>& device_ids,
+                                         rocfft_result_placement placement)
+{
+    const std::vector<size_t> lengths = {24, 10};
+    const size_t              inner   = lengths[0];
+    const size_t              count   = lengths[0] * lengths[1];
+    const size_t              elem    = sizeof(std::complex<double>);
+
+    int current = 0;
+    ASSERT_EQ(hipGetDevice(&current), hipSuccess);
+    BOOST_SCOPE_EXIT_ALL(&)
+    {
+        (void)hipSetDevice(current);
+    };
+
+    std::vector<std::complex<double>> input(count);
+    for(size_t i = 0; i < count; ++i)
+        input[i] = {std::sin(0.37 * i), std::cos(0.11 * i)};
+
+    std::vector<std::complex<double>> expected(count);
+    {
+        rocfft_plan plan = nullptr;
+        ASSERT_EQ(rocfft_plan_create(&plan,
+                                     rocfft_placement_inplace,
+                                     rocfft_transform_type_complex_forward,
+                                     rocfft_precision_double,
+                                     lengths.size(),
+                                     lengths.data(),
+                                     1,
+                                     nullptr),
+                  rocfft_status_success);
+        gpubuf data;
+        ASSERT_EQ(data.alloc(count * elem), hipSuccess);
+        ASSERT_EQ(hipMemcpy(data.data(), input.data(), count * elem, hipMemcpyHostToDevice),
+                  hipSuccess);
+        void* buffers[] = {data.data()};
+        ASSERT_EQ(rocfft_execute(plan, buffers, nullptr, nullptr), rocfft_status_success);
+        ASSERT_EQ(hipMemcpy(expected.data(), data.data(), count * elem, hipMemcpyDeviceToHost),
+                  hipSuccess);
+        rocfft_plan_destroy(plan);
+    }
+
+    ASSERT_EQ(rocfft_reset_statistics(), rocfft_status_success);
+    rocfft_plan_description desc = nullptr;
+    ASSERT_EQ(rocfft_plan_description_create(&desc), rocfft_status_success);
+    ASSERT_EQ(rocfft_plan_description_set_devices(
+                  desc, const_cast<int*>(device_ids.data()), device_ids.size()),
+              rocfft_status_success);
+    rocfft_plan plan = nullptr;
+    ASSERT_EQ(rocfft_plan_create(&plan,
+                                 placement,
+                                 rocfft_transform_type_complex_forward,
+                                 rocfft_precision_double,
+                                 lengths.size(),
+                                 lengths.data(),
+                                 1,
+                                 desc),
+              rocfft_status_success);
+    rocfft_plan_description_destroy(desc);
+
+    // per-device sub-plans don't count as plans of their own
+    rocfft_statistics stats = {sizeof(rocfft_statistics)};
+    ASSERT_EQ(rocfft_get_statistics(&stats), rocfft_status_success);
+    EXPECT_EQ(stats.plans_created, 1u);
+
+    // each device gets a slab of the slowest dimension
+    auto rows = md_split(lengths.back(), std::min({device_ids.size(), lengths.back(), inner}));
+    std::vector<gpubuf> in(rows.size()), out(rows.size());
+    std::vector<void*>  in_ptrs, out_ptrs;
+    for(size_t d = 0; d < rows.size(); ++d)
+    {
+        ASSERT_EQ(hipSetDevice(device_ids[d]), hipSuccess);
+        size_t bytes = rows[d].count * inner * elem;
+        ASSERT_EQ(in[d].alloc(bytes), hipSuccess);
+        ASSERT_EQ(hipMemcpy(in[d].data(),
+                            input.data() + rows[d].offset * inner,
+                            bytes,
+                            hipMemcpyHostToDevice),
+                  hipSuccess);
+        in_ptrs.push_back(in[d].data());
+        if(placement == rocfft_placement_notinplace)
+        {
+            ASSERT_EQ(out[d].alloc(bytes), hipSuccess);
+            out_ptrs.push_back(out[d].data());
+        }
+    }
+    ASSERT_EQ(hipSetDevice(device_ids.front()), hipSuccess);
+    void** out_buffer = out_ptrs.empty() ? nullptr : out_ptrs.data();
+
+    rocfft_execution_info info = nullptr;
+    ASSERT_EQ(rocfft_execution_info_create(&info), rocfft_status_success);
+    if(rows.size() > 1)
+    {
+        // sub-plans can't run callbacks, or use a work buffer that's
+        // only on one device
+        void* not_a_callback[] = {in_ptrs.front()};
+        ASSERT_EQ(rocfft_execution_info_set_load_callback(info, not_a_callback, nullptr, 0),
+                  rocfft_status_success);
+        EXPECT_EQ(rocfft_execute(plan, in_ptrs.data(), out_buffer, info),
+                  rocfft_status_invalid_arg_value);
+        ASSERT_EQ(rocfft_execution_info_set_load_callback(info, nullptr, nullptr, 0),
+                  rocfft_status_success);
+
+        rocfft_execution_info work_info = nullptr;
+        ASSERT_EQ(rocfft_execution_info_create(&work_info), rocfft_status_success);
+        ASSERT_EQ(rocfft_execution_info_set_work_buffer(work_info, in_ptrs.front(), elem),
+                  rocfft_status_success);
+        EXPECT_EQ(rocfft_execute(plan, in_ptrs.data(), out_buffer, work_info),
+                  rocfft_status_invalid_work_buffer);
+        rocfft_execution_info_destroy(work_info);
+    }
+
+    ASSERT_EQ(rocfft_execute(plan, in_ptrs.data(), out_buffer, info), rocfft_status_success);
+    ASSERT_EQ(hipDeviceSynchronize(), hipSuccess);
+    ASSERT_EQ(rocfft_get_statistics(&stats), rocfft_status_success);
+    EXPECT_EQ(stats.executions, 1u);
+
+    std::vector<std::complex<double>> result(count);
+    auto&                             result_bufs = out_ptrs.empty() ? in : out;
+    for(size_t d = 0; d < rows.size(); ++d)
+        ASSERT_EQ(hipMemcpy(result.data() + rows[d].offset * inner,
+                            result_bufs[d].data(),
+                            rows[d].count * inner * elem,
+                            hipMemcpyDeviceToHost),
+                  hipSuccess);
+
+    double max_diff = 0.0;
+    double max_abs  = 0.0;
+    for(size_t i = 0; i < count; ++i)
+    {
+        max_diff = std::max(max_diff, std::abs(result[i] - expected[i]));
+        max_abs  = std::max(max_abs, std::abs(expected[i]));
+    }
+    EXPECT_LE(max_diff, 1e-12 * max_abs);
+
+    rocfft_execution_info_destroy(info);
+    rocfft_plan_destroy(plan);
+}
+
+// A single listed device binds the plan to it
+TEST(rocfft_UnitTest, multi_device_one_gpu)
+{
+    int device = 0;
+    ASSERT_EQ(hipGetDevice(&device), hipSuccess);
+    for(auto placement : {rocfft_placement_inplace, rocfft_placement_notinplace})
+    {
+        SCOPED_TRACE(placement == rocfft_placement_inplace ? "in-place" : "out-of-place");
+        check_multi_device_transform({device}, placement);
+    }
+
+    // each device can only hold one slab
+    rocfft_plan_description desc = nullptr;
+    ASSERT_EQ(rocfft_plan_description_create(&desc), rocfft_status_success);
+    int twice[] = {device, device};
+    EXPECT_EQ(rocfft_plan_description_set_devices(desc, twice, 2),
+              rocfft_status_invalid_arg_value);
+    rocfft_plan_description_destroy(desc);
+}
+
+// Split a transform across the first two devices
+TEST(rocfft_UnitTest, multi_device_two_gpus)
+{
+    int device_count = 0;
+    ASSERT_EQ(hipGetDeviceCount(&device_count), hipSuccess);
+    if(device_count < 2)
+        GTEST_SKIP() << "needs at least two devices";
+    for(auto placement : {rocfft_placement_inplace, rocfft_placement_notinplace})
+    {
+        SCOPED_TRACE(placement == rocfft_placement_inplace ? "in-place" : "out-of-place");
+        check_multi_device_transform({0, 1}, placement);
+    }
+}
+
+TEST(rocfft_UnitTest, grouped_plan_binning)
+{
+    // a length-8 kernel does 4 transforms per block, and a
+    // length-16 kernel does 2
+    auto transforms_per_block = [](size_t length) -> size_t {
+        return length == 8 ? 4 : length == 16 ? 2 : 0;
+    };
+
+    std::vector<grouped_problem> problems(4);
+    problems[0].length  = 16;
+    problems[0].batch   = 3;
+    problems[0].dist[0] = 16;
+    problems[0].dist[1] = 16;
+
+    problems[1].length    = 8;
+    problems[1].batch     = 6;
+    problems[1].dist[0]   = 8;
+    problems[1].dist[1]   = 10;
+    problems[1].offset[0] = 48;
+    problems[1].offset[1] = 100;
+
+    // non-unit stride goes in its own bin
+    problems[2].length    = 8;
+    problems[2].batch     = 2;
+    problems[2].stride[0] = 2;
+    problems[2].dist[0]   = 1;
+    problems[2].dist[1]   = 8;
+    problems[2].offset[0] = 96;
+    problems[2].offset[1] = 200;
+
+    problems[3].length    = 8;
+    problems[3].batch     = 1;
+    problems[3].dist[0]   = 8;
+    problems[3].dist[1]   = 8;
+    problems[3].offset[0] = 112;
+    problems[3].offset[1] = 300;
+
+    auto bins = grouped_bin_problems(problems, transforms_per_block);
+    ASSERT_EQ(bins.size(), 3u);
+
+    // bins are ordered by length, then non-unit stride first
+    EXPECT_EQ(bins[0].length, 8u);
+    EXPECT_FALSE(bins[0].unit_stride);
+    EXPECT_EQ(bins[0].problems, std::vector<size_t>({2}));
+    EXPECT_EQ(bins[0].table[0], std::vector<size_t>({96, 2, 1, 2}));
+    EXPECT_EQ(bins[0].table[1], std::vector<size_t>({200, 1, 8, 2}));
+
+    // a block never spans two problems, so the partial block of
+    // problem 1 isn't filled from problem 3
+    EXPECT_EQ(bins[1].length, 8u);
+    EXPECT_TRUE(bins[1].unit_stride);
+    EXPECT_EQ(bins[1].problems, std::vector<size_t>({1, 3}));
+    EXPECT_EQ(bins[1].blocks(), 3u);
+    EXPECT_EQ(bins[1].table[0], std::vector<size_t>({48, 1, 8, 4, 80, 1, 8, 2, 112, 1, 8, 1}));
+    EXPECT_EQ(bins[1].table[1], std::vector<size_t>({100, 1, 10, 4, 140, 1, 10, 2, 300, 1, 8, 1}));
+
+    EXPECT_EQ(bins[2].length, 16u);
+    EXPECT_EQ(bins[2].blocks(), 2u);
+    EXPECT_EQ(bins[2].table[0], std::vector<size_t>({0, 1, 16, 2, 32, 1, 16, 1}));
+    EXPECT_EQ(bins[2].table[0], bins[2].table[1]);
+
+    // lengths without a kernel can't be grouped
+    problems[0].length = 17;
+    EXPECT_THROW(grouped_bin_problems(problems, transforms_per_block), std::runtime_error);
+}
+
+TEST(rocfft_UnitTest, chirp_twiddle)
+{
+    // chirp_twiddle reduces the angle with integer math before
+    // calling sincospi, so compare it against the angle computed
+    // directly in extended precision
+    for(size_t N : {1, 2, 3, 7, 100, 1021, 65537, 1000003})
+    {
+        SCOPED_TRACE("N " + std::to_string(N));
+
+        std::vector<size_t> us;
+        for(size_t u = 0; u < std::min<size_t>(N, 4096); ++u)
+            us.push_back(u);
+        // the reduction doesn't depend on u being less than N
+        for(size_t u : {N - 1, N, N + 1, 2 * N - 1, 2 * N, 3 * N + 5, 12345 * N + 7})
+            us.push_back(u);
+
+        for(auto u : us)
+        {
+            long double angle = M_PI * static_cast<long double>((u * u) % (2 * N)) / N;
+            double      re    = static_cast<double>(std::cos(angle));
+            double      im    = static_cast<double>(-std::sin(angle));
+
+            double d_re, d_im;
+            chirp_twiddle(u, N, &d_re, &d_im);
+            ASSERT_NEAR(d_re, re, 1e-14) << "u " << u;
+            ASSERT_NEAR(d_im, im, 1e-14) << "u " << u;
+
+            float f_re, f_im;
+            chirp_twiddle(u, N, &f_re, &f_im);
+            ASSERT_NEAR(f_re, re, 1e-6) << "u " << u;
+            ASSERT_NEAR(f_im, im, 1e-6) << "u " << u;
+        }
+    }
+}
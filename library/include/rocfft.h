@@ -70,13 +70,29 @@ typedef enum rocfft_status_e
     rocfft_status_invalid_work_buffer,
 } rocfft_status;
 
-/*! @brief Type of transform */
+/*! @brief Type of transform
+ *  @details The real-to-real types compute discrete cosine (DCT)
+ *  and sine (DST) transforms of types I to IV on real input and
+ *  output.  They follow the same definitions as FFTW's REDFT00 to
+ *  REDFT11 and RODFT00 to RODFT11 kinds, and like the other
+ *  transform types are unnormalized.  Types II and III are inverses
+ *  of each other, and the other types are their own inverses, up to
+ *  scale.  DCT-I requires lengths of at least 2.
+ */
 typedef enum rocfft_transform_type_e
 {
     rocfft_transform_type_complex_forward,
     rocfft_transform_type_complex_inverse,
     rocfft_transform_type_real_forward,
     rocfft_transform_type_real_inverse,
+    rocfft_transform_type_dct_1,
+    rocfft_transform_type_dct_2,
+    rocfft_transform_type_dct_3,
+    rocfft_transform_type_dct_4,
+    rocfft_transform_type_dst_1,
+    rocfft_transform_type_dst_2,
+    rocfft_transform_type_dst_3,
+    rocfft_transform_type_dst_4,
 } rocfft_transform_type;
 
 /*! @brief Precision */
@@ -109,6 +125,144 @@ typedef enum rocfft_array_type_e
     rocfft_array_type_unset,
 } rocfft_array_type;
 
+/*! @brief Events recorded by an execution
+ *  @details Chooses which events ::rocfft_execute records, for
+ *  ::rocfft_execution_info_get_events to return.
+ */
+typedef enum rocfft_event_mode_e
+{
+    /*! no events (the default) */
+    rocfft_event_mode_none,
+    /*! one event, recorded once the transform has been enqueued */
+    rocfft_event_mode_completion,
+    /*! one event after each kernel; the last marks completion.
+     *  Grouped plans and plans across more than one device record
+     *  only the completion event. */
+    rocfft_event_mode_per_kernel,
+} rocfft_event_mode;
+
+/*! @brief Number of buckets in each ::rocfft_statistics histogram */
+#define ROCFFT_STATISTICS_HISTOGRAM_BUCKETS 32
+
+/*! @brief Library-wide runtime statistics
+ *  @details Counters for the whole process, filled in by
+ *  ::rocfft_get_statistics.  Counters are cumulative since library
+ *  load or the last ::rocfft_reset_statistics, except for the twiddle
+ *  table fields, which describe the tables currently in device
+ *  memory.
+ *
+ *  Histograms count durations by powers of two: bucket 0 counts
+ *  durations under 1 microsecond, bucket i counts durations of at
+ *  least 2^(i-1) and under 2^i microseconds, and the last bucket also
+ *  counts anything longer.
+ *
+ *  A plan across several devices counts as one plan and its
+ *  executions as one execution each, though the kernels it launches
+ *  on every device are counted.
+ *
+ *  Callers set struct_size to sizeof(rocfft_statistics) before
+ *  calling ::rocfft_get_statistics, so that fields added by later
+ *  versions of the library can be told apart from ones the caller
+ *  knows about.
+ */
+typedef struct rocfft_statistics_s
+{
+    /*! size of this struct in bytes, set by the caller */
+    size_t struct_size;
+
+    /*! plans successfully created */
+    size_t plans_created;
+    /*! plans whose creation failed */
+    size_t plan_create_failures;
+    /*! plans destroyed */
+    size_t plans_destroyed;
+    /*! total time spent creating plans, in milliseconds */
+    double plan_create_ms;
+    /*! plan creation times */
+    size_t plan_create_histogram[ROCFFT_STATISTICS_HISTOGRAM_BUCKETS];
+
+    /*! kernels found in the runtime compilation cache */
+    size_t rtc_cache_hits;
+    /*! kernels not found in, or unusable from, the cache */
+    size_t rtc_cache_misses;
+    /*! kernels compiled at runtime */
+    size_t rtc_compiles;
+    /*! total time spent compiling kernels, in milliseconds */
+    double rtc_compile_ms;
+    /*! kernel compile times */
+    size_t rtc_compile_histogram[ROCFFT_STATISTICS_HISTOGRAM_BUCKETS];
+
+    /*! number of twiddle tables in device memory */
+    size_t twiddle_tables;
+    /*! bytes of device memory used by twiddle tables */
+    size_t twiddle_bytes;
+
+    /*! work buffers allocated by ::rocfft_execute because none was given */
+    size_t work_buffer_allocs;
+    /*! total bytes of those work buffers */
+    size_t work_buffer_bytes;
+
+    /*! calls to ::rocfft_execute */
+    size_t executions;
+    /*! kernels launched by those executions */
+    size_t kernel_launches;
+
+    /*! log records dropped because a log file couldn't be written as
+     *  fast as records were produced */
+    size_t log_records_dropped;
+} rocfft_statistics;
+
+/*! @brief One problem of a grouped plan
+ *
+ *  @details Describes a batch of 1D complex transforms for
+ *  ::rocfft_plan_create_grouped.  Strides, distances and offsets are
+ *  in elements.  A stride of 0 means unit stride, and a distance of 0
+ *  means the transforms are packed, i.e. length * stride apart.
+ */
+typedef struct rocfft_grouped_problem_s
+{
+    /*! transform length */
+    size_t length;
+    /*! number of transforms */
+    size_t batch;
+    /*! stride between input elements of a transform */
+    size_t in_stride;
+    /*! stride between output elements of a transform */
+    size_t out_stride;
+    /*! distance between the first input elements of consecutive transforms */
+    size_t in_distance;
+    /*! distance between the first output elements of consecutive transforms */
+    size_t out_distance;
+    /*! offset of the first input element */
+    size_t in_offset;
+    /*! offset of the first output element */
+    size_t out_offset;
+} rocfft_grouped_problem;
+
+/*! @brief Planes of planar callback data
+ *  @details Load and store callbacks on planar input or output are
+ *  passed a pointer to this struct in place of the data pointer.
+ *  Both planes are indexed by the same offset.
+ */
+typedef struct rocfft_planar_float_s
+{
+    /*! real plane */
+    float* real;
+    /*! imaginary plane */
+    float* imag;
+} rocfft_planar_float;
+
+/*! @brief Planes of double-precision planar callback data
+ *  @details See ::rocfft_planar_float.
+ */
+typedef struct rocfft_planar_double_s
+{
+    /*! real plane */
+    double* real;
+    /*! imaginary plane */
+    double* imag;
+} rocfft_planar_double;
+
 #if 0
 /*! @brief Execution mode */
 typedef enum rocfft_execution_mode_e
@@ -169,6 +323,46 @@ ROCFFT_EXPORT rocfft_status rocfft_plan_create(rocfft_plan*                  pla
                                                size_t                        number_of_transforms,
                                                const rocfft_plan_description description);
 
+/*! @brief Create a plan for a group of small 1D transforms
+ *
+ *  @details This API creates a plan that runs many independent
+ *  batches of 1D complex transforms, of assorted lengths, in one
+ *  execution.  Problems that the same kernel transforms are run in
+ *  a single kernel launch, so a group of many small problems needs
+ *  only a few launches.
+ *
+ *  All problems read from one input buffer and write to one output
+ *  buffer, at the offsets given in each problem.  For in-place
+ *  plans, each problem's input and output strides, distances and
+ *  offsets must be equal.  Problems must not overlap in the output
+ *  buffer.
+ *
+ *  Each length must be one that rocFFT transforms in a single
+ *  kernel.  Grouped plans are executed with ::rocfft_execute like
+ *  any other plan, and need no work buffer.  They don't support
+ *  load or store callbacks: executing with callbacks set in the
+ *  execution info fails with ::rocfft_status_invalid_arg_value.
+ *  Executions record only the completion event, even with
+ *  ::rocfft_event_mode_per_kernel.
+ *
+ *  The plan must be destroyed with a call to ::rocfft_plan_destroy.
+ *
+ *  @param[out] plan plan handle
+ *  @param[in] placement placement of result
+ *  @param[in] transform_type type of transform; must be a complex
+ *  transform
+ *  @param[in] precision precision
+ *  @param[in] number_of_problems number of problems
+ *  @param[in] problems number_of_problems-sized array of problems
+ *  */
+ROCFFT_EXPORT rocfft_status
+    rocfft_plan_create_grouped(rocfft_plan*                  plan,
+                               rocfft_result_placement       placement,
+                               rocfft_transform_type         transform_type,
+                               rocfft_precision              precision,
+                               size_t                        number_of_problems,
+                               const rocfft_grouped_problem* problems);
+
 /*! @brief Execute an FFT plan
  *
  *  @details This API executes an FFT plan on buffers given by the user.
@@ -284,15 +478,43 @@ ROCFFT_EXPORT rocfft_status
  */
 ROCFFT_EXPORT rocfft_status rocfft_get_version_string(char* buf, size_t len);
 
-#if 0
 /*! @brief Set devices in plan description
  *  @details This is one of plan description functions to specify optional additional plan properties using the description handle. This API specifies what compute devices to target.
+ *
+ *  With one device, the plan is created for that device instead of
+ *  the current device, and must be executed with that device
+ *  current.
+ *
+ *  With more than one device, the transform is split into slabs
+ *  along its slowest dimension, one slab per device.  The first
+ *  (length % number_of_devices) devices get one more row of the
+ *  slowest dimension than the rest.  Each buffer given to
+ *  ::rocfft_execute then holds one pointer per device, to that
+ *  device's slab.  Devices are only used while there is at least one
+ *  row of the slowest dimension and one point of the faster
+ *  dimensions for each; pointers for the remaining devices are
+ *  ignored.
+ *
+ *  Transforms across more than one device must be complex
+ *  interleaved, unbatched, and have default strides, distances and
+ *  offsets.  ::rocfft_execute waits for work already on the
+ *  execution stream, and returns once the transform has finished.
+ *  Work buffers are allocated by the plan on each device, so
+ *  ::rocfft_plan_get_work_buffer_size returns 0, and executing with a
+ *  work buffer set in the execution info fails with
+ *  ::rocfft_status_invalid_work_buffer.  Callbacks are not supported
+ *  across more than one device, and executing with them fails with
+ *  ::rocfft_status_invalid_arg_value.  Such executions record only
+ *  the completion event, even with ::rocfft_event_mode_per_kernel.
+ *
  *  @param[in] description description handle
- *  @param[in] devices array of device identifiers
+ *  @param[in] devices array of int device identifiers
  *  @param[in] number_of_devices number of devices (size of devices array)
  *  */
-ROCFFT_EXPORT rocfft_status rocfft_plan_description_set_devices( rocfft_plan_description description, void *devices, size_t number_of_devices );
-#endif
+ROCFFT_EXPORT rocfft_status
+    rocfft_plan_description_set_devices(rocfft_plan_description description,
+                                        void*                   devices,
+                                        size_t                  number_of_devices);
 
 /*! @brief Get work buffer size
  *  @details Get the work buffer size required for a plan.
@@ -308,6 +530,38 @@ ROCFFT_EXPORT rocfft_status rocfft_plan_get_work_buffer_size(const rocfft_plan p
  *  */
 ROCFFT_EXPORT rocfft_status rocfft_plan_get_print(const rocfft_plan plan);
 
+/*! @brief Get number of timed plan creation phases
+ *  @details Get the number of phases of plan creation that were
+ *  timed when the plan was created.  Phases are only timed if
+ *  ROCFFT_LAYER includes the timing (64) or Chrome trace (128)
+ *  layers when the plan is created; otherwise the count is 0.
+ *  @param[in] plan plan handle
+ *  @param[out] count number of timed phases
+ *  */
+ROCFFT_EXPORT rocfft_status rocfft_plan_get_phase_count(const rocfft_plan plan, size_t* count);
+
+/*! @brief Get timing of one plan creation phase
+ *  @details Get the name, detail and wall-clock duration of one timed
+ *  phase of plan creation, in the order the phases finished.  Phases
+ *  that happen once per kernel or per twiddle table (e.g.
+ *  "rtc_compile" or "twiddle_upload") appear once each, with the
+ *  detail saying which kernel or table it was.  Runtime compilation
+ *  phases may overlap, since kernels are compiled in parallel.
+ *
+ *  The returned strings belong to the plan and are valid until it is
+ *  destroyed.  Any of the output pointers may be null.
+ *  @param[in] plan plan handle
+ *  @param[in] index phase index, less than ::rocfft_plan_get_phase_count
+ *  @param[out] name phase name
+ *  @param[out] detail what the phase was operating on; may be empty
+ *  @param[out] milliseconds duration of the phase
+ *  */
+ROCFFT_EXPORT rocfft_status rocfft_plan_get_phase_timing(const rocfft_plan plan,
+                                                         size_t            index,
+                                                         const char**      name,
+                                                         const char**      detail,
+                                                         double*           milliseconds);
+
 /*! @brief Create plan description
  *  @details This API creates a plan description with which the user
  * can set extra plan properties.  The plan description must be freed
@@ -396,6 +650,27 @@ ROCFFT_EXPORT rocfft_status rocfft_execution_info_set_mode( rocfft_execution_inf
 ROCFFT_EXPORT rocfft_status rocfft_execution_info_set_stream(rocfft_execution_info info,
                                                              void*                 stream);
 
+/*! @brief Replay kernel launches from a graph (experimental)
+ *  @details Asks ::rocfft_execute to capture the plan's kernel
+ *  launches into a HIP graph, and to launch that graph on later
+ *  executions of the plan with the same buffers, stream and
+ *  callbacks.  This reduces launch overhead for plans with several
+ *  small kernels.
+ *
+ *  A few graphs are kept per plan.  If the buffers change, the
+ *  launches are recaptured and a cached graph is updated with the
+ *  new pointers where possible.  Executions fall back to launching
+ *  kernels directly on the null stream, if graphs cannot be
+ *  captured on the stream, if the buffers change on nearly every
+ *  execution, or while profile or kernel I/O logging is enabled.
+ *
+ *  @param[in] info execution info handle
+ *  @param[in] enable nonzero to replay graphs, zero to launch
+ *  kernels directly (the default)
+ *  */
+ROCFFT_EXPORT rocfft_status rocfft_execution_info_set_graph_replay(rocfft_execution_info info,
+                                                                   int                   enable);
+
 /*! @brief Set a load callback for a plan execution (experimental)
  *  @details This function specifies a user-defined callback function
  *  that is run to load input from global memory at the start of the
@@ -423,9 +698,17 @@ ROCFFT_EXPORT rocfft_status rocfft_execution_info_set_stream(rocfft_execution_in
  *  A null value for 'cb' may be specified to clear any previously
  *  registered load callback.
  *
- *  Currently, 'shared_mem_bytes' must be 0.  Callbacks are not
- *  supported on transforms that use planar formats for either input
- *  or output.
+ *  For planar input, load callbacks instead have this signature,
+ *  where 'T' is the complex element type and 'P' is
+ *  ::rocfft_planar_float or ::rocfft_planar_double:
+ *
+ *  @code
+ *  T load_cb(const P* data, size_t offset, void* cbdata, void* sharedMem);
+ *  @endcode
+ *
+ *  'offset' applies to both planes.
+ *
+ *  Currently, 'shared_mem_bytes' must be 0.
  *
  *  @param[in] info execution info handle
  *  @param[in] cb callback function pointers
@@ -463,9 +746,17 @@ ROCFFT_EXPORT rocfft_status rocfft_execution_info_set_load_callback(rocfft_execu
  *  A null value for 'cb' may be specified to clear any previously
  *  registered store callback.
  *
- *  Currently, 'shared_mem_bytes' must be 0.  Callbacks are not
- *  supported on transforms that use planar formats for either input
- *  or output.
+ *  For planar output, store callbacks instead have this signature,
+ *  where 'T' is the complex element type and 'P' is
+ *  ::rocfft_planar_float or ::rocfft_planar_double:
+ *
+ *  @code
+ *  void store_cb(const P* data, size_t offset, T element, void* cbdata, void* sharedMem);
+ *  @endcode
+ *
+ *  'offset' applies to both planes.
+ *
+ *  Currently, 'shared_mem_bytes' must be 0.
  *
  *  @param[in] info execution info handle
  *  @param[in] cb callbacks function pointers
@@ -477,17 +768,120 @@ ROCFFT_EXPORT rocfft_status rocfft_execution_info_set_store_callback(rocfft_exec
                                                                      void** cb_data,
                                                                      size_t shared_mem_bytes);
 
-#if 0
+/*! @brief Choose events to record in execution info
+ *  @details Asks ::rocfft_execute to record events on the execution
+ *  stream, so that other streams or the host can wait for the
+ *  transform (or each of its kernels) without synchronizing the
+ *  whole stream.  Get the events with
+ *  ::rocfft_execution_info_get_events.
+ *
+ *  Per-kernel events are not compatible with graph replay
+ *  (::rocfft_execution_info_set_graph_replay), so executions that
+ *  record them launch kernels directly.
+ *
+ *  @param[in] info execution info handle
+ *  @param[in] mode events to record
+ *  */
+ROCFFT_EXPORT rocfft_status rocfft_execution_info_set_event_mode(rocfft_execution_info info,
+                                                                 rocfft_event_mode     mode);
+
 /*! @brief Get events from execution info
- *  @details This is one of the execution info functions to retrieve information from execution.
- *  This API obtains event information. It has to be called after the call to rocfft_execute.
- *  This gets handles to events that the library created around one or more kernel launches during execution.
+ *  @details Gets the events recorded by the last call to
+ *  ::rocfft_execute with this execution info, as chosen by
+ *  ::rocfft_execution_info_set_event_mode.  Each event is a
+ *  hipEvent_t.
+ *
+ *  Call with a null events pointer to get the number of events in
+ *  number_of_events.  Otherwise, number_of_events gives the size of
+ *  the events array, which must be large enough for all of the
+ *  events, and is set to the number of events written.
+ *
+ *  The events are owned by the execution info, and are reused by
+ *  the library: they are valid until the next ::rocfft_execute with
+ *  this execution info, or until the execution info is destroyed.
+ *  Waits already enqueued on an event (e.g. with hipStreamWaitEvent)
+ *  are not affected by it being reused.  Do not destroy the events.
+ *
+ *  The events are invalid after ::rocfft_cleanup.  Execution infos
+ *  destroyed after cleanup destroy their events instead of giving
+ *  them back to the library for reuse.
+ *
  *  @param[in] info execution info handle
- *  @param[out] events array of events
- *  @param[out] number_of_events number of events (size of events array)
+ *  @param[out] events array of events, or null
+ *  @param[in,out] number_of_events size of events array, set to
+ *  number of events
  *  */
-ROCFFT_EXPORT rocfft_status rocfft_execution_info_get_events( const rocfft_execution_info info, void **events, size_t *number_of_events );
-#endif
+ROCFFT_EXPORT rocfft_status rocfft_execution_info_get_events(const rocfft_execution_info info,
+                                                             void** events,
+                                                             size_t* number_of_events);
+
+/*! @brief Set the memory budget for unused twiddle tables
+
+ *  @details Twiddle tables are shared between plans that need the
+ *  same twiddles.  Once no plan is using a table, rocFFT keeps it in
+ *  device memory so that plans created later can reuse it, as long
+ *  as all unused tables fit within 'budget_bytes'.  Least recently
+ *  used tables are freed first when the budget is exceeded.
+ *
+ *  The default budget is 0, meaning tables are freed as soon as no
+ *  plan uses them.  The default can be changed by setting the
+ *  ROCFFT_TWIDDLE_CACHE_BYTES environment variable.  */
+ROCFFT_EXPORT rocfft_status rocfft_twiddle_cache_set_budget(size_t budget_bytes);
+
+/*! @brief Get twiddle table memory usage
+
+ *  @details Get the budget for unused twiddle tables, the bytes of
+ *  device memory used by twiddle tables that plans are using and
+ *  that are unused, and the number of times a plan's twiddles were
+ *  found in an existing table (hits) or had to be created (misses).
+ *  Any of the pointers may be null.  */
+ROCFFT_EXPORT rocfft_status rocfft_twiddle_cache_get_usage(size_t* budget_bytes,
+                                                           size_t* used_bytes,
+                                                           size_t* unused_bytes,
+                                                           size_t* hits,
+                                                           size_t* misses);
+
+/*! @brief Get library-wide runtime statistics
+ *
+ *  @details Fill in a snapshot of the process's counters.  This is
+ *  cheap enough to poll periodically; counters are updated with
+ *  atomic operations and reading them does not block plan creation
+ *  or execution.  Counters updated concurrently with this call may
+ *  or may not be included.
+ *
+ *  stats->struct_size must be set to the size of the caller's
+ *  struct.  A struct from an older version of this header is filled
+ *  in up to its size; rocfft_status_invalid_arg_value is returned if
+ *  the size is larger than this library's struct, or too small to
+ *  hold any counters.
+ *  @param[in,out] stats statistics to fill in  */
+ROCFFT_EXPORT rocfft_status rocfft_get_statistics(rocfft_statistics* stats);
+
+/*! @brief Get per-scheme execution statistics
+ *
+ *  @details Get, for each compute scheme, the number of executions of
+ *  plans whose top-level node used that scheme, and the number of
+ *  kernels launched with that scheme.
+ *
+ *  Call first with null arrays to get the number of schemes in
+ *  'num_schemes', then again with arrays of that many elements.  Any
+ *  of the arrays may be null.  The scheme names are owned by the
+ *  library and are valid until it is unloaded.
+ *  @param[in,out] num_schemes number of elements in the arrays
+ *  @param[out] schemes scheme names
+ *  @param[out] executions executions per top-level scheme
+ *  @param[out] kernel_launches kernel launches per scheme  */
+ROCFFT_EXPORT rocfft_status rocfft_get_scheme_statistics(size_t*      num_schemes,
+                                                         const char** schemes,
+                                                         size_t*      executions,
+                                                         size_t*      kernel_launches);
+
+/*! @brief Reset library-wide runtime statistics
+ *
+ *  @details Set all cumulative counters and histograms to zero.
+ *  The twiddle table fields are not affected, since they describe
+ *  memory that is still allocated.  */
+ROCFFT_EXPORT rocfft_status rocfft_reset_statistics();
 
 #ifdef ROCFFT_RUNTIME_COMPILE
 /*! @brief Serialize compiled kernel cache
@@ -202,7 +202,11 @@ bool AssignmentPolicy::ValidOutBuffer(ExecPlan&           execPlan,
         // if node's output is complex and buffer's format is real,
         // adjust output length to be 2x to make the units of
         // comparison match
-        bool kernelOutputIsReal = node.scheme == CS_KERNEL_COPY_CMPLX_TO_R;
+        bool kernelOutputIsReal = node.scheme == CS_KERNEL_COPY_CMPLX_TO_R
+                                  || node.scheme == CS_KERNEL_PAIR_CMPLX_TO_R
+                                  || node.scheme == CS_KERNEL_R2R_POST
+                                  || node.ebtype == EmbeddedType::C2Real_ODD
+                                  || node.ebtype == EmbeddedType::Real2Real;
         bool outBufferIsReal
             = (buffer == OB_USER_OUT && execPlan.rootPlan->outArrayType == rocfft_array_type_real)
               || (buffer == OB_USER_IN && execPlan.rootPlan->inArrayType == rocfft_array_type_real);
@@ -1093,6 +1097,12 @@ void AssignmentPolicy::PadPlan(ExecPlan& execPlan)
                 // SBCR plans combine higher dimensions in ways that confuse padding
                 if(u.node.scheme == CS_KERNEL_STOCKHAM_BLOCK_CR)
                     return;
+                // real-to-real stages fold the other dimensions into
+                // the FFT's batch, and lay out their temp data
+                // contiguously themselves
+                if(u.node.scheme == CS_KERNEL_R2R_PRE || u.node.scheme == CS_KERNEL_R2R_POST
+                   || u.node.ebtype == EmbeddedType::Real2Real)
+                    return;
             }
 
             // Ensure that if we're forced to pad along one dimension
@@ -21,24 +21,29 @@
 *******************************************************************************/
 
 #include "../../shared/environment.h"
+#include "chrome_trace.h"
 #include "logging.h"
+#include "plan.h"
 #include "repo.h"
 #include "rocfft.h"
 #include "rocfft_hip.h"
 #include "rocfft_ostream.hpp"
 #include "rtccache.h"
+#include "transform.h"
 #include <fcntl.h>
 #include <memory>
 
 /*******************************************************************************
  * Static handle data
  ******************************************************************************/
-int log_trace_fd    = -1;
-int log_bench_fd    = -1;
-int log_profile_fd  = -1;
-int log_plan_fd     = -1;
-int log_kernelio_fd = -1;
-int log_rtc_fd      = -1;
+int log_trace_fd        = -1;
+int log_bench_fd        = -1;
+int log_profile_fd      = -1;
+int log_plan_fd         = -1;
+int log_kernelio_fd     = -1;
+int log_rtc_fd          = -1;
+int log_timing_fd       = -1;
+int log_chrome_trace_fd = -1;
 
 /**
  *  @brief Logging function
@@ -92,6 +97,11 @@ rocfft_status rocfft_setup()
             = static_cast<rocfft_layer_mode>(strtol(str_layer_mode.c_str(), 0, 0));
         LogSingleton::GetInstance().SetLayerMode(layer_mode);
 
+        // ROCFFT_LOG_FORMAT=jsonl writes one JSON object per record
+        // instead of free-form text
+        if(rocfft_getenv("ROCFFT_LOG_FORMAT") == "jsonl")
+            LogSingleton::GetInstance().SetLogFormat(rocfft_log_format_jsonl);
+
         // open log_trace file
         if(layer_mode & rocfft_layer_mode_log_trace)
             open_log_stream("ROCFFT_LOG_TRACE_PATH", log_trace_fd);
@@ -115,6 +125,14 @@ rocfft_status rocfft_setup()
         // open log_rtc file
         if(layer_mode & rocfft_layer_mode_log_rtc)
             open_log_stream("ROCFFT_LOG_RTC_PATH", log_rtc_fd);
+
+        // open log_timing file
+        if(layer_mode & rocfft_layer_mode_log_timing)
+            open_log_stream("ROCFFT_LOG_TIMING_PATH", log_timing_fd);
+
+        // open Chrome trace file, which is written at cleanup
+        if(layer_mode & rocfft_layer_mode_log_chrome_trace)
+            open_log_stream("ROCFFT_LOG_CHROME_TRACE_PATH", log_chrome_trace_fd);
     }
 
     log_trace(__func__);
@@ -133,7 +151,18 @@ rocfft_status rocfft_cleanup()
     RTCCache::single.reset();
 #endif
 
+    // finish profiling kernels that ran on user streams
+    ResolveKernelProfiles();
+
+    // destroy events that no execution info is using
+    ReleaseExecutionEvents();
+
+    // write out the events recorded since setup
+    if(LOG_CHROME_TRACE_ENABLED())
+        chrome_trace::flush(log_chrome_trace_fd);
+
     LogSingleton::GetInstance().SetLayerMode(rocfft_layer_mode_none);
+    LogSingleton::GetInstance().SetLogFormat(rocfft_log_format_text);
     // Close log files
     if(log_trace_fd != -1)
     {
@@ -165,6 +194,16 @@ rocfft_status rocfft_cleanup()
         CLOSE(log_rtc_fd);
         log_rtc_fd = -1;
     }
+    if(log_timing_fd != -1)
+    {
+        CLOSE(log_timing_fd);
+        log_timing_fd = -1;
+    }
+    if(log_chrome_trace_fd != -1)
+    {
+        CLOSE(log_chrome_trace_fd);
+        log_chrome_trace_fd = -1;
+    }
 
     // stop all log worker threads
     rocfft_ostream::cleanup();
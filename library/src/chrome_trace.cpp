@@ -0,0 +1,141 @@
+/******************************************************************************
+* Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#include "chrome_trace.h"
+
+#include <mutex>
+#include <set>
+#include <vector>
+
+#ifdef WIN32
+#include <process.h>
+#define GETPID _getpid
+#else
+#include <unistd.h>
+#define GETPID getpid
+#endif
+
+namespace chrome_trace
+{
+    // Limit memory used by very long runs.  Events past the limit are
+    // counted and the count is noted in the trace.
+    static const size_t MAX_EVENTS = 1 << 20;
+
+    static std::mutex               events_mutex;
+    static std::vector<std::string> events;
+    static std::set<size_t>         tids;
+    static size_t                   dropped_events = 0;
+
+    // timestamps are relative to library load, which keeps them small
+    // enough to print exactly
+    static const clock::time_point origin = clock::now();
+
+    void complete(const char*        category,
+                  const std::string& name,
+                  clock::time_point  begin,
+                  double             dur_ms,
+                  size_t             tid,
+                  const std::string& args)
+    {
+        std::chrono::duration<double, std::micro> ts = begin - origin;
+
+        json_object event;
+        event.field("name", name)
+            .field("cat", category)
+            .field("ph", "X")
+            .field("ts", ts.count())
+            .field("dur", dur_ms * 1000.0)
+            .field("pid", static_cast<int>(GETPID()))
+            .field("tid", tid);
+        if(!args.empty())
+            event.raw("args", args);
+
+        std::lock_guard<std::mutex> lock(events_mutex);
+        if(events.size() >= MAX_EVENTS)
+        {
+            ++dropped_events;
+            return;
+        }
+        events.push_back(event.str());
+        tids.insert(tid);
+    }
+
+    // metadata event that names a track
+    static std::string thread_name(size_t tid)
+    {
+        json_object args;
+        std::string name = "thread " + std::to_string(tid);
+        if(tid == GPU_TID)
+            name = "GPU (null stream)";
+        else if(tid == GPU_STREAM_TID)
+            name = "GPU (user streams)";
+        args.field("name", name);
+
+        json_object event;
+        event.field("name", "thread_name")
+            .field("ph", "M")
+            .field("pid", static_cast<int>(GETPID()))
+            .field("tid", tid)
+            .raw("args", args.str());
+        return event.str();
+    }
+
+    void flush(int fd)
+    {
+        std::vector<std::string> to_write;
+        std::set<size_t>         to_name;
+        size_t                   dropped;
+        {
+            std::lock_guard<std::mutex> lock(events_mutex);
+            to_write.swap(events);
+            to_name.swap(tids);
+            dropped        = dropped_events;
+            dropped_events = 0;
+        }
+        if(to_write.empty())
+            return;
+
+        std::string trace = "{\"traceEvents\":[\n";
+        for(auto tid : to_name)
+            trace += thread_name(tid) + ",\n";
+        for(size_t i = 0; i < to_write.size(); ++i)
+        {
+            trace += to_write[i];
+            trace += i + 1 < to_write.size() ? ",\n" : "\n";
+        }
+        trace += "],\"displayTimeUnit\":\"ms\"";
+        if(dropped)
+            trace += ",\"otherData\":{\"dropped_events\":" + std::to_string(dropped) + "}";
+        trace += "}\n";
+
+        if(fd == -1)
+        {
+            rocfft_cerr << trace;
+            rocfft_cerr.flush();
+            return;
+        }
+        // a fresh stream writes the whole trace as one record
+        rocfft_ostream os(fd);
+        os << trace;
+        os.flush();
+    }
+}
@@ -5,7 +5,10 @@ static const size_t APPLY_REAL_CALLBACK_THREADS = 64;
 template <typename Treal>
 __global__ void __launch_bounds__(APPLY_REAL_CALLBACK_THREADS)
     apply_real_callback_kernel(const size_t input_size,
-                               const size_t dist1D,
+                               const size_t stride0,
+                               const size_t length1,
+                               const size_t stride1,
+                               const size_t stride2,
                                Treal* __restrict__ input0,
                                const size_t dist,
                                void* __restrict__ load_cb_fn,
@@ -22,10 +25,11 @@ __global__ void __launch_bounds__(APPLY_REAL_CALLBACK_THREADS)
 
         // blockIdx.y gives the multi-dimensional offset
         // blockIdx.z gives the batch offset
-        const auto idx = blockIdx.y * dist1D + blockIdx.z * dist;
+        const auto idx = (blockIdx.y % length1) * stride1 + (blockIdx.y / length1) * stride2
+                         + blockIdx.z * dist + tid * stride0;
 
-        auto elem = load_cb(input0, idx + tid, load_cb_data, nullptr);
-        store_cb(input0, idx + tid, elem, store_cb_data, nullptr);
+        auto elem = load_cb(input0, idx, load_cb_data, nullptr);
+        store_cb(input0, idx, elem, store_cb_data, nullptr);
     }
 }
 
@@ -37,8 +41,12 @@ ROCFFT_DEVICE_EXPORT void apply_real_callback(const void* data_p, void* back)
 
     size_t input_distance = data->node->iDist;
 
-    size_t input_stride
-        = (data->node->length.size() > 1) ? data->node->inStride[1] : input_distance;
+    // up to two higher dimensions, with any strides
+    const auto& length  = data->node->length;
+    const auto& stride  = data->node->inStride;
+    size_t      length1 = length.size() > 1 ? length[1] : 1;
+    size_t      stride1 = length.size() > 1 ? stride[1] : 0;
+    size_t      stride2 = length.size() > 2 ? stride[2] : 0;
 
     void* input_buffer = data->bufIn[0];
 
@@ -67,7 +75,10 @@ ROCFFT_DEVICE_EXPORT void apply_real_callback(const void* data_p, void* back)
                            0,
                            data->rocfft_stream,
                            input_size,
-                           input_stride,
+                           stride[0],
+                           length1,
+                           stride1,
+                           stride2,
                            static_cast<float*>(input_buffer),
                            input_distance,
                            data->callbacks.load_cb_fn,
@@ -83,7 +94,10 @@ ROCFFT_DEVICE_EXPORT void apply_real_callback(const void* data_p, void* back)
                            0,
                            data->rocfft_stream,
                            input_size,
-                           input_stride,
+                           stride[0],
+                           length1,
+                           stride1,
+                           stride2,
                            static_cast<double*>(input_buffer),
                            input_distance,
                            data->callbacks.load_cb_fn,
@@ -224,45 +224,61 @@ ROCFFT_DEVICE_EXPORT void rocfft_internal_mul(const void* data_p, void* back_p)
 
         if(data->node->precision == rocfft_precision_single)
         {
-            hipLaunchKernelGGL(HIP_KERNEL_NAME(mul_device_P_I<float2>),
-                               dim3(grid),
-                               dim3(threads),
-                               0,
-                               rocfft_stream,
-                               numof,
-                               count,
-                               N,
-                               M,
-                               (const real_type_t<float2>*)bufIn0,
-                               (const real_type_t<float2>*)bufIn1,
-                               (float2*)bufOut0,
-                               data->node->length.size(),
-                               kargs_lengths(data->node->devKernArg),
-                               kargs_stride_in(data->node->devKernArg),
-                               kargs_stride_out(data->node->devKernArg),
-                               dir,
-                               scheme);
+            hipLaunchKernelGGL(
+                cbtype == CallbackType::USER_LOAD_STORE
+                    ? HIP_KERNEL_NAME(mul_device_P_I<float2, CallbackType::USER_LOAD_STORE>)
+                    : HIP_KERNEL_NAME(mul_device_P_I<float2, CallbackType::NONE>),
+                dim3(grid),
+                dim3(threads),
+                0,
+                rocfft_stream,
+                numof,
+                count,
+                N,
+                M,
+                (const real_type_t<float2>*)bufIn0,
+                (const real_type_t<float2>*)bufIn1,
+                (float2*)bufOut0,
+                data->node->length.size(),
+                kargs_lengths(data->node->devKernArg),
+                kargs_stride_in(data->node->devKernArg),
+                kargs_stride_out(data->node->devKernArg),
+                dir,
+                scheme,
+                data->callbacks.load_cb_fn,
+                data->callbacks.load_cb_data,
+                data->callbacks.load_cb_lds_bytes,
+                data->callbacks.store_cb_fn,
+                data->callbacks.store_cb_data);
         }
         else
         {
-            hipLaunchKernelGGL(HIP_KERNEL_NAME(mul_device_P_I<double2>),
-                               dim3(grid),
-                               dim3(threads),
-                               0,
-                               rocfft_stream,
-                               numof,
-                               count,
-                               N,
-                               M,
-                               (const real_type_t<double2>*)bufIn0,
-                               (const real_type_t<double2>*)bufIn1,
-                               (double2*)bufOut0,
-                               data->node->length.size(),
-                               kargs_lengths(data->node->devKernArg),
-                               kargs_stride_in(data->node->devKernArg),
-                               kargs_stride_out(data->node->devKernArg),
-                               dir,
-                               scheme);
+            hipLaunchKernelGGL(
+                cbtype == CallbackType::USER_LOAD_STORE
+                    ? HIP_KERNEL_NAME(mul_device_P_I<double2, CallbackType::USER_LOAD_STORE>)
+                    : HIP_KERNEL_NAME(mul_device_P_I<double2, CallbackType::NONE>),
+                dim3(grid),
+                dim3(threads),
+                0,
+                rocfft_stream,
+                numof,
+                count,
+                N,
+                M,
+                (const real_type_t<double2>*)bufIn0,
+                (const real_type_t<double2>*)bufIn1,
+                (double2*)bufOut0,
+                data->node->length.size(),
+                kargs_lengths(data->node->devKernArg),
+                kargs_stride_in(data->node->devKernArg),
+                kargs_stride_out(data->node->devKernArg),
+                dir,
+                scheme,
+                data->callbacks.load_cb_fn,
+                data->callbacks.load_cb_data,
+                data->callbacks.load_cb_lds_bytes,
+                data->callbacks.store_cb_fn,
+                data->callbacks.store_cb_data);
         }
     }
     else if((data->node->inArrayType == rocfft_array_type_complex_interleaved
@@ -275,45 +291,61 @@ ROCFFT_DEVICE_EXPORT void rocfft_internal_mul(const void* data_p, void* back_p)
 
         if(data->node->precision == rocfft_precision_single)
         {
-            hipLaunchKernelGGL(HIP_KERNEL_NAME(mul_device_I_P<float2>),
-                               dim3(grid),
-                               dim3(threads),
-                               0,
-                               rocfft_stream,
-                               numof,
-                               count,
-                               N,
-                               M,
-                               (const float2*)bufIn0,
-                               (real_type_t<float2>*)bufOut0,
-                               (real_type_t<float2>*)bufOut1,
-                               data->node->length.size(),
-                               kargs_lengths(data->node->devKernArg),
-                               kargs_stride_in(data->node->devKernArg),
-                               kargs_stride_out(data->node->devKernArg),
-                               dir,
-                               scheme);
+            hipLaunchKernelGGL(
+                cbtype == CallbackType::USER_LOAD_STORE
+                    ? HIP_KERNEL_NAME(mul_device_I_P<float2, CallbackType::USER_LOAD_STORE>)
+                    : HIP_KERNEL_NAME(mul_device_I_P<float2, CallbackType::NONE>),
+                dim3(grid),
+                dim3(threads),
+                0,
+                rocfft_stream,
+                numof,
+                count,
+                N,
+                M,
+                (const float2*)bufIn0,
+                (real_type_t<float2>*)bufOut0,
+                (real_type_t<float2>*)bufOut1,
+                data->node->length.size(),
+                kargs_lengths(data->node->devKernArg),
+                kargs_stride_in(data->node->devKernArg),
+                kargs_stride_out(data->node->devKernArg),
+                dir,
+                scheme,
+                data->callbacks.load_cb_fn,
+                data->callbacks.load_cb_data,
+                data->callbacks.load_cb_lds_bytes,
+                data->callbacks.store_cb_fn,
+                data->callbacks.store_cb_data);
         }
         else
         {
-            hipLaunchKernelGGL(HIP_KERNEL_NAME(mul_device_I_P<double2>),
-                               dim3(grid),
-                               dim3(threads),
-                               0,
-                               rocfft_stream,
-                               numof,
-                               count,
-                               N,
-                               M,
-                               (const double2*)bufIn0,
-                               (real_type_t<double2>*)bufOut0,
-                               (real_type_t<double2>*)bufOut1,
-                               data->node->length.size(),
-                               kargs_lengths(data->node->devKernArg),
-                               kargs_stride_in(data->node->devKernArg),
-                               kargs_stride_out(data->node->devKernArg),
-                               dir,
-                               scheme);
+            hipLaunchKernelGGL(
+                cbtype == CallbackType::USER_LOAD_STORE
+                    ? HIP_KERNEL_NAME(mul_device_I_P<double2, CallbackType::USER_LOAD_STORE>)
+                    : HIP_KERNEL_NAME(mul_device_I_P<double2, CallbackType::NONE>),
+                dim3(grid),
+                dim3(threads),
+                0,
+                rocfft_stream,
+                numof,
+                count,
+                N,
+                M,
+                (const double2*)bufIn0,
+                (real_type_t<double2>*)bufOut0,
+                (real_type_t<double2>*)bufOut1,
+                data->node->length.size(),
+                kargs_lengths(data->node->devKernArg),
+                kargs_stride_in(data->node->devKernArg),
+                kargs_stride_out(data->node->devKernArg),
+                dir,
+                scheme,
+                data->callbacks.load_cb_fn,
+                data->callbacks.load_cb_data,
+                data->callbacks.load_cb_lds_bytes,
+                data->callbacks.store_cb_fn,
+                data->callbacks.store_cb_data);
         }
     }
     else if((data->node->inArrayType == rocfft_array_type_complex_planar
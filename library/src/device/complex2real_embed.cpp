@@ -273,7 +273,7 @@ __global__ static void hermitian2complex_kernel(const unsigned int hermitian_siz
     }
 }
 
-template <typename T, unsigned int dim>
+template <typename T, CallbackType cbtype, unsigned int dim>
 __global__ static void hermitian2complex_planar_kernel(const unsigned int hermitian_size,
                                                        unsigned int       dim_0,
                                                        unsigned int       dim_1,
@@ -288,7 +288,12 @@ __global__ static void hermitian2complex_planar_kernel(const unsigned int hermit
                                                        unsigned int       stride_out3,
                                                        real_type_t<T>* __restrict__ inputRe,
                                                        real_type_t<T>* __restrict__ inputIm,
-                                                       T* __restrict__ output)
+                                                       T* __restrict__ output,
+                                                       void* __restrict__ load_cb_fn,
+                                                       void* __restrict__ load_cb_data,
+                                                       uint32_t load_cb_lds_bytes,
+                                                       void* __restrict__ store_cb_fn,
+                                                       void* __restrict__ store_cb_data)
 {
     const size_t tid = blockIdx.x * blockDim.x + threadIdx.x;
 
@@ -318,24 +323,26 @@ __global__ static void hermitian2complex_planar_kernel(const unsigned int hermit
     outputs_offset += is2 * stride_out2 + is1 * stride_out1 + is0 * stride_out0;
     outputc_offset += ic2 * stride_out2 + ic1 * stride_out1 + ic0 * stride_out0;
 
-    inputRe += input_offset;
-    inputIm += input_offset;
+    auto load_cb = get_load_cb<T, cbtype>(load_cb_fn);
+
+    // as with the interleaved kernel, don't bother going through
+    // the store callback to write global memory.
+
     T* outputs = output + outputs_offset;
     T* outputc = output + outputc_offset;
 
     if((is0 == 0) || (is0 * 2 == dim_0)) // simply write the element to output
     {
-        outputs[0].x = inputRe[0];
-        outputs[0].y = inputIm[0];
+        outputs[0] = load_planar<cbtype>(load_cb, inputRe, inputIm, input_offset, load_cb_data);
         return;
     }
 
     if(is0 < hermitian_size)
     {
-        outputs[0].x = inputRe[0];
-        outputs[0].y = inputIm[0];
-        outputc[0].x = inputRe[0];
-        outputc[0].y = -inputIm[0];
+        T res      = load_planar<cbtype>(load_cb, inputRe, inputIm, input_offset, load_cb_data);
+        outputs[0] = res;
+        res.y      = -res.y;
+        outputc[0] = res;
     }
 }
 
@@ -387,32 +394,37 @@ __global__ static void hermitian2complex_planar_kernel(const unsigned int hermit
     else                                           \
         throw std::runtime_error("invalid dimension in hermitian2complex");
 
-#define HERM2COMPLEX_PLANAR_KERNEL_LAUNCH_DIM(TFLOAT, DIM)                \
-    decltype(&hermitian2complex_planar_kernel<TFLOAT, DIM>) kernel_func;  \
-    if(data->get_callback_type() == CallbackType::USER_LOAD_STORE)        \
-        kernel_func = hermitian2complex_planar_kernel<TFLOAT, DIM>;       \
-    else                                                                  \
-        kernel_func = hermitian2complex_planar_kernel<TFLOAT, DIM>;       \
-    hipLaunchKernelGGL(kernel_func,                                       \
-                       grid,                                              \
-                       threads,                                           \
-                       0,                                                 \
-                       rocfft_stream,                                     \
-                       hermitian_size,                                    \
-                       dim_0,                                             \
-                       dim_1,                                             \
-                       dim_2,                                             \
-                       kern_stride_in[0],                                 \
-                       kern_stride_in[1],                                 \
-                       kern_stride_in[2],                                 \
-                       kern_stride_in[3],                                 \
-                       kern_stride_out[0],                                \
-                       kern_stride_out[1],                                \
-                       kern_stride_out[2],                                \
-                       kern_stride_out[3],                                \
-                       static_cast<real_type_t<TFLOAT>*>(data->bufIn[0]), \
-                       static_cast<real_type_t<TFLOAT>*>(data->bufIn[1]), \
-                       static_cast<TFLOAT*>(output_buffer));
+#define HERM2COMPLEX_PLANAR_KERNEL_LAUNCH_DIM(TFLOAT, DIM)                                         \
+    decltype(&hermitian2complex_planar_kernel<TFLOAT, CallbackType::NONE, DIM>) kernel_func;       \
+    if(data->get_callback_type() == CallbackType::USER_LOAD_STORE)                                 \
+        kernel_func = hermitian2complex_planar_kernel<TFLOAT, CallbackType::USER_LOAD_STORE, DIM>; \
+    else                                                                                           \
+        kernel_func = hermitian2complex_planar_kernel<TFLOAT, CallbackType::NONE, DIM>;            \
+    hipLaunchKernelGGL(kernel_func,                                                                \
+                       grid,                                                                       \
+                       threads,                                                                    \
+                       0,                                                                          \
+                       rocfft_stream,                                                              \
+                       hermitian_size,                                                             \
+                       dim_0,                                                                      \
+                       dim_1,                                                                      \
+                       dim_2,                                                                      \
+                       kern_stride_in[0],                                                          \
+                       kern_stride_in[1],                                                          \
+                       kern_stride_in[2],                                                          \
+                       kern_stride_in[3],                                                          \
+                       kern_stride_out[0],                                                         \
+                       kern_stride_out[1],                                                         \
+                       kern_stride_out[2],                                                         \
+                       kern_stride_out[3],                                                         \
+                       static_cast<real_type_t<TFLOAT>*>(data->bufIn[0]),                          \
+                       static_cast<real_type_t<TFLOAT>*>(data->bufIn[1]),                          \
+                       static_cast<TFLOAT*>(output_buffer),                                        \
+                       data->callbacks.load_cb_fn,                                                 \
+                       data->callbacks.load_cb_data,                                               \
+                       data->callbacks.load_cb_lds_bytes,                                          \
+                       data->callbacks.store_cb_fn,                                                \
+                       data->callbacks.store_cb_data);
 
 // assign hermitian2complex_planar function pointer given a float type
 #define HERM2COMPLEX_PLANAR_KERNEL_LAUNCH(TFLOAT)         \
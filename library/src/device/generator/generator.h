@@ -1631,6 +1631,13 @@ struct MakePlanarVisitor : public BaseVisitor
 {
     std::string varname, rename, imname;
 
+    // names declared by CallbackDeclaration and the kernel arguments
+    Variable cbtype{"cbtype", "CallbackType"};
+    Variable load_cb{"load_cb", "auto"};
+    Variable load_cb_data{"load_cb_data", "void", true, true};
+    Variable store_cb{"store_cb", "auto"};
+    Variable store_cb_data{"store_cb_data", "void", true, true};
+
     MakePlanarVisitor(const std::string& varname)
         : varname(varname)
         , rename(varname + "re")
@@ -1693,8 +1700,8 @@ struct MakePlanarVisitor : public BaseVisitor
             stmts += Assign{x.lhs, ComplexLiteral{re, im}, x.oper};
             return stmts;
         }
-        // callbacks don't support planar, so loads are just direct
-        // memory accesses
+        // planar loads go through load_planar, which either reads
+        // both planes directly or hands them to the user callback
         else if(std::holds_alternative<LoadGlobal>(x.rhs))
         {
             auto load = std::get<LoadGlobal>(x.rhs);
@@ -1708,7 +1715,11 @@ struct MakePlanarVisitor : public BaseVisitor
                 auto im = ptr;
                 im.name = imname;
 
-                stmts += Assign{x.lhs, ComplexLiteral{re[idx], im[idx]}, x.oper};
+                stmts += Assign{x.lhs,
+                                CallExpr{"load_planar",
+                                         TemplateList{cbtype},
+                                         {load_cb, re, im, idx, load_cb_data}},
+                                x.oper};
                 return stmts;
             }
         }
@@ -1718,8 +1729,7 @@ struct MakePlanarVisitor : public BaseVisitor
 
     StatementList visit_StoreGlobal(const StoreGlobal& x) override
     {
-        // callbacks don't support planar, so stores are just direct
-        // memory accesses
+        // planar stores go through store_planar, same as loads
         auto var   = std::get<Variable>(x.ptr);
         auto value = std::get<Variable>(x.value);
 
@@ -1731,8 +1741,9 @@ struct MakePlanarVisitor : public BaseVisitor
             im.name = imname;
 
             StatementList stmts;
-            stmts += Assign(re[x.index], value.x);
-            stmts += Assign(im[x.index], value.y);
+            stmts += Call{"store_planar",
+                          TemplateList{cbtype},
+                          {store_cb, re, im, x.index, value, store_cb_data}};
             return stmts;
         }
         return StatementList{x};
@@ -1745,6 +1756,67 @@ Function make_planar(const Function& f, const std::string& varname)
     return visitor(f);
 }
 
+//
+// Make real
+//
+
+struct MakeRealVisitor : public BaseVisitor
+{
+    std::string varname;
+
+    MakeRealVisitor(const std::string& varname)
+        : varname(varname)
+    {
+    }
+
+    ArgumentList visit_ArgumentList(const ArgumentList& x) override
+    {
+        ArgumentList y;
+        for(auto a : x.arguments)
+        {
+            if(a.name == varname)
+                a.type = "real_type_t<" + a.type + ">";
+            y.append(a);
+        }
+        return y;
+    }
+
+    StatementList visit_Assign(const Assign& x) override
+    {
+        // real loads are direct memory accesses, widened to complex
+        // with a zero imaginary part.  callbacks on the real data
+        // are applied by a separate kernel.
+        if(std::holds_alternative<LoadGlobal>(x.rhs))
+        {
+            auto load = std::get<LoadGlobal>(x.rhs);
+            auto ptr  = std::get<Variable>(load.args[0]);
+            if(ptr.name == varname)
+            {
+                auto& idx = load.args[1];
+                return {Assign{x.lhs, ComplexLiteral{ptr[idx], 0}, x.oper}};
+            }
+        }
+        return StatementList{x};
+    }
+
+    StatementList visit_StoreGlobal(const StoreGlobal& x) override
+    {
+        // real stores keep only the real part of the value
+        auto var   = std::get<Variable>(x.ptr);
+        auto value = std::get<Variable>(x.value);
+
+        if(var.name == varname)
+            return {Assign(var[x.index], value.x)};
+        return StatementList{x};
+    }
+};
+
+Function make_real(const Function& f, const std::string& varname)
+{
+    auto visitor = MakeRealVisitor(varname);
+    return visitor(f);
+}
+
 //
 // Make out of place
 //
@@ -1873,7 +1945,7 @@ struct MakeOutOfPlaceVisitor : public BaseVisitor
 
 Function make_outofplace(const Function& f)
 {
-    auto visitor = MakeOutOfPlaceVisitor({"buf", "stride", "stride0", "offset"});
+    auto visitor = MakeOutOfPlaceVisitor({"buf", "stride", "stride0", "offset", "problems"});
     return visitor(f);
 }
 
@@ -90,6 +90,7 @@ struct GeneratedLauncher
         , workgroup_size(kernel.workgroup_size)
         , half_lds(kernel.half_lds)
         , direct_to_reg(kernel.direct_to_reg)
+        , shfl_exchange(kernel.shfl_exchange)
         , sbrc_type(sbrc_type)
         , sbrc_transpose_type(sbrc_transpose_type)
         , double_precision(double_precision)
@@ -105,6 +106,7 @@ struct GeneratedLauncher
     unsigned int workgroup_size;
     bool         half_lds;
     bool         direct_to_reg;
+    bool         shfl_exchange;
 
     // SBRC transpose type
     std::string sbrc_type;
@@ -147,6 +149,7 @@ struct GeneratedLauncher
         add_member("workgroup_size", std::to_string(workgroup_size));
         add_member("half_lds", half_lds ? "true" : "false");
         add_member("direct_to_reg", direct_to_reg ? "true" : "false");
+        add_member("shfl_exchange", shfl_exchange ? "true" : "false");
         add_member("sbrc_type", quote_str(sbrc_type));
         add_member("sbrc_transpose_type", quote_str(sbrc_transpose_type));
         add_member("double_precision", double_precision ? "true" : "false");
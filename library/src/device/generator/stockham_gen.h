@@ -60,6 +60,7 @@ struct StockhamGeneratorSpecs
     unsigned int threads_per_transform = 0;
     bool         half_lds              = false;
     bool         direct_to_reg         = false;
+    bool         shfl_exchange         = false;
     std::string  scheme;
 };
 
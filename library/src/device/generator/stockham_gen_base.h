@@ -19,6 +19,7 @@
 // THE SOFTWARE.
 
 #pragma once
+#include "shfl_exchange.h"
 #include "stockham_gen.h"
 
 #include <cmath>
@@ -72,6 +73,15 @@ struct StockhamKernel : public StockhamGeneratorSpecs
         workgroup_size = threads_per_transform * transforms_per_block;
         nregisters     = compute_nregisters(length, factors, threads_per_transform);
         R.size         = Expression{nregisters};
+
+        // shuffles replace the half-LDS exchange done when data
+        // stays in registers, so we need a kernel that has that
+        // path in the first place
+        if(shfl_exchange
+           && (scheme != "CS_KERNEL_STOCKHAM" || !half_lds
+               || !shfl_exchange_supported(length, factors, threads_per_transform)))
+            throw std::runtime_error("shfl_exchange not supported for length "
+                                     + std::to_string(length));
     }
     virtual ~StockhamKernel(){};
 
@@ -235,6 +245,13 @@ struct StockhamKernel : public StockhamGeneratorSpecs
         return {};
     }
 
+    // stride between elements of a transform in global memory,
+    // when it's not known to be 1
+    virtual Expression global_stride0()
+    {
+        return stride[0];
+    }
+
     virtual StatementList check_batch()
     {
         return {If{batch >= nbatch, {Return{}}}};
@@ -381,6 +398,51 @@ struct StockhamKernel : public StockhamGeneratorSpecs
         return work;
     }
 
+    // reg -> reg, between pass npass and npass + 1, using cross-lane
+    // shuffles.  Lanes and registers come from shfl_exchange_index,
+    // the same math that host code uses.
+    StatementList shfl_exchange_generator(unsigned int npass)
+    {
+        Variable shfl_R{"shfl_R", "scalar_type", false, false, nregisters};
+        Variable shfl_t{"shfl_t", "scalar_type"};
+
+        StatementList work;
+        work += Declaration{shfl_R};
+        work += Declaration{shfl_t};
+        for(unsigned int reg = 0; reg < length / threads_per_transform; ++reg)
+        {
+            auto source = shfl_exchange_index(
+                length, factors, threads_per_transform, npass, Expression{thread}, reg);
+
+            auto candidates
+                = shfl_exchange_candidates(length, factors, threads_per_transform, npass, reg);
+
+            // a single thread just renames its registers
+            if(threads_per_transform == 1)
+            {
+                work += Assign{shfl_R[reg], R[candidates.front()]};
+                continue;
+            }
+
+            // a shuffle reads the same register from every lane, so
+            // we need one per distinct source register
+            for(auto c : candidates)
+            {
+                work += Assign{shfl_t.x,
+                               CallExpr{"__shfl", {R[c].x, source.lane, threads_per_transform}}};
+                work += Assign{shfl_t.y,
+                               CallExpr{"__shfl", {R[c].y, source.lane, threads_per_transform}}};
+                if(candidates.size() == 1)
+                    work += Assign{shfl_R[reg], shfl_t};
+                else
+                    work += If{source.reg == c, {Assign{shfl_R[reg], shfl_t}}};
+            }
+        }
+        for(unsigned int reg = 0; reg < length / threads_per_transform; ++reg)
+            work += Assign{R[reg], shfl_R[reg]};
+        return work;
+    }
+
     StatementList apply_twiddle_generator(unsigned int h,
                                           unsigned int hr,
                                           unsigned int width,
@@ -489,7 +551,12 @@ struct StockhamKernel : public StockhamGeneratorSpecs
                     + std::to_string(length / width) + " radix-" + std::to_string(width)
                     + " butterflies",
                 "therefore each thread will do " + std::to_string(height) + " butterflies"};
-            body += SyncThreads();
+            // shuffle exchanges don't touch LDS, so no barrier is
+            // needed when data stays in registers
+            if(shfl_exchange)
+                body += If{Not{lds_is_real}, {SyncThreads()}};
+            else
+                body += SyncThreads();
 
             auto load_lds  = std::mem_fn(&StockhamKernel::load_lds_generator);
             auto store_lds = std::mem_fn(&StockhamKernel::store_lds_generator);
@@ -521,7 +588,12 @@ struct StockhamKernel : public StockhamGeneratorSpecs
                 body += large_twiddles_multiply(width, cumheight);
 
             StatementList store_half;
-            if(npass < factors.size() - 1)
+            if(npass < factors.size() - 1 && shfl_exchange)
+            {
+                store_half += CommentLines{"exchange registers with other lanes"};
+                store_half += shfl_exchange_generator(npass);
+            }
+            else if(npass < factors.size() - 1)
             {
                 for(auto component : {Component::X, Component::Y})
                 {
@@ -594,7 +666,8 @@ struct StockhamKernel : public StockhamGeneratorSpecs
         body += Declaration{lds_linear, Literal{"true"}};
 
         body += Declaration{
-            stride0, Ternary{Parens{stride_type == "SB_UNIT"}, Parens{1}, Parens{stride[0]}}};
+            stride0,
+            Ternary{Parens{stride_type == "SB_UNIT"}, Parens{1}, Parens{global_stride0()}}};
         body += CallbackDeclaration{scalar_type.name, callback_type.name};
 
         body += LineBreak{};
@@ -0,0 +1,79 @@
+// Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#pragma once
+#include "../../include/grouped_plan.h"
+#include "stockham_gen_rr.h"
+
+// Row-to-row kernel for grouped plans.  Instead of working out its
+// transforms from lengths, strides and a batch, each thread block
+// reads its record from a problem table, so one launch can cover
+// many problems of the same length.
+struct StockhamKernelGrouped : public StockhamKernelRR
+{
+    explicit StockhamKernelGrouped(StockhamGeneratorSpecs& specs)
+        : StockhamKernelRR(specs)
+    {
+    }
+
+    // per-block problem table, split into input and output tables
+    // for out-of-place kernels
+    Variable problems{"problems", "const size_t", true, true};
+
+    Expression record(grouped_record_field field)
+    {
+        return problems[block_id * static_cast<unsigned int>(GROUPED_RECORD_WIDTH)
+                        + static_cast<unsigned int>(field)];
+    }
+
+    ArgumentList global_arguments() override
+    {
+        ArgumentList arguments{twiddles, problems, lds_padding};
+        for(const auto& arg : get_callback_args().arguments)
+            arguments.append(arg);
+        arguments.append(buf);
+        return arguments;
+    }
+
+    Expression global_stride0() override
+    {
+        return record(GROUPED_STRIDE);
+    }
+
+    StatementList calculate_offsets() override
+    {
+        StatementList stmts;
+        stmts += Declaration{thread};
+        stmts += Assign{transform, thread_id / threads_per_transform};
+        stmts += Assign{batch, transform};
+        stmts += Assign{offset, record(GROUPED_OFFSET) + transform * record(GROUPED_DIST)};
+        stmts += Assign{stride_lds, (length + get_lds_padding())};
+        stmts += Assign{offset_lds, stride_lds * transform};
+        return stmts;
+    }
+
+    // input and output records of a block have the same number of
+    // transforms, so either table will do
+    StatementList check_batch() override
+    {
+        return {If{batch >= record(GROUPED_TRANSFORMS), {Return{}}}};
+    }
+};
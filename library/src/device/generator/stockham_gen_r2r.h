@@ -0,0 +1,278 @@
+// Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include "../../include/tree_node.h"
+#include "stockham_gen_rr.h"
+
+// Row-to-row kernel for one dimension of a real-to-real (DCT/DST)
+// transform.  The kernel's length is that of the complex FFT the
+// transform is computed with, which is done in full in LDS.  Loading
+// reorders and twiddles the real input into the FFT's input, and
+// storing turns the FFT's output into the real result, so the
+// transform needs no temp buffer of its own.  The math for each type
+// is described in device/real2real.cpp.
+struct StockhamKernelR2R : public StockhamKernelRR
+{
+    StockhamKernelR2R(StockhamGeneratorSpecs& specs, R2RType r2r_type, unsigned int real_length)
+        : StockhamKernelRR(specs)
+        , r2r_type(r2r_type)
+        , real_length(real_length)
+    {
+    }
+
+    R2RType r2r_type;
+    // length of the real-to-real transform
+    unsigned int real_length;
+
+    // real values are held in the .x of complex temporaries, since
+    // loads and stores of real buffers widen to and narrow from
+    // complex values
+    Variable r2r_a{"r2r_a", "scalar_type"};
+    Variable r2r_b{"r2r_b", "scalar_type"};
+    Variable r2r_tw{"r2r_tw", "scalar_type"};
+
+    bool is_dst() const
+    {
+        return r2r_type == R2RType::DST_I || r2r_type == R2RType::DST_II
+               || r2r_type == R2RType::DST_III || r2r_type == R2RType::DST_IV;
+    }
+
+    Expression real_index(const Expression& n)
+    {
+        return offset + Parens{n} * stride0;
+    }
+
+    // element n of the input, read backwards for types III and IV
+    // of DST
+    Expression real_index_rev(const Expression& n)
+    {
+        return is_dst() ? real_index(real_length - 1 - n) : real_index(n);
+    }
+
+    Expression twiddle(const Expression& num, const Expression& den)
+    {
+        return CallExpr{"r2r_twiddle", TemplateList{scalar_type}, {num, den}};
+    }
+
+    // complex product of a and the twiddle
+    ComplexLiteral cmul_twiddle(const Variable& a)
+    {
+        return ComplexLiteral{a.x * r2r_tw.x - a.y * r2r_tw.y, a.x * r2r_tw.y + a.y * r2r_tw.x};
+    }
+
+    StatementList declare_temps()
+    {
+        return {Declaration{r2r_a}, Declaration{r2r_b}, Declaration{r2r_tw}};
+    }
+
+    StatementList load_from_global(bool load_registers) override
+    {
+        // real-to-real kernels always go through LDS
+        if(load_registers)
+            return StockhamKernelRR::load_from_global(load_registers);
+
+        StatementList stmts;
+        stmts += Assign{thread, thread_id % threads_per_transform};
+        stmts += declare_temps();
+
+        unsigned int width  = threads_per_transform;
+        unsigned int height = length / width;
+        for(unsigned int h = 0; h < height; ++h)
+            stmts += load_r2r(thread + h * width, h == 0);
+        return stmts;
+    }
+
+    StatementList store_to_global(bool store_registers) override
+    {
+        if(store_registers)
+            return StockhamKernelRR::store_to_global(store_registers);
+
+        StatementList stmts;
+        stmts += declare_temps();
+
+        unsigned int width  = threads_per_transform;
+        unsigned int height = length / width;
+        for(unsigned int h = 0; h < height; ++h)
+            stmts += store_r2r(thread + h * width);
+        return stmts;
+    }
+
+    // write element j of the FFT's input to LDS.  first is true for
+    // the elements that include j == 0.
+    StatementList load_r2r(const Expression& j, bool first)
+    {
+        auto          fft_in = lds_complex[offset_lds + j];
+        unsigned int  N      = real_length;
+        unsigned int  half   = (N + 1) / 2;
+        StatementList stmts;
+
+        switch(r2r_type)
+        {
+        case R2RType::DCT_I:
+            // even extension of the input
+            stmts += Assign{fft_in, LoadGlobal{buf, real_index(Ternary{j < N, j, length - j})}};
+            break;
+        case R2RType::DST_I:
+        {
+            // odd extension of the input, with zeros at 0 and N + 1
+            StatementList load;
+            load += Assign{r2r_a,
+                           LoadGlobal{buf, real_index(Ternary{j <= N, j - 1, length - j - 1})}};
+            load += Assign{fft_in, ComplexLiteral{Ternary{j <= N, r2r_a.x, -r2r_a.x}, 0}};
+            StatementList zero{Assign{fft_in, ComplexLiteral{0, 0}}};
+            stmts += If{j == 0 || j == N + 1, zero};
+            stmts += Else{load};
+            break;
+        }
+        case R2RType::DCT_II:
+        case R2RType::DST_II:
+            // even elements forwards, then odd elements backwards.
+            // DST negates the odd elements.
+            stmts += Assign{r2r_a,
+                            LoadGlobal{buf, real_index(Ternary{j < half, j * 2, 2 * N - 1 - j * 2})}};
+            if(is_dst())
+                stmts += Assign{fft_in, ComplexLiteral{Ternary{j < half, r2r_a.x, -r2r_a.x}, 0}};
+            else
+                stmts += Assign{fft_in, r2r_a};
+            break;
+        case R2RType::DCT_III:
+        case R2RType::DST_III:
+        {
+            // spectrum of the reordered sequence, which is Hermitian
+            // so that the inverse FFT is real:
+            // (a - ib) * conj(twiddle), with b = 0 for j == 0
+            StatementList load_b{
+                Assign{r2r_b,
+                       LoadGlobal{buf, is_dst() ? real_index(j - 1) : real_index(N - j)}}};
+            stmts += Assign{r2r_a, LoadGlobal{buf, real_index_rev(j)}};
+            if(first)
+            {
+                stmts += Assign{r2r_b, ComplexLiteral{0, 0}};
+                stmts += If{j > 0, load_b};
+            }
+            else
+                stmts += load_b;
+            stmts += Assign{r2r_tw, twiddle(j, 2 * N)};
+            stmts += Assign{fft_in,
+                            ComplexLiteral{r2r_a.x * r2r_tw.x - r2r_b.x * r2r_tw.y,
+                                           -r2r_a.x * r2r_tw.y - r2r_b.x * r2r_tw.x}};
+            break;
+        }
+        case R2RType::DCT_IV:
+        case R2RType::DST_IV:
+            if(N % 2 == 0)
+            {
+                // pack pairs of elements into a half-length complex
+                // sequence and twiddle it
+                stmts += Assign{r2r_a, LoadGlobal{buf, real_index_rev(j * 2)}};
+                stmts += Assign{r2r_b, LoadGlobal{buf, real_index_rev(N - 1 - j * 2)}};
+                stmts += Assign{r2r_a, ComplexLiteral{r2r_a.x, r2r_b.x}};
+                stmts += Assign{r2r_tw, twiddle(j * 4 + 1, 4 * N)};
+                stmts += Assign{fft_in, cmul_twiddle(r2r_a)};
+            }
+            else
+            {
+                // twiddled input, zero-padded to twice its length
+                StatementList load;
+                load += Assign{r2r_a, LoadGlobal{buf, real_index_rev(j)}};
+                load += Assign{r2r_tw, twiddle(j, 2 * N)};
+                load += Assign{fft_in, ComplexLiteral{r2r_a.x * r2r_tw.x, r2r_a.x * r2r_tw.y}};
+                StatementList pad{Assign{fft_in, ComplexLiteral{0, 0}}};
+                stmts += If{j < N, load};
+                stmts += Else{pad};
+            }
+            break;
+        case R2RType::NONE:
+            throw std::runtime_error("real-to-real kernel needs a transform type");
+        }
+        return stmts;
+    }
+
+    // turn element k of the FFT's output in LDS into the real
+    // result
+    StatementList store_r2r(const Expression& k)
+    {
+        auto          fft_out = lds_complex[offset_lds + k];
+        unsigned int  N       = real_length;
+        unsigned int  half    = (N + 1) / 2;
+        StatementList stmts;
+
+        auto store = [&](const Expression& n) { return StoreGlobal{buf, real_index(n), r2r_a}; };
+
+        switch(r2r_type)
+        {
+        case R2RType::DCT_I:
+            stmts += If{k < N, {Assign{r2r_a, fft_out}, store(k)}};
+            break;
+        case R2RType::DST_I:
+            stmts += If{k >= 1 && k <= N,
+                        {Assign{r2r_a, ComplexLiteral{-fft_out.y, 0}}, store(k - 1)}};
+            break;
+        case R2RType::DCT_II:
+        case R2RType::DST_II:
+            // the full complex FFT gives every output directly,
+            // without pairing up conjugates
+            stmts += Assign{r2r_tw, twiddle(k, 2 * N)};
+            stmts += Assign{
+                r2r_a,
+                ComplexLiteral{2 * Parens{r2r_tw.x * fft_out.x - r2r_tw.y * fft_out.y}, 0}};
+            stmts += store(is_dst() ? Expression{N - 1 - k} : k);
+            break;
+        case R2RType::DCT_III:
+        case R2RType::DST_III:
+            // undo the reordering.  DST negates the odd outputs.
+            if(is_dst())
+                stmts += Assign{r2r_a, ComplexLiteral{Ternary{k < half, fft_out.x, -fft_out.x}, 0}};
+            else
+                stmts += Assign{r2r_a, fft_out};
+            stmts += store(Ternary{k < half, k * 2, 2 * N - 1 - k * 2});
+            break;
+        case R2RType::DCT_IV:
+        case R2RType::DST_IV:
+            if(N % 2 == 0)
+            {
+                stmts += Assign{r2r_tw, twiddle(k, N)};
+                stmts += Assign{r2r_b, cmul_twiddle(fft_out)};
+                stmts += Assign{r2r_a, ComplexLiteral{2 * r2r_b.x, 0}};
+                stmts += store(k * 2);
+                stmts += Assign{r2r_a, ComplexLiteral{is_dst() ? 2 * r2r_b.y : -2 * r2r_b.y, 0}};
+                stmts += store(N - 1 - k * 2);
+            }
+            else
+            {
+                StatementList store_k;
+                store_k += Assign{r2r_tw, twiddle(k * 2 + 1, 4 * N)};
+                store_k += Assign{r2r_b, cmul_twiddle(fft_out)};
+                if(is_dst())
+                    store_k += Assign{
+                        r2r_a, ComplexLiteral{Ternary{k % 2 == 1, -2 * r2r_b.x, 2 * r2r_b.x}, 0}};
+                else
+                    store_k += Assign{r2r_a, ComplexLiteral{2 * r2r_b.x, 0}};
+                store_k += store(k);
+                stmts += If{k < N, store_k};
+            }
+            break;
+        case R2RType::NONE:
+            throw std::runtime_error("real-to-real kernel needs a transform type");
+        }
+        return stmts;
+    }
+};
@@ -18,6 +18,7 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 
+#pragma once
 #include "stockham_gen_base.h"
 
 struct StockhamKernelRR : public StockhamKernel
@@ -72,14 +73,15 @@ struct StockhamKernelRR : public StockhamKernel
             unsigned int width  = threads_per_transform;
             unsigned int height = length / width;
 
+            StatementList stmts_load;
             for(unsigned int h = 0; h < height; ++h)
             {
                 auto idx = thread + h * width;
-                stmts += Assign{lds_complex[offset_lds + idx],
-                                LoadGlobal{buf, offset + idx * stride0}};
+                stmts_load += Assign{lds_complex[offset_lds + idx],
+                                     LoadGlobal{buf, offset + idx * stride0}};
             }
-            stmts += LineBreak();
-            stmts += CommentLines{"append extra global loading for C2Real pre-process only"};
+            stmts_load += LineBreak();
+            stmts_load += CommentLines{"append extra global loading for C2Real pre-process only"};
 
             StatementList stmts_c2real_pre;
             stmts_c2real_pre += CommentLines{
@@ -88,7 +90,17 @@ struct StockhamKernelRR : public StockhamKernel
                 thread == threads_per_transform - 1,
                 {Assign{lds_complex[offset_lds + thread + (height - 1) * width + 1],
                         LoadGlobal{buf, offset + (thread + (height - 1) * width + 1) * stride0}}}};
-            stmts += If{embedded_type == Literal{"EmbeddedType::C2Real_PRE"}, stmts_c2real_pre};
+            stmts_load
+                += If{embedded_type == Literal{"EmbeddedType::C2Real_PRE"}, stmts_c2real_pre};
+
+            if(length % 2 == 1)
+            {
+                stmts += If{embedded_type == Literal{"EmbeddedType::C2Real_ODD"},
+                            load_hermitian_odd(width, height)};
+                stmts += Else{stmts_load};
+            }
+            else
+                stmts += stmts_load;
         }
         else
         {
@@ -110,14 +122,17 @@ struct StockhamKernelRR : public StockhamKernel
         {
             auto width  = threads_per_transform;
             auto height = length / width;
+
+            StatementList stmts_store;
             for(unsigned int h = 0; h < height; ++h)
             {
                 auto idx = thread + h * width;
-                stmts += StoreGlobal{buf, offset + idx * stride0, lds_complex[offset_lds + idx]};
+                stmts_store
+                    += StoreGlobal{buf, offset + idx * stride0, lds_complex[offset_lds + idx]};
             }
 
-            stmts += LineBreak{};
-            stmts += CommentLines{"append extra global write for Real2C post-process only"};
+            stmts_store += LineBreak{};
+            stmts_store += CommentLines{"append extra global write for Real2C post-process only"};
             StatementList stmts_real2c_post;
             stmts_real2c_post += CommentLines{
                 "use the last thread of each transform to write one more element per row"};
@@ -126,7 +141,17 @@ struct StockhamKernelRR : public StockhamKernel
                       {StoreGlobal{buf,
                                    offset + (thread + (height - 1) * width + 1) * stride0,
                                    lds_complex[offset_lds + thread + (height - 1) * width + 1]}}};
-            stmts += If{Equal{embedded_type, "EmbeddedType::Real2C_POST"}, stmts_real2c_post};
+            stmts_store
+                += If{Equal{embedded_type, "EmbeddedType::Real2C_POST"}, stmts_real2c_post};
+
+            if(length % 2 == 1)
+            {
+                stmts += If{Equal{embedded_type, "EmbeddedType::Real2C_ODD"},
+                            store_hermitian_odd(width, height)};
+                stmts += Else{stmts_store};
+            }
+            else
+                stmts += stmts_store;
         }
         else
         {
@@ -141,4 +166,54 @@ struct StockhamKernelRR : public StockhamKernel
 
         return stmts;
     }
+
+    // odd-length real-to-complex: the whole real row was loaded as
+    // complex values with zero imaginary part, so the first
+    // length/2 + 1 outputs are the Hermitian half of the result
+    StatementList store_hermitian_odd(unsigned int width, unsigned int height)
+    {
+        StatementList stmts;
+        stmts += CommentLines{"store the Hermitian half of the odd-length result only"};
+        for(unsigned int h = 0; h < height && h * width <= length / 2; ++h)
+        {
+            auto          idx = thread + h * width;
+            StatementList store{
+                StoreGlobal{buf, offset + idx * stride0, lds_complex[offset_lds + idx]}};
+            if((h + 1) * width - 1 <= length / 2)
+                stmts += store;
+            else
+                stmts += If{idx <= length / 2, store};
+        }
+        return stmts;
+    }
+
+    // odd-length complex-to-real: load the Hermitian half of the
+    // input and fill in the rest of the row with its conjugates, so
+    // the inverse transform produces a real result
+    StatementList load_hermitian_odd(unsigned int width, unsigned int height)
+    {
+        StatementList stmts;
+        stmts += CommentLines{"load the Hermitian half of the odd-length input,",
+                              "and reconstruct the other half from its symmetry"};
+        for(unsigned int h = 0; h < height && h * width <= length / 2; ++h)
+        {
+            auto          idx = thread + h * width;
+            StatementList load{
+                Assign{lds_complex[offset_lds + idx], LoadGlobal{buf, offset + idx * stride0}}};
+            StatementList conjugate{Assign{
+                lds_complex[offset_lds + length - idx],
+                ComplexLiteral{lds_complex[offset_lds + idx].x, -lds_complex[offset_lds + idx].y}}};
+            // element 0 is its own conjugate
+            if(h == 0)
+                load += If{idx > 0, conjugate};
+            else
+                load += conjugate;
+
+            if((h + 1) * width - 1 <= length / 2)
+                stmts += load;
+            else
+                stmts += If{idx <= length / 2, load};
+        }
+        return stmts;
+    }
 };
@@ -0,0 +1,318 @@
+// Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// interface for generation of tiled transpose kernels
+
+#pragma once
+#include "generator.h"
+
+#include <stdexcept>
+#include <string>
+
+// Everything that changes the index math or the work done per
+// element is decided at generation time, so each distinct set of
+// specs produces a distinct kernel.
+struct TransposeGeneratorSpecs
+{
+    // a tile of tile_x * tile_x elements is transposed by
+    // tile_x * tile_y threads
+    unsigned int tile_x = 64;
+    unsigned int tile_y = 16;
+
+    // number of large twiddle steps to multiply by on load, or 0 to
+    // skip the large twiddle multiply
+    unsigned int large_twiddle_steps = 0;
+
+    // index into the stride arrays of the distance between matrices
+    unsigned int batch_stride_index = 2;
+
+    // every tile is full, so no bounds checks are needed
+    bool tile_aligned = false;
+
+    // consecutive elements of a row are contiguous on input and output
+    bool unit_stride = false;
+
+    // walk thread blocks diagonally across the matrix, to spread
+    // concurrent accesses across memory channels
+    bool diagonal = false;
+};
+
+// This inherits from specs as a shortcut to avoid having to look
+// inside a class member for variables we need all the time
+struct TransposeKernel : public TransposeGeneratorSpecs
+{
+    explicit TransposeKernel(const TransposeGeneratorSpecs& specs)
+        : TransposeGeneratorSpecs(specs)
+    {
+        if(tile_x == 0 || tile_y == 0 || tile_x % tile_y != 0)
+            throw std::runtime_error("transpose tile width must be a multiple of its height");
+        if(large_twiddle_steps > 3)
+            throw std::runtime_error("transpose supports at most 3 large twiddle steps");
+    }
+
+    // LDS rows are padded by one element, so that threads writing
+    // down a column of the tile hit different banks
+    unsigned int lds_pitch() const
+    {
+        return tile_x + 1;
+    }
+
+    //
+    // templates
+    //
+    Variable scalar_type{"scalar_type", "typename"};
+    Variable callback_type{"cbtype", "CallbackType"};
+    Variable large_twiddle_base{"large_twiddle_base", "size_t"};
+    Variable large_twiddle_steps_var{"large_twiddle_steps", "size_t"};
+
+    //
+    // arguments
+    //
+    // large 1D twiddle table
+    Variable twiddles_large{"twiddles_large", "const scalar_type", true, true};
+
+    // input/output array strides
+    Variable stride_in{"stride_in", "const size_t", true, true};
+    Variable stride_out{"stride_out", "const size_t", true, true};
+
+    // distance between rows of the input and output matrices
+    Variable ld_in{"ld_in", "const size_t"};
+    Variable ld_out{"ld_out", "const size_t"};
+
+    // input matrix is m rows by n columns
+    Variable m{"m", "const size_t"};
+    Variable n{"n", "const size_t"};
+
+    // global input/output buffers
+    Variable buf_in{"buf_in", "scalar_type", true, true};
+    Variable buf_out{"buf_out", "scalar_type", true, true};
+
+    //
+    // locals
+    //
+    // hip thread block ids and counts
+    Variable block_id_x{"blockIdx.x", "unsigned int"};
+    Variable block_id_y{"blockIdx.y", "unsigned int"};
+    Variable block_id_z{"blockIdx.z", "unsigned int"};
+    Variable grid_dim_x{"gridDim.x", "unsigned int"};
+    Variable grid_dim_y{"gridDim.y", "unsigned int"};
+
+    // hip thread ids
+    Variable tx{"threadIdx.x", "unsigned int"};
+    Variable ty{"threadIdx.y", "unsigned int"};
+
+    // tile of the matrix this block works on
+    Variable tile_col{"tile_col", "size_t"};
+    Variable tile_row{"tile_row", "size_t"};
+
+    // global input/output buffer offsets to the current tile
+    Variable offset_in{"offset_in", "size_t"};
+    Variable offset_out{"offset_out", "size_t"};
+
+    // valid rows/columns of a partial tile
+    Variable tile_rows{"tile_rows", "size_t"};
+    Variable tile_cols{"tile_cols", "size_t"};
+
+    // twiddle value during twiddle application
+    Variable W{"W", "scalar_type"};
+
+    // temporary register during twiddle application
+    Variable t{"t", "scalar_type"};
+
+    static ArgumentList get_callback_args()
+    {
+        return {Variable{"load_cb_fn", "void", true, true},
+                Variable{"load_cb_data", "void", true, true},
+                Variable{"load_cb_lds_bytes", "uint32_t"},
+                Variable{"store_cb_fn", "void", true, true},
+                Variable{"store_cb_data", "void", true, true}};
+    }
+
+    TemplateList global_templates()
+    {
+        TemplateList tpls{scalar_type, callback_type};
+        if(large_twiddle_steps)
+        {
+            tpls.append(large_twiddle_base);
+            tpls.append(large_twiddle_steps_var);
+        }
+        return tpls;
+    }
+
+    ArgumentList global_arguments()
+    {
+        ArgumentList arguments{twiddles_large, stride_in, stride_out, ld_in, ld_out, m, n};
+        for(const auto& arg : get_callback_args().arguments)
+            arguments.append(arg);
+        arguments.append(buf_in);
+        arguments.append(buf_out);
+        return arguments;
+    }
+
+    StatementList calculate_offsets()
+    {
+        StatementList stmts;
+        stmts += Declaration{tile_col};
+        stmts += Declaration{tile_row};
+        if(diagonal)
+        {
+            Variable bid{"bid", "size_t"};
+            stmts += Declaration{bid, block_id_x + grid_dim_x * block_id_y};
+            stmts += Assign{tile_row, bid % grid_dim_y};
+            stmts += Assign{tile_col, Parens{bid / grid_dim_y + tile_row} % grid_dim_x};
+        }
+        else
+        {
+            stmts += Assign{tile_col, block_id_x};
+            stmts += Assign{tile_row, block_id_y};
+        }
+
+        stmts += Declaration{offset_in,
+                             block_id_z * stride_in[batch_stride_index]
+                                 + tile_col * tile_x * stride_in[0] + tile_row * tile_x * ld_in};
+        stmts += Declaration{offset_out,
+                             block_id_z * stride_out[batch_stride_index]
+                                 + tile_col * tile_x * ld_out + tile_row * tile_x * stride_out[0]};
+
+        if(!tile_aligned)
+        {
+            stmts += Declaration{tile_rows,
+                                 Ternary{m - tile_row * tile_x < tile_x,
+                                         Parens{m - tile_row * tile_x},
+                                         Parens{tile_x}}};
+            stmts += Declaration{tile_cols,
+                                 Ternary{n - tile_col * tile_x < tile_x,
+                                         Parens{n - tile_col * tile_x},
+                                         Parens{tile_x}}};
+        }
+        return stmts;
+    }
+
+    // wrap statements in a bounds check, if partial tiles are possible
+    StatementList guard(const Expression& rows, const Expression& cols, const StatementList& body)
+    {
+        if(tile_aligned)
+            return body;
+        return {If{tx < cols && rows, body}};
+    }
+
+    StatementList load_from_global(const Variable& elem)
+    {
+        StatementList stmts;
+        auto          col = unit_stride ? Expression{tx} : Expression{tx * stride_in[0]};
+        for(unsigned int j = 0; j < tile_x / tile_y; ++j)
+        {
+            auto          row = ty + j * tile_y;
+            StatementList load;
+            load += Assign{elem[j], LoadGlobal{buf_in, offset_in + col + row * ld_in}};
+            if(large_twiddle_steps)
+            {
+                auto idx = Parens{tile_col * tile_x + tx} * Parens{tile_row * tile_x + row};
+                load += Assign{W,
+                               CallExpr{"TW_NSteps",
+                                        TemplateList{scalar_type,
+                                                     large_twiddle_base,
+                                                     large_twiddle_steps_var},
+                                        {twiddles_large, idx}}};
+                load += Assign{t, TwiddleMultiply{elem[j], W}};
+                load += Assign{elem[j], t};
+            }
+            stmts += guard(row < tile_rows, tile_cols, load);
+        }
+        return stmts;
+    }
+
+    StatementList store_to_global(const Variable& elem)
+    {
+        StatementList stmts;
+        auto          col = unit_stride ? Expression{tx} : Expression{tx * stride_out[0]};
+        for(unsigned int j = 0; j < tile_x / tile_y; ++j)
+        {
+            auto row = ty + j * tile_y;
+            stmts += guard(row < tile_cols,
+                           tile_rows,
+                           {StoreGlobal{buf_out, offset_out + col + row * ld_out, elem[j]}});
+        }
+        return stmts;
+    }
+
+    Function generate_global_function()
+    {
+        Function f("forward_transpose_tile" + std::to_string(tile_x) + "x"
+                   + std::to_string(tile_y));
+        f.qualifier     = "__global__";
+        f.launch_bounds = tile_x * tile_y;
+        f.templates     = global_templates();
+        f.arguments     = global_arguments();
+
+        Variable lds{"lds", "__shared__ scalar_type", false, false, tile_x * lds_pitch()};
+        Variable elem{"elem", "scalar_type", false, false, tile_x / tile_y};
+
+        StatementList& body = f.body;
+        body += CommentLines{
+            "this kernel:",
+            "  transposes a " + std::to_string(tile_x) + "x" + std::to_string(tile_x)
+                + " tile per thread block",
+            "therefore it should be called with " + std::to_string(tile_x) + "x"
+                + std::to_string(tile_y) + " threads per thread block"};
+        body += Declaration{lds};
+        body += Declaration{elem};
+        if(large_twiddle_steps)
+        {
+            body += Declaration{W};
+            body += Declaration{t};
+        }
+        body += CallbackDeclaration{scalar_type.name, callback_type.name};
+
+        body += LineBreak{};
+        body += CommentLines{"offsets"};
+        body += calculate_offsets();
+
+        body += LineBreak{};
+        body += CommentLines{"load tile into registers"};
+        body += load_from_global(elem);
+
+        // Loads are all issued before any LDS writes, and LDS reads
+        // are all done before any stores, so that the compiler can
+        // easily overlap the long-latency global memory operations.
+        body += LineBreak{};
+        body += CommentLines{"transpose through lds"};
+        for(unsigned int j = 0; j < tile_x / tile_y; ++j)
+        {
+            auto row = ty + j * tile_y;
+            body += guard(row < tile_rows,
+                          tile_cols,
+                          {Assign{lds[tx * lds_pitch() + row], elem[j]}});
+        }
+        body += SyncThreads{};
+        for(unsigned int j = 0; j < tile_x / tile_y; ++j)
+        {
+            auto row = ty + j * tile_y;
+            body += guard(row < tile_cols,
+                          tile_rows,
+                          {Assign{elem[j], lds[row * lds_pitch() + tx]}});
+        }
+
+        body += LineBreak{};
+        body += CommentLines{"store tile to global"};
+        body += store_to_global(elem);
+        return f;
+    }
+};
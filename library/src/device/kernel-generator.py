@@ -10,7 +10,9 @@ It accept two sub-commands:
 import argparse
 import collections
 import functools
+import hashlib
 import itertools
+import json
 import subprocess
 import sys
 import os
@@ -20,8 +22,8 @@ from pathlib import Path
 from types import SimpleNamespace as NS
 from operator import mul
 
-from generator import (ArgumentList, BaseNode, Call, CommentBlock, Function, Include,
-                       LineBreak, Map, StatementList, Variable, name_args, write,
+from generator import (ArgumentList, BaseNode, CommentBlock, Declaration, Function,
+                       Include, LineBreak, StatementList, Variable, name_args, write,
                        clang_format_file)
 
 
@@ -31,7 +33,8 @@ LaunchParams = namedtuple('LaunchParams', ['transforms_per_block',
                                            'workgroup_size',
                                            'threads_per_transform',
                                            'half_lds', # load real and imag part separately with half regular lds resouce to increase occupancy
-                                           'direct_to_reg']) # load from global mem to registers directly and store from registers to global mem.
+                                           'direct_to_reg', # load from global mem to registers directly and store from registers to global mem.
+                                           'shfl_exchange']) # exchange data between passes with cross-lane shuffles instead of lds.
 
 #
 # CMake helpers
@@ -78,69 +81,103 @@ def unique(kernels):
 # Prototype generators
 #
 
-@name_args(['function'])
+@name_args(['function', 'factors'])
 class FFTKernel(BaseNode):
+    """Initializer of a FunctionPoolEntry.
+
+    'factors' is the expression pointing at the kernel's factors in
+    static storage.
+    """
     def __str__(self):
-        f = 'FFTKernel('
-        if self.function.meta.runtime_compile:
+        meta = self.function.meta
+        length = meta.length
+        if isinstance(length, (int, str)):
+            length = [length, 0]
+        f = '{{' + cjoin(length) + '}, '
+        if meta.runtime_compile:
             f += 'nullptr'
         else:
             f += str(self.function.address())
-        use_3steps_large_twd = getattr(self.function.meta, 'use_3steps_large_twd', None)
+        factors = getattr(meta, 'factors', None) or []
+        f += ', ' + (self.factors if factors else 'nullptr')
+        f += ', ' + str(len(factors))
+        f += ', ' + str(getattr(meta, 'transforms_per_block', None) or 0)
+        f += ', ' + str(getattr(meta, 'workgroup_size', None) or 0)
+        f += ', {' + ','.join([str(s) for s in meta.threads_per_transform]) + '}'
+        use_3steps_large_twd = getattr(meta, 'use_3steps_large_twd', None)
         if use_3steps_large_twd is not None:
-            f += ', ' + str(use_3steps_large_twd[self.function.meta.precision])
+            f += ', ' + str(use_3steps_large_twd[meta.precision]).lower()
         else:
             f += ', false'
-        factors = getattr(self.function.meta, 'factors', None)
-        if factors is not None:
-            f += ', {' + cjoin(factors) + '}'
-        transforms_per_block = getattr(self.function.meta, 'transforms_per_block', None)
-        if transforms_per_block is not None:
-            f += ', ' + str(transforms_per_block)
-        workgroup_size = getattr(self.function.meta, 'workgroup_size', None)
-        if workgroup_size is not None:
-            f += ', ' + str(workgroup_size)
-        f += ', {' + ','.join([str(s) for s in self.function.meta.threads_per_transform]) + '}'
-        direct_to_reg = None
-        half_lds = None
-        if hasattr(self.function.meta, 'params'):
-            half_lds = getattr(self.function.meta.params, 'half_lds', None)
-            direct_to_reg = getattr(self.function.meta.params, 'direct_to_reg', None)
-        if half_lds is not None:
-            f += ', ' + str(half_lds).lower()
-        if direct_to_reg is not None:
-            f += ', ' + str(direct_to_reg).lower()
-        f += ')'
+        params = getattr(meta, 'params', None)
+        for flag in ['half_lds', 'direct_to_reg', 'shfl_exchange']:
+            f += ', ' + str(bool(getattr(params, flag, False))).lower()
+        f += '}'
         return f
 
 
+def function_pool_key(function):
+    """Return (precision, scheme, transpose) group and length of a function pool entry."""
+    meta = function.meta
+    length = meta.length
+    if isinstance(length, (int, str)):
+        length = [length, 0]
+    return (meta.precision, meta.scheme, meta.transpose or 'NONE'), [int(x) for x in length]
+
+
 def generate_cpu_function_pool(functions):
-    """Generate function to populate the kernel function pool."""
+    """Generate the statically-initialized kernel function pool.
+
+    Entries are grouped by precision, scheme and transpose type, and
+    sorted by length within each group, so that the library can
+    binary-search a group instead of building a hash map at load
+    time.  Sorting also keeps the generated file stable regardless
+    of the order kernels were generated in.
+    """
 
-    function_map = Map('function_map')
     precisions = { 'sp': 'rocfft_precision_single',
                    'dp': 'rocfft_precision_double' }
 
-    populate = StatementList()
+    groups = collections.defaultdict(list)
     for f in functions:
-        length, precision, scheme, transpose = f.meta.length, f.meta.precision, f.meta.scheme, f.meta.transpose
-        if isinstance(length, (int, str)):
-            length = [length, 0]
-        key = Call(name='std::make_tuple',
-                   arguments=ArgumentList('std::array<size_t, 2>({' + cjoin(length) + '})',
-                                          precisions[precision],
-                                          scheme,
-                                          transpose or 'NONE')).inline()
-        populate += function_map.assert_emplace(key, FFTKernel(f))
+        group, length = function_pool_key(f)
+        groups[group].append((length, f))
+
+    factors = []
+    entries = []
+    directory = []
+    for group in sorted(groups):
+        members = sorted(groups[group], key=lambda x: x[0])
+        for (length, _), (next_length, _) in zip(members, members[1:]):
+            if length == next_length:
+                raise RuntimeError(f'duplicate function pool entry {group} {length}')
+        begin = len(entries)
+        for _, f in members:
+            entries.append(FFTKernel(f, f'pool_factors + {len(factors)}'))
+            factors += getattr(f.meta, 'factors', None) or []
+        precision, scheme, transpose = group
+        directory.append('{' + cjoin([precisions[precision], scheme, transpose,
+                                      f'pool_entries + {begin}',
+                                      f'pool_entries + {len(entries)}']) + '}')
 
     return StatementList(
-        Include('<iostream>'),
         Include('"../include/function_pool.h"'),
         StatementList(*[f.prototype() for f in functions]),
+        Declaration('pool_factors', 'static const size_t', size=max(len(factors), 1),
+                    value='{' + cjoin(factors or [0]) + '}'),
+        Declaration('pool_entries', 'static const FunctionPoolEntry', size=len(entries),
+                    value='{' + cjoin(entries) + '}'),
+        Declaration('pool_groups', 'static const FunctionPoolGroup', size=len(directory),
+                    value='{' + cjoin(directory) + '}'),
         Function(name='function_pool::function_pool',
                  value=False,
                  arguments=ArgumentList(),
-                 body=populate))
+                 body=StatementList('groups = pool_groups;',
+                                    f'group_count = {len(directory)};')))
+
+
+# number of small kernels compiled together in one translation unit
+SMALL_KERNELS_PER_GROUP = 8
 
 
 def list_generated_kernels(kernels):
@@ -148,6 +185,35 @@ def list_generated_kernels(kernels):
     return [kernel_file_name(x) for x in kernels if not x.runtime_compile]
 
 
+def group_small_kernels(kernels):
+    """Return dict of group filename to the small kernel filenames it includes.
+
+    Small kernels are cheap to compile compared to the headers they
+    pull in, so several of them are built in one translation unit.
+    Groups are formed from the sorted list of file names to keep
+    their contents stable over time.
+    """
+    small = sorted(kernel_file_name(x) for x in kernels
+                   if not x.runtime_compile and x.scheme == 'CS_KERNEL_STOCKHAM')
+    groups = {}
+    for i in range(0, len(small), SMALL_KERNELS_PER_GROUP):
+        groups[f'rocfft_small_group{i // SMALL_KERNELS_PER_GROUP}.cpp'] = small[i:i + SMALL_KERNELS_PER_GROUP]
+    return groups
+
+
+def list_compiled_files(kernels):
+    """Return list of generated files that the build compiles."""
+    groups = group_small_kernels(kernels)
+    grouped = set(flatten(list(groups.values())))
+    return [f for f in list_generated_kernels(kernels) if f not in grouped] + list(groups.keys())
+
+
+def write_small_kernel_groups(kernels):
+    """Write the translation units that include grouped small kernels."""
+    for group, files in group_small_kernels(kernels).items():
+        write(group, ''.join(f'#include "{f}"\n' for f in files))
+
+
 #
 # Main!
 #
@@ -191,7 +257,7 @@ def list_small_kernels():
         NS(length=  13, workgroup_size= 64, threads_per_transform=  1, factors=(13,)),
         NS(length=  14, workgroup_size=128, threads_per_transform=  7, factors=(7, 2)),
         NS(length=  15, workgroup_size=128, threads_per_transform=  5, factors=(3, 5)),
-        NS(length=  16, workgroup_size= 64, threads_per_transform=  4, factors=(4, 4)),
+        NS(length=  16, workgroup_size= 64, threads_per_transform=  4, factors=(4, 4), shfl_exchange=True),
         NS(length=  17, workgroup_size=256, threads_per_transform=  1, factors=(17,)),
         NS(length=  18, workgroup_size= 64, threads_per_transform=  6, factors=(3, 6)),
         NS(length=  20, workgroup_size=256, threads_per_transform= 10, factors=(5, 4)),
@@ -216,7 +282,7 @@ def list_small_kernels():
         NS(length=  54, workgroup_size=256, threads_per_transform= 18, factors=(6, 3, 3)),
         NS(length=  56, workgroup_size=128, threads_per_transform=  8, factors=(7, 8)),
         NS(length=  60, workgroup_size= 64, threads_per_transform= 10, factors=(6, 10)),
-        NS(length=  64, workgroup_size= 64, threads_per_transform= 16, factors=(4, 4, 4)),
+        NS(length=  64, workgroup_size= 64, threads_per_transform= 16, factors=(4, 4, 4), shfl_exchange=True),
         NS(length=  72, workgroup_size= 64, threads_per_transform=  9, factors=(8, 3, 3)),
         NS(length=  75, workgroup_size=256, threads_per_transform= 25, factors=(5, 5, 3)),
         NS(length=  80, workgroup_size= 64, threads_per_transform= 10, factors=(5, 2, 8)),
@@ -604,12 +670,26 @@ def default_runtime_compile(kernels, default_val):
 
     return [k if hasattr(k, 'runtime_compile') else NS(**k.__dict__, runtime_compile=default_val) for k in kernels]
 
-def generate_kernel(kernel, precisions, stockham_aot):
+def generator_version(stockham_aot):
+    """Return a hash of everything that decides what a kernel file looks like."""
+    h = hashlib.sha256()
+    for fname in [stockham_aot, __file__, Path(__file__).parent / 'generator.py']:
+        h.update(Path(fname).read_bytes())
+    return h.hexdigest()
+
+
+def generate_kernel(kernel, precisions, stockham_aot, version):
     """Generate a single kernel file for 'kernel'.
 
     The kernel file contains all kernel variations corresponding to
     the kernel meta data in 'kernel'.
 
+    The stockham_aot arguments and the generator version are hashed
+    and stored next to the kernel file, along with the launchers it
+    reported.  If they match a previous run, stockham_aot is not run
+    again.  The kernel file is only rewritten if its content changed,
+    so the build system only recompiles kernels that really changed.
+
     A list of CPU functions is returned.
     """
 
@@ -638,19 +718,36 @@ def generate_kernel(kernel, precisions, stockham_aot):
 
     direct_to_reg = getattr(kernel, 'direct_to_reg', False)
 
+    shfl_exchange = getattr(kernel, 'shfl_exchange', False)
+
     filename = kernel_file_name(kernel)
 
     args.append(str(kernel.workgroup_size))
     args.append('1' if half_lds else '0')
     args.append('1' if direct_to_reg else '0')
+    args.append('1' if shfl_exchange else '0')
     args.append(kernel.scheme)
-    args.append(filename)
 
-    proc = subprocess.run(args=args, stdout=subprocess.PIPE, check=True)
-    clang_format_file(filename)
+    spec_hash = hashlib.sha256((version + ' '.join(args[1:])).encode('ascii')).hexdigest()
+    stamp_file = Path(filename).with_suffix('.json')
+
+    launchers = None
+    if stamp_file.exists() and Path(filename).exists():
+        stamp = json.loads(stamp_file.read_text())
+        if stamp.get('hash') == spec_hash:
+            launchers = stamp['launchers']
 
-    import json
-    launchers = json.loads(proc.stdout.decode('ascii'))
+    if launchers is None:
+        tmp_filename = filename + '.tmp'
+        args.append(tmp_filename)
+
+        proc = subprocess.run(args=args, stdout=subprocess.PIPE, check=True)
+        clang_format_file(tmp_filename)
+        write(filename, Path(tmp_filename).read_text())
+        os.remove(tmp_filename)
+
+        launchers = json.loads(proc.stdout.decode('ascii'))
+        stamp_file.write_text(json.dumps({'hash': spec_hash, 'launchers': launchers}))
 
     cpu_functions = []
     data = Variable('data_p', 'const void *')
@@ -665,6 +762,7 @@ def generate_kernel(kernel, precisions, stockham_aot):
         threads_per_transform = workgroup_size // transforms_per_block
         half_lds = launcher.half_lds
         direct_to_reg = launcher.direct_to_reg
+        shfl_exchange = launcher.shfl_exchange
         scheme = launcher.scheme
         sbrc_type = launcher.sbrc_type
         sbrc_transpose_type = launcher.sbrc_transpose_type
@@ -672,7 +770,7 @@ def generate_kernel(kernel, precisions, stockham_aot):
         runtime_compile = kernel.runtime_compile
         use_3steps_large_twd = getattr(kernel, 'use_3steps_large_twd', None)
 
-        params = LaunchParams(transforms_per_block, workgroup_size, threads_per_transform, half_lds, direct_to_reg)
+        params = LaunchParams(transforms_per_block, workgroup_size, threads_per_transform, half_lds, direct_to_reg, shfl_exchange)
 
         # make 2D list of threads_per_transform to populate FFTKernel
         tpt_list = kernel.threads_per_transform if scheme == 'CS_KERNEL_2D_SINGLE' else [threads_per_transform, 0]
@@ -717,6 +815,8 @@ def generate_kernels(kernels, precisions, stockham_aot):
     # queue for outputs
     q_out = queue.Queue()
 
+    version = generator_version(stockham_aot)
+
     def threadfunc():
         nonlocal q_in
         nonlocal q_out
@@ -724,8 +824,8 @@ def generate_kernels(kernels, precisions, stockham_aot):
         nonlocal stockham_aot
         try:
             while not q_in.empty():
-                k = q_in.get()
-                q_out.put(generate_kernel(k, precisions, stockham_aot))
+                k = q_in.get_nowait()
+                q_out.put(generate_kernel(k, precisions, stockham_aot, version))
         except queue.Empty:
             pass
 
@@ -838,10 +938,11 @@ def cli():
     #
 
     if args.command == 'list':
-        scprint(set(['function_pool.cpp'] + list_generated_kernels(kernels)))
+        scprint(set(['function_pool.cpp'] + list_compiled_files(kernels)))
 
     if args.command == 'generate':
         cpu_functions = generate_kernels(kernels, precisions, args.stockham_aot)
+        write_small_kernel_groups(kernels)
         write('function_pool.cpp', generate_cpu_function_pool(cpu_functions), format=True)
 
 
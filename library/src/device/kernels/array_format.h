@@ -105,17 +105,15 @@ struct Handler<planar<float2>, cbtype>
     static __host__ __device__ inline float2
         read(const planar<float2> in, size_t idx, void* load_cb_fn, void* load_cb_data)
     {
-        float2 t;
-        t.x = in.R[idx];
-        t.y = in.I[idx];
-        return t;
+        auto load_cb = get_load_cb<float2, cbtype>(load_cb_fn);
+        return load_planar<cbtype>(load_cb, in.R, in.I, idx, load_cb_data);
     }
 
     static __host__ __device__ inline void
         write(planar<float2> out, size_t idx, float2 v, void* store_cb_fn, void* store_cb_data)
     {
-        out.R[idx] = v.x;
-        out.I[idx] = v.y;
+        auto store_cb = get_store_cb<float2, cbtype>(store_cb_fn);
+        store_planar<cbtype>(store_cb, out.R, out.I, idx, v, store_cb_data);
     }
 };
 
@@ -125,17 +123,15 @@ struct Handler<planar<double2>, cbtype>
     static __host__ __device__ inline double2
         read(const planar<double2> in, size_t idx, void* load_cb_fn, void* load_cb_data)
     {
-        double2 t;
-        t.x = in.R[idx];
-        t.y = in.I[idx];
-        return t;
+        auto load_cb = get_load_cb<double2, cbtype>(load_cb_fn);
+        return load_planar<cbtype>(load_cb, in.R, in.I, idx, load_cb_data);
     }
 
     static __host__ __device__ inline void
         write(planar<double2> out, size_t idx, double2 v, void* store_cb_fn, void* store_cb_data)
     {
-        out.R[idx] = v.x;
-        out.I[idx] = v.y;
+        auto store_cb = get_store_cb<double2, cbtype>(store_cb_fn);
+        store_planar<cbtype>(store_cb, out.R, out.I, idx, v, store_cb_data);
     }
 };
 
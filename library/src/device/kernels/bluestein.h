@@ -53,22 +53,20 @@ __global__ void __launch_bounds__(LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
 
     val.y *= (real_type_t<T>)(dir);
 
+    // Only the copy of the chirp at offset M is written, since the
+    // FFT of that copy is all that the later steps read.  PAD_MUL
+    // and RES_MUL compute the chirp they need on the fly.
     if(tx == 0)
     {
-        output[tx]     = val;
         output[tx + M] = val;
     }
     else if(tx < N)
     {
-        output[tx]     = val;
-        output[tx + M] = val;
-
-        output[M - tx]     = val;
+        output[tx + M]     = val;
         output[M - tx + M] = val;
     }
     else if(tx <= (M - N))
     {
-        output[tx]     = lib_make_vector2<T>(0, 0);
         output[tx + M] = lib_make_vector2<T>(0, 0);
     }
 }
@@ -145,8 +143,6 @@ __global__ void __launch_bounds__(LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
         // should never be the last kernel to write global memory.
         // So we should never need to run a "store" callback.
 
-        T* chirp = output;
-
         iIdx += iOffset;
 
         oIdx += M;
@@ -154,10 +150,13 @@ __global__ void __launch_bounds__(LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
 
         if(tx < N)
         {
+            T chirp = chirp_twiddle<T>(tx, N);
+            chirp.y *= -(real_type_t<T>)(dir);
+
             // callback might modify input, but otherwise it's const
             T in_elem      = load_cb(const_cast<T*>(input), iIdx, load_cb_data, nullptr);
-            output[oIdx].x = in_elem.x * chirp[tx].x + in_elem.y * chirp[tx].y;
-            output[oIdx].y = -in_elem.x * chirp[tx].y + in_elem.y * chirp[tx].x;
+            output[oIdx].x = in_elem.x * chirp.x - in_elem.y * chirp.y;
+            output[oIdx].y = in_elem.x * chirp.y + in_elem.y * chirp.x;
         }
         else
         {
@@ -170,7 +169,8 @@ __global__ void __launch_bounds__(LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
         // should never be the first kernel to read global memory.
         // So we should never need to run a "load" callback.
 
-        const T* chirp = input;
+        T chirp = chirp_twiddle<T>(tx, N);
+        chirp.y *= -(real_type_t<T>)(dir);
 
         iIdx += 2 * M;
         iIdx += iOffset;
@@ -180,13 +180,13 @@ __global__ void __launch_bounds__(LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
         real_type_t<T> MI = 1.0 / (real_type_t<T>)M;
         T              out_elem;
 
-        out_elem.x = MI * (input[iIdx].x * chirp[tx].x + input[iIdx].y * chirp[tx].y);
-        out_elem.y = MI * (-input[iIdx].x * chirp[tx].y + input[iIdx].y * chirp[tx].x);
+        out_elem.x = MI * (input[iIdx].x * chirp.x - input[iIdx].y * chirp.y);
+        out_elem.y = MI * (input[iIdx].x * chirp.y + input[iIdx].y * chirp.x);
         store_cb(output, oIdx, out_elem, store_cb_data, nullptr);
     }
 }
 
-template <typename T>
+template <typename T, CallbackType cbtype>
 __global__ void __launch_bounds__(LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
     mul_device_P_I(const size_t          numof,
                    const size_t          totalWI,
@@ -200,7 +200,12 @@ __global__ void __launch_bounds__(LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
                    const size_t*         stride_in,
                    const size_t*         stride_out,
                    const int             dir,
-                   const int             scheme)
+                   const int             scheme,
+                   void* __restrict__ load_cb_fn,
+                   void* __restrict__ load_cb_data,
+                   uint32_t load_cb_lds_bytes,
+                   void* __restrict__ store_cb_fn,
+                   void* __restrict__ store_cb_data)
 {
     size_t tx = hipThreadIdx_x + hipBlockIdx_x * hipBlockDim_x;
 
@@ -241,18 +246,23 @@ __global__ void __launch_bounds__(LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
     }
     else if(scheme == 1)
     {
-        T* chirp = output;
+        // PAD_MUL is the first kernel to read global memory, so run
+        // the load callback on the planar input
+        auto load_cb = get_load_cb<T, cbtype>(load_cb_fn);
 
-        inputRe += iOffset;
-        inputIm += iOffset;
+        iIdx += iOffset;
 
         output += M;
         output += oOffset;
 
         if(tx < N)
         {
-            output[oIdx].x = inputRe[iIdx] * chirp[tx].x + inputIm[iIdx] * chirp[tx].y;
-            output[oIdx].y = -inputRe[iIdx] * chirp[tx].y + inputIm[iIdx] * chirp[tx].x;
+            T chirp = chirp_twiddle<T>(tx, N);
+            chirp.y *= -(real_type_t<T>)(dir);
+
+            T in_elem      = load_planar<cbtype>(load_cb, inputRe, inputIm, iIdx, load_cb_data);
+            output[oIdx].x = in_elem.x * chirp.x - in_elem.y * chirp.y;
+            output[oIdx].y = in_elem.x * chirp.y + in_elem.y * chirp.x;
         }
         else
         {
@@ -261,8 +271,8 @@ __global__ void __launch_bounds__(LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
     }
     else if(scheme == 2)
     {
-        const real_type_t<T>* chirpRe = inputRe;
-        const real_type_t<T>* chirpIm = inputIm;
+        T chirp = chirp_twiddle<T>(tx, N);
+        chirp.y *= -(real_type_t<T>)(dir);
 
         inputRe += 2 * M;
         inputRe += iOffset;
@@ -273,12 +283,12 @@ __global__ void __launch_bounds__(LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
         output += oOffset;
 
         real_type_t<T> MI = 1.0 / (real_type_t<T>)M;
-        output[oIdx].x    = MI * (inputRe[iIdx] * chirpRe[tx] + inputIm[iIdx] * chirpIm[tx]);
-        output[oIdx].y    = MI * (-inputRe[iIdx] * chirpIm[tx] + inputIm[iIdx] * chirpRe[tx]);
+        output[oIdx].x    = MI * (inputRe[iIdx] * chirp.x - inputIm[iIdx] * chirp.y);
+        output[oIdx].y    = MI * (inputRe[iIdx] * chirp.y + inputIm[iIdx] * chirp.x);
     }
 }
 
-template <typename T>
+template <typename T, CallbackType cbtype>
 __global__ void __launch_bounds__(LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
     mul_device_I_P(const size_t    numof,
                    const size_t    totalWI,
@@ -292,7 +302,12 @@ __global__ void __launch_bounds__(LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
                    const size_t*   stride_in,
                    const size_t*   stride_out,
                    const int       dir,
-                   const int       scheme)
+                   const int       scheme,
+                   void* __restrict__ load_cb_fn,
+                   void* __restrict__ load_cb_data,
+                   uint32_t load_cb_lds_bytes,
+                   void* __restrict__ store_cb_fn,
+                   void* __restrict__ store_cb_data)
 {
     size_t tx = hipThreadIdx_x + hipBlockIdx_x * hipBlockDim_x;
 
@@ -334,9 +349,6 @@ __global__ void __launch_bounds__(LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
     }
     else if(scheme == 1)
     {
-        real_type_t<T>* chirpRe = outputRe;
-        real_type_t<T>* chirpIm = outputIm;
-
         input += iOffset;
 
         outputRe += M;
@@ -347,8 +359,11 @@ __global__ void __launch_bounds__(LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
 
         if(tx < N)
         {
-            outputRe[oIdx] = input[iIdx].x * chirpRe[tx] + input[iIdx].y * chirpIm[tx];
-            outputIm[oIdx] = -input[iIdx].x * chirpIm[tx] + input[iIdx].y * chirpRe[tx];
+            T chirp = chirp_twiddle<T>(tx, N);
+            chirp.y *= -(real_type_t<T>)(dir);
+
+            outputRe[oIdx] = input[iIdx].x * chirp.x - input[iIdx].y * chirp.y;
+            outputIm[oIdx] = input[iIdx].x * chirp.y + input[iIdx].y * chirp.x;
         }
         else
         {
@@ -358,17 +373,24 @@ __global__ void __launch_bounds__(LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
     }
     else if(scheme == 2)
     {
-        const T* chirp = input;
+        T chirp = chirp_twiddle<T>(tx, N);
+        chirp.y *= -(real_type_t<T>)(dir);
+
+        // RES_MUL is the last kernel to write global memory, so run
+        // the store callback on the planar output
+        auto store_cb = get_store_cb<T, cbtype>(store_cb_fn);
 
         input += 2 * M;
         input += iOffset;
 
-        outputRe += oOffset;
-        outputIm += oOffset;
+        oIdx += oOffset;
 
         real_type_t<T> MI = 1.0 / (real_type_t<T>)M;
-        outputRe[oIdx]    = MI * (input[iIdx].x * chirp[tx].x + input[iIdx].y * chirp[tx].y);
-        outputIm[oIdx]    = MI * (-input[iIdx].x * chirp[tx].y + input[iIdx].y * chirp[tx].x);
+        T              out_elem;
+
+        out_elem.x = MI * (input[iIdx].x * chirp.x - input[iIdx].y * chirp.y);
+        out_elem.y = MI * (input[iIdx].x * chirp.y + input[iIdx].y * chirp.x);
+        store_planar<cbtype>(store_cb, outputRe, outputIm, oIdx, out_elem, store_cb_data);
     }
 }
 
@@ -429,9 +451,6 @@ __global__ void __launch_bounds__(LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
     }
     else if(scheme == 1)
     {
-        real_type_t<T>* chirpRe = outputRe;
-        real_type_t<T>* chirpIm = outputIm;
-
         inputRe += iOffset;
         inputIm += iOffset;
 
@@ -443,8 +462,11 @@ __global__ void __launch_bounds__(LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
 
         if(tx < N)
         {
-            outputRe[oIdx] = inputRe[iIdx] * chirpRe[tx] + inputIm[iIdx] * chirpIm[tx];
-            outputIm[oIdx] = -inputRe[iIdx] * chirpIm[tx] + inputIm[iIdx] * chirpRe[tx];
+            T chirp = chirp_twiddle<T>(tx, N);
+            chirp.y *= -(real_type_t<T>)(dir);
+
+            outputRe[oIdx] = inputRe[iIdx] * chirp.x - inputIm[iIdx] * chirp.y;
+            outputIm[oIdx] = inputRe[iIdx] * chirp.y + inputIm[iIdx] * chirp.x;
         }
         else
         {
@@ -454,8 +476,8 @@ __global__ void __launch_bounds__(LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
     }
     else if(scheme == 2)
     {
-        const real_type_t<T>* chirpRe = inputRe;
-        const real_type_t<T>* chirpIm = inputIm;
+        T chirp = chirp_twiddle<T>(tx, N);
+        chirp.y *= -(real_type_t<T>)(dir);
 
         inputRe += 2 * M;
         inputRe += iOffset;
@@ -467,8 +489,8 @@ __global__ void __launch_bounds__(LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
         outputIm += oOffset;
 
         real_type_t<T> MI = 1.0 / (real_type_t<T>)M;
-        outputRe[oIdx]    = MI * (inputRe[iIdx] * chirpRe[tx] + inputIm[iIdx] * chirpIm[tx]);
-        outputIm[oIdx]    = MI * (-inputRe[iIdx] * chirpIm[tx] + inputIm[iIdx] * chirpRe[tx]);
+        outputRe[oIdx]    = MI * (inputRe[iIdx] * chirp.x - inputIm[iIdx] * chirp.y);
+        outputIm[oIdx]    = MI * (inputRe[iIdx] * chirp.y + inputIm[iIdx] * chirp.x);
     }
 }
 
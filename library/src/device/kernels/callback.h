@@ -126,4 +126,123 @@ static __device__ typename callback_type<T>::store get_store_cb(void* ptr)
     return store_cb_default<T>;
 }
 
+// planar data is handed to user callbacks as a pointer to a struct
+// of the real and imaginary plane pointers, in place of the data
+// pointer.  offset applies to both planes.  The layout matches
+// rocfft_planar_float and rocfft_planar_double in rocfft.h, which
+// runtime-compiled kernels can't include.
+template <typename Treal>
+struct callback_planar_data
+{
+    Treal* real;
+    Treal* imag;
+};
+
+// function pointer types of planar callbacks, for complex type T
+template <typename T>
+struct callback_type_planar;
+
+template <>
+struct callback_type_planar<float2>
+{
+    typedef float2 (*load)(const callback_planar_data<float>* data,
+                           size_t                             offset,
+                           void*                              cbdata,
+                           void*                              sharedMem);
+    typedef void (*store)(const callback_planar_data<float>* data,
+                          size_t                             offset,
+                          float2                             element,
+                          void*                              cbdata,
+                          void*                              sharedMem);
+};
+
+template <>
+struct callback_type_planar<double2>
+{
+    typedef double2 (*load)(const callback_planar_data<double>* data,
+                            size_t                              offset,
+                            void*                               cbdata,
+                            void*                               sharedMem);
+    typedef void (*store)(const callback_planar_data<double>* data,
+                          size_t                              offset,
+                          double2                             element,
+                          void*                               cbdata,
+                          void*                               sharedMem);
+};
+
+// default planar callbacks, for a plan with planar data that has
+// only one of the load and store callbacks set
+template <typename T, typename Treal>
+__device__ T load_cb_default_planar(const callback_planar_data<Treal>* data,
+                                    size_t                             offset,
+                                    void*                              cbdata,
+                                    void*                              sharedMem)
+{
+    T ret;
+    ret.x = data->real[offset];
+    ret.y = data->imag[offset];
+    return ret;
+}
+
+template <typename T, typename Treal>
+__device__ void store_cb_default_planar(const callback_planar_data<Treal>* data,
+                                        size_t                             offset,
+                                        T                                  element,
+                                        void*                              cbdata,
+                                        void*                              sharedMem)
+{
+    data->real[offset] = element.x;
+    data->imag[offset] = element.y;
+}
+
+__device__ auto load_cb_default_planar_float2   = load_cb_default_planar<float2, float>;
+__device__ auto store_cb_default_planar_float2  = store_cb_default_planar<float2, float>;
+__device__ auto load_cb_default_planar_double2  = load_cb_default_planar<double2, double>;
+__device__ auto store_cb_default_planar_double2 = store_cb_default_planar<double2, double>;
+
+// load_cb and store_cb are the user's function pointers as they
+// were set on the execution info.  For planar data, they point to
+// functions with the planar signatures above.
+template <CallbackType cbtype, typename T, typename Treal>
+static __device__ T load_planar(T (*load_cb)(T*, size_t, void*, void*),
+                                Treal* re,
+                                Treal* im,
+                                size_t offset,
+                                void*  load_cb_data)
+{
+#ifdef ROCFFT_CALLBACKS_ENABLED
+    if(cbtype == CallbackType::USER_LOAD_STORE)
+    {
+        const callback_planar_data<Treal> planes{re, im};
+        auto planar_cb = reinterpret_cast<typename callback_type_planar<T>::load>(load_cb);
+        return planar_cb(&planes, offset, load_cb_data, nullptr);
+    }
+#endif
+    T ret;
+    ret.x = re[offset];
+    ret.y = im[offset];
+    return ret;
+}
+
+template <CallbackType cbtype, typename T, typename Treal>
+static __device__ void store_planar(void (*store_cb)(T*, size_t, T, void*, void*),
+                                    Treal* re,
+                                    Treal* im,
+                                    size_t offset,
+                                    T      element,
+                                    void*  store_cb_data)
+{
+#ifdef ROCFFT_CALLBACKS_ENABLED
+    if(cbtype == CallbackType::USER_LOAD_STORE)
+    {
+        const callback_planar_data<Treal> planes{re, im};
+        auto planar_cb = reinterpret_cast<typename callback_type_planar<T>::store>(store_cb);
+        planar_cb(&planes, offset, element, store_cb_data, nullptr);
+        return;
+    }
+#endif
+    re[offset] = element.x;
+    im[offset] = element.y;
+}
+
 #endif
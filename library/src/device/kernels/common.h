@@ -7,6 +7,8 @@
 #include <hip/hip_runtime.h>
 #include <hip/hip_vector_types.h>
 
+#include "../../../../shared/twiddle_math.h"
+
 #ifdef WIN32
 #define ROCFFT_DEVICE_EXPORT __declspec(dllexport)
 #else
@@ -92,6 +94,9 @@ enum class EmbeddedType
     NONE, // Works as the regular complex to complex FFT kernel
     Real2C_POST, // Works with even-length real2complex post-processing
     C2Real_PRE, // Works with even-length complex2real pre-processing
+    Real2C_ODD, // Loads odd-length real input, stores the Hermitian half of the result
+    C2Real_ODD, // Loads the Hermitian half of odd-length input, stores the real result
+    Real2Real, // Loads and stores real data, with DCT/DST pre/post-processing
 };
 
 // TODO: rework this
@@ -292,6 +297,29 @@ __device__ T TWLstep4(const T* twiddles, size_t u)
     return result;
 }
 
+// Bluestein chirp for element u of a length N transform, see the
+// host and device version in twiddle_math.h
+template <typename T>
+__device__ T chirp_twiddle(size_t u, size_t N)
+{
+    real_type_t<T> re, im;
+    chirp_twiddle(u, N, &re, &im);
+    return lib_make_vector2<T>(re, im);
+}
+
+// Twiddle exp(-i * pi * num / den) for the pre- and post-processing
+// of real-to-real transforms.  Their angles are all in [0, pi/2], so
+// no folding is needed.
+template <typename T>
+__device__ T r2r_twiddle(size_t num, size_t den)
+{
+    typedef real_type_t<T> real_t;
+
+    real_t s, c;
+    lib_sincospi(static_cast<real_t>(num) / static_cast<real_t>(den), &s, &c);
+    return lib_make_vector2<T>(c, -s);
+}
+
 #define TWIDDLE_STEP_MUL_FWD(TWFUNC, TWIDDLES, INDEX, REG) \
     {                                                      \
         T              W = TWFUNC(TWIDDLES, INDEX);        \
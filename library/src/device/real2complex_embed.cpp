@@ -269,7 +269,7 @@ __global__ void __launch_bounds__(LAUNCH_BOUNDS_R2C_C2R_KERNEL)
 }
 
 // The planar overload function of the above interleaved one
-template <typename Tcomplex, unsigned int dim>
+template <typename Tcomplex, CallbackType cbtype, unsigned int dim>
 __global__ static void __launch_bounds__(LAUNCH_BOUNDS_R2C_C2R_KERNEL)
     complex2hermitian_planar_kernel(unsigned int lengths0,
                                     unsigned int lengths1,
@@ -284,7 +284,12 @@ __global__ static void __launch_bounds__(LAUNCH_BOUNDS_R2C_C2R_KERNEL)
                                     unsigned int stride_out3,
                                     const Tcomplex* __restrict__ input,
                                     real_type_t<Tcomplex>* __restrict__ outputRe,
-                                    real_type_t<Tcomplex>* __restrict__ outputIm)
+                                    real_type_t<Tcomplex>* __restrict__ outputIm,
+                                    void* __restrict__ load_cb_fn,
+                                    void* __restrict__ load_cb_data,
+                                    uint32_t load_cb_lds_bytes,
+                                    void* __restrict__ store_cb_fn,
+                                    void* __restrict__ store_cb_data)
 {
     size_t idx_0 = blockIdx.x * LAUNCH_BOUNDS_R2C_C2R_KERNEL + threadIdx.x;
 
@@ -313,11 +318,15 @@ __global__ static void __launch_bounds__(LAUNCH_BOUNDS_R2C_C2R_KERNEL)
     // only read and write the first [length0/2+1] elements due to conjugate redundancy
     if(idx_0 < (1 + lengths[0] / 2))
     {
+        // as with the interleaved kernel, don't bother going
+        // through the load callback to read global memory.
+
         const auto inputIdx  = offset_in + idx_0 * stride_in[0];
         const auto outputIdx = offset_out + idx_0 * stride_out[0];
 
-        outputRe[outputIdx] = input[inputIdx].x;
-        outputIm[outputIdx] = input[inputIdx].y;
+        auto store_cb = get_store_cb<Tcomplex, cbtype>(store_cb_fn);
+        store_planar<cbtype>(
+            store_cb, outputRe, outputIm, outputIdx, input[inputIdx], store_cb_data);
     }
 }
 
@@ -368,31 +377,36 @@ __global__ static void __launch_bounds__(LAUNCH_BOUNDS_R2C_C2R_KERNEL)
     else                                           \
         throw std::runtime_error("invalid dimension in complex2hermitian");
 
-#define COMPLEX2HERM_PLANAR_KERNEL_LAUNCH_DIM(TFLOAT, DIM)                 \
-    decltype(&complex2hermitian_planar_kernel<TFLOAT, DIM>) kernel_func;   \
-    if(data->get_callback_type() == CallbackType::USER_LOAD_STORE)         \
-        kernel_func = complex2hermitian_planar_kernel<TFLOAT, DIM>;        \
-    else                                                                   \
-        kernel_func = complex2hermitian_planar_kernel<TFLOAT, DIM>;        \
-    hipLaunchKernelGGL(kernel_func,                                        \
-                       grid,                                               \
-                       threads,                                            \
-                       0,                                                  \
-                       rocfft_stream,                                      \
-                       kern_lengths[0],                                    \
-                       kern_lengths[1],                                    \
-                       kern_lengths[2],                                    \
-                       kern_stride_in[0],                                  \
-                       kern_stride_in[1],                                  \
-                       kern_stride_in[2],                                  \
-                       kern_stride_in[3],                                  \
-                       kern_stride_out[0],                                 \
-                       kern_stride_out[1],                                 \
-                       kern_stride_out[2],                                 \
-                       kern_stride_out[3],                                 \
-                       static_cast<TFLOAT*>(input_buffer),                 \
-                       static_cast<real_type_t<TFLOAT>*>(data->bufOut[0]), \
-                       static_cast<real_type_t<TFLOAT>*>(data->bufOut[1]));
+#define COMPLEX2HERM_PLANAR_KERNEL_LAUNCH_DIM(TFLOAT, DIM)                                         \
+    decltype(&complex2hermitian_planar_kernel<TFLOAT, CallbackType::NONE, DIM>) kernel_func;       \
+    if(data->get_callback_type() == CallbackType::USER_LOAD_STORE)                                 \
+        kernel_func = complex2hermitian_planar_kernel<TFLOAT, CallbackType::USER_LOAD_STORE, DIM>; \
+    else                                                                                           \
+        kernel_func = complex2hermitian_planar_kernel<TFLOAT, CallbackType::NONE, DIM>;            \
+    hipLaunchKernelGGL(kernel_func,                                                                \
+                       grid,                                                                       \
+                       threads,                                                                    \
+                       0,                                                                          \
+                       rocfft_stream,                                                              \
+                       kern_lengths[0],                                                            \
+                       kern_lengths[1],                                                            \
+                       kern_lengths[2],                                                            \
+                       kern_stride_in[0],                                                          \
+                       kern_stride_in[1],                                                          \
+                       kern_stride_in[2],                                                          \
+                       kern_stride_in[3],                                                          \
+                       kern_stride_out[0],                                                         \
+                       kern_stride_out[1],                                                         \
+                       kern_stride_out[2],                                                         \
+                       kern_stride_out[3],                                                         \
+                       static_cast<TFLOAT*>(input_buffer),                                         \
+                       static_cast<real_type_t<TFLOAT>*>(data->bufOut[0]),                         \
+                       static_cast<real_type_t<TFLOAT>*>(data->bufOut[1]),                         \
+                       data->callbacks.load_cb_fn,                                                 \
+                       data->callbacks.load_cb_data,                                               \
+                       data->callbacks.load_cb_lds_bytes,                                          \
+                       data->callbacks.store_cb_fn,                                                \
+                       data->callbacks.store_cb_data);
 
 // assign complex2hermitian_planar function pointer given a float type
 #define COMPLEX2HERM_PLANAR_KERNEL_LAUNCH(TFLOAT)         \
@@ -0,0 +1,448 @@
+// Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Pre- and post-processing kernels for real-to-real (DCT/DST)
+// transforms.  Each transforms along the fastest dimension of the
+// node, with an FFT in between that works on a contiguous temp
+// buffer.  When the FFT is a single runtime-compiled kernel, the
+// same processing is done in that kernel's loads and stores instead
+// (see StockhamKernelR2R), and these kernels are only the fallback
+// for other FFTs.  Writing x for the length N input and y for the
+// output:
+//
+// DCT-I:   FFT the even extension of x, length 2(N-1) real, and
+//          take the real part of the first N outputs.
+// DST-I:   FFT the odd extension of x, length 2(N+1) real, and
+//          take the negated imaginary part of outputs 1 to N.
+// DCT-II:  reorder x as v[n] = x[2n], v[N-1-n] = x[2n+1], do a
+//          length N real FFT V, and y[k] = 2 Re(exp(-i pi k / 2N) V[k]).
+//          Each thread produces y[k] and y[N-k] from V[k].
+// DCT-III: the inverse of DCT-II: build the Hermitian half of V
+//          from x, do a length N C2R FFT, and undo the reordering.
+// DCT-IV:  for even N, do a length N/2 complex FFT of
+//          (x[2n] + i x[N-1-2n]) exp(-i pi (4n+1) / 4N) and
+//          twiddle the result.  Odd N falls back to a zero-padded
+//          length 2N complex FFT of x[n] exp(-i pi n / 2N).
+//
+// DST-II, DST-III and DST-IV are their DCT counterparts with the
+// input or output reversed and every other element negated.
+//
+// Every twiddle angle is in [0, pi/2], so they're computed on the
+// fly with sincospi instead of needing a table.
+
+#include "./kernels/common.h"
+#include "kernel_launch.h"
+#include "rocfft.h"
+#include "rocfft_hip.h"
+
+#include <array>
+
+template <typename Tcomplex>
+__device__ static Tcomplex r2r_cmul(const Tcomplex& a, const Tcomplex& b)
+{
+    return lib_make_vector2<Tcomplex>(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);
+}
+
+static __device__ bool r2r_is_dst(R2RType kind)
+{
+    return kind == R2RType::DST_I || kind == R2RType::DST_II || kind == R2RType::DST_III
+           || kind == R2RType::DST_IV;
+}
+
+// offsets of the current block along the higher dimensions and batch
+template <unsigned int dim>
+__device__ static void r2r_block_offsets(const unsigned int lengths[3],
+                                         const unsigned int stride_in[4],
+                                         const unsigned int stride_out[4],
+                                         size_t&            offset_in,
+                                         size_t&            offset_out)
+{
+    offset_in        = 0;
+    offset_out       = 0;
+    size_t remaining = blockIdx.y;
+    for(unsigned int d = 1; d < dim; ++d)
+    {
+        size_t index_along_d = remaining % lengths[d];
+        remaining            = remaining / lengths[d];
+        offset_in += index_along_d * stride_in[d];
+        offset_out += index_along_d * stride_out[d];
+    }
+    offset_in += blockIdx.z * stride_in[dim];
+    offset_out += blockIdx.z * stride_out[dim];
+}
+
+// reorder (and for types III and IV, twiddle) the real input into
+// the FFT's input.  lengths0 is the length of the real-to-real
+// transform, and count is the number of FFT input elements.
+template <typename Tcomplex, CallbackType cbtype, unsigned int dim>
+__global__ static void __launch_bounds__(LAUNCH_BOUNDS_R2C_C2R_KERNEL)
+    r2r_pre_kernel(R2RType      kind,
+                   unsigned int count,
+                   unsigned int lengths0,
+                   unsigned int lengths1,
+                   unsigned int lengths2,
+                   unsigned int stride_in0,
+                   unsigned int stride_in1,
+                   unsigned int stride_in2,
+                   unsigned int stride_in3,
+                   unsigned int stride_out0,
+                   unsigned int stride_out1,
+                   unsigned int stride_out2,
+                   unsigned int stride_out3,
+                   const real_type_t<Tcomplex>* __restrict__ input,
+                   void* __restrict__ output,
+                   void* __restrict__ load_cb_fn,
+                   void* __restrict__ load_cb_data,
+                   uint32_t load_cb_lds_bytes,
+                   void* __restrict__ store_cb_fn,
+                   void* __restrict__ store_cb_data)
+{
+    typedef real_type_t<Tcomplex> real_t;
+
+    const size_t j = blockIdx.x * blockDim.x + threadIdx.x;
+    if(j >= count)
+        return;
+
+    const unsigned int lengths[3]    = {lengths0, lengths1, lengths2};
+    const unsigned int stride_in[4]  = {stride_in0, stride_in1, stride_in2, stride_in3};
+    const unsigned int stride_out[4] = {stride_out0, stride_out1, stride_out2, stride_out3};
+
+    size_t offset_in, offset_out;
+    r2r_block_offsets<dim>(lengths, stride_in, stride_out, offset_in, offset_out);
+
+    const size_t N   = lengths[0];
+    const bool   dst = r2r_is_dst(kind);
+
+    // pre-processing is the first kernel of the plan, so reads go
+    // through the load callback.  callback is allowed to modify
+    // input, though it's const for us.
+    auto  load_cb = get_load_cb<real_t, cbtype>(load_cb_fn);
+    auto* in      = const_cast<real_t*>(input);
+    auto  load    = [&](size_t n) {
+        return load_cb(in, offset_in + n * stride_in[0], load_cb_data, nullptr);
+    };
+    // types III and IV of DST read the input reversed
+    auto load_rev = [&](size_t n) { return dst ? load(N - 1 - n) : load(n); };
+
+    auto* out_real    = static_cast<real_t*>(output) + offset_out + j * stride_out[0];
+    auto* out_complex = static_cast<Tcomplex*>(output) + offset_out + j * stride_out[0];
+
+    switch(kind)
+    {
+    case R2RType::DCT_I:
+    {
+        const size_t M = 2 * (N - 1);
+        *out_real      = load(j < N ? j : M - j);
+        break;
+    }
+    case R2RType::DST_I:
+    {
+        const size_t M = 2 * (N + 1);
+        if(j == 0 || j == N + 1)
+            *out_real = 0;
+        else
+            *out_real = j <= N ? load(j - 1) : -load(M - j - 1);
+        break;
+    }
+    case R2RType::DCT_II:
+    case R2RType::DST_II:
+    {
+        const size_t src = j < (N + 1) / 2 ? 2 * j : 2 * N - 2 * j - 1;
+        const real_t x   = load(src);
+        *out_real        = dst && (src & 1) ? -x : x;
+        break;
+    }
+    case R2RType::DCT_III:
+    case R2RType::DST_III:
+    {
+        // Hermitian half of the reordered sequence's spectrum
+        const real_t a  = load_rev(j);
+        const real_t b  = j ? load_rev(N - j) : 0;
+        const auto   tw = r2r_twiddle<Tcomplex>(j, 2 * N);
+        // (a - ib) * conj(tw)
+        *out_complex = lib_make_vector2<Tcomplex>(a * tw.x - b * tw.y, -a * tw.y - b * tw.x);
+        break;
+    }
+    case R2RType::DCT_IV:
+    case R2RType::DST_IV:
+    {
+        if(N % 2 == 0)
+        {
+            const auto z = lib_make_vector2<Tcomplex>(load_rev(2 * j), load_rev(N - 1 - 2 * j));
+            *out_complex = r2r_cmul(z, r2r_twiddle<Tcomplex>(4 * j + 1, 4 * N));
+        }
+        else
+        {
+            const real_t x = j < N ? load_rev(j) : 0;
+            const auto   tw = r2r_twiddle<Tcomplex>(j < N ? j : 0, 2 * N);
+            *out_complex    = lib_make_vector2<Tcomplex>(x * tw.x, x * tw.y);
+        }
+        break;
+    }
+    case R2RType::NONE:
+        break;
+    }
+}
+
+// extract the real-to-real output from the FFT's output.  count is
+// the number of threads needed per transform.
+template <typename Tcomplex, CallbackType cbtype, unsigned int dim>
+__global__ static void __launch_bounds__(LAUNCH_BOUNDS_R2C_C2R_KERNEL)
+    r2r_post_kernel(R2RType      kind,
+                    unsigned int count,
+                    unsigned int lengths0,
+                    unsigned int lengths1,
+                    unsigned int lengths2,
+                    unsigned int stride_in0,
+                    unsigned int stride_in1,
+                    unsigned int stride_in2,
+                    unsigned int stride_in3,
+                    unsigned int stride_out0,
+                    unsigned int stride_out1,
+                    unsigned int stride_out2,
+                    unsigned int stride_out3,
+                    const void* __restrict__ input,
+                    real_type_t<Tcomplex>* __restrict__ output,
+                    void* __restrict__ load_cb_fn,
+                    void* __restrict__ load_cb_data,
+                    uint32_t load_cb_lds_bytes,
+                    void* __restrict__ store_cb_fn,
+                    void* __restrict__ store_cb_data)
+{
+    typedef real_type_t<Tcomplex> real_t;
+
+    const size_t k = blockIdx.x * blockDim.x + threadIdx.x;
+    if(k >= count)
+        return;
+
+    const unsigned int lengths[3]    = {lengths0, lengths1, lengths2};
+    const unsigned int stride_in[4]  = {stride_in0, stride_in1, stride_in2, stride_in3};
+    const unsigned int stride_out[4] = {stride_out0, stride_out1, stride_out2, stride_out3};
+
+    size_t offset_in, offset_out;
+    r2r_block_offsets<dim>(lengths, stride_in, stride_out, offset_in, offset_out);
+
+    const size_t N   = lengths[0];
+    const bool   dst = r2r_is_dst(kind);
+
+    const auto* in_real    = static_cast<const real_t*>(input) + offset_in;
+    const auto* in_complex = static_cast<const Tcomplex*>(input) + offset_in;
+
+    // post-processing is the last kernel of the plan, so writes go
+    // through the store callback
+    auto store_cb = get_store_cb<real_t, cbtype>(store_cb_fn);
+    auto store    = [&](size_t n, real_t y) {
+        store_cb(output, offset_out + n * stride_out[0], y, store_cb_data, nullptr);
+    };
+
+    switch(kind)
+    {
+    case R2RType::DCT_I:
+        store(k, in_complex[k * stride_in[0]].x);
+        break;
+    case R2RType::DST_I:
+        store(k, -in_complex[(k + 1) * stride_in[0]].y);
+        break;
+    case R2RType::DCT_II:
+    case R2RType::DST_II:
+    {
+        const Tcomplex V  = in_complex[k * stride_in[0]];
+        const auto     tw = r2r_twiddle<Tcomplex>(k, 2 * N);
+        store(dst ? N - 1 - k : k, 2 * (tw.x * V.x - tw.y * V.y));
+
+        // V[N-k] is conj(V[k]), which gives the output at N-k
+        if(k > 0 && 2 * k != N)
+        {
+            const auto tw_rev = r2r_twiddle<Tcomplex>(N - k, 2 * N);
+            store(dst ? k - 1 : N - k, 2 * (tw_rev.x * V.x + tw_rev.y * V.y));
+        }
+        break;
+    }
+    case R2RType::DCT_III:
+    case R2RType::DST_III:
+    {
+        const real_t v = in_real[k * stride_in[0]];
+        const size_t d = k < (N + 1) / 2 ? 2 * k : 2 * N - 2 * k - 1;
+        store(d, dst && (d & 1) ? -v : v);
+        break;
+    }
+    case R2RType::DCT_IV:
+    case R2RType::DST_IV:
+    {
+        if(N % 2 == 0)
+        {
+            const auto u
+                = r2r_cmul(in_complex[k * stride_in[0]], r2r_twiddle<Tcomplex>(k, N));
+            store(2 * k, 2 * u.x);
+            store(N - 1 - 2 * k, dst ? 2 * u.y : -2 * u.y);
+        }
+        else
+        {
+            const auto u
+                = r2r_cmul(in_complex[k * stride_in[0]], r2r_twiddle<Tcomplex>(2 * k + 1, 4 * N));
+            store(k, dst && (k & 1) ? -2 * u.x : 2 * u.x);
+        }
+        break;
+    }
+    case R2RType::NONE:
+        break;
+    }
+}
+
+// number of threads the post-processing kernel needs per transform
+static size_t r2r_post_count(R2RType kind, size_t N)
+{
+    switch(kind)
+    {
+    case R2RType::DCT_II:
+    case R2RType::DST_II:
+        return N / 2 + 1;
+    case R2RType::DCT_IV:
+    case R2RType::DST_IV:
+        return N % 2 == 0 ? N / 2 : N;
+    default:
+        return N;
+    }
+}
+
+// lengths, strides and launch dimensions shared by the r2r kernels
+struct R2RLaunch
+{
+    size_t                dim;
+    size_t                count;
+    std::array<size_t, 3> lengths{1, 1, 1};
+    std::array<size_t, 4> stride_in{1, 1, 1, 1};
+    std::array<size_t, 4> stride_out{1, 1, 1, 1};
+    dim3                  grid;
+    dim3                  threads{LAUNCH_BOUNDS_R2C_C2R_KERNEL, 1, 1};
+
+    R2RLaunch(const TreeNode& node, size_t count)
+        : dim(node.length.size())
+        , count(count)
+    {
+        if(dim > 3)
+            throw std::runtime_error("Error: dimension larger than 3, which is not handled");
+
+        std::copy(node.length.begin(), node.length.end(), lengths.begin());
+        std::copy(node.inStride.begin(), node.inStride.end(), stride_in.begin());
+        stride_in[dim] = node.iDist;
+        std::copy(node.outStride.begin(), node.outStride.end(), stride_out.begin());
+        stride_out[dim] = node.oDist;
+
+        size_t high_dimension = lengths[1] * lengths[2];
+        size_t blocks         = (count - 1) / LAUNCH_BOUNDS_R2C_C2R_KERNEL + 1;
+
+        grid = dim3(blocks, high_dimension, node.batch);
+    }
+};
+
+// pick the kernel instantiation for the launch's dimension
+#define R2R_KERNEL_FOR_DIM(KERNEL, ...)                                      \
+    (launch.dim == 1 ? KERNEL<__VA_ARGS__, 1>                                \
+                     : launch.dim == 2 ? KERNEL<__VA_ARGS__, 2> : KERNEL<__VA_ARGS__, 3>)
+
+// pick the kernel instantiation for the launch's dimension and callback type
+#define R2R_KERNEL_FOR_DIM_CB(KERNEL, TFLOAT)                                 \
+    (data.get_callback_type() == CallbackType::USER_LOAD_STORE                \
+         ? R2R_KERNEL_FOR_DIM(KERNEL, TFLOAT, CallbackType::USER_LOAD_STORE) \
+         : R2R_KERNEL_FOR_DIM(KERNEL, TFLOAT, CallbackType::NONE))
+
+template <typename Tkernel, typename Tin, typename Tout>
+static void r2r_kernel_launch(Tkernel             kernel_func,
+                              const R2RLaunch&    launch,
+                              const DeviceCallIn& data,
+                              Tin                 input,
+                              Tout                output)
+{
+    hipLaunchKernelGGL(kernel_func,
+                       launch.grid,
+                       launch.threads,
+                       0,
+                       data.rocfft_stream,
+                       data.node->r2rType,
+                       launch.count,
+                       launch.lengths[0],
+                       launch.lengths[1],
+                       launch.lengths[2],
+                       launch.stride_in[0],
+                       launch.stride_in[1],
+                       launch.stride_in[2],
+                       launch.stride_in[3],
+                       launch.stride_out[0],
+                       launch.stride_out[1],
+                       launch.stride_out[2],
+                       launch.stride_out[3],
+                       input,
+                       output,
+                       data.callbacks.load_cb_fn,
+                       data.callbacks.load_cb_data,
+                       data.callbacks.load_cb_lds_bytes,
+                       data.callbacks.store_cb_fn,
+                       data.callbacks.store_cb_data);
+}
+
+template <typename Tcomplex>
+static void r2r_pre_launch(const DeviceCallIn& data, const R2RLaunch& launch)
+{
+    r2r_kernel_launch(R2R_KERNEL_FOR_DIM_CB(r2r_pre_kernel, Tcomplex),
+                      launch,
+                      data,
+                      static_cast<const real_type_t<Tcomplex>*>(data.bufIn[0]),
+                      data.bufOut[0]);
+}
+
+template <typename Tcomplex>
+static void r2r_post_launch(const DeviceCallIn& data, const R2RLaunch& launch)
+{
+    r2r_kernel_launch(R2R_KERNEL_FOR_DIM_CB(r2r_post_kernel, Tcomplex),
+                      launch,
+                      data,
+                      static_cast<const void*>(data.bufIn[0]),
+                      static_cast<real_type_t<Tcomplex>*>(data.bufOut[0]));
+}
+
+/// \brief auxiliary function
+///   reorder and twiddle real input for the FFT of a DCT/DST
+ROCFFT_DEVICE_EXPORT void r2r_pre(const void* data_p, void* back_p)
+{
+    auto data = static_cast<const DeviceCallIn*>(data_p);
+
+    // output length is the number of FFT input elements
+    R2RLaunch launch(*data->node, data->node->outputLength[0]);
+
+    if(data->node->precision == rocfft_precision_single)
+        r2r_pre_launch<float2>(*data, launch);
+    else
+        r2r_pre_launch<double2>(*data, launch);
+}
+
+/// \brief auxiliary function
+///   extract the real output of a DCT/DST from its FFT
+ROCFFT_DEVICE_EXPORT void r2r_post(const void* data_p, void* back_p)
+{
+    auto data = static_cast<const DeviceCallIn*>(data_p);
+
+    R2RLaunch launch(*data->node, r2r_post_count(data->node->r2rType, data->node->length[0]));
+
+    if(data->node->precision == rocfft_precision_single)
+        r2r_post_launch<float2>(*data, launch);
+    else
+        r2r_post_launch<double2>(*data, launch);
+}
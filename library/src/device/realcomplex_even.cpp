@@ -131,7 +131,7 @@ __global__ static void __launch_bounds__(LAUNCH_BOUNDS_R2C_C2R_KERNEL)
     }
 }
 
-template <typename Tcomplex, bool Ndiv4>
+template <typename Tcomplex, bool Ndiv4, CallbackType cbtype>
 __device__ inline void post_process_planar(const size_t           idx_p,
                                            const size_t           idx_q,
                                            const size_t           half_N,
@@ -139,19 +139,34 @@ __device__ inline void post_process_planar(const size_t           idx_p,
                                            const Tcomplex*        input,
                                            real_type_t<Tcomplex>* outputRe,
                                            real_type_t<Tcomplex>* outputIm,
-                                           const Tcomplex*        twiddles)
+                                           size_t                 output_base,
+                                           const Tcomplex*        twiddles,
+                                           void* __restrict__ store_cb_fn,
+                                           void* __restrict__ store_cb_data)
 {
+    // post process can't be the first kernel, so don't bother
+    // going through the load cb to read global memory
+    auto store_cb = get_store_cb<Tcomplex, cbtype>(store_cb_fn);
+
+    Tcomplex outval;
+
     if(idx_p == 0)
     {
-        outputRe[half_N] = input[0].x - input[0].y;
-        outputIm[half_N] = 0;
-        outputRe[0]      = input[0].x + input[0].y;
-        outputIm[0]      = 0;
+        outval.x = input[0].x - input[0].y;
+        outval.y = 0;
+        store_planar<cbtype>(
+            store_cb, outputRe, outputIm, output_base + half_N, outval, store_cb_data);
+
+        outval.x = input[0].x + input[0].y;
+        outval.y = 0;
+        store_planar<cbtype>(store_cb, outputRe, outputIm, output_base, outval, store_cb_data);
 
         if(Ndiv4)
         {
-            outputRe[quarter_N] = input[quarter_N].x;
-            outputIm[quarter_N] = -input[quarter_N].y;
+            outval.x = input[quarter_N].x;
+            outval.y = -input[quarter_N].y;
+            store_planar<cbtype>(
+                store_cb, outputRe, outputIm, output_base + quarter_N, outval, store_cb_data);
         }
     }
     else
@@ -164,16 +179,20 @@ __device__ inline void post_process_planar(const size_t           idx_p,
         const Tcomplex twd_p = twiddles[idx_p];
         // NB: twd_q = -conj(twd_p) = (-twd_p.x, twd_p.y);
 
-        outputRe[idx_p] = u.x + v.x * twd_p.y + u.y * twd_p.x;
-        outputIm[idx_p] = v.y + u.y * twd_p.y - v.x * twd_p.x;
+        outval.x = u.x + v.x * twd_p.y + u.y * twd_p.x;
+        outval.y = v.y + u.y * twd_p.y - v.x * twd_p.x;
+        store_planar<cbtype>(
+            store_cb, outputRe, outputIm, output_base + idx_p, outval, store_cb_data);
 
-        outputRe[idx_q] = u.x - v.x * twd_p.y - u.y * twd_p.x;
-        outputIm[idx_q] = -v.y + u.y * twd_p.y - v.x * twd_p.x;
+        outval.x = u.x - v.x * twd_p.y - u.y * twd_p.x;
+        outval.y = -v.y + u.y * twd_p.y - v.x * twd_p.x;
+        store_planar<cbtype>(
+            store_cb, outputRe, outputIm, output_base + idx_q, outval, store_cb_data);
     }
 }
 
 // Planar version of r2c post-process kernel, 1D
-template <typename Tcomplex, bool Ndiv4>
+template <typename Tcomplex, bool Ndiv4, CallbackType cbtype>
 __global__ static void __launch_bounds__(LAUNCH_BOUNDS_R2C_C2R_KERNEL)
     real_post_process_kernel_planar_1D(const size_t half_N,
                                        const void*  input0,
@@ -181,7 +200,12 @@ __global__ static void __launch_bounds__(LAUNCH_BOUNDS_R2C_C2R_KERNEL)
                                        void*        output0,
                                        void*        output1,
                                        const size_t odist,
-                                       const void*  twiddles0)
+                                       const void*  twiddles0,
+                                       void* __restrict__ load_cb_fn,
+                                       void* __restrict__ load_cb_data,
+                                       uint32_t load_cb_lds_bytes,
+                                       void* __restrict__ store_cb_fn,
+                                       void* __restrict__ store_cb_data)
 {
     // blockIdx.y gives the multi-dimensional offset
     // blockIdx.z gives the batch offset
@@ -194,16 +218,21 @@ __global__ static void __launch_bounds__(LAUNCH_BOUNDS_R2C_C2R_KERNEL)
 
     if(idx_p < quarter_N)
     {
-        // blockIdx.y gives the multi-dimensional offset
         // blockIdx.z gives the batch offset
-        // clang format off
-        const auto input    = (Tcomplex*)(input0) + blockIdx.z * idist;
-        auto       outputRe = (real_type_t<Tcomplex>*)(output0) + blockIdx.z * odist;
-        auto       outputIm = (real_type_t<Tcomplex>*)(output1) + blockIdx.z * odist;
-        // clang format on
+        const auto input         = (Tcomplex*)(input0) + blockIdx.z * idist;
+        auto       output_offset = blockIdx.z * odist;
 
-        post_process_planar<Tcomplex, Ndiv4>(
-            idx_p, idx_q, half_N, quarter_N, input, outputRe, outputIm, twiddles);
+        post_process_planar<Tcomplex, Ndiv4, cbtype>(idx_p,
+                                                     idx_q,
+                                                     half_N,
+                                                     quarter_N,
+                                                     input,
+                                                     static_cast<real_type_t<Tcomplex>*>(output0),
+                                                     static_cast<real_type_t<Tcomplex>*>(output1),
+                                                     output_offset,
+                                                     twiddles,
+                                                     store_cb_fn,
+                                                     store_cb_data);
     }
 }
 
@@ -234,15 +263,24 @@ __global__ static void __launch_bounds__(LAUNCH_BOUNDS_R2C_C2R_KERNEL)
         // blockIdx.y gives the multi-dimensional offset
         // blockIdx.z gives the batch offset
         // clang format off
-        const auto input = (Tcomplex*)(input0) + blockIdx.y * idist1D + blockIdx.z * idist;
-        auto       outputRe
-            = (real_type_t<Tcomplex>*)(output0) + blockIdx.y * odist1D + blockIdx.z * odist;
-        auto outputIm
-            = (real_type_t<Tcomplex>*)(output1) + blockIdx.y * odist1D + blockIdx.z * odist;
+        const auto input       = (Tcomplex*)(input0) + blockIdx.y * idist1D + blockIdx.z * idist;
+        size_t     output_base = blockIdx.y * odist1D + blockIdx.z * odist;
         // clang format on
 
-        post_process_planar<Tcomplex, Ndiv4>(
-            idx_p, idx_q, half_N, quarter_N, input, outputRe, outputIm, twiddles);
+        // 2D/3D post-process is always in the middle of the
+        // transform and won't run load/store callbacks
+        post_process_planar<Tcomplex, Ndiv4, CallbackType::NONE>(
+            idx_p,
+            idx_q,
+            half_N,
+            quarter_N,
+            input,
+            static_cast<real_type_t<Tcomplex>*>(output0),
+            static_cast<real_type_t<Tcomplex>*>(output1),
+            output_base,
+            twiddles,
+            nullptr,
+            nullptr);
     }
 }
 
@@ -292,17 +330,33 @@ ROCFFT_DEVICE_EXPORT void r2c_1d_post(const void* data_p, void*)
                                   &(real_post_process_kernel_interleaved<double2, false>));
 
     // Map to planar 1D kernels:
-    std::map<std::tuple<rocfft_precision, bool>,
-             decltype(&real_post_process_kernel_planar_1D<float2, true>)>
+    std::map<std::tuple<rocfft_precision, bool, CallbackType>,
+             decltype(&real_post_process_kernel_planar_1D<float2, true, CallbackType::NONE>)>
         kernelmap_planar_1D;
-    kernelmap_planar_1D.emplace(std::make_tuple(rocfft_precision_single, true),
-                                &(real_post_process_kernel_planar_1D<float2, true>));
-    kernelmap_planar_1D.emplace(std::make_tuple(rocfft_precision_single, false),
-                                &(real_post_process_kernel_planar_1D<float2, false>));
-    kernelmap_planar_1D.emplace(std::make_tuple(rocfft_precision_double, true),
-                                &(real_post_process_kernel_planar_1D<double2, true>));
-    kernelmap_planar_1D.emplace(std::make_tuple(rocfft_precision_double, false),
-                                &(real_post_process_kernel_planar_1D<double2, false>));
+    kernelmap_planar_1D.emplace(
+        std::make_tuple(rocfft_precision_single, true, CallbackType::NONE),
+        &(real_post_process_kernel_planar_1D<float2, true, CallbackType::NONE>));
+    kernelmap_planar_1D.emplace(
+        std::make_tuple(rocfft_precision_single, false, CallbackType::NONE),
+        &(real_post_process_kernel_planar_1D<float2, false, CallbackType::NONE>));
+    kernelmap_planar_1D.emplace(
+        std::make_tuple(rocfft_precision_double, true, CallbackType::NONE),
+        &(real_post_process_kernel_planar_1D<double2, true, CallbackType::NONE>));
+    kernelmap_planar_1D.emplace(
+        std::make_tuple(rocfft_precision_double, false, CallbackType::NONE),
+        &(real_post_process_kernel_planar_1D<double2, false, CallbackType::NONE>));
+    kernelmap_planar_1D.emplace(
+        std::make_tuple(rocfft_precision_single, true, CallbackType::USER_LOAD_STORE),
+        &(real_post_process_kernel_planar_1D<float2, true, CallbackType::USER_LOAD_STORE>));
+    kernelmap_planar_1D.emplace(
+        std::make_tuple(rocfft_precision_single, false, CallbackType::USER_LOAD_STORE),
+        &(real_post_process_kernel_planar_1D<float2, false, CallbackType::USER_LOAD_STORE>));
+    kernelmap_planar_1D.emplace(
+        std::make_tuple(rocfft_precision_double, true, CallbackType::USER_LOAD_STORE),
+        &(real_post_process_kernel_planar_1D<double2, true, CallbackType::USER_LOAD_STORE>));
+    kernelmap_planar_1D.emplace(
+        std::make_tuple(rocfft_precision_double, false, CallbackType::USER_LOAD_STORE),
+        &(real_post_process_kernel_planar_1D<double2, false, CallbackType::USER_LOAD_STORE>));
 
     // Map to planar kernels:
     std::map<std::tuple<rocfft_precision, bool>,
@@ -376,7 +430,7 @@ ROCFFT_DEVICE_EXPORT void r2c_1d_post(const void* data_p, void*)
         }
         else
         {
-            hipLaunchKernelGGL(kernelmap_planar_1D.at(params),
+            hipLaunchKernelGGL(kernelmap_planar_1D.at(params_cb),
                                grid,
                                threads,
                                0,
@@ -387,7 +441,12 @@ ROCFFT_DEVICE_EXPORT void r2c_1d_post(const void* data_p, void*)
                                bufOut0,
                                bufOut1,
                                odist,
-                               data->node->twiddles);
+                               data->node->twiddles,
+                               data->callbacks.load_cb_fn,
+                               data->callbacks.load_cb_data,
+                               data->callbacks.load_cb_lds_bytes,
+                               data->callbacks.store_cb_fn,
+                               data->callbacks.store_cb_data);
         }
     }
     else
@@ -510,7 +569,7 @@ __global__ static void __launch_bounds__(LAUNCH_BOUNDS_R2C_C2R_KERNEL)
 }
 
 // Planar version of c2r pre-process kernel
-template <typename Tcomplex, bool Ndiv4>
+template <typename Tcomplex, bool Ndiv4, CallbackType cbtype>
 __global__ static void __launch_bounds__(LAUNCH_BOUNDS_R2C_C2R_KERNEL)
     real_pre_process_kernel_planar(const size_t      half_N,
                                    const size_t      idist1D,
@@ -520,7 +579,12 @@ __global__ static void __launch_bounds__(LAUNCH_BOUNDS_R2C_C2R_KERNEL)
                                    const size_t      idist,
                                    void*             output0,
                                    const size_t      odist,
-                                   const void* const twiddles0)
+                                   const void* const twiddles0,
+                                   void* __restrict__ load_cb_fn,
+                                   void* __restrict__ load_cb_data,
+                                   uint32_t load_cb_lds_bytes,
+                                   void* __restrict__ store_cb_fn,
+                                   void* __restrict__ store_cb_data)
 {
     const size_t idx_p = blockIdx.x * blockDim.x + threadIdx.x;
     const size_t idx_q = half_N - idx_p;
@@ -530,43 +594,42 @@ __global__ static void __launch_bounds__(LAUNCH_BOUNDS_R2C_C2R_KERNEL)
 
     if(idx_p < quarter_N)
     {
+        // as with the interleaved kernel, only the load callback
+        // can apply here
+        auto load_cb = get_load_cb<Tcomplex, cbtype>(load_cb_fn);
+
         // blockIdx.y gives the multi-dimensional offset, stride is [i/o]dist1D.
         // blockIdx.z gives the batch offset, stride is [i/o]dist.
         // clang format off
-        const auto inputRe
-            = (real_type_t<Tcomplex>*)(input0) + idist1D * blockIdx.y + idist * blockIdx.z;
-        const auto inputIm
-            = (real_type_t<Tcomplex>*)(input1) + idist1D * blockIdx.y + idist * blockIdx.z;
-        auto output = (Tcomplex*)(output0) + odist1D * blockIdx.y + odist * blockIdx.z;
+        const auto inputIdx = idist1D * blockIdx.y + idist * blockIdx.z;
+        auto       inputRe  = (real_type_t<Tcomplex>*)(input0);
+        auto       inputIm  = (real_type_t<Tcomplex>*)(input1);
+        auto       output   = (Tcomplex*)(output0) + odist1D * blockIdx.y + odist * blockIdx.z;
         // clang format on
 
+        const Tcomplex p = load_planar<cbtype>(
+            load_cb, inputRe, inputIm, inputIdx + idx_p, load_cb_data);
+        const Tcomplex q = load_planar<cbtype>(
+            load_cb, inputRe, inputIm, inputIdx + idx_q, load_cb_data);
+
         if(idx_p == 0)
         {
             // NB: multi-dimensional transforms may have non-zero
             // imaginary part at index 0 or at the Nyquist frequency.
 
-            Tcomplex p, q;
-            p.x             = inputRe[idx_p];
-            p.y             = inputIm[idx_p];
-            q.x             = inputRe[idx_q];
-            q.y             = inputIm[idx_q];
             output[idx_p].x = p.x - p.y + q.x + q.y;
             output[idx_p].y = p.x + p.y - q.x + q.y;
 
             if(Ndiv4)
             {
-                output[quarter_N].x = 2.0 * inputRe[quarter_N];
-                output[quarter_N].y = -2.0 * inputIm[quarter_N];
+                auto quarter_elem = load_planar<cbtype>(
+                    load_cb, inputRe, inputIm, inputIdx + quarter_N, load_cb_data);
+                output[quarter_N].x = 2.0 * quarter_elem.x;
+                output[quarter_N].y = -2.0 * quarter_elem.y;
             }
         }
         else
         {
-            Tcomplex p, q;
-            p.x = inputRe[idx_p];
-            p.y = inputIm[idx_p];
-            q.x = inputRe[idx_q];
-            q.y = inputIm[idx_q];
-
             const Tcomplex u = p + q;
             const Tcomplex v = p - q;
 
@@ -615,17 +678,33 @@ ROCFFT_DEVICE_EXPORT void c2r_1d_pre(const void* data_p, void*)
         &(real_pre_process_kernel<double2, false, CallbackType::USER_LOAD_STORE>));
 
     // map to planar kernels
-    std::map<std::tuple<rocfft_precision, bool>,
-             decltype(&real_pre_process_kernel_planar<double2, true>)>
+    std::map<std::tuple<rocfft_precision, bool, CallbackType>,
+             decltype(&real_pre_process_kernel_planar<double2, true, CallbackType::NONE>)>
         kernelmap_planar;
-    kernelmap_planar.emplace(std::make_tuple(rocfft_precision_single, true),
-                             &(real_pre_process_kernel_planar<float2, true>));
-    kernelmap_planar.emplace(std::make_tuple(rocfft_precision_single, false),
-                             &(real_pre_process_kernel_planar<float2, false>));
-    kernelmap_planar.emplace(std::make_tuple(rocfft_precision_double, true),
-                             &(real_pre_process_kernel_planar<double2, true>));
-    kernelmap_planar.emplace(std::make_tuple(rocfft_precision_double, false),
-                             &(real_pre_process_kernel_planar<double2, false>));
+    kernelmap_planar.emplace(
+        std::make_tuple(rocfft_precision_single, true, CallbackType::NONE),
+        &(real_pre_process_kernel_planar<float2, true, CallbackType::NONE>));
+    kernelmap_planar.emplace(
+        std::make_tuple(rocfft_precision_single, false, CallbackType::NONE),
+        &(real_pre_process_kernel_planar<float2, false, CallbackType::NONE>));
+    kernelmap_planar.emplace(
+        std::make_tuple(rocfft_precision_double, true, CallbackType::NONE),
+        &(real_pre_process_kernel_planar<double2, true, CallbackType::NONE>));
+    kernelmap_planar.emplace(
+        std::make_tuple(rocfft_precision_double, false, CallbackType::NONE),
+        &(real_pre_process_kernel_planar<double2, false, CallbackType::NONE>));
+    kernelmap_planar.emplace(
+        std::make_tuple(rocfft_precision_single, true, CallbackType::USER_LOAD_STORE),
+        &(real_pre_process_kernel_planar<float2, true, CallbackType::USER_LOAD_STORE>));
+    kernelmap_planar.emplace(
+        std::make_tuple(rocfft_precision_single, false, CallbackType::USER_LOAD_STORE),
+        &(real_pre_process_kernel_planar<float2, false, CallbackType::USER_LOAD_STORE>));
+    kernelmap_planar.emplace(
+        std::make_tuple(rocfft_precision_double, true, CallbackType::USER_LOAD_STORE),
+        &(real_pre_process_kernel_planar<double2, true, CallbackType::USER_LOAD_STORE>));
+    kernelmap_planar.emplace(
+        std::make_tuple(rocfft_precision_double, false, CallbackType::USER_LOAD_STORE),
+        &(real_pre_process_kernel_planar<double2, false, CallbackType::USER_LOAD_STORE>));
 
     auto data = static_cast<const DeviceCallIn*>(data_p);
 
@@ -652,10 +731,8 @@ ROCFFT_DEVICE_EXPORT void c2r_1d_pre(const void* data_p, void*)
     const size_t ostride = high_dimension > 1 ? data->node->outStride[1] : 0;
 
     const bool                                             Ndiv4 = half_N % 2 == 0;
-    const std::tuple<rocfft_precision, bool, CallbackType> params_interleaved
+    const std::tuple<rocfft_precision, bool, CallbackType> params
         = std::make_tuple(data->node->precision, Ndiv4, data->get_callback_type());
-    const std::tuple<rocfft_precision, bool> params_planar
-        = std::make_tuple(data->node->precision, Ndiv4);
 
     const size_t block_size = LAUNCH_BOUNDS_R2C_C2R_KERNEL;
     const size_t blocks     = ((half_N + 1) / 2 + block_size - 1) / block_size;
@@ -669,7 +746,7 @@ ROCFFT_DEVICE_EXPORT void c2r_1d_pre(const void* data_p, void*)
 
     if(is_complex_interleaved(data->node->inArrayType))
     {
-        hipLaunchKernelGGL(kernelmap_interleaved.at(params_interleaved),
+        hipLaunchKernelGGL(kernelmap_interleaved.at(params),
                            grid,
                            threads,
                            0,
@@ -690,7 +767,7 @@ ROCFFT_DEVICE_EXPORT void c2r_1d_pre(const void* data_p, void*)
     }
     else
     {
-        hipLaunchKernelGGL(kernelmap_planar.at(params_planar),
+        hipLaunchKernelGGL(kernelmap_planar.at(params),
                            grid,
                            threads,
                            0,
@@ -703,6 +780,11 @@ ROCFFT_DEVICE_EXPORT void c2r_1d_pre(const void* data_p, void*)
                            idist,
                            bufOut0,
                            odist,
-                           data->node->twiddles);
+                           data->node->twiddles,
+                           data->callbacks.load_cb_fn,
+                           data->callbacks.load_cb_data,
+                           data->callbacks.load_cb_lds_bytes,
+                           data->callbacks.store_cb_fn,
+                           data->callbacks.store_cb_data);
     }
 }
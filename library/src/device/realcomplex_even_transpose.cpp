@@ -251,12 +251,20 @@ ROCFFT_DEVICE_EXPORT void r2c_1d_post_transpose(const void* data_p, void*)
         if(is_complex_planar(data->node->outArrayType))
         {
             hipLaunchKernelGGL(
-                HIP_KERNEL_NAME(real_post_process_kernel_transpose<float2,
-                                                                   interleaved<float2>,
-                                                                   planar<float2>,
-                                                                   DIM_X,
-                                                                   DIM_Y,
-                                                                   CallbackType::NONE>),
+                cbtype == CallbackType::USER_LOAD_STORE
+                    ? HIP_KERNEL_NAME(
+                        real_post_process_kernel_transpose<float2,
+                                                           interleaved<float2>,
+                                                           planar<float2>,
+                                                           DIM_X,
+                                                           DIM_Y,
+                                                           CallbackType::USER_LOAD_STORE>)
+                    : HIP_KERNEL_NAME(real_post_process_kernel_transpose<float2,
+                                                                         interleaved<float2>,
+                                                                         planar<float2>,
+                                                                         DIM_X,
+                                                                         DIM_Y,
+                                                                         CallbackType::NONE>),
                 grid,
                 threads,
                 0,
@@ -318,12 +326,20 @@ ROCFFT_DEVICE_EXPORT void r2c_1d_post_transpose(const void* data_p, void*)
         if(is_complex_planar(data->node->outArrayType))
         {
             hipLaunchKernelGGL(
-                HIP_KERNEL_NAME(real_post_process_kernel_transpose<double2,
-                                                                   interleaved<double2>,
-                                                                   planar<double2>,
-                                                                   DIM_X,
-                                                                   DIM_Y,
-                                                                   CallbackType::NONE>),
+                cbtype == CallbackType::USER_LOAD_STORE
+                    ? HIP_KERNEL_NAME(
+                        real_post_process_kernel_transpose<double2,
+                                                           interleaved<double2>,
+                                                           planar<double2>,
+                                                           DIM_X,
+                                                           DIM_Y,
+                                                           CallbackType::USER_LOAD_STORE>)
+                    : HIP_KERNEL_NAME(real_post_process_kernel_transpose<double2,
+                                                                         interleaved<double2>,
+                                                                         planar<double2>,
+                                                                         DIM_X,
+                                                                         DIM_Y,
+                                                                         CallbackType::NONE>),
                 grid,
                 threads,
                 0,
@@ -612,12 +628,20 @@ ROCFFT_DEVICE_EXPORT void transpose_c2r_1d_pre(const void* data_p, void*)
         if(is_complex_planar(data->node->inArrayType))
         {
             hipLaunchKernelGGL(
-                HIP_KERNEL_NAME(transpose_real_pre_process_kernel<float2,
-                                                                  planar<float2>,
-                                                                  interleaved<float2>,
-                                                                  DIM_X,
-                                                                  DIM_Y,
-                                                                  CallbackType::NONE>),
+                cbtype == CallbackType::USER_LOAD_STORE
+                    ? HIP_KERNEL_NAME(
+                        transpose_real_pre_process_kernel<float2,
+                                                          planar<float2>,
+                                                          interleaved<float2>,
+                                                          DIM_X,
+                                                          DIM_Y,
+                                                          CallbackType::USER_LOAD_STORE>)
+                    : HIP_KERNEL_NAME(transpose_real_pre_process_kernel<float2,
+                                                                        planar<float2>,
+                                                                        interleaved<float2>,
+                                                                        DIM_X,
+                                                                        DIM_Y,
+                                                                        CallbackType::NONE>),
                 grid,
                 threads,
                 0,
@@ -679,12 +703,20 @@ ROCFFT_DEVICE_EXPORT void transpose_c2r_1d_pre(const void* data_p, void*)
         if(is_complex_planar(data->node->inArrayType))
         {
             hipLaunchKernelGGL(
-                HIP_KERNEL_NAME(transpose_real_pre_process_kernel<double2,
-                                                                  planar<double2>,
-                                                                  interleaved<double2>,
-                                                                  DIM_X,
-                                                                  DIM_Y,
-                                                                  CallbackType::NONE>),
+                cbtype == CallbackType::USER_LOAD_STORE
+                    ? HIP_KERNEL_NAME(
+                        transpose_real_pre_process_kernel<double2,
+                                                          planar<double2>,
+                                                          interleaved<double2>,
+                                                          DIM_X,
+                                                          DIM_Y,
+                                                          CallbackType::USER_LOAD_STORE>)
+                    : HIP_KERNEL_NAME(transpose_real_pre_process_kernel<double2,
+                                                                        planar<double2>,
+                                                                        interleaved<double2>,
+                                                                        DIM_X,
+                                                                        DIM_Y,
+                                                                        CallbackType::NONE>),
                 grid,
                 threads,
                 0,
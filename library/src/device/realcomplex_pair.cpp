@@ -0,0 +1,690 @@
+// Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Kernels for doing two real transforms with one complex transform.
+//
+// For R2C, batch elements 2p and 2p+1 are packed as the real and
+// imaginary parts of complex batch element p.  After the complex
+// FFT Z, the two hermitian outputs are separated with
+//
+//   X[k] = (Z[k] + conj(Z[-k])) / 2
+//   Y[k] = -i (Z[k] - conj(Z[-k])) / 2
+//
+// where -k is negated along every dimension.
+//
+// For C2R, the two full spectra are rebuilt from their hermitian
+// halves and packed as Z = X + iY, so that the real and imaginary
+// parts of the inverse complex FFT are the two real outputs.
+//
+// With an odd batch, the last complex batch element only carries one
+// real sequence and the other half is zero.
+
+#include "./kernels/common.h"
+#include "kernel_launch.h"
+#include "rocfft.h"
+#include "rocfft_hip.h"
+
+#include <array>
+
+// offset of the current block's index along the higher dimensions,
+// optionally negated (modulo the length) along each of them
+template <unsigned int dim>
+__device__ static size_t pair_higher_offset(const unsigned int lengths[3],
+                                            const unsigned int stride[4],
+                                            bool               negate)
+{
+    size_t offset    = 0;
+    size_t remaining = blockIdx.y;
+    for(unsigned int d = 1; d < dim; ++d)
+    {
+        size_t index_along_d = remaining % lengths[d];
+        remaining            = remaining / lengths[d];
+        if(negate && index_along_d)
+            index_along_d = lengths[d] - index_along_d;
+        offset += index_along_d * stride[d];
+    }
+    return offset;
+}
+
+// pack two real inputs into one complex output
+template <typename Tcomplex, CallbackType cbtype, unsigned int dim>
+__global__ static void __launch_bounds__(LAUNCH_BOUNDS_R2C_C2R_KERNEL)
+    real2complex_pair_kernel(unsigned int lengths0,
+                             unsigned int lengths1,
+                             unsigned int lengths2,
+                             unsigned int batch,
+                             unsigned int stride_in0,
+                             unsigned int stride_in1,
+                             unsigned int stride_in2,
+                             unsigned int stride_in3,
+                             unsigned int stride_out0,
+                             unsigned int stride_out1,
+                             unsigned int stride_out2,
+                             unsigned int stride_out3,
+                             const real_type_t<Tcomplex>* __restrict__ input,
+                             Tcomplex* __restrict__ output,
+                             void* __restrict__ load_cb_fn,
+                             void* __restrict__ load_cb_data,
+                             uint32_t load_cb_lds_bytes,
+                             void* __restrict__ store_cb_fn,
+                             void* __restrict__ store_cb_data)
+{
+    const size_t idx_0 = blockIdx.x * blockDim.x + threadIdx.x;
+
+    const unsigned int lengths[3]    = {lengths0, lengths1, lengths2};
+    const unsigned int stride_in[4]  = {stride_in0, stride_in1, stride_in2, stride_in3};
+    const unsigned int stride_out[4] = {stride_out0, stride_out1, stride_out2, stride_out3};
+
+    if(idx_0 >= lengths[0])
+        return;
+
+    const size_t first  = 2 * blockIdx.z;
+    const size_t second = first + 1;
+
+    const size_t inputIdx
+        = pair_higher_offset<dim>(lengths, stride_in, false) + idx_0 * stride_in[0];
+    const size_t outputIdx = pair_higher_offset<dim>(lengths, stride_out, false)
+                             + idx_0 * stride_out[0] + blockIdx.z * stride_out[dim];
+
+    // pack is the first kernel of the plan, so reads go through
+    // the load callback.  callback is allowed to modify input,
+    // though it's const for us.
+    auto  load_cb = get_load_cb<real_type_t<Tcomplex>, cbtype>(load_cb_fn);
+    auto* in      = const_cast<real_type_t<Tcomplex>*>(input);
+
+    Tcomplex z;
+    z.x = load_cb(in, inputIdx + first * stride_in[dim], load_cb_data, nullptr);
+    z.y = second < batch ? load_cb(in, inputIdx + second * stride_in[dim], load_cb_data, nullptr)
+                         : 0.0;
+    output[outputIdx] = z;
+}
+
+// separate the transforms of two real inputs from one complex
+// transform, returning the hermitian halves in x and y
+template <typename Tcomplex>
+__device__ static void complex2hermitian_pair_split(const Tcomplex* __restrict__ input,
+                                                    size_t    inputIdx,
+                                                    size_t    inputNegIdx,
+                                                    Tcomplex& x,
+                                                    Tcomplex& y)
+{
+    const real_type_t<Tcomplex> half = 0.5;
+
+    const Tcomplex pos = input[inputIdx];
+    const Tcomplex neg = input[inputNegIdx];
+
+    x.x = (pos.x + neg.x) * half;
+    x.y = (pos.y - neg.y) * half;
+    y.x = (pos.y + neg.y) * half;
+    y.y = (neg.x - pos.x) * half;
+}
+
+// compute indexes shared by the interleaved and planar unpack kernels
+template <unsigned int dim>
+__device__ static void complex2hermitian_pair_indexes(size_t             idx_0,
+                                                      const unsigned int lengths[3],
+                                                      const unsigned int stride_in[4],
+                                                      const unsigned int stride_out[4],
+                                                      size_t&            inputIdx,
+                                                      size_t&            inputNegIdx,
+                                                      size_t&            outputIdx)
+{
+    const size_t neg_0 = idx_0 ? lengths[0] - idx_0 : 0;
+
+    inputIdx = pair_higher_offset<dim>(lengths, stride_in, false) + idx_0 * stride_in[0]
+               + blockIdx.z * stride_in[dim];
+    inputNegIdx = pair_higher_offset<dim>(lengths, stride_in, true) + neg_0 * stride_in[0]
+                  + blockIdx.z * stride_in[dim];
+    outputIdx = pair_higher_offset<dim>(lengths, stride_out, false) + idx_0 * stride_out[0];
+}
+
+// unpack one complex transform into two hermitian outputs
+template <typename Tcomplex, CallbackType cbtype, unsigned int dim>
+__global__ static void __launch_bounds__(LAUNCH_BOUNDS_R2C_C2R_KERNEL)
+    complex2hermitian_pair_kernel(unsigned int lengths0,
+                                  unsigned int lengths1,
+                                  unsigned int lengths2,
+                                  unsigned int batch,
+                                  unsigned int stride_in0,
+                                  unsigned int stride_in1,
+                                  unsigned int stride_in2,
+                                  unsigned int stride_in3,
+                                  unsigned int stride_out0,
+                                  unsigned int stride_out1,
+                                  unsigned int stride_out2,
+                                  unsigned int stride_out3,
+                                  const Tcomplex* __restrict__ input,
+                                  Tcomplex* __restrict__ output,
+                                  void* __restrict__ load_cb_fn,
+                                  void* __restrict__ load_cb_data,
+                                  uint32_t load_cb_lds_bytes,
+                                  void* __restrict__ store_cb_fn,
+                                  void* __restrict__ store_cb_data)
+{
+    const size_t idx_0 = blockIdx.x * blockDim.x + threadIdx.x;
+
+    const unsigned int lengths[3]    = {lengths0, lengths1, lengths2};
+    const unsigned int stride_in[4]  = {stride_in0, stride_in1, stride_in2, stride_in3};
+    const unsigned int stride_out[4] = {stride_out0, stride_out1, stride_out2, stride_out3};
+
+    // only write the first [length0/2+1] elements due to conjugate redundancy
+    if(idx_0 >= 1 + lengths[0] / 2)
+        return;
+
+    size_t inputIdx, inputNegIdx, outputIdx;
+    complex2hermitian_pair_indexes<dim>(
+        idx_0, lengths, stride_in, stride_out, inputIdx, inputNegIdx, outputIdx);
+
+    Tcomplex x, y;
+    complex2hermitian_pair_split(input, inputIdx, inputNegIdx, x, y);
+
+    const size_t first  = 2 * blockIdx.z;
+    const size_t second = first + 1;
+
+    // unpack is the last kernel of the plan, so writes go through
+    // the store callback
+    auto store_cb = get_store_cb<Tcomplex, cbtype>(store_cb_fn);
+    store_cb(output, outputIdx + first * stride_out[dim], x, store_cb_data, nullptr);
+    if(second < batch)
+        store_cb(output, outputIdx + second * stride_out[dim], y, store_cb_data, nullptr);
+}
+
+// The planar overload function of the above interleaved one
+template <typename Tcomplex, CallbackType cbtype, unsigned int dim>
+__global__ static void __launch_bounds__(LAUNCH_BOUNDS_R2C_C2R_KERNEL)
+    complex2hermitian_pair_planar_kernel(unsigned int lengths0,
+                                         unsigned int lengths1,
+                                         unsigned int lengths2,
+                                         unsigned int batch,
+                                         unsigned int stride_in0,
+                                         unsigned int stride_in1,
+                                         unsigned int stride_in2,
+                                         unsigned int stride_in3,
+                                         unsigned int stride_out0,
+                                         unsigned int stride_out1,
+                                         unsigned int stride_out2,
+                                         unsigned int stride_out3,
+                                         const Tcomplex* __restrict__ input,
+                                         real_type_t<Tcomplex>* __restrict__ outputRe,
+                                         real_type_t<Tcomplex>* __restrict__ outputIm,
+                                         void* __restrict__ load_cb_fn,
+                                         void* __restrict__ load_cb_data,
+                                         uint32_t load_cb_lds_bytes,
+                                         void* __restrict__ store_cb_fn,
+                                         void* __restrict__ store_cb_data)
+{
+    const size_t idx_0 = blockIdx.x * blockDim.x + threadIdx.x;
+
+    const unsigned int lengths[3]    = {lengths0, lengths1, lengths2};
+    const unsigned int stride_in[4]  = {stride_in0, stride_in1, stride_in2, stride_in3};
+    const unsigned int stride_out[4] = {stride_out0, stride_out1, stride_out2, stride_out3};
+
+    if(idx_0 >= 1 + lengths[0] / 2)
+        return;
+
+    size_t inputIdx, inputNegIdx, outputIdx;
+    complex2hermitian_pair_indexes<dim>(
+        idx_0, lengths, stride_in, stride_out, inputIdx, inputNegIdx, outputIdx);
+
+    Tcomplex x, y;
+    complex2hermitian_pair_split(input, inputIdx, inputNegIdx, x, y);
+
+    const size_t first  = 2 * blockIdx.z;
+    const size_t second = first + 1;
+
+    auto store_cb = get_store_cb<Tcomplex, cbtype>(store_cb_fn);
+    store_planar<cbtype>(
+        store_cb, outputRe, outputIm, outputIdx + first * stride_out[dim], x, store_cb_data);
+    if(second < batch)
+        store_planar<cbtype>(
+            store_cb, outputRe, outputIm, outputIdx + second * stride_out[dim], y, store_cb_data);
+}
+
+// Element of the full spectrum at the current index, given a
+// function to load an element of the hermitian input.  Elements
+// whose mirror is also stored (the planes at k0 = 0 and k0 = N0/2)
+// are symmetrized, since only the hermitian part of those planes
+// contributes to a real output.
+template <typename Tcomplex, typename Tload>
+__device__ static Tcomplex hermitian2complex_pair_value(size_t       idx_0,
+                                                        unsigned int length0,
+                                                        size_t       inputIdx,
+                                                        size_t       inputNegIdx,
+                                                        unsigned int stride_in0,
+                                                        Tload        load)
+{
+    const size_t hermitian_size = length0 / 2 + 1;
+    const size_t neg_0          = idx_0 ? length0 - idx_0 : 0;
+
+    if(idx_0 < hermitian_size && neg_0 < hermitian_size)
+    {
+        const real_type_t<Tcomplex> half = 0.5;
+
+        const Tcomplex pos = load(inputIdx + idx_0 * stride_in0);
+        const Tcomplex neg = load(inputNegIdx + neg_0 * stride_in0);
+        Tcomplex       res;
+        res.x = (pos.x + neg.x) * half;
+        res.y = (pos.y - neg.y) * half;
+        return res;
+    }
+    if(idx_0 < hermitian_size)
+        return load(inputIdx + idx_0 * stride_in0);
+
+    Tcomplex res = load(inputNegIdx + neg_0 * stride_in0);
+    res.y        = -res.y;
+    return res;
+}
+
+// pack two hermitian inputs into one full complex spectrum, given
+// a function to load an element of the hermitian input
+template <typename Tcomplex, unsigned int dim, typename Tload>
+__device__ static void hermitian2complex_pair_pack(unsigned int       batch,
+                                                   const unsigned int lengths[3],
+                                                   const unsigned int stride_in[4],
+                                                   const unsigned int stride_out[4],
+                                                   Tcomplex* __restrict__ output,
+                                                   Tload load)
+{
+    const size_t idx_0 = blockIdx.x * blockDim.x + threadIdx.x;
+    if(idx_0 >= lengths[0])
+        return;
+
+    const size_t first  = 2 * blockIdx.z;
+    const size_t second = first + 1;
+
+    const size_t inputIdx    = pair_higher_offset<dim>(lengths, stride_in, false);
+    const size_t inputNegIdx = pair_higher_offset<dim>(lengths, stride_in, true);
+    const size_t outputIdx   = pair_higher_offset<dim>(lengths, stride_out, false)
+                             + idx_0 * stride_out[0] + blockIdx.z * stride_out[dim];
+
+    const Tcomplex x = hermitian2complex_pair_value<Tcomplex>(idx_0,
+                                                              lengths[0],
+                                                              inputIdx + first * stride_in[dim],
+                                                              inputNegIdx + first * stride_in[dim],
+                                                              stride_in[0],
+                                                              load);
+    Tcomplex       y;
+    y.x = 0.0;
+    y.y = 0.0;
+    if(second < batch)
+        y = hermitian2complex_pair_value<Tcomplex>(idx_0,
+                                                   lengths[0],
+                                                   inputIdx + second * stride_in[dim],
+                                                   inputNegIdx + second * stride_in[dim],
+                                                   stride_in[0],
+                                                   load);
+
+    // z = x + iy
+    Tcomplex z;
+    z.x               = x.x - y.y;
+    z.y               = x.y + y.x;
+    output[outputIdx] = z;
+}
+
+// lengths are the real lengths of the transform
+template <typename Tcomplex, CallbackType cbtype, unsigned int dim>
+__global__ static void __launch_bounds__(LAUNCH_BOUNDS_R2C_C2R_KERNEL)
+    hermitian2complex_pair_kernel(unsigned int lengths0,
+                                  unsigned int lengths1,
+                                  unsigned int lengths2,
+                                  unsigned int batch,
+                                  unsigned int stride_in0,
+                                  unsigned int stride_in1,
+                                  unsigned int stride_in2,
+                                  unsigned int stride_in3,
+                                  unsigned int stride_out0,
+                                  unsigned int stride_out1,
+                                  unsigned int stride_out2,
+                                  unsigned int stride_out3,
+                                  Tcomplex* __restrict__ input,
+                                  Tcomplex* __restrict__ output,
+                                  void* __restrict__ load_cb_fn,
+                                  void* __restrict__ load_cb_data,
+                                  uint32_t load_cb_lds_bytes,
+                                  void* __restrict__ store_cb_fn,
+                                  void* __restrict__ store_cb_data)
+{
+    const unsigned int lengths[3]    = {lengths0, lengths1, lengths2};
+    const unsigned int stride_in[4]  = {stride_in0, stride_in1, stride_in2, stride_in3};
+    const unsigned int stride_out[4] = {stride_out0, stride_out1, stride_out2, stride_out3};
+
+    auto load_cb = get_load_cb<Tcomplex, cbtype>(load_cb_fn);
+    hermitian2complex_pair_pack<Tcomplex, dim>(
+        batch, lengths, stride_in, stride_out, output, [=](size_t idx) {
+            return load_cb(input, idx, load_cb_data, nullptr);
+        });
+}
+
+// The planar overload function of the above interleaved one
+template <typename Tcomplex, CallbackType cbtype, unsigned int dim>
+__global__ static void __launch_bounds__(LAUNCH_BOUNDS_R2C_C2R_KERNEL)
+    hermitian2complex_pair_planar_kernel(unsigned int lengths0,
+                                         unsigned int lengths1,
+                                         unsigned int lengths2,
+                                         unsigned int batch,
+                                         unsigned int stride_in0,
+                                         unsigned int stride_in1,
+                                         unsigned int stride_in2,
+                                         unsigned int stride_in3,
+                                         unsigned int stride_out0,
+                                         unsigned int stride_out1,
+                                         unsigned int stride_out2,
+                                         unsigned int stride_out3,
+                                         real_type_t<Tcomplex>* __restrict__ inputRe,
+                                         real_type_t<Tcomplex>* __restrict__ inputIm,
+                                         Tcomplex* __restrict__ output,
+                                         void* __restrict__ load_cb_fn,
+                                         void* __restrict__ load_cb_data,
+                                         uint32_t load_cb_lds_bytes,
+                                         void* __restrict__ store_cb_fn,
+                                         void* __restrict__ store_cb_data)
+{
+    const unsigned int lengths[3]    = {lengths0, lengths1, lengths2};
+    const unsigned int stride_in[4]  = {stride_in0, stride_in1, stride_in2, stride_in3};
+    const unsigned int stride_out[4] = {stride_out0, stride_out1, stride_out2, stride_out3};
+
+    auto load_cb = get_load_cb<Tcomplex, cbtype>(load_cb_fn);
+    hermitian2complex_pair_pack<Tcomplex, dim>(
+        batch, lengths, stride_in, stride_out, output, [=](size_t idx) {
+            return load_planar<cbtype>(load_cb, inputRe, inputIm, idx, load_cb_data);
+        });
+}
+
+// unpack one complex inverse transform into two real outputs
+template <typename Tcomplex, CallbackType cbtype, unsigned int dim>
+__global__ static void __launch_bounds__(LAUNCH_BOUNDS_R2C_C2R_KERNEL)
+    complex2real_pair_kernel(unsigned int lengths0,
+                             unsigned int lengths1,
+                             unsigned int lengths2,
+                             unsigned int batch,
+                             unsigned int stride_in0,
+                             unsigned int stride_in1,
+                             unsigned int stride_in2,
+                             unsigned int stride_in3,
+                             unsigned int stride_out0,
+                             unsigned int stride_out1,
+                             unsigned int stride_out2,
+                             unsigned int stride_out3,
+                             const Tcomplex* __restrict__ input,
+                             real_type_t<Tcomplex>* __restrict__ output,
+                             void* __restrict__ load_cb_fn,
+                             void* __restrict__ load_cb_data,
+                             uint32_t load_cb_lds_bytes,
+                             void* __restrict__ store_cb_fn,
+                             void* __restrict__ store_cb_data)
+{
+    const size_t idx_0 = blockIdx.x * blockDim.x + threadIdx.x;
+
+    const unsigned int lengths[3]    = {lengths0, lengths1, lengths2};
+    const unsigned int stride_in[4]  = {stride_in0, stride_in1, stride_in2, stride_in3};
+    const unsigned int stride_out[4] = {stride_out0, stride_out1, stride_out2, stride_out3};
+
+    if(idx_0 >= lengths[0])
+        return;
+
+    const size_t first  = 2 * blockIdx.z;
+    const size_t second = first + 1;
+
+    const size_t inputIdx = pair_higher_offset<dim>(lengths, stride_in, false)
+                            + idx_0 * stride_in[0] + blockIdx.z * stride_in[dim];
+    const size_t outputIdx
+        = pair_higher_offset<dim>(lengths, stride_out, false) + idx_0 * stride_out[0];
+
+    const Tcomplex z = input[inputIdx];
+
+    auto store_cb = get_store_cb<real_type_t<Tcomplex>, cbtype>(store_cb_fn);
+    store_cb(output, outputIdx + first * stride_out[dim], z.x, store_cb_data, nullptr);
+    if(second < batch)
+        store_cb(output, outputIdx + second * stride_out[dim], z.y, store_cb_data, nullptr);
+}
+
+// lengths, strides and launch dimensions shared by the pair kernels
+struct PairLaunch
+{
+    size_t                dim;
+    std::array<size_t, 3> lengths{1, 1, 1};
+    std::array<size_t, 4> stride_in{1, 1, 1, 1};
+    std::array<size_t, 4> stride_out{1, 1, 1, 1};
+    dim3                  grid;
+    dim3                  threads{LAUNCH_BOUNDS_R2C_C2R_KERNEL, 1, 1};
+    size_t                real_batch;
+
+    // real_length is the real length of the transform, and
+    // threads_0 is the number of threads needed along the fastest
+    // dimension
+    PairLaunch(const TreeNode& node, const std::vector<size_t>& real_length, size_t threads_0)
+        : dim(real_length.size())
+    {
+        if(dim > 3)
+            throw std::runtime_error("Error: dimension larger than 3, which is not handled");
+
+        std::copy(real_length.begin(), real_length.end(), lengths.begin());
+        std::copy(node.inStride.begin(), node.inStride.end(), stride_in.begin());
+        stride_in[dim] = node.iDist;
+        std::copy(node.outStride.begin(), node.outStride.end(), stride_out.begin());
+        stride_out[dim] = node.oDist;
+
+        size_t high_dimension = lengths[1] * lengths[2];
+        size_t blocks         = (threads_0 - 1) / LAUNCH_BOUNDS_R2C_C2R_KERNEL + 1;
+
+        // the node's batch counts pairs, and the z dimension is used
+        // for those.  the parent knows how many real sequences there
+        // are.
+        grid       = dim3(blocks, high_dimension, node.batch);
+        real_batch = node.parent->batch;
+    }
+};
+
+// pick the kernel instantiation for the launch's dimension
+#define PAIR_KERNEL_FOR_DIM(KERNEL, ...)                                     \
+    (launch.dim == 1 ? KERNEL<__VA_ARGS__, 1>                                \
+                     : launch.dim == 2 ? KERNEL<__VA_ARGS__, 2> : KERNEL<__VA_ARGS__, 3>)
+
+// pick the kernel instantiation for the launch's dimension and callback type
+#define PAIR_KERNEL_FOR_DIM_CB(KERNEL, TFLOAT)                                 \
+    (data.get_callback_type() == CallbackType::USER_LOAD_STORE                 \
+         ? PAIR_KERNEL_FOR_DIM(KERNEL, TFLOAT, CallbackType::USER_LOAD_STORE) \
+         : PAIR_KERNEL_FOR_DIM(KERNEL, TFLOAT, CallbackType::NONE))
+
+template <typename Tkernel, typename Tin, typename Tout>
+static void pair_kernel_launch(Tkernel             kernel_func,
+                               const PairLaunch&   launch,
+                               const DeviceCallIn& data,
+                               Tin                 input,
+                               Tout                output)
+{
+    hipLaunchKernelGGL(kernel_func,
+                       launch.grid,
+                       launch.threads,
+                       0,
+                       data.rocfft_stream,
+                       launch.lengths[0],
+                       launch.lengths[1],
+                       launch.lengths[2],
+                       launch.real_batch,
+                       launch.stride_in[0],
+                       launch.stride_in[1],
+                       launch.stride_in[2],
+                       launch.stride_in[3],
+                       launch.stride_out[0],
+                       launch.stride_out[1],
+                       launch.stride_out[2],
+                       launch.stride_out[3],
+                       input,
+                       output,
+                       data.callbacks.load_cb_fn,
+                       data.callbacks.load_cb_data,
+                       data.callbacks.load_cb_lds_bytes,
+                       data.callbacks.store_cb_fn,
+                       data.callbacks.store_cb_data);
+}
+
+template <typename Tkernel, typename Tin0, typename Tin1, typename Tout>
+static void pair_planar_kernel_launch(Tkernel             kernel_func,
+                                      const PairLaunch&   launch,
+                                      const DeviceCallIn& data,
+                                      Tin0                input0,
+                                      Tin1                input1,
+                                      Tout                output)
+{
+    hipLaunchKernelGGL(kernel_func,
+                       launch.grid,
+                       launch.threads,
+                       0,
+                       data.rocfft_stream,
+                       launch.lengths[0],
+                       launch.lengths[1],
+                       launch.lengths[2],
+                       launch.real_batch,
+                       launch.stride_in[0],
+                       launch.stride_in[1],
+                       launch.stride_in[2],
+                       launch.stride_in[3],
+                       launch.stride_out[0],
+                       launch.stride_out[1],
+                       launch.stride_out[2],
+                       launch.stride_out[3],
+                       input0,
+                       input1,
+                       output,
+                       data.callbacks.load_cb_fn,
+                       data.callbacks.load_cb_data,
+                       data.callbacks.load_cb_lds_bytes,
+                       data.callbacks.store_cb_fn,
+                       data.callbacks.store_cb_data);
+}
+
+template <typename Tcomplex>
+static void real2complex_pair_launch(const DeviceCallIn& data, const PairLaunch& launch)
+{
+    pair_kernel_launch(PAIR_KERNEL_FOR_DIM_CB(real2complex_pair_kernel, Tcomplex),
+                       launch,
+                       data,
+                       static_cast<const real_type_t<Tcomplex>*>(data.bufIn[0]),
+                       static_cast<Tcomplex*>(data.bufOut[0]));
+}
+
+template <typename Tcomplex>
+static void complex2hermitian_pair_launch(const DeviceCallIn& data, const PairLaunch& launch)
+{
+    if(array_type_is_planar(data.node->outArrayType))
+        pair_planar_kernel_launch(
+            PAIR_KERNEL_FOR_DIM_CB(complex2hermitian_pair_planar_kernel, Tcomplex),
+            launch,
+            data,
+            static_cast<const Tcomplex*>(data.bufIn[0]),
+            static_cast<real_type_t<Tcomplex>*>(data.bufOut[0]),
+            static_cast<real_type_t<Tcomplex>*>(data.bufOut[1]));
+    else
+        pair_kernel_launch(PAIR_KERNEL_FOR_DIM_CB(complex2hermitian_pair_kernel, Tcomplex),
+                           launch,
+                           data,
+                           static_cast<const Tcomplex*>(data.bufIn[0]),
+                           static_cast<Tcomplex*>(data.bufOut[0]));
+}
+
+template <typename Tcomplex>
+static void hermitian2complex_pair_launch(const DeviceCallIn& data, const PairLaunch& launch)
+{
+    if(array_type_is_planar(data.node->inArrayType))
+        pair_planar_kernel_launch(
+            PAIR_KERNEL_FOR_DIM_CB(hermitian2complex_pair_planar_kernel, Tcomplex),
+            launch,
+            data,
+            static_cast<real_type_t<Tcomplex>*>(data.bufIn[0]),
+            static_cast<real_type_t<Tcomplex>*>(data.bufIn[1]),
+            static_cast<Tcomplex*>(data.bufOut[0]));
+    else
+        pair_kernel_launch(PAIR_KERNEL_FOR_DIM_CB(hermitian2complex_pair_kernel, Tcomplex),
+                           launch,
+                           data,
+                           static_cast<Tcomplex*>(data.bufIn[0]),
+                           static_cast<Tcomplex*>(data.bufOut[0]));
+}
+
+template <typename Tcomplex>
+static void complex2real_pair_launch(const DeviceCallIn& data, const PairLaunch& launch)
+{
+    pair_kernel_launch(PAIR_KERNEL_FOR_DIM_CB(complex2real_pair_kernel, Tcomplex),
+                       launch,
+                       data,
+                       static_cast<const Tcomplex*>(data.bufIn[0]),
+                       static_cast<real_type_t<Tcomplex>*>(data.bufOut[0]));
+}
+
+/// \brief auxiliary function
+///   pack pairs of real batch elements into complex batch elements
+ROCFFT_DEVICE_EXPORT void real2complex_pair(const void* data_p, void* back_p)
+{
+    auto data = static_cast<const DeviceCallIn*>(data_p);
+
+    const auto& length = data->node->length;
+    PairLaunch  launch(*data->node, length, length[0]);
+
+    if(data->node->precision == rocfft_precision_single)
+        real2complex_pair_launch<float2>(*data, launch);
+    else
+        real2complex_pair_launch<double2>(*data, launch);
+}
+
+/// \brief auxiliary function
+///   separate complex batch elements into pairs of hermitian outputs
+ROCFFT_DEVICE_EXPORT void complex2hermitian_pair(const void* data_p, void* back_p)
+{
+    auto data = static_cast<const DeviceCallIn*>(data_p);
+
+    const auto& length = data->node->length;
+    PairLaunch  launch(*data->node, length, length[0] / 2 + 1);
+
+    if(data->node->precision == rocfft_precision_single)
+        complex2hermitian_pair_launch<float2>(*data, launch);
+    else
+        complex2hermitian_pair_launch<double2>(*data, launch);
+}
+
+/// \brief auxiliary function
+///   pack pairs of hermitian batch elements into full complex batch elements
+ROCFFT_DEVICE_EXPORT void hermitian2complex_pair(const void* data_p, void* back_p)
+{
+    auto data = static_cast<const DeviceCallIn*>(data_p);
+
+    const auto& length = data->node->outputLength;
+    PairLaunch  launch(*data->node, length, length[0]);
+
+    if(data->node->precision == rocfft_precision_single)
+        hermitian2complex_pair_launch<float2>(*data, launch);
+    else
+        hermitian2complex_pair_launch<double2>(*data, launch);
+}
+
+/// \brief auxiliary function
+///   separate complex batch elements into pairs of real outputs
+ROCFFT_DEVICE_EXPORT void complex2real_pair(const void* data_p, void* back_p)
+{
+    auto data = static_cast<const DeviceCallIn*>(data_p);
+
+    const auto& length = data->node->length;
+    PairLaunch  launch(*data->node, length, length[0]);
+
+    if(data->node->precision == rocfft_precision_single)
+        complex2real_pair_launch<float2>(*data, launch);
+    else
+        complex2real_pair_launch<double2>(*data, launch);
+}
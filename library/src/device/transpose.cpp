@@ -288,8 +288,8 @@ ROCFFT_DEVICE_EXPORT void rocfft_internal_transpose_var2(const void* data_p, voi
     // NB:
     //    Need better arch comparison other than strings.
     //    Need to check it for Navi and other oncoming new Archs.
-    if(is_device_gcn_arch(data->deviceProp, "gfx908")
-       || is_device_gcn_arch(data->deviceProp, "gfx90a"))
+    if(is_device_gcn_arch(*data->deviceProp, "gfx908")
+       || is_device_gcn_arch(*data->deviceProp, "gfx90a"))
     {
         diagonal = (m % 256) == 0 && (data->node->outStride[1] % 256 == 0)
                    && (data->node->scheme != CS_KERNEL_TRANSPOSE_XY_Z);
@@ -580,7 +580,7 @@ ROCFFT_DEVICE_EXPORT void rocfft_internal_transpose_var2(const void* data_p, voi
         {
 #ifdef __HIP_PLATFORM_AMD__
             // For some large pow of 2 cases on gfx90a, the 64x16 conig seems better
-            if(is_device_gcn_arch(data->deviceProp, "gfx90a")
+            if(is_device_gcn_arch(*data->deviceProp, "gfx90a")
                && ((m == 512 && n == 512) || (m == 4096 && n == 262144)
                    || (n == 4096 && m == 262144)))
                 rocfft_transpose_outofplace_template<double2,
@@ -0,0 +1,155 @@
+/******************************************************************************
+* Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#include "grouped_plan.h"
+#include "function_pool.h"
+#include "kernel_launch.h"
+#include "node_factory.h"
+#include "rocfft_ostream.hpp"
+#include "rtc.h"
+#include "statistics.h"
+#include "tree_node.h"
+
+struct grouped_plan::bin_launch
+{
+    std::unique_ptr<TreeNode> node;
+    GridParam                 gridParam;
+    RTCKernel*                kernel = nullptr;
+};
+
+grouped_plan::grouped_plan(const std::vector<grouped_problem>& problems,
+                           rocfft_result_placement             placement,
+                           rocfft_transform_type               transform_type,
+                           rocfft_precision                    precision)
+{
+    bins = grouped_bin_problems(problems, [=](size_t length) -> size_t {
+        auto key = fpkey(length, precision);
+        if(!function_pool::has_function(key))
+            return 0;
+        return function_pool::get_kernel(key).transforms_per_block;
+    });
+
+    hipDeviceProp_t deviceProp;
+    int             deviceId = 0;
+    if(hipGetDevice(&deviceId) != hipSuccess
+       || hipGetDeviceProperties(&deviceProp, deviceId) != hipSuccess)
+        throw std::runtime_error("failed to get device properties");
+
+    // all tables go in one allocation, with each bin's input table
+    // followed by its output table
+    std::vector<size_t> host_tables;
+    std::vector<size_t> table_offsets;
+    for(const auto& bin : bins)
+    {
+        table_offsets.push_back(host_tables.size());
+        for(const auto& table : bin.table)
+            host_tables.insert(host_tables.end(), table.begin(), table.end());
+    }
+    if(!host_tables.empty())
+    {
+        auto bytes = host_tables.size() * sizeof(size_t);
+        if(tables.alloc(bytes) != hipSuccess
+           || hipMemcpy(tables.data(), host_tables.data(), bytes, hipMemcpyHostToDevice)
+                  != hipSuccess)
+            throw std::runtime_error("failed to upload grouped problem tables");
+    }
+
+    // start every bin's compile before waiting on any of them
+    for(size_t i = 0; i < bins.size(); ++i)
+    {
+        const auto& bin = bins[i];
+
+        bin_launch launch;
+        launch.node       = NodeFactory::CreateNodeFromScheme(CS_KERNEL_STOCKHAM);
+        auto& node        = *launch.node;
+        node.grouped      = true;
+        node.length       = {bin.length};
+        node.dimension    = 1;
+        node.batch        = bin.blocks() * bin.transforms_per_block;
+        // the kernel reads strides from the problem tables, but a
+        // stride of 1 here picks the unit-stride specialization
+        node.inStride     = {bin.unit_stride ? 1u : 0u};
+        node.outStride    = node.inStride;
+        node.placement    = placement;
+        node.precision    = precision;
+        node.direction    = transform_type == rocfft_transform_type_complex_forward ? -1 : 1;
+        node.inArrayType  = rocfft_array_type_complex_interleaved;
+        node.outArrayType = rocfft_array_type_complex_interleaved;
+        node.deviceProp   = deviceProp;
+        node.devKernArg   = static_cast<size_t*>(tables.data()) + table_offsets[i];
+
+        if(!node.CreateTwiddleTableResource())
+            throw std::runtime_error("failed to create twiddles for grouped length "
+                                     + std::to_string(bin.length));
+        DevFnCall fn = nullptr;
+        node.SetupGridParamAndFuncPtr(fn, launch.gridParam);
+        launch.gridParam.b_x = bin.blocks();
+
+        node.compiledKernel = RTCKernel::runtime_compile(node, deviceProp.gcnArchName);
+        launches.push_back(std::move(launch));
+    }
+
+    for(auto& launch : launches)
+    {
+        launch.kernel = launch.node->compiledKernel.get().get();
+        if(!launch.kernel)
+            throw std::runtime_error("grouped plans need runtime compilation");
+    }
+}
+
+grouped_plan::~grouped_plan() = default;
+
+void grouped_plan::execute(void* in_buffer[], void* out_buffer[], hipStream_t stream)
+{
+    auto& exec_stats = rocfft_stats::get().exec;
+    exec_stats.add(stat_sharded_counters::EXECUTIONS);
+
+    for(auto& launch : launches)
+    {
+        // bins without any transforms have no blocks to launch
+        if(launch.gridParam.b_x == 0)
+            continue;
+
+        DeviceCallIn data;
+        data.node          = launch.node.get();
+        data.bufIn[0]      = in_buffer[0];
+        data.bufOut[0]     = out_buffer[0];
+        data.rocfft_stream = stream;
+        data.gridParam     = launch.gridParam;
+        data.deviceProp    = &launch.node->deviceProp;
+
+        launch.kernel->launch(data);
+        exec_stats.add(stat_sharded_counters::KERNEL_LAUNCHES);
+        exec_stats.add(stat_sharded_counters::scheme_launches(CS_KERNEL_STOCKHAM));
+    }
+}
+
+void grouped_plan::print(rocfft_ostream& os) const
+{
+    os << "grouped bins: " << bins.size() << std::endl;
+    for(const auto& bin : bins)
+    {
+        os << "length " << bin.length << (bin.unit_stride ? ", unit stride" : "") << ": "
+           << bin.problems.size() << " problems, " << bin.blocks() << " blocks of "
+           << bin.transforms_per_block << " transforms" << std::endl;
+    }
+}
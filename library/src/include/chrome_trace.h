@@ -0,0 +1,63 @@
+/******************************************************************************
+* Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#ifndef ROCFFT_CHROME_TRACE_H
+#define ROCFFT_CHROME_TRACE_H
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include "logging.h"
+
+// Records events in Chrome's trace-event format, so that plan
+// creation and execution over a whole run can be opened in Perfetto
+// or chrome://tracing.  Events are kept in memory and written out as
+// one JSON file by rocfft_cleanup, so recording an event doesn't do
+// any I/O.
+namespace chrome_trace
+{
+    typedef std::chrono::steady_clock clock;
+
+    // Track for kernels on the null stream, as timed by hipEvents.
+    // Host threads use their log_thread_id, which starts at 1.
+    static const size_t GPU_TID = 0;
+    // Track for kernels on user streams, which are timed
+    // asynchronously.  The id is far out of the way of host threads.
+    static const size_t GPU_STREAM_TID = std::numeric_limits<int32_t>::max();
+
+    // Record a complete event: 'name' ran on track 'tid' from 'begin'
+    // for 'dur_ms' milliseconds.  'args' is a JSON object, or empty.
+    void complete(const char*        category,
+                  const std::string& name,
+                  clock::time_point  begin,
+                  double             dur_ms,
+                  size_t             tid,
+                  const std::string& args = {});
+
+    // Write all recorded events to fd as a trace JSON file, and
+    // forget them.
+    void flush(int fd);
+}
+
+#endif // ROCFFT_CHROME_TRACE_H
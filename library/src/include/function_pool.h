@@ -25,8 +25,9 @@
 
 #include "../device/kernels/common.h"
 #include "tree_node.h"
+#include <algorithm>
 #include <sstream>
-#include <unordered_map>
+#include <stdexcept>
 
 using FMKey
     = std::tuple<std::array<size_t, 2>, rocfft_precision, ComputeScheme, SBRC_TRANSPOSE_TYPE>;
@@ -63,20 +64,6 @@ inline void PrintMissingKernelInfo(const FMKey& key)
     throw std::runtime_error(msg.str());
 }
 
-struct SimpleHash
-{
-    size_t operator()(const FMKey& p) const noexcept
-    {
-        size_t h = 0;
-        for(auto& v : std::get<0>(p))
-            h ^= std::hash<int>{}(v);
-        h ^= std::hash<rocfft_precision>{}(std::get<1>(p));
-        h ^= std::hash<ComputeScheme>{}(std::get<2>(p));
-        h ^= std::hash<SBRC_TRANSPOSE_TYPE>{}(std::get<3>(p));
-        return h;
-    }
-};
-
 struct FFTKernel
 {
 
@@ -95,6 +82,9 @@ struct FFTKernel
     bool               use_3steps_large_twd  = false;
     bool               half_lds              = false;
     bool               direct_to_reg         = false;
+    // exchange data between passes with cross-lane shuffles, so no
+    // LDS is needed when data stays in registers
+    bool shfl_exchange = false;
 
     FFTKernel() = delete;
 
@@ -108,7 +98,8 @@ struct FFTKernel
               int                   wgs,
               std::array<int, 2>&&  tpt,
               bool                  half_lds      = false,
-              bool                  direct_to_reg = false)
+              bool                  direct_to_reg = false,
+              bool                  shfl_exchange = false)
         : device_function(fn)
         , factors(factors)
         , transforms_per_block(tpb)
@@ -117,16 +108,94 @@ struct FFTKernel
         , use_3steps_large_twd(use_3steps)
         , half_lds(half_lds)
         , direct_to_reg(direct_to_reg)
+        , shfl_exchange(shfl_exchange)
     {
     }
 };
 
+// Kernel as described by the generator.  The generator emits a
+// statically-initialized array of these, so the pool costs nothing
+// to set up when the library is loaded.
+struct FunctionPoolEntry
+{
+    std::array<size_t, 2> length;
+    DevFnCall             device_function;
+    const size_t*         factors;
+    size_t                num_factors;
+    int                   transforms_per_block;
+    int                   workgroup_size;
+    std::array<int, 2>    threads_per_transform;
+    bool                  use_3steps_large_twd;
+    bool                  half_lds;
+    bool                  direct_to_reg;
+    bool                  shfl_exchange;
+
+    FFTKernel kernel() const
+    {
+        return FFTKernel(device_function,
+                         use_3steps_large_twd,
+                         std::vector<size_t>(factors, factors + num_factors),
+                         transforms_per_block,
+                         workgroup_size,
+                         std::array<int, 2>(threads_per_transform),
+                         half_lds,
+                         direct_to_reg,
+                         shfl_exchange);
+    }
+};
+
+// Entries that share a precision, scheme and transpose type are
+// contiguous in the entry array, and sorted by length.
+struct FunctionPoolGroup
+{
+    rocfft_precision         precision;
+    ComputeScheme            scheme;
+    SBRC_TRANSPOSE_TYPE      transpose;
+    const FunctionPoolEntry* begin;
+    const FunctionPoolEntry* end;
+};
+
 class function_pool
 {
-    std::unordered_map<FMKey, FFTKernel, SimpleHash> function_map;
+    const FunctionPoolGroup* groups      = nullptr;
+    size_t                   group_count = 0;
 
     ROCFFT_DEVICE_EXPORT function_pool();
 
+    const FunctionPoolGroup*
+        find_group(rocfft_precision precision, ComputeScheme scheme, SBRC_TRANSPOSE_TYPE transpose) const
+    {
+        auto end = groups + group_count;
+        auto group
+            = std::find_if(groups, end, [=](const FunctionPoolGroup& g) {
+                  return g.precision == precision && g.scheme == scheme && g.transpose == transpose;
+              });
+        return group == end ? nullptr : group;
+    }
+
+    const FunctionPoolEntry* find(const FMKey& key) const
+    {
+        auto group = find_group(std::get<1>(key), std::get<2>(key), std::get<3>(key));
+        if(!group)
+            return nullptr;
+        const auto& length = std::get<0>(key);
+        auto        entry  = std::lower_bound(
+            group->begin, group->end, length, [](const FunctionPoolEntry& e, const auto& len) {
+                return e.length < len;
+            });
+        if(entry == group->end || entry->length != length)
+            return nullptr;
+        return entry;
+    }
+
+    const FunctionPoolEntry& at(const FMKey& key) const
+    {
+        auto entry = find(key);
+        if(!entry)
+            throw std::out_of_range("kernel not found in function pool");
+        return *entry;
+    }
+
 public:
     function_pool(const function_pool&) = delete;
     function_pool& operator=(const function_pool&) = delete;
@@ -142,44 +211,45 @@ public:
     static bool has_function(const FMKey& key)
     {
         function_pool& func_pool = get_function_pool();
-        return func_pool.function_map.count(key) > 0;
+        return func_pool.find(key) != nullptr;
     }
 
     static size_t get_largest_length(rocfft_precision precision)
     {
-        auto supported = function_pool::get_lengths(precision, CS_KERNEL_STOCKHAM);
-        auto itr       = std::max_element(supported.cbegin(), supported.cend());
-        if(itr != supported.cend())
-            return *itr;
-        return 0;
+        const function_pool& func_pool = get_function_pool();
+        auto group = func_pool.find_group(precision, CS_KERNEL_STOCKHAM, NONE);
+        if(!group || group->begin == group->end)
+            return 0;
+        // 1D stockham entries are sorted by length
+        return (group->end - 1)->length[0];
     }
 
     static std::vector<size_t> get_lengths(rocfft_precision precision, ComputeScheme scheme)
     {
         const function_pool& func_pool = get_function_pool();
         std::vector<size_t>  lengths;
-        for(auto const& kv : func_pool.function_map)
+        auto                 group = func_pool.find_group(precision, scheme, NONE);
+        if(group)
         {
-            if(std::get<0>(kv.first)[1] == 0 && std::get<1>(kv.first) == precision
-               && std::get<2>(kv.first) == scheme && std::get<3>(kv.first) == NONE)
+            for(auto entry = group->begin; entry != group->end; ++entry)
             {
-                lengths.push_back(std::get<0>(kv.first)[0]);
+                if(entry->length[1] == 0)
+                    lengths.push_back(entry->length[0]);
             }
         }
-
         return lengths;
     }
 
     static DevFnCall get_function(const FMKey& key)
     {
         function_pool& func_pool = get_function_pool();
-        return func_pool.function_map.at(key).device_function;
+        return func_pool.at(key).device_function;
     }
 
     static FFTKernel get_kernel(const FMKey& key)
     {
         function_pool& func_pool = get_function_pool();
-        return func_pool.function_map.at(key);
+        return func_pool.at(key).kernel();
     }
 
     // helper for common used
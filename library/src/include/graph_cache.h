@@ -0,0 +1,278 @@
+/******************************************************************************
+* Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#ifndef ROCFFT_GRAPH_CACHE_H
+#define ROCFFT_GRAPH_CACHE_H
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "../device/kernels/callback.h"
+#include <hip/hip_runtime_api.h>
+
+// Runtime calls needed to capture and replay graphs.  graph_cache
+// only talks to the runtime through this interface, so its
+// bookkeeping can be tested on the host with a mock.
+struct graph_ops
+{
+    virtual ~graph_ops() = default;
+
+    // capture work enqueued on 'stream' into a graph, instead of
+    // running it
+    virtual bool begin_capture(hipStream_t stream)                  = 0;
+    virtual bool end_capture(hipStream_t stream, hipGraph_t& graph) = 0;
+
+    virtual bool instantiate(hipGraph_t graph, hipGraphExec_t& exec) = 0;
+    // give 'exec' the kernel arguments of 'graph'; fails if the
+    // graphs don't have the same nodes
+    virtual bool update(hipGraphExec_t exec, hipGraph_t graph)   = 0;
+    virtual bool launch(hipGraphExec_t exec, hipStream_t stream) = 0;
+
+    virtual void destroy_graph(hipGraph_t graph)   = 0;
+    virtual void destroy_exec(hipGraphExec_t exec) = 0;
+};
+
+// Everything about an execution that a captured graph depends on.
+struct graph_key
+{
+    void*         in_buffer[2]  = {nullptr, nullptr};
+    void*         out_buffer[2] = {nullptr, nullptr};
+    void*         work_buffer   = nullptr;
+    hipStream_t   stream        = nullptr;
+    UserCallbacks callbacks;
+
+    // Graphs for keys of the same shape launch the same kernels in
+    // the same order, and differ only in kernel arguments.  Kernels
+    // with callbacks are different kernels, and some are skipped
+    // without callbacks.
+    bool same_shape(const graph_key& other) const
+    {
+        return stream == other.stream
+               && (callbacks.load_cb_fn == nullptr) == (other.callbacks.load_cb_fn == nullptr)
+               && (callbacks.store_cb_fn == nullptr) == (other.callbacks.store_cb_fn == nullptr);
+    }
+
+    bool operator==(const graph_key& other) const
+    {
+        return same_shape(other) && in_buffer[0] == other.in_buffer[0]
+               && in_buffer[1] == other.in_buffer[1] && out_buffer[0] == other.out_buffer[0]
+               && out_buffer[1] == other.out_buffer[1] && work_buffer == other.work_buffer
+               && callbacks.load_cb_fn == other.callbacks.load_cb_fn
+               && callbacks.load_cb_data == other.callbacks.load_cb_data
+               && callbacks.load_cb_lds_bytes == other.callbacks.load_cb_lds_bytes
+               && callbacks.store_cb_fn == other.callbacks.store_cb_fn
+               && callbacks.store_cb_data == other.callbacks.store_cb_data
+               && callbacks.store_cb_lds_bytes == other.callbacks.store_cb_lds_bytes;
+    }
+};
+
+// Graphs of one plan's kernel launches, for replaying executions
+// that reuse the buffers and stream of an earlier execution.
+//
+// An execution with new buffers is captured into a graph.  If a
+// cached graph has the same shape, it's updated with the new kernel
+// arguments, which is much cheaper than instantiating another graph.
+// Executions go back to launching kernels directly if capture fails,
+// or if buffers change on almost every execution, since capturing
+// would then cost more than it saves.
+class graph_cache
+{
+public:
+    enum result_t
+    {
+        // launched a cached graph
+        REPLAYED,
+        // captured, and updated a cached graph to launch
+        UPDATED,
+        // captured, and instantiated a new graph to launch
+        CAPTURED,
+        // launched kernels directly
+        EAGER,
+    };
+
+    // graphs kept per plan
+    static constexpr size_t MAX_GRAPHS = 4;
+    // after this many executions in a row that didn't replay a
+    // graph, only try capturing once per this many executions
+    static constexpr size_t MAX_MISSES = 8;
+
+    explicit graph_cache(graph_ops& ops)
+        : ops(ops)
+    {
+    }
+    ~graph_cache()
+    {
+        for(auto& g : graphs)
+            ops.destroy_exec(g.exec);
+    }
+    graph_cache(const graph_cache&) = delete;
+    graph_cache& operator=(const graph_cache&) = delete;
+
+    // Run the kernels that 'launch' enqueues on key.stream, from a
+    // graph if possible.
+    result_t execute(const graph_key& key, const std::function<void()>& launch)
+    {
+        // the null stream can't be captured
+        if(!key.stream)
+        {
+            launch();
+            return EAGER;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        ++use_count;
+        for(auto& g : graphs)
+        {
+            if(g.key == key)
+            {
+                g.last_use = use_count;
+                misses     = 0;
+                if(!ops.launch(g.exec, key.stream))
+                    throw std::runtime_error("hipGraphLaunch failure");
+                return REPLAYED;
+            }
+        }
+
+        ++misses;
+        if(disabled || (misses > MAX_MISSES && misses % MAX_MISSES != 0))
+        {
+            lock.unlock();
+            launch();
+            return EAGER;
+        }
+
+        hipGraph_t graph = nullptr;
+        // this fails if the stream is already capturing, e.g. into
+        // a graph of the caller's own
+        if(!ops.begin_capture(key.stream))
+        {
+            lock.unlock();
+            launch();
+            return EAGER;
+        }
+        try
+        {
+            launch();
+        }
+        catch(...)
+        {
+            // don't leave the stream capturing
+            if(ops.end_capture(key.stream, graph))
+                ops.destroy_graph(graph);
+            throw;
+        }
+        // nothing ran while capturing, so launch directly if the
+        // capture didn't work
+        if(!ops.end_capture(key.stream, graph))
+        {
+            disabled = true;
+            lock.unlock();
+            launch();
+            return EAGER;
+        }
+
+        result_t result = CAPTURED;
+        auto     target = update_candidate(key);
+        if(target != graphs.end() && ops.update(target->exec, graph))
+        {
+            target->key = key;
+            result      = UPDATED;
+        }
+        else
+        {
+            hipGraphExec_t exec = nullptr;
+            if(!ops.instantiate(graph, exec))
+            {
+                ops.destroy_graph(graph);
+                disabled = true;
+                lock.unlock();
+                launch();
+                return EAGER;
+            }
+            if(graphs.size() == MAX_GRAPHS)
+            {
+                auto lru = least_recently_used(graphs.begin(), graphs.end());
+                ops.destroy_exec(lru->exec);
+                graphs.erase(lru);
+            }
+            graphs.push_back({key, exec, 0});
+            target = graphs.end() - 1;
+        }
+        ops.destroy_graph(graph);
+
+        target->last_use = use_count;
+        if(!ops.launch(target->exec, key.stream))
+            throw std::runtime_error("hipGraphLaunch failure");
+        return result;
+    }
+
+    // number of graphs currently cached
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return graphs.size();
+    }
+
+private:
+    struct cached_graph
+    {
+        graph_key      key;
+        hipGraphExec_t exec;
+        size_t         last_use;
+    };
+
+    typedef std::vector<cached_graph>::iterator graph_iterator;
+
+    static graph_iterator least_recently_used(graph_iterator begin, graph_iterator end)
+    {
+        graph_iterator lru = end;
+        for(auto it = begin; it != end; ++it)
+            if(lru == end || it->last_use < lru->last_use)
+                lru = it;
+        return lru;
+    }
+
+    // The least recently used graph of the same shape as 'key', or
+    // end() if there isn't one.
+    graph_iterator update_candidate(const graph_key& key)
+    {
+        graph_iterator lru = graphs.end();
+        for(auto it = graphs.begin(); it != graphs.end(); ++it)
+            if(it->key.same_shape(key) && (lru == graphs.end() || it->last_use < lru->last_use))
+                lru = it;
+        return lru;
+    }
+
+    graph_ops&                ops;
+    mutable std::mutex        mutex;
+    std::vector<cached_graph> graphs;
+    size_t                    use_count = 0;
+    size_t                    misses    = 0;
+    // set if the runtime couldn't capture or instantiate a graph,
+    // in which case we won't try again
+    bool disabled = false;
+};
+
+#endif // ROCFFT_GRAPH_CACHE_H
@@ -0,0 +1,178 @@
+/******************************************************************************
+* Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#ifndef ROCFFT_GROUPED_PLAN_H
+#define ROCFFT_GROUPED_PLAN_H
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../../../shared/gpubuf.h"
+#include "rocfft.h"
+
+class rocfft_ostream;
+
+// A grouped plan runs many independent 1D transforms of assorted
+// lengths in a handful of kernel launches.  Problems are binned by
+// the kernel that transforms them, and each bin is one launch.
+// Each thread block of a launch reads a record from a per-block
+// problem table that says where its transforms are, so blocks of
+// one launch can work on different problems.
+//
+// Binning and the tables are computed on the host, so they can be
+// tested without a device.
+
+// One problem of a group.  Index 0 of each array is the input, and
+// index 1 is the output.  Everything counts elements, not bytes.
+struct grouped_problem
+{
+    size_t length    = 0;
+    size_t batch     = 0;
+    size_t stride[2] = {1, 1};
+    size_t dist[2]   = {0, 0};
+    size_t offset[2] = {0, 0};
+};
+
+// Fields of a thread block's record in a problem table.
+enum grouped_record_field
+{
+    // offset of the block's first transform
+    GROUPED_OFFSET,
+    // stride between elements of a transform
+    GROUPED_STRIDE,
+    // distance between the block's transforms
+    GROUPED_DIST,
+    // number of transforms the block does
+    GROUPED_TRANSFORMS,
+
+    GROUPED_RECORD_WIDTH,
+};
+
+// Problems that one kernel transforms in one launch.
+struct grouped_bin
+{
+    size_t length = 0;
+    // problems with unit stride on both sides get a kernel
+    // specialized for it
+    bool   unit_stride          = false;
+    size_t transforms_per_block = 0;
+
+    // indexes of the bin's problems, in the order they were given
+    std::vector<size_t> problems;
+    // input and output problem tables, one record per block
+    std::vector<size_t> table[2];
+
+    size_t blocks() const
+    {
+        return table[0].size() / GROUPED_RECORD_WIDTH;
+    }
+};
+
+// Sort problems into bins, ordered by length, and build each bin's
+// problem tables.  'transforms_per_block' gives the number of
+// transforms a thread block of the kernel for a length does, or 0
+// if there's no such kernel.  A block never spans two problems.
+inline std::vector<grouped_bin>
+    grouped_bin_problems(const std::vector<grouped_problem>&   problems,
+                         const std::function<size_t(size_t)>& transforms_per_block)
+{
+    std::map<std::pair<size_t, bool>, grouped_bin> bins;
+    for(size_t i = 0; i < problems.size(); ++i)
+    {
+        const auto& problem     = problems[i];
+        bool        unit_stride = problem.stride[0] == 1 && problem.stride[1] == 1;
+        auto&       bin         = bins[std::make_pair(problem.length, unit_stride)];
+        if(bin.problems.empty())
+        {
+            bin.length               = problem.length;
+            bin.unit_stride          = unit_stride;
+            bin.transforms_per_block = transforms_per_block(problem.length);
+            if(bin.transforms_per_block == 0)
+                throw std::runtime_error("no kernel for grouped length "
+                                         + std::to_string(problem.length));
+        }
+        bin.problems.push_back(i);
+
+        for(size_t first = 0; first < problem.batch; first += bin.transforms_per_block)
+        {
+            for(size_t side = 0; side < 2; ++side)
+            {
+                size_t record[GROUPED_RECORD_WIDTH];
+                record[GROUPED_OFFSET] = problem.offset[side] + first * problem.dist[side];
+                record[GROUPED_STRIDE] = problem.stride[side];
+                record[GROUPED_DIST]   = problem.dist[side];
+                record[GROUPED_TRANSFORMS]
+                    = std::min(bin.transforms_per_block, problem.batch - first);
+                auto& table = bin.table[side];
+                table.insert(table.end(), record, record + GROUPED_RECORD_WIDTH);
+            }
+        }
+    }
+
+    std::vector<grouped_bin> ret;
+    for(auto& bin : bins)
+        ret.push_back(std::move(bin.second));
+    return ret;
+}
+
+// A plan that runs a group of 1D complex problems that share one
+// input and one output buffer.
+class grouped_plan
+{
+public:
+    // Bin the problems, and compile a kernel and upload the problem
+    // tables for each bin on the current device.  Throws on failure.
+    grouped_plan(const std::vector<grouped_problem>& problems,
+                 rocfft_result_placement             placement,
+                 rocfft_transform_type               transform_type,
+                 rocfft_precision                    precision);
+    ~grouped_plan();
+    grouped_plan(const grouped_plan&) = delete;
+    grouped_plan& operator=(const grouped_plan&) = delete;
+
+    // Launch one kernel per bin on 'stream'.
+    void execute(void* in_buffer[], void* out_buffer[], hipStream_t stream);
+
+    const std::vector<grouped_bin>& get_bins() const
+    {
+        return bins;
+    }
+
+    void print(rocfft_ostream& os) const;
+
+private:
+    std::vector<grouped_bin> bins;
+
+    // kernel node and launch parameters of each bin
+    struct bin_launch;
+    std::vector<bin_launch> launches;
+
+    // every bin's problem tables, in one device allocation
+    gpubuf tables;
+};
+
+#endif // ROCFFT_GROUPED_PLAN_H
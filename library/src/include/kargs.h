@@ -25,35 +25,111 @@
 #define KARGS_H
 
 #include "../../../shared/gpubuf.h"
+#include <algorithm>
+#include <cassert>
 #include <cstddef>
 #include <vector>
 
 #define KERN_ARGS_ARRAY_WIDTH 16
 
-gpubuf_t<size_t> kargs_create(std::vector<size_t> length,
-                              std::vector<size_t> inStride,
-                              std::vector<size_t> outStride,
-                              size_t              iDist,
-                              size_t              oDist);
+// number of elements in one node's kernel argument block: lengths,
+// input strides and output strides, each KERN_ARGS_ARRAY_WIDTH wide
+#define KERN_ARGS_BLOCK_SIZE (3 * KERN_ARGS_ARRAY_WIDTH)
 
-// data->node->devKernArg : points to the internal length device pointer
-// data->node->devKernArg + 1*KERN_ARGS_ARRAY_WIDTH : points to the intenal in
+// write one node's kernel arguments to a host block of
+// KERN_ARGS_BLOCK_SIZE elements
+static void kargs_fill(size_t*                    block,
+                       const std::vector<size_t>& length,
+                       const std::vector<size_t>& inStride,
+                       const std::vector<size_t>& outStride,
+                       size_t                     iDist,
+                       size_t                     oDist)
+{
+    assert(length.size() == inStride.size());
+    assert(length.size() == outStride.size());
+    assert(length.size() < KERN_ARGS_ARRAY_WIDTH);
+
+    std::fill_n(block, KERN_ARGS_BLOCK_SIZE, 0);
+
+    size_t i = 0;
+    while(i < length.size())
+    {
+        block[i + 0 * KERN_ARGS_ARRAY_WIDTH] = length[i];
+        block[i + 1 * KERN_ARGS_ARRAY_WIDTH] = inStride[i];
+        block[i + 2 * KERN_ARGS_ARRAY_WIDTH] = outStride[i];
+        i++;
+    }
+
+    // NB: iDist is right after the last inStride[dim-1], i.e. inStride[dim] = batch-in-stride
+    //     oDist is right after the last outStride[dim-1], i.e. outStride[dim] = batch-out-stride
+    block[i + 1 * KERN_ARGS_ARRAY_WIDTH] = iDist;
+    block[i + 2 * KERN_ARGS_ARRAY_WIDTH] = oDist;
+}
+
+// All of a plan's device-side metadata lives in one arena.  Nodes
+// reserve blocks in a host staging buffer and remember their
+// offsets.  Once every node has written its block, the whole
+// buffer is uploaded with a single allocation and a single copy,
+// and nodes turn their offsets into device pointers.
+struct kargs_arena
+{
+    // host staging buffer, laid out exactly as on the device
+    std::vector<size_t> host;
+    // device copy of the staging buffer, valid after upload()
+    gpubuf_t<size_t> device;
+
+    // number of device allocations and host-to-device copies done
+    // for this arena
+    size_t alloc_count = 0;
+    size_t copy_count  = 0;
+
+    // reserve a zeroed block of "count" elements, returning its
+    // offset in the arena
+    size_t reserve(size_t count)
+    {
+        size_t offset = host.size();
+        host.resize(offset + count, 0);
+        return offset;
+    }
+
+    size_t* host_block(size_t offset)
+    {
+        return host.data() + offset;
+    }
+
+    size_t* device_block(size_t offset) const
+    {
+        return device.data() + offset;
+    }
+
+    size_t size_bytes() const
+    {
+        return host.size() * sizeof(size_t);
+    }
+
+    // allocate the device buffer and copy the staging buffer to it;
+    // throws on failure
+    void upload();
+};
+
+// devKernArg : points to the internal length device pointer
+// devKernArg + 1*KERN_ARGS_ARRAY_WIDTH : points to the intenal in
 // stride device pointer
-// data->node->devKernArg + 2*KERN_ARGS_ARRAY_WIDTH : points to the internal out
+// devKernArg + 2*KERN_ARGS_ARRAY_WIDTH : points to the internal out
 // stride device pointer, only used in outof place kernels
-static size_t* kargs_lengths(const gpubuf_t<size_t>& devKernArg)
+static size_t* kargs_lengths(size_t* devKernArg)
 {
-    return devKernArg.data();
+    return devKernArg;
 }
 
-static size_t* kargs_stride_in(const gpubuf_t<size_t>& devKernArg)
+static size_t* kargs_stride_in(size_t* devKernArg)
 {
-    return devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH;
+    return devKernArg + 1 * KERN_ARGS_ARRAY_WIDTH;
 }
 
-static size_t* kargs_stride_out(const gpubuf_t<size_t>& devKernArg)
+static size_t* kargs_stride_out(size_t* devKernArg)
 {
-    return devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH;
+    return devKernArg + 2 * KERN_ARGS_ARRAY_WIDTH;
 }
 
 #endif // defined( KARGS_H )
@@ -34,6 +34,7 @@
 #include "rocfft_hip.h"
 #include "tree_node.h"
 #include <iostream>
+#include <stdexcept>
 
 // FIXME: documentation
 struct DeviceCallIn
@@ -42,9 +43,9 @@ struct DeviceCallIn
     void*     bufIn[2];
     void*     bufOut[2];
 
-    hipStream_t     rocfft_stream;
-    GridParam       gridParam;
-    hipDeviceProp_t deviceProp;
+    hipStream_t            rocfft_stream;
+    GridParam              gridParam;
+    const hipDeviceProp_t* deviceProp;
 
     UserCallbacks callbacks;
 
@@ -63,6 +64,79 @@ struct DeviceCallOut
     int err;
 };
 
+// Work out where a kernel will find operating buffer 'ob' when a
+// plan is executed.  'offset' is the kernel's offset into the
+// Bluestein part of the work buffer, and the work buffer sizes are
+// in elements of 'complexTSize' bytes.
+static inline void SetupLaunchPtrs(OperatingBuffer   ob,
+                                   rocfft_array_type arrayType,
+                                   size_t            offset,
+                                   size_t            tmpWorkBufSize,
+                                   size_t            copyWorkBufSize,
+                                   size_t            complexTSize,
+                                   launch_ptr_t      ptrs[2])
+{
+    switch(ob)
+    {
+    case OB_USER_IN:
+    case OB_USER_OUT:
+        ptrs[0].source = ob == OB_USER_IN ? launch_ptr_t::USER_IN : launch_ptr_t::USER_OUT;
+        if(array_type_is_planar(arrayType))
+        {
+            ptrs[1].source = ptrs[0].source;
+            ptrs[1].index  = 1;
+        }
+        break;
+    case OB_TEMP:
+        ptrs[0].source = launch_ptr_t::WORK;
+        if(array_type_is_planar(arrayType))
+        {
+            // Assume planar using the same extra size of memory as
+            // interleaved format, and we just need to split it for
+            // planar.
+            ptrs[1].source = launch_ptr_t::WORK;
+            ptrs[1].offset = tmpWorkBufSize * complexTSize / 2;
+        }
+        break;
+    case OB_TEMP_CMPLX_FOR_REAL:
+        // TODO: Can we use this in planar as well ??
+        ptrs[0].source = launch_ptr_t::WORK;
+        ptrs[0].offset = tmpWorkBufSize * complexTSize;
+        break;
+    case OB_TEMP_BLUESTEIN:
+        // Bluestein mul-kernels (3 types) work well for CI->CI
+        // so we only consider CI->CI now
+        ptrs[0].source = launch_ptr_t::WORK;
+        ptrs[0].offset = (tmpWorkBufSize + copyWorkBufSize + offset) * complexTSize;
+        break;
+    case OB_UNINIT:
+        throw std::runtime_error("operating buffer not initialized for kernel");
+    default:
+        throw std::runtime_error("operating buffer not specified for kernel");
+    }
+}
+
+// Fill in a kernel's arguments from its launch step and the buffers
+// given to rocfft_execute.  Callbacks are left for the caller.
+static inline void ResolveLaunchStep(const launch_step_t&   step,
+                                     const hipDeviceProp_t* deviceProp,
+                                     hipStream_t            stream,
+                                     void*                  in_buffer[],
+                                     void*                  out_buffer[],
+                                     void*                  work_buffer,
+                                     DeviceCallIn&          data)
+{
+    data.node          = step.node;
+    data.rocfft_stream = stream;
+    data.deviceProp    = deviceProp;
+    data.gridParam     = step.gridParam;
+    for(size_t j = 0; j < 2; ++j)
+    {
+        data.bufIn[j]  = step.bufIn[j].resolve(in_buffer, out_buffer, work_buffer);
+        data.bufOut[j] = step.bufOut[j].resolve(in_buffer, out_buffer, work_buffer);
+    }
+}
+
 /* Naming convention
 
 dfn – device function caller (just a prefix, though actually GPU kernel
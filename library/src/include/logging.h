@@ -26,7 +26,9 @@
 #include "rocfft_ostream.hpp"
 #include "tuple_helper.hpp"
 #include <atomic>
+#include <chrono>
 #include <cmath>
+#include <cstdio>
 #include <cstdlib>
 #include <iomanip>
 #include <iostream>
@@ -40,6 +42,7 @@
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "rocfft.h"
 
@@ -132,19 +135,30 @@ extern int log_profile_fd;
 extern int log_plan_fd;
 extern int log_kernelio_fd;
 extern int log_rtc_fd;
+extern int log_timing_fd;
+extern int log_chrome_trace_fd;
 
 /*! \brief Indicates if layer is active with bitmask*/
 typedef enum rocfft_layer_mode_
 {
-    rocfft_layer_mode_none         = 0b0000000000,
-    rocfft_layer_mode_log_trace    = 0b0000000001, //  1
-    rocfft_layer_mode_log_bench    = 0b0000000010, //  2
-    rocfft_layer_mode_log_profile  = 0b0000000100, //  4
-    rocfft_layer_mode_log_plan     = 0b0000001000, //  8
-    rocfft_layer_mode_log_kernelio = 0b0000010000, // 16
-    rocfft_layer_mode_log_rtc      = 0b0000100000, // 32
+    rocfft_layer_mode_none             = 0b0000000000,
+    rocfft_layer_mode_log_trace        = 0b0000000001, //   1
+    rocfft_layer_mode_log_bench        = 0b0000000010, //   2
+    rocfft_layer_mode_log_profile      = 0b0000000100, //   4
+    rocfft_layer_mode_log_plan         = 0b0000001000, //   8
+    rocfft_layer_mode_log_kernelio     = 0b0000010000, //  16
+    rocfft_layer_mode_log_rtc          = 0b0000100000, //  32
+    rocfft_layer_mode_log_timing       = 0b0001000000, //  64
+    rocfft_layer_mode_log_chrome_trace = 0b0010000000, // 128
 } rocfft_layer_mode;
 
+/*! \brief Format of the records written to the log channels */
+typedef enum rocfft_log_format_
+{
+    rocfft_log_format_text,
+    rocfft_log_format_jsonl,
+} rocfft_log_format;
+
 class LogSingleton
 {
 public:
@@ -158,10 +172,33 @@ private:
     LogSingleton() {}
 
     rocfft_layer_mode layer_mode{};
+    rocfft_log_format log_format{};
 
     LogSingleton(LogSingleton const&);
     void operator=(LogSingleton const&);
 
+    // A thread's stream for one log file.  The stream is recreated if
+    // the library has been cleaned up since it was opened, as the log
+    // file may have changed.
+    struct thread_stream
+    {
+        rocfft_ostream os;
+        size_t         generation = std::numeric_limits<size_t>::max();
+
+        rocfft_ostream* get(int fd)
+        {
+            if(fd == -1)
+                return &rocfft_cerr;
+            auto current = rocfft_ostream::generation();
+            if(generation != current)
+            {
+                os         = rocfft_ostream(fd);
+                generation = current;
+            }
+            return &os;
+        }
+    };
+
 public:
     void SetLayerMode(rocfft_layer_mode mode)
     {
@@ -171,47 +208,48 @@ public:
     {
         return layer_mode;
     }
+    void SetLogFormat(rocfft_log_format format)
+    {
+        log_format = format;
+    }
+    rocfft_log_format GetLogFormat() const
+    {
+        return log_format;
+    }
     rocfft_ostream* GetTraceOS()
     {
-        if(log_trace_fd == -1)
-            return &rocfft_cerr;
-        static thread_local rocfft_ostream log_trace_os(log_trace_fd);
-        return &log_trace_os;
+        static thread_local thread_stream log_trace_os;
+        return log_trace_os.get(log_trace_fd);
     }
     rocfft_ostream* GetBenchOS()
     {
-        if(log_bench_fd == -1)
-            return &rocfft_cerr;
-        static thread_local rocfft_ostream log_bench_os(log_bench_fd);
-        return &log_bench_os;
+        static thread_local thread_stream log_bench_os;
+        return log_bench_os.get(log_bench_fd);
     }
     rocfft_ostream* GetProfileOS()
     {
-        if(log_profile_fd == -1)
-            return &rocfft_cerr;
-        static thread_local rocfft_ostream log_profile_os(log_profile_fd);
-        return &log_profile_os;
+        static thread_local thread_stream log_profile_os;
+        return log_profile_os.get(log_profile_fd);
     }
     rocfft_ostream* GetPlanOS()
     {
-        if(log_plan_fd == -1)
-            return &rocfft_cerr;
-        static thread_local rocfft_ostream log_plan_os(log_plan_fd);
-        return &log_plan_os;
+        static thread_local thread_stream log_plan_os;
+        return log_plan_os.get(log_plan_fd);
     }
     rocfft_ostream* GetKernelIOOS()
     {
-        if(log_kernelio_fd == -1)
-            return &rocfft_cerr;
-        static thread_local rocfft_ostream log_kernelio_os(log_kernelio_fd);
-        return &log_kernelio_os;
+        static thread_local thread_stream log_kernelio_os;
+        return log_kernelio_os.get(log_kernelio_fd);
     }
     rocfft_ostream* GetRTCOS()
     {
-        if(log_rtc_fd == -1)
-            return &rocfft_cerr;
-        static thread_local rocfft_ostream log_rtc_os(log_rtc_fd);
-        return &log_rtc_os;
+        static thread_local thread_stream log_rtc_os;
+        return log_rtc_os.get(log_rtc_fd);
+    }
+    rocfft_ostream* GetTimingOS()
+    {
+        static thread_local thread_stream log_timing_os;
+        return log_timing_os.get(log_timing_fd);
     }
 };
 
@@ -225,6 +263,167 @@ public:
 #define LOG_KERNELIO_ENABLED() \
     (LogSingleton::GetInstance().GetLayerMode() & rocfft_layer_mode_log_kernelio)
 #define LOG_RTC_ENABLED() (LogSingleton::GetInstance().GetLayerMode() & rocfft_layer_mode_log_rtc)
+#define LOG_TIMING_ENABLED() \
+    (LogSingleton::GetInstance().GetLayerMode() & rocfft_layer_mode_log_timing)
+#define LOG_CHROME_TRACE_ENABLED() \
+    (LogSingleton::GetInstance().GetLayerMode() & rocfft_layer_mode_log_chrome_trace)
+#define LOG_JSONL_ENABLED() \
+    (LogSingleton::GetInstance().GetLogFormat() == rocfft_log_format_jsonl)
+
+/************************************************************************************
+ * Structured (JSON lines) log records
+ ************************************************************************************/
+// Builds a JSON object one field at a time, so that a whole record
+// can be written to a log stream as a single line.
+class json_object
+{
+    std::string buf;
+
+    void key(const char* name)
+    {
+        buf += buf.empty() ? "{" : ",";
+        append_string(name);
+        buf += ':';
+    }
+
+    void append_string(const char* s)
+    {
+        buf += '"';
+        for(; *s; ++s)
+        {
+            switch(*s)
+            {
+            case '"':
+                buf += "\\\"";
+                break;
+            case '\\':
+                buf += "\\\\";
+                break;
+            case '\n':
+                buf += "\\n";
+                break;
+            case '\r':
+                buf += "\\r";
+                break;
+            case '\t':
+                buf += "\\t";
+                break;
+            default:
+                if(static_cast<unsigned char>(*s) < 0x20)
+                {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", *s);
+                    buf += escaped;
+                }
+                else
+                    buf += *s;
+            }
+        }
+        buf += '"';
+    }
+
+    void append_number(double x)
+    {
+        // JSON has no representation for NaN or infinity
+        if(!std::isfinite(x))
+        {
+            buf += "null";
+            return;
+        }
+        char str[32];
+        std::snprintf(str, sizeof(str), "%.9g", x);
+        buf += str;
+    }
+
+public:
+    json_object& field(const char* name, const char* value)
+    {
+        key(name);
+        append_string(value);
+        return *this;
+    }
+    json_object& field(const char* name, const std::string& value)
+    {
+        return field(name, value.c_str());
+    }
+    json_object& field(const char* name, bool value)
+    {
+        key(name);
+        buf += value ? "true" : "false";
+        return *this;
+    }
+    template <typename T, std::enable_if_t<std::is_integral<T>::value, int> = 0>
+    json_object& field(const char* name, T value)
+    {
+        key(name);
+        buf += std::to_string(value);
+        return *this;
+    }
+    json_object& field(const char* name, double value)
+    {
+        key(name);
+        append_number(value);
+        return *this;
+    }
+    json_object& field(const char* name, const std::vector<size_t>& values)
+    {
+        key(name);
+        buf += '[';
+        for(size_t i = 0; i < values.size(); ++i)
+        {
+            if(i > 0)
+                buf += ',';
+            buf += std::to_string(values[i]);
+        }
+        buf += ']';
+        return *this;
+    }
+    // add a field whose value is already valid JSON (e.g. a nested
+    // object or array)
+    json_object& raw(const char* name, const std::string& json)
+    {
+        key(name);
+        buf += json;
+        return *this;
+    }
+
+    std::string str() const
+    {
+        return buf.empty() ? "{}" : buf + "}";
+    }
+
+    // write the object to a log stream as one line
+    void write(rocfft_ostream& os) const
+    {
+        os << str() << std::endl;
+    }
+};
+
+// small sequential id for the calling thread, which is easier to
+// read in logs than a native thread handle
+inline size_t log_thread_id()
+{
+    static std::atomic<size_t>       thread_count{0};
+    static thread_local const size_t id = ++thread_count;
+    return id;
+}
+
+// A JSON lines log record.  Every record starts with the time it
+// was created (microseconds since the epoch), the calling thread, the
+// type of event being logged and optionally the plan it pertains to.
+class log_record : public json_object
+{
+public:
+    explicit log_record(const char* event, size_t plan_id = 0)
+    {
+        auto now = std::chrono::system_clock::now().time_since_epoch();
+        field("ts_us", std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+        field("tid", log_thread_id());
+        field("event", event);
+        if(plan_id)
+            field("plan", plan_id);
+    }
+};
 
 // if profile logging is turned on with
 // (layer_mode & rocfft_layer_mode_log_profile) != 0
@@ -250,14 +449,48 @@ static inline void log_arguments(rocfft_ostream& os, const char* sep, H head, Ts
     os << std::endl;
 }
 
+// trace arguments are (name, value) pairs - add each one to a JSON
+// object, formatting the value the same way the text log would
+static inline void log_trace_fields(json_object& args) {}
+
+template <typename V, typename... Ts>
+static inline void log_trace_fields(json_object& args, const char* name, V&& value, Ts&&... xs)
+{
+    rocfft_ostream value_str;
+    value_str << std::forward<V>(value);
+    args.field(name, value_str.str());
+    log_trace_fields(args, std::forward<Ts>(xs)...);
+}
+
 // if trace logging is turned on with
 // (layer_mode & rocbfft_layer_mode_log_trace) != 0
 // log_function will call log_arguments to log arguments with a comma separator
 template <typename... Ts>
-inline void log_trace(Ts&&... xs)
+inline void log_trace(const char* function, Ts&&... xs)
 {
-    if(LOG_TRACE_ENABLED())
-        log_arguments(*LogSingleton::GetInstance().GetTraceOS(), ",", std::forward<Ts>(xs)...);
+    if(!LOG_TRACE_ENABLED())
+        return;
+    auto& os = *LogSingleton::GetInstance().GetTraceOS();
+    if(LOG_JSONL_ENABLED())
+    {
+        json_object args;
+        log_trace_fields(args, std::forward<Ts>(xs)...);
+        log_record("trace").field("function", function).raw("args", args.str()).write(os);
+    }
+    else
+        log_arguments(os, ",", function, std::forward<Ts>(xs)...);
+}
+
+// log the reason an API function failed to the trace log
+inline void log_trace_error(const char* function, const char* what)
+{
+    if(!LOG_TRACE_ENABLED())
+        return;
+    auto& os = *LogSingleton::GetInstance().GetTraceOS();
+    if(LOG_JSONL_ENABLED())
+        log_record("error").field("function", function).field("what", what).write(os);
+    else
+        os << what << std::endl;
 }
 
 // if bench logging is turned on with
@@ -265,10 +498,23 @@ inline void log_trace(Ts&&... xs)
 // log_bench will call log_arguments to log a string that
 // can be input to the executable rocfft-rider.
 template <typename... Ts>
-inline void log_bench(Ts&&... xs)
+inline void log_bench(size_t plan_id, Ts&&... xs)
 {
-    if(LOG_BENCH_ENABLED())
-        log_arguments(*LogSingleton::GetInstance().GetBenchOS(), " ", std::forward<Ts>(xs)...);
+    if(!LOG_BENCH_ENABLED())
+        return;
+    auto& os = *LogSingleton::GetInstance().GetBenchOS();
+    if(LOG_JSONL_ENABLED())
+    {
+        rocfft_ostream command;
+        log_arguments(command, " ", std::forward<Ts>(xs)...);
+        // log_arguments ends the line, which doesn't belong in the field
+        auto command_str = command.str();
+        if(!command_str.empty() && command_str.back() == '\n')
+            command_str.pop_back();
+        log_record("bench", plan_id).field("command", command_str).write(os);
+    }
+    else
+        log_arguments(os, " ", std::forward<Ts>(xs)...);
 }
 
 #endif
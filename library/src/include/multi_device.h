@@ -0,0 +1,255 @@
+/******************************************************************************
+* Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#ifndef ROCFFT_MULTI_DEVICE_H
+#define ROCFFT_MULTI_DEVICE_H
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "../../../shared/gpubuf.h"
+#include "rocfft.h"
+
+class rocfft_ostream;
+
+// Decomposition of a multi-dimensional transform across devices.
+//
+// The data is split into slabs along the slowest dimension, with
+// each device holding one contiguous slab.  The transform runs in
+// four steps:
+//
+// 1. each device transforms the faster dimensions of its slab
+// 2. an all-to-all exchange gives each device a range of columns
+//    (points in the faster dimensions) over the whole slowest
+//    dimension
+// 3. each device transforms the slowest dimension of its columns
+// 4. a second exchange puts the columns back into slabs
+//
+// Everything here is computed on the host, independent of any
+// device, so the schedule can be tested with simulated devices.
+
+// contiguous range of rows or columns
+struct md_range
+{
+    size_t offset = 0;
+    size_t count  = 0;
+};
+
+// Split n items into 'parts' contiguous ranges whose sizes differ
+// by at most one, with the larger ranges first.
+inline std::vector<md_range> md_split(size_t n, size_t parts)
+{
+    std::vector<md_range> ranges(parts);
+    size_t                offset = 0;
+    for(size_t i = 0; i < parts; ++i)
+    {
+        ranges[i].offset = offset;
+        ranges[i].count  = n / parts + (i < n % parts ? 1 : 0);
+        offset += ranges[i].count;
+    }
+    return ranges;
+}
+
+// Copy of a 2D block between devices: 'height' rows of 'width'
+// elements, with rows 'src_pitch' and 'dst_pitch' elements apart.
+// Offsets and sizes count elements, not bytes.
+struct md_copy
+{
+    size_t src_device = 0;
+    size_t dst_device = 0;
+    size_t src_offset = 0;
+    size_t dst_offset = 0;
+    size_t src_pitch  = 0;
+    size_t dst_pitch  = 0;
+    size_t width      = 0;
+    size_t height     = 0;
+};
+
+struct md_decomposition
+{
+    // lengths of the transform, fastest dimension first
+    std::vector<size_t> lengths;
+    // elements per point of the slowest dimension, i.e. the product
+    // of the faster lengths
+    size_t inner = 1;
+
+    // rows of the slowest dimension in each device's slab, and
+    // columns each device transforms in step 3
+    std::vector<md_range> rows;
+    std::vector<md_range> cols;
+
+    // Copies for steps 2 and 4.  They're ordered in rounds where
+    // each device sends one block and receives one block, to spread
+    // the exchange over all links at once.  The first round is the
+    // copies a device makes to itself.
+    std::vector<md_copy> to_columns;
+    std::vector<md_copy> to_slabs;
+
+    size_t devices() const
+    {
+        return rows.size();
+    }
+    // elements in a device's slab (row-major, rows by inner)
+    size_t slab_elements(size_t device) const
+    {
+        return rows[device].count * inner;
+    }
+    // elements in a device's columns (row-major, slowest length by
+    // column count)
+    size_t column_elements(size_t device) const
+    {
+        return lengths.back() * cols[device].count;
+    }
+};
+
+// Decompose a transform of 'lengths' (fastest first) across up to
+// 'devices' devices.  Fewer devices are used if the slowest
+// dimension or the faster dimensions don't have a row or column for
+// every device.
+inline md_decomposition md_decompose(const std::vector<size_t>& lengths, size_t devices)
+{
+    if(lengths.size() < 2)
+        throw std::runtime_error("multi-device transforms need at least two dimensions");
+    if(devices == 0)
+        throw std::runtime_error("multi-device transforms need at least one device");
+
+    md_decomposition dec;
+    dec.lengths = lengths;
+    for(size_t i = 0; i + 1 < lengths.size(); ++i)
+        dec.inner *= lengths[i];
+
+    devices  = std::min({devices, lengths.back(), dec.inner});
+    dec.rows = md_split(lengths.back(), devices);
+    dec.cols = md_split(dec.inner, devices);
+
+    for(size_t round = 0; round < devices; ++round)
+    {
+        for(size_t src = 0; src < devices; ++src)
+        {
+            size_t dst = (src + round) % devices;
+
+            // slab rows 'src' and columns 'dst' are the block where
+            // the two devices' data overlap
+            md_copy copy;
+            copy.src_device = src;
+            copy.dst_device = dst;
+            copy.src_offset = dec.cols[dst].offset;
+            copy.dst_offset = dec.rows[src].offset * dec.cols[dst].count;
+            copy.src_pitch  = dec.inner;
+            copy.dst_pitch  = dec.cols[dst].count;
+            copy.width      = dec.cols[dst].count;
+            copy.height     = dec.rows[src].count;
+            dec.to_columns.push_back(copy);
+
+            // and the same block on its way back
+            std::swap(copy.src_device, copy.dst_device);
+            std::swap(copy.src_offset, copy.dst_offset);
+            std::swap(copy.src_pitch, copy.dst_pitch);
+            dec.to_slabs.push_back(copy);
+        }
+    }
+    return dec;
+}
+
+// Make a device current until the end of the scope.
+class scoped_device
+{
+public:
+    explicit scoped_device(int device)
+    {
+        if(hipGetDevice(&previous) != hipSuccess)
+            throw std::runtime_error("hipGetDevice failure");
+        if(hipSetDevice(device) != hipSuccess)
+            throw std::runtime_error("hipSetDevice failure");
+    }
+    ~scoped_device()
+    {
+        (void)hipSetDevice(previous);
+    }
+    scoped_device(const scoped_device&) = delete;
+    scoped_device& operator=(const scoped_device&) = delete;
+
+private:
+    int previous = 0;
+};
+
+// Per-device resources of a multi-device plan.
+struct md_device
+{
+    int         id     = 0;
+    hipStream_t stream = nullptr;
+    hipEvent_t  event  = nullptr;
+
+    // sub-plans for steps 1 and 3
+    rocfft_plan slab_plan   = nullptr;
+    rocfft_plan column_plan = nullptr;
+    // runs sub-plans on 'stream', in 'work'
+    rocfft_execution_info info = nullptr;
+
+    gpubuf columns;
+    gpubuf work;
+    size_t work_bytes = 0;
+};
+
+// A plan that runs one transform on several devices.
+class multi_device_plan
+{
+public:
+    // Create sub-plans and buffers on each of 'device_ids' for a
+    // complex transform.  Throws on failure.
+    multi_device_plan(const std::vector<int>&    device_ids,
+                      const std::vector<size_t>& lengths,
+                      rocfft_result_placement    placement,
+                      rocfft_transform_type      transform_type,
+                      rocfft_precision           precision);
+    ~multi_device_plan();
+    multi_device_plan(const multi_device_plan&) = delete;
+    multi_device_plan& operator=(const multi_device_plan&) = delete;
+
+    // Run the transform.  Buffers hold one pointer per device, to
+    // that device's slab.  Waits for work already on 'stream', and
+    // returns once the transform is finished on every device.
+    void execute(void* in_buffer[], void* out_buffer[], hipStream_t stream);
+
+    const md_decomposition& decomposition() const
+    {
+        return dec;
+    }
+
+    void print(rocfft_ostream& os) const;
+
+private:
+    md_decomposition       dec;
+    std::vector<md_device> devices;
+    size_t                 element_size;
+    bool                   inplace;
+
+    void release();
+    // all device streams wait for every device's latest event
+    void exchange_barrier();
+    void exchange(const std::vector<md_copy>& copies,
+                  const std::vector<void*>&   src,
+                  const std::vector<void*>&   dst);
+};
+
+#endif // ROCFFT_MULTI_DEVICE_H
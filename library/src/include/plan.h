@@ -23,9 +23,12 @@
 
 #include <array>
 #include <cstring>
+#include <memory>
 #include <vector>
 
 #include "function_pool.h"
+#include "grouped_plan.h"
+#include "multi_device.h"
 #include "tree_node.h"
 
 // Calculate the maximum pow number with the given base number
@@ -64,6 +67,10 @@ struct rocfft_plan_description_t
 
     double scale = 1.0;
 
+    // devices to split the transform across; empty means the
+    // current device
+    std::vector<int> devices;
+
     rocfft_plan_description_t() = default;
 };
 
@@ -83,6 +90,11 @@ struct rocfft_plan_t
     rocfft_plan_t() = default;
 
     ExecPlan execPlan;
+
+    // set instead of execPlan for plans that span devices
+    std::unique_ptr<multi_device_plan> multiDevice;
+    // set instead of execPlan for grouped plans
+    std::unique_ptr<grouped_plan> grouped;
 };
 
 bool PlanPowX(ExecPlan& execPlan);
@@ -0,0 +1,171 @@
+/******************************************************************************
+* Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#ifndef PLAN_TIMING_H
+#define PLAN_TIMING_H
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "logging.h"
+
+// Wall-clock time of one phase of plan creation.  Phases that
+// happen more than once (e.g. one per twiddle table or per kernel)
+// are recorded separately, with a detail string saying which
+// table or kernel it was.
+struct plan_phase_t
+{
+    std::string name;
+    std::string detail;
+    double      ms = 0.0;
+
+    // when and on which thread (see log_thread_id) the phase started
+    std::chrono::steady_clock::time_point start;
+    size_t                                tid = 0;
+};
+
+// Phase timings collected while creating one plan.  Phases may be
+// recorded from other threads (e.g. runtime compilation), so adding
+// is thread-safe.
+class plan_timing
+{
+public:
+    // record a phase that ran on the calling thread
+    void add(const char*                           name,
+             std::string&&                         detail,
+             std::chrono::steady_clock::time_point start,
+             std::chrono::steady_clock::time_point end)
+    {
+        std::chrono::duration<double, std::milli> ms = end - start;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        phases.push_back({name, std::move(detail), ms.count(), start, log_thread_id()});
+    }
+
+    std::vector<plan_phase_t> get_phases() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return phases;
+    }
+
+    size_t phase_count() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return phases.size();
+    }
+
+    // Get one phase, or nullptr if the index is out of range.  Only
+    // call this once the plan is created, since adding phases may
+    // invalidate the pointer.
+    const plan_phase_t* phase(size_t index) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return index < phases.size() ? &phases[index] : nullptr;
+    }
+
+    // The timing that phases on the calling thread are recorded to,
+    // or nullptr if the thread isn't timing a plan.  This lets code
+    // far from the plan (e.g. twiddle creation) time itself without
+    // being passed the plan.
+    static plan_timing*& current()
+    {
+        static thread_local plan_timing* timing = nullptr;
+        return timing;
+    }
+
+private:
+    mutable std::mutex        mutex;
+    std::vector<plan_phase_t> phases;
+};
+
+// Records phases on the calling thread to 'timing' for the lifetime
+// of this object.
+class plan_timing_scope
+{
+    plan_timing* prev;
+
+public:
+    explicit plan_timing_scope(plan_timing* timing)
+        : prev(plan_timing::current())
+    {
+        plan_timing::current() = timing;
+    }
+    ~plan_timing_scope()
+    {
+        plan_timing::current() = prev;
+    }
+    plan_timing_scope(const plan_timing_scope&) = delete;
+    plan_timing_scope& operator=(const plan_timing_scope&) = delete;
+};
+
+// Times a phase from construction until stop() or destruction.  If
+// no plan is being timed, this only costs a null pointer check.
+class phase_timer
+{
+    typedef std::chrono::steady_clock clock;
+
+    plan_timing*      timing;
+    const char*       name;
+    std::string       detail;
+    clock::time_point start;
+
+public:
+    explicit phase_timer(const char* name, plan_timing* timing = plan_timing::current())
+        : timing(timing)
+        , name(name)
+    {
+        if(timing)
+            start = clock::now();
+    }
+    ~phase_timer()
+    {
+        stop();
+    }
+    phase_timer(const phase_timer&) = delete;
+    phase_timer& operator=(const phase_timer&) = delete;
+
+    // true if the time will be recorded, so callers can skip
+    // building a detail string that would not be used
+    bool active() const
+    {
+        return timing != nullptr;
+    }
+
+    void set_detail(std::string&& d)
+    {
+        detail = std::move(d);
+    }
+
+    // record the phase now, instead of at the end of the scope
+    void stop()
+    {
+        if(!timing)
+            return;
+        timing->add(name, std::move(detail), start, clock::now());
+        timing = nullptr;
+    }
+};
+
+#endif // PLAN_TIMING_H
@@ -27,6 +27,13 @@ ROCFFT_DEVICE_EXPORT void complex2hermitian(const void* data, void* back);
 ROCFFT_DEVICE_EXPORT void hermitian2complex(const void* data, void* back);
 ROCFFT_DEVICE_EXPORT void complex2real(const void* data, void* back);
 
+ROCFFT_DEVICE_EXPORT void real2complex_pair(const void* data, void* back);
+ROCFFT_DEVICE_EXPORT void complex2hermitian_pair(const void* data, void* back);
+ROCFFT_DEVICE_EXPORT void hermitian2complex_pair(const void* data, void* back);
+ROCFFT_DEVICE_EXPORT void complex2real_pair(const void* data, void* back);
+ROCFFT_DEVICE_EXPORT void r2r_pre(const void* data, void* back);
+ROCFFT_DEVICE_EXPORT void r2r_post(const void* data, void* back);
+
 ROCFFT_DEVICE_EXPORT void r2c_1d_post(const void* data_p, void*);
 ROCFFT_DEVICE_EXPORT void r2c_1d_post_transpose(const void* data, void* back);
 ROCFFT_DEVICE_EXPORT void c2r_1d_pre(const void* data_p, void*);
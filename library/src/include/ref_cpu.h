@@ -918,7 +918,8 @@ public:
         switch(data->node->scheme)
         {
         case CS_KERNEL_CHIRP:
-            out_size *= 2;
+            // only the second copy of the chirp is written
+            bufOut = ((char*)bufOut + 2 * sizeof(float) * data->node->lengthBlue);
             break;
         case CS_KERNEL_FFT_MUL:
         case CS_KERNEL_PAD_MUL:
@@ -969,7 +970,7 @@ public:
             length_chirp.push_back(data->node->lengthBlue);
             CopyVector((local_fftwf_complex*)libout.data,
                        (local_fftwf_complex*)tmp_mem.data,
-                       2 * data->node->batch,
+                       data->node->batch,
                        data->node->oDist,
                        length_chirp,
                        data->node->outStride);
@@ -25,12 +25,16 @@
 #define REPO_H
 
 #include "../../../shared/gpubuf.h"
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <list>
 #include <map>
 #include <mutex>
 
 class Repo
 {
-    Repo() {}
+    Repo();
 
     // key structure for 1D twiddles - these are the arguments to
     // twiddle creation
@@ -64,6 +68,47 @@ class Repo
                 return radices < other.radices;
             return deviceId < other.deviceId;
         }
+
+        // number of elements a plan reads from the table, or 0 if
+        // it reads the whole buffer
+        size_t elements() const
+        {
+            if(large_twiddle_base || attach_halfN)
+                return 0;
+            return length_limit ? length_limit : length;
+        }
+
+        // Return true if the table for this key begins with the
+        // table for "other", so "other" can be served as a view of
+        // this key's buffer:
+        //
+        // - a length-limited table is a prefix of the unlimited (or
+        //   less limited) table
+        // - a table with attach_halfN has the plain table as its prefix
+        // - a table built from radices holds the tables for every
+        //   leading subset of those radices, one after another
+        //
+        // Large twiddle tables and half-N attachments depend on the
+        // whole length, so those only match exactly.
+        bool subsumes(const repo_key_1D_t& other) const
+        {
+            if(precision != other.precision || deviceId != other.deviceId)
+                return false;
+            if(large_twiddle_base || other.large_twiddle_base || other.attach_halfN)
+                return false;
+            if(radices.empty() != other.radices.empty())
+                return false;
+            if(radices.empty())
+            {
+                if(length != other.length)
+                    return false;
+            }
+            else if(other.radices.size() > radices.size()
+                    || !std::equal(other.radices.begin(), other.radices.end(), radices.begin()))
+                return false;
+            // a half-N attachment comes after the plain table
+            return other.elements() <= (length_limit ? length_limit : length);
+        }
     };
     // key structure for 2D twiddles
     struct repo_key_2D_t
@@ -85,34 +130,82 @@ class Repo
                 return precision < other.precision;
             return deviceId < other.deviceId;
         }
+
+        size_t elements() const
+        {
+            return 0;
+        }
+
+        // 2D tables are only shared between identical keys
+        bool subsumes(const repo_key_2D_t&) const
+        {
+            return false;
+        }
     };
 
     // twiddle tables are buffers in device memory, along with a
-    // reference count
+    // reference count.  The count includes every plan that was
+    // handed a view of the buffer because the buffer subsumes the
+    // table it asked for.
     //
-    // NOTE: some buffers might be more shareable here (e.g. simple
-    // 1D might match half of a 2D twiddle, or a simple 1D might be
-    // shareable with a same-length attach_halfN buffer)
-    std::map<repo_key_1D_t, std::pair<gpubuf, unsigned int>> twiddles_1D;
-    std::map<repo_key_2D_t, std::pair<gpubuf, unsigned int>> twiddles_2D;
+    // NOTE: a 1D table might also match the first half of a 2D
+    // table, but 2D keys don't record the radices needed to tell.
+    struct repo_entry_t
+    {
+        gpubuf       buf;
+        unsigned int refcount = 0;
+        // position in the unused list, once refcount drops to 0
+        std::list<void*>::iterator unused_pos;
+        // true while a thread is creating the table without holding
+        // the lock - other threads wanting it wait on "ready"
+        bool                                        creating = false;
+        std::shared_future<std::pair<void*, size_t>> ready;
+    };
+    std::map<repo_key_1D_t, repo_entry_t> twiddles_1D;
+    std::map<repo_key_2D_t, repo_entry_t> twiddles_2D;
     // reverse-map the device pointers back to the keys so users can
     // free the pointer they were given
     std::map<void*, repo_key_1D_t> twiddles_1D_reverse;
     std::map<void*, repo_key_2D_t> twiddles_2D_reverse;
     static std::mutex              mtx;
 
+    // Tables that no plan is using stay resident while they fit in
+    // the budget, so that plans created later can reuse them.  The
+    // unused list is ordered from most to least recently used, and
+    // the least recently used tables are freed first.
+    size_t           unused_budget = 0;
+    size_t           unused_bytes  = 0;
+    std::list<void*> unused;
+
+    // number of requests served by an existing table, and number
+    // that had to create one
+    size_t hits   = 0;
+    size_t misses = 0;
+
+    // number and bytes of finished tables in device memory.  These
+    // are updated under the lock, but can be read without it.
+    static std::atomic<size_t> resident_tables;
+    static std::atomic<size_t> resident_bytes;
+
     // internal helpers to get and free twiddles
     template <typename KeyType>
-    static std::pair<void*, size_t>
-        GetTwiddlesInternal(KeyType,
-                            std::map<KeyType, std::pair<gpubuf, unsigned int>>&,
-                            std::map<void*, KeyType>&,
-                            std::function<gpubuf()>);
+    static std::pair<void*, size_t> GetTwiddlesInternal(std::unique_lock<std::mutex>&,
+                                                        KeyType,
+                                                        std::map<KeyType, repo_entry_t>&,
+                                                        std::map<void*, KeyType>&,
+                                                        std::function<gpubuf()>);
     template <typename KeyType>
     static void ReleaseTwiddlesInternal(void* ptr,
-                                        std::map<KeyType, std::pair<gpubuf, unsigned int>>&,
+                                        std::map<KeyType, repo_entry_t>&,
                                         std::map<void*, KeyType>&);
 
+    // free a table that no plan is using
+    template <typename KeyType>
+    bool EvictInternal(void* ptr, std::map<KeyType, repo_entry_t>&, std::map<void*, KeyType>&);
+    // free least recently used tables until unused tables fit in
+    // the budget
+    void EvictUnused(size_t budget);
+
 public:
     // repo is a singleton, so no copying or assignment
     Repo(const Repo&) = delete;
@@ -127,6 +220,8 @@ public:
     ~Repo()
     {
         repoDestroyed = true;
+        resident_tables.store(0, std::memory_order_relaxed);
+        resident_bytes.store(0, std::memory_order_relaxed);
     }
 
     static std::pair<void*, size_t> GetTwiddles1D(size_t                     length,
@@ -142,6 +237,24 @@ public:
     // remove cached twiddles
     static void Clear();
 
+    // set the number of bytes of unused twiddle tables to keep
+    static void SetUnusedBudget(size_t budget);
+    // get the budget, bytes of tables in use and unused, the number
+    // of tables, and the hit/miss counts
+    static void GetUsage(size_t& budget,
+                         size_t& used_bytes,
+                         size_t& unused_bytes,
+                         size_t& tables,
+                         size_t& hits,
+                         size_t& misses);
+    // get the number and bytes of tables in device memory, without
+    // waiting for the lock
+    static void GetResident(size_t& tables, size_t& bytes)
+    {
+        tables = resident_tables.load(std::memory_order_relaxed);
+        bytes  = resident_bytes.load(std::memory_order_relaxed);
+    }
+
     // Repo is a singleton that should only be destroyed on static
     // deinitialization.  But it's possible for other things to want to
     // destroy plans at static deinitialization time.  So keep track of
@@ -24,24 +24,25 @@
 #define _ROCFFT_OSTREAM_HPP_
 
 #include "rocfft.h"
+#include <atomic>
 #include <cmath>
 #include <complex>
 #include <condition_variable>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
-#include <future>
 #include <iomanip>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <ostream>
-#include <queue>
+#include <shared_mutex>
 #include <sstream>
 #include <string>
 #include <sys/stat.h>
 #include <thread>
 #include <utility>
+#include <vector>
 #ifdef WIN32
 #include <io.h>
 #include <iostream>
@@ -83,75 +84,145 @@ private:
     /**************************************************************************
      * The worker class sets up a worker thread for writing to log files. Two *
      * files are considered the same if they have the same device ID / inode. *
+     *                                                                        *
+     * Each stream writing to a worker gets its own single-producer,          *
+     * single-consumer ring of records, so threads logging to the same file   *
+     * never wait on each other or on the file.  The worker thread drains     *
+     * all of the rings and writes their records in timestamp order.          *
      **************************************************************************/
     class worker
     {
-        // task_t represents a payload of data and a promise to finish
-        class task_t
+    public:
+        // A fixed-size ring of formatted records from one stream.  The
+        // stream is the only producer; whoever holds the worker's
+        // write_mutex is the only consumer.
+        class ring
         {
-            std::string        str;
-            std::promise<void> promise;
-
         public:
-            // The task takes ownership of the string payload
-            explicit task_t(std::string&& str)
-                : str(std::move(str))
-            {
-            }
+            // bounds on the records and bytes queued in one ring - when
+            // the writer falls this far behind, the stream writes the
+            // ring out itself, or drops new records if the file is busy
+            static const size_t max_records = 1024;
+            static const size_t max_bytes   = 32 * 1024 * 1024;
 
-            auto get_future()
+            struct record_t
             {
-                return promise.get_future();
-            }
-
-            // Notify the future to wake up
-            void set_value()
-            {
-                promise.set_value();
-            }
-
-            // Size of the string payload
-            size_t size() const
-            {
-                return str.size();
-            }
-
-            // Data of the string payload
-            const char* data() const
-            {
-                return str.data();
-            }
+                uint64_t    timestamp = 0;
+                std::string str;
+            };
+
+            // Add a record, returning false if the ring is full
+            bool push(uint64_t timestamp, std::string&& str);
+            // Remove the oldest record, returning false if the ring is empty
+            bool pop(record_t& record);
+
+            // set by the producer when it will not push any more records
+            std::atomic<bool> closed{false};
+
+        private:
+            record_t            records[max_records];
+            std::atomic<size_t> head{0};
+            std::atomic<size_t> tail{0};
+            std::atomic<size_t> bytes{0};
         };
 
+    private:
         // FILE is used for safety in the presence of signals
         FILE* file = nullptr;
 
+        // Set if writing the file failed, after which records are discarded
+        bool write_failed = false;
+
         // This worker's thread
         std::thread thread;
 
-        // Condition variable for worker notification
+        // Condition variable and mutex for waking the worker thread
         std::condition_variable cond;
+        std::mutex              wake_mutex;
+        std::atomic<bool>       pending{false};
+        bool                    stop = false;
+
+        // Set while the worker thread holds write_mutex without
+        // writing anything (see hold_writes), and once it has taken it
+        bool holding = false;
+        bool held    = false;
 
-        // Mutex for this thread's queue
-        std::mutex mutex;
+        // The rings of all streams writing to this worker
+        std::mutex                         rings_mutex;
+        std::vector<std::shared_ptr<ring>> rings;
 
-        // Queue of tasks
-        std::queue<task_t> queue;
+        // Serializes draining, which may happen on the worker thread or
+        // on a thread that wants the log written out (e.g. at cleanup)
+        std::mutex write_mutex;
 
-        // Worker thread which waits for and handles tasks sequentially
+        // Worker thread which waits for and drains records
         void thread_function();
 
+        // Write out everything queued so far, with write_mutex held
+        void drain_locked();
+
     public:
         // Worker constructor creates a worker thread for a raw filehandle
         explicit worker(int fd);
 
-        // Send a string to be written
-        void send(std::string);
+        // Create a ring for a new stream to write records to
+        std::shared_ptr<ring> add_ring();
+
+        // Queue a string to be written from a stream's ring.  If the
+        // ring is full, it's written out on the calling thread, unless
+        // the file is busy being written by another thread - then the
+        // string is dropped.
+        void send(ring& r, std::string&& str);
+
+        // Write out everything queued so far, returning when it has
+        // been written
+        void drain();
+
+        // Let the worker thread write again, if it was holding the
+        // file without writing
+        void release();
 
         // Destroy a worker when all std::shared_ptr references to it are gone
         ~worker();
     };
 
+    // A stream's reference to its ring, which tells the worker when the
+    // stream is done with the ring
+    class ring_handle
+    {
+        std::shared_ptr<worker::ring> ring_ptr;
+
+        void close()
+        {
+            if(ring_ptr)
+                ring_ptr->closed.store(true, std::memory_order_release);
+        }
+
+    public:
+        ring_handle() = default;
+        ring_handle(ring_handle&&) = default;
+        ring_handle& operator=(ring_handle&& other)
+        {
+            close();
+            ring_ptr = std::move(other.ring_ptr);
+            return *this;
+        }
+        ring_handle& operator=(std::shared_ptr<worker::ring>&& r)
+        {
+            close();
+            ring_ptr = std::move(r);
+            return *this;
+        }
+        ~ring_handle()
+        {
+            close();
+        }
+        worker::ring* get() const
+        {
+            return ring_ptr.get();
+        }
+    };
+
     // Two filehandles point to the same file if they share the same (std_dev, std_ino).
 
     // Initial slice of struct stat which contains device ID and inode
@@ -176,14 +247,34 @@ private:
     // Worker thread for accepting tasks
     std::shared_ptr<worker> worker_ptr;
 
-    // Get worker for file descriptor
-    static std::shared_ptr<worker> get_worker(int fd);
+    // This stream's ring on the worker, created on first flush
+    ring_handle ring;
 
-    // map of files to workers (and associated mutex), allocated
-    // during setup() and freed during cleanup()
+    // Get worker for file descriptor.  Workers for descriptors that
+    // stay open until cleanup() (e.g. log files) are remembered by
+    // descriptor, which avoids an fstat on later lookups.
+    static std::shared_ptr<worker> get_worker(int fd, bool remember_fd);
+
+    // maps of files and descriptors to workers (and associated mutex),
+    // allocated during setup() and freed during cleanup()
     typedef std::map<file_id_t, std::shared_ptr<worker>, file_id_less> worker_map_t;
+    typedef std::map<int, std::shared_ptr<worker>>                     worker_fd_map_t;
     static std::unique_ptr<worker_map_t>                               worker_map;
-    static std::unique_ptr<std::recursive_mutex>                       worker_map_mutex;
+    static std::unique_ptr<worker_fd_map_t>                            worker_fd_map;
+    static std::unique_ptr<std::shared_timed_mutex>                    worker_map_mutex;
+
+    // incremented by setup() and cleanup(), so long-lived streams can
+    // tell that the log files they were created for have been closed
+    static std::atomic<size_t> log_generation;
+
+    // count of records dropped because a ring was full
+    static std::atomic<size_t> dropped_count;
+
+    // Test hook, set at setup() from ROCFFT_LOG_HOLD_WRITES.  Workers
+    // created while it's set hold their file without writing until
+    // cleanup(), so each stream's ring fills up and every record
+    // after that is dropped, regardless of timing.
+    static bool hold_writes;
 
 public:
     // Default constructor is a std::ostringstream with no worker
@@ -229,6 +320,27 @@ public:
     // Flush the output
     void flush();
 
+    // Current logging generation - changes whenever the library is
+    // set up or cleaned up
+    static size_t generation()
+    {
+        return log_generation.load(std::memory_order_acquire);
+    }
+
+    // Number of records dropped since the process started or the
+    // last reset_dropped_records().  Records are only dropped when a
+    // stream's ring is full while its file is being written, i.e.
+    // when the file can't keep up.  Everything else a stream has
+    // flushed is written by the time cleanup() returns.
+    static size_t dropped_records()
+    {
+        return dropped_count.load(std::memory_order_relaxed);
+    }
+    static void reset_dropped_records()
+    {
+        dropped_count.store(0, std::memory_order_relaxed);
+    }
+
     // Destroy the rocfft_ostream
     virtual ~rocfft_ostream();
 
@@ -0,0 +1,134 @@
+/******************************************************************************
+* Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+// Index math for Stockham kernels that exchange data between passes
+// with cross-lane shuffles instead of going through LDS.
+//
+// After pass p (radix "width", cumulative height "cumheight"), lane
+// "thread" holds the element at
+//
+//   (tid / cumheight) * (width * cumheight) + tid % cumheight + w * cumheight
+//
+// in register h * width + w, where tid = thread + h * threads_per_transform.
+// Pass p + 1 wants element tid' + w' * length / width' in register
+// h' * width' + w'.  The exchange moves each element from the former
+// location to the latter.
+//
+// The generator uses these helpers to emit the shuffles and host
+// tests use them to emulate what the generated code does.
+
+// Largest transform that we allow to do its exchanges in registers.
+static const unsigned int SHFL_EXCHANGE_MAX_LENGTH = 64;
+// All transforms must fit in a single wavefront, for wave32 and wave64.
+static const unsigned int SHFL_EXCHANGE_MAX_THREADS = 32;
+
+// Lane and register to read a value from.  T is unsigned int on the
+// host, or an expression of the lane's thread index in the generator.
+template <typename T>
+struct ShflExchangeIndex
+{
+    T lane;
+    T reg;
+};
+typedef ShflExchangeIndex<unsigned int> ShflExchangeSource;
+
+// Return true if a kernel of the given shape can do all of its
+// exchanges with shuffles.  Every thread must do the same number of
+// butterflies in every pass (so no lane is idle during an exchange)
+// and the lanes of a transform must be a power-of-2 sized segment of
+// a wavefront.
+static inline bool shfl_exchange_supported(unsigned int                     length,
+                                           const std::vector<unsigned int>& factors,
+                                           unsigned int                     threads_per_transform)
+{
+    if(length > SHFL_EXCHANGE_MAX_LENGTH || threads_per_transform == 0
+       || threads_per_transform > SHFL_EXCHANGE_MAX_THREADS)
+        return false;
+    if(threads_per_transform & (threads_per_transform - 1))
+        return false;
+    return std::all_of(factors.begin(), factors.end(), [=](unsigned int width) {
+        return length % (width * threads_per_transform) == 0;
+    });
+}
+
+// Find where register "reg" of lane "thread" gets its value from,
+// when exchanging data between pass "npass" and pass "npass + 1".
+// The generator emits this same math with "thread" as an expression.
+template <typename T>
+static inline ShflExchangeIndex<T>
+    shfl_exchange_index(unsigned int                     length,
+                        const std::vector<unsigned int>& factors,
+                        unsigned int                     threads_per_transform,
+                        unsigned int                     npass,
+                        const T&                         thread,
+                        unsigned int                     reg)
+{
+    unsigned int cumheight = 1;
+    for(unsigned int i = 0; i < npass; ++i)
+        cumheight *= factors[i];
+    const unsigned int width      = factors[npass];
+    const unsigned int next_width = factors[npass + 1];
+
+    // element wanted by the next pass
+    const T idx = thread + (reg / next_width) * threads_per_transform
+                  + (reg % next_width) * length / next_width;
+
+    // butterfly and register that produced it in this pass
+    const T tid = (idx / (width * cumheight)) * cumheight + idx % cumheight;
+    const T w   = (idx / cumheight) % width;
+
+    return {tid % threads_per_transform, (tid / threads_per_transform) * width + w};
+}
+
+static inline ShflExchangeSource
+    shfl_exchange_source(unsigned int                     length,
+                         const std::vector<unsigned int>& factors,
+                         unsigned int                     threads_per_transform,
+                         unsigned int                     npass,
+                         unsigned int                     thread,
+                         unsigned int                     reg)
+{
+    return shfl_exchange_index(length, factors, threads_per_transform, npass, thread, reg);
+}
+
+// Source registers that register "reg" reads from, across all lanes
+// of a transform.  Each needs its own shuffle, since a shuffle reads
+// the same register from every lane.
+static inline std::vector<unsigned int>
+    shfl_exchange_candidates(unsigned int                     length,
+                             const std::vector<unsigned int>& factors,
+                             unsigned int                     threads_per_transform,
+                             unsigned int                     npass,
+                             unsigned int                     reg)
+{
+    std::set<unsigned int> candidates;
+    for(unsigned int thread = 0; thread < threads_per_transform; ++thread)
+        candidates.insert(
+            shfl_exchange_source(length, factors, threads_per_transform, npass, thread, reg).reg);
+    return {candidates.begin(), candidates.end()};
+}
@@ -0,0 +1,208 @@
+/******************************************************************************
+* Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#ifndef ROCFFT_STATISTICS_H
+#define ROCFFT_STATISTICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "rocfft.h"
+#include "tree_node.h"
+
+// Counter updated rarely enough (e.g. once per plan) that threads
+// won't contend on it.
+class stat_counter
+{
+    std::atomic<size_t> value{0};
+
+public:
+    void add(size_t n = 1)
+    {
+        value.fetch_add(n, std::memory_order_relaxed);
+    }
+    size_t get() const
+    {
+        return value.load(std::memory_order_relaxed);
+    }
+    void reset()
+    {
+        value.store(0, std::memory_order_relaxed);
+    }
+};
+
+// Power-of-two histogram of durations, bucketed the way
+// rocfft_statistics documents, plus the total.
+class stat_histogram
+{
+    std::atomic<uint64_t>                                                total_ns{0};
+    std::array<std::atomic<size_t>, ROCFFT_STATISTICS_HISTOGRAM_BUCKETS> buckets{};
+
+public:
+    void add(std::chrono::nanoseconds duration)
+    {
+        uint64_t ns = duration.count() > 0 ? duration.count() : 0;
+        total_ns.fetch_add(ns, std::memory_order_relaxed);
+
+        // bucket is the number of bits in the duration in microseconds
+        size_t bucket = 0;
+        for(uint64_t us = ns / 1000; us && bucket < buckets.size() - 1; us >>= 1)
+            ++bucket;
+        buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+    double total_ms() const
+    {
+        return total_ns.load(std::memory_order_relaxed) / 1e6;
+    }
+    void get(size_t* out) const
+    {
+        for(size_t i = 0; i < buckets.size(); ++i)
+            out[i] = buckets[i].load(std::memory_order_relaxed);
+    }
+    void reset()
+    {
+        total_ns.store(0, std::memory_order_relaxed);
+        for(auto& b : buckets)
+            b.store(0, std::memory_order_relaxed);
+    }
+};
+
+// Counters updated on every execution.  Each thread increments its
+// own cache-line-aligned shard, so concurrent executions don't
+// bounce a shared line between cores; reads sum the shards.
+class stat_sharded_counters
+{
+public:
+    // index of each counter
+    static const size_t NUM_SCHEMES     = CS_NUM_SCHEMES;
+    static const size_t EXECUTIONS      = 0;
+    static const size_t KERNEL_LAUNCHES = 1;
+    static const size_t NUM_COUNTERS    = 2 + 2 * NUM_SCHEMES;
+
+    // executions of plans whose root node has this scheme
+    static size_t scheme_executions(ComputeScheme scheme)
+    {
+        return 2 + scheme;
+    }
+    // kernel launches of nodes with this scheme
+    static size_t scheme_launches(ComputeScheme scheme)
+    {
+        return 2 + NUM_SCHEMES + scheme;
+    }
+
+    void add(size_t counter, size_t n = 1)
+    {
+        shards[shard_index()].values[counter].fetch_add(n, std::memory_order_relaxed);
+    }
+    size_t get(size_t counter) const
+    {
+        size_t sum = 0;
+        for(const auto& s : shards)
+            sum += s.values[counter].load(std::memory_order_relaxed);
+        return sum;
+    }
+    void reset()
+    {
+        for(auto& s : shards)
+            for(auto& v : s.values)
+                v.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static const size_t NUM_SHARDS = 16;
+
+    struct alignas(64) shard
+    {
+        std::array<std::atomic<size_t>, NUM_COUNTERS> values{};
+    };
+    std::array<shard, NUM_SHARDS> shards;
+
+    static size_t shard_index()
+    {
+        static std::atomic<size_t> next_shard{0};
+        static thread_local size_t index
+            = next_shard.fetch_add(1, std::memory_order_relaxed) % NUM_SHARDS;
+        return index;
+    }
+};
+
+// While one of these is alive, plans created, destroyed and executed
+// on this thread are parts of another plan (e.g. a multi-device
+// plan's per-device sub-plans), so they don't count as plans or
+// executions of their own.  Their kernel launches still count.
+class stat_sub_plan_scope
+{
+public:
+    stat_sub_plan_scope()
+    {
+        ++depth();
+    }
+    ~stat_sub_plan_scope()
+    {
+        --depth();
+    }
+    stat_sub_plan_scope(const stat_sub_plan_scope&) = delete;
+    stat_sub_plan_scope& operator=(const stat_sub_plan_scope&) = delete;
+
+    static bool active()
+    {
+        return depth() > 0;
+    }
+
+private:
+    static int& depth()
+    {
+        static thread_local int value = 0;
+        return value;
+    }
+};
+
+// Process-wide counters behind rocfft_get_statistics.
+struct rocfft_stats
+{
+    stat_counter   plans_created;
+    stat_counter   plan_create_failures;
+    stat_counter   plans_destroyed;
+    stat_histogram plan_create;
+
+    stat_counter   rtc_cache_hits;
+    stat_counter   rtc_cache_misses;
+    stat_counter   rtc_compiles;
+    stat_histogram rtc_compile;
+
+    stat_counter work_buffer_allocs;
+    stat_counter work_buffer_bytes;
+
+    stat_sharded_counters exec;
+
+    static rocfft_stats& get()
+    {
+        static rocfft_stats stats;
+        return stats;
+    }
+
+    void reset();
+};
+
+#endif // ROCFFT_STATISTICS_H
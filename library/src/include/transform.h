@@ -25,6 +25,30 @@
 
 #include "rocfft_hip.h"
 
+#include <memory>
+#include <vector>
+
+// Events recorded by executions with one execution info, for
+// rocfft_execution_info_get_events.  Events come from a process-wide
+// pool as they're first needed, are re-recorded by each execution,
+// and go back to the pool when the info is destroyed.
+struct execution_events
+{
+    rocfft_event_mode mode = rocfft_event_mode_none;
+    // every event taken from the pool
+    std::vector<hipEvent_t> events;
+    // number of events recorded by the last execution
+    size_t count = 0;
+
+    execution_events() = default;
+    ~execution_events();
+    execution_events(const execution_events&) = delete;
+    execution_events& operator=(const execution_events&) = delete;
+
+    // record the next event on 'stream'
+    void record(hipStream_t stream);
+};
+
 struct rocfft_execution_info_t
 {
     void*       workBuffer;
@@ -36,6 +60,11 @@ struct rocfft_execution_info_t
     {
     }
     UserCallbacks callbacks;
+    bool          graphReplay = false;
+
+    // shared so that rocfft_execute's copy of the info records into
+    // the caller's events
+    std::shared_ptr<execution_events> events;
 };
 
 void TransformPowX(const ExecPlan&       execPlan,
@@ -43,4 +72,13 @@ void TransformPowX(const ExecPlan&       execPlan,
                    void*                 out_buffer[],
                    rocfft_execution_info info);
 
+// Log the profiles of kernels launched on user streams, waiting for
+// any that are still running.
+void ResolveKernelProfiles();
+
+// Destroy the events in the pool used by execution_events.  Events
+// that execution infos give back afterwards are destroyed instead of
+// pooled, until an execution needs events again.
+void ReleaseExecutionEvents();
+
 #endif // TRANSFORM_H
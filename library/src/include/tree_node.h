@@ -35,6 +35,7 @@
 #include "../device/kernels/callback.h"
 #include "../device/kernels/common.h"
 #include "kargs.h"
+#include "plan_timing.h"
 #include "rtc.h"
 #include <hip/hip_runtime_api.h>
 
@@ -76,8 +77,19 @@ enum ComputeScheme
     CS_KERNEL_TRANSPOSE_CMPLX_TO_R,
     CS_REAL_2D_EVEN,
     CS_REAL_3D_EVEN,
+    CS_REAL_TRANSFORM_ODD,
     CS_KERNEL_APPLY_CALLBACK,
 
+    CS_REAL_TRANSFORM_PAIR,
+    CS_KERNEL_PAIR_R_TO_CMPLX,
+    CS_KERNEL_PAIR_CMPLX_TO_HERM,
+    CS_KERNEL_PAIR_HERM_TO_CMPLX,
+    CS_KERNEL_PAIR_CMPLX_TO_R,
+
+    CS_REAL_TO_REAL,
+    CS_KERNEL_R2R_PRE,
+    CS_KERNEL_R2R_POST,
+
     CS_BLUESTEIN,
     CS_KERNEL_CHIRP,
     CS_KERNEL_PAD_MUL,
@@ -101,7 +113,25 @@ enum ComputeScheme
     CS_3D_BLOCK_CR,
     CS_3D_RC,
     CS_KERNEL_3D_STOCKHAM_BLOCK_CC, // not implemented yet
-    CS_KERNEL_3D_SINGLE // not implemented yet
+    CS_KERNEL_3D_SINGLE, // not implemented yet
+
+    // number of schemes, which must stay last
+    CS_NUM_SCHEMES
+};
+
+// Kind of real-to-real transform, matching the DCT/DST values of
+// rocfft_transform_type
+enum class R2RType
+{
+    NONE,
+    DCT_I,
+    DCT_II,
+    DCT_III,
+    DCT_IV,
+    DST_I,
+    DST_II,
+    DST_III,
+    DST_IV,
 };
 
 enum NodeType
@@ -174,6 +204,19 @@ static bool is_cube_size(const std::vector<size_t>& length)
     return length.size() == 3 && length[0] == length[1] && length[1] == length[2];
 }
 
+// odd-length real transforms done in a single kernel, that read or
+// write real data directly on one side
+static bool ebtype_is_odd(EmbeddedType ebtype)
+{
+    return ebtype == EmbeddedType::Real2C_ODD || ebtype == EmbeddedType::C2Real_ODD;
+}
+
+// embedded processing that only runtime-compiled kernels implement
+static bool ebtype_is_rtc_only(EmbeddedType ebtype)
+{
+    return ebtype_is_odd(ebtype) || ebtype == EmbeddedType::Real2Real;
+}
+
 inline size_t sizeof_precision(rocfft_precision precision)
 {
     switch(precision)
@@ -205,11 +248,13 @@ struct NodeMetaData
     rocfft_array_type       outArrayType = rocfft_array_type_unset;
     hipDeviceProp_t         deviceProp   = {};
     bool                    rootIsC2C;
+    R2RType                 r2rType = R2RType::NONE;
 
     explicit NodeMetaData(TreeNode* refNode);
 };
 
 class rocfft_ostream;
+class graph_cache;
 
 class FuseShim
 {
@@ -356,9 +401,21 @@ public:
     // embedded C2R/R2C pre/post processing
     EmbeddedType ebtype = EmbeddedType::NONE;
 
+    // kind of DCT/DST, set on real-to-real plans and their
+    // pre/post-processing kernels
+    R2RType r2rType = R2RType::NONE;
+    // length of the real-to-real transform done by a Stockham kernel
+    // with Real2Real embedded processing, whose own length is that
+    // of the FFT it uses
+    size_t r2rLength = 0;
+
     // sbrc transpose type
     SBRC_TRANSPOSE_TYPE sbrcTranstype = SBRC_TRANSPOSE_TYPE::NONE;
 
+    // kernel of a grouped plan, which reads per-block problem tables
+    // from devKernArg instead of lengths and strides
+    bool grouped = false;
+
     // Tree structure:
     // non-owning pointer to parent node, may be null
     TreeNode* parent = nullptr;
@@ -377,14 +434,15 @@ public:
 
     // Device pointers:
     // twiddle memory is owned by the repo
-    void*            twiddles            = nullptr;
-    size_t           twiddles_size       = 0;
-    void*            twiddles_large      = nullptr;
-    size_t           twiddles_large_size = 0;
-    gpubuf_t<size_t> devKernArg;
-
-    // callback parameters
-    UserCallbacks callbacks;
+    void*  twiddles            = nullptr;
+    size_t twiddles_size       = 0;
+    void*  twiddles_large      = nullptr;
+    size_t twiddles_large_size = 0;
+    // kernel arguments are owned by the plan's arena; the offset is
+    // assigned when the arena is laid out, and the pointer once it
+    // is uploaded
+    size_t  devKernArgOffset = 0;
+    size_t* devKernArg       = nullptr;
 
     hipDeviceProp_t deviceProp = {};
 
@@ -524,7 +582,7 @@ public:
     }
 
     virtual bool KernelCheck()                                             = 0;
-    virtual bool CreateDevKernelArgs()                                     = 0;
+    virtual void CreateDevKernelArgs(kargs_arena& arena)                   = 0;
     virtual bool CreateTwiddleTableResource()                              = 0;
     virtual void SetupGridParamAndFuncPtr(DevFnCall& fnPtr, GridParam& gp) = 0;
 
@@ -562,10 +620,9 @@ protected:
         nodeType = NT_INTERNAL;
     }
 
-    bool CreateDevKernelArgs() override
+    void CreateDevKernelArgs(kargs_arena& arena) override
     {
         throw std::runtime_error("Shouldn't call CreateDevKernelArgs in a non-LeafNode");
-        return false;
     }
 
     bool CreateTwiddleTableResource() override
@@ -628,7 +685,7 @@ protected:
 public:
     bool         KernelCheck() override;
     void         SanityCheck() override;
-    virtual bool CreateDevKernelArgs() override;
+    virtual void CreateDevKernelArgs(kargs_arena& arena) override;
     bool         CreateTwiddleTableResource() override;
     void         SetupGridParamAndFuncPtr(DevFnCall& fnPtr, GridParam& gp) override;
     void         GetKernelFactors();
@@ -653,6 +710,38 @@ protected:
     void SetupGPAndFnPtr_internal(DevFnCall& fnPtr, GridParam& gp) override;
 
 public:
+    // Shape of the problem as the transpose kernels see it: "count"
+    // matrices of m rows by n columns.  This mirrors the setup done
+    // by the ahead-of-time compiled transpose launcher.
+    struct MatrixDims
+    {
+        size_t m, n;
+        size_t ld_in, ld_out;
+        size_t count;
+        // index into the stride arrays of the distance between matrices
+        size_t batchStrideIdx;
+    };
+    MatrixDims GetMatrixDims() const;
+
+    // Number of 256-entry steps of large twiddle to multiply by, or
+    // 0 if this transpose has no large twiddle multiply.
+    size_t LargeTwiddleSteps() const;
+
+    // Whether thread blocks should walk the matrix diagonally.
+    bool UseDiagonal() const;
+
+    // Tile width (tiles are square) and thread block height for a
+    // runtime-compiled transpose, chosen from the problem dimensions.
+    std::pair<unsigned int, unsigned int> TileDims() const;
+
+    // Tile width and thread block height of the ahead-of-time
+    // compiled transpose kernels.
+    std::pair<unsigned int, unsigned int> DefaultTileDims() const
+    {
+        return precision == rocfft_precision_single ? std::make_pair(64u, 16u)
+                                                    : std::make_pair(32u, 32u);
+    }
+
     // Transpose tiles read more row-ish and write more column-ish.  So
     // assume output benefits more from padding than input.
     bool PaddingBenefitsOutput() override
@@ -668,8 +757,69 @@ public:
     }
 };
 
+// Where one of a kernel's buffer pointers comes from when the plan
+// is executed: a planar component of a user buffer, or an offset into
+// the work buffer.
+struct launch_ptr_t
+{
+    enum source_t
+    {
+        NONE,
+        USER_IN,
+        USER_OUT,
+        WORK,
+    };
+    source_t source = NONE;
+    // planar component of a user buffer
+    size_t index = 0;
+    // offset into the work buffer, in bytes
+    size_t offset = 0;
+
+    void* resolve(void* in_buffer[], void* out_buffer[], void* work_buffer) const
+    {
+        switch(source)
+        {
+        case USER_IN:
+            return in_buffer[index];
+        case USER_OUT:
+            return out_buffer[index];
+        case WORK:
+            return static_cast<char*>(work_buffer) + offset;
+        case NONE:
+            break;
+        }
+        return nullptr;
+    }
+};
+
+// Everything needed to launch one kernel of a plan that doesn't
+// depend on the arguments to rocfft_execute, worked out once when
+// the plan is created.
+struct launch_step_t
+{
+    TreeNode* node = nullptr;
+
+    // kernel to launch: a runtime-compiled kernel (with or without
+    // callbacks) if one is available, otherwise a built-in function
+    DevFnCall  fn                    = nullptr;
+    RTCKernel* compiled              = nullptr;
+    RTCKernel* compiledWithCallbacks = nullptr;
+    GridParam  gridParam;
+
+    launch_ptr_t bufIn[2];
+    launch_ptr_t bufOut[2];
+};
+
 struct ExecPlan
 {
+    // process-unique identifier, used to tie together log records
+    // about the same plan
+    size_t id = 0;
+
+    // time spent in each phase of creating the plan, if timing is
+    // enabled
+    std::shared_ptr<plan_timing> timing;
+
     // shared pointer allows for ExecPlans to be copyable
     std::shared_ptr<TreeNode> rootPlan;
 
@@ -680,8 +830,19 @@ struct ExecPlan
     // flattened potentially-fusable shims of rootPlan
     std::vector<FuseShim*> fuseShims;
 
-    std::vector<DevFnCall> devFnCall;
-    std::vector<GridParam> gridParam;
+    // one step per node in execSeq
+    std::vector<launch_step_t> launchProgram;
+    // steps that load from and store to user buffers, which are
+    // given any user callbacks
+    size_t loadStep  = 0;
+    size_t storeStep = 0;
+
+    // device-side kernel arguments of all nodes in execSeq
+    std::shared_ptr<kargs_arena> kernArgArena;
+
+    // graphs of the plan's kernel launches, for executions that ask
+    // for graph replay
+    std::shared_ptr<graph_cache> graphs;
 
     hipDeviceProp_t deviceProp;
 
@@ -713,5 +874,7 @@ struct ExecPlan
 
 void ProcessNode(ExecPlan& execPlan);
 void PrintNode(rocfft_ostream& os, const ExecPlan& execPlan);
+// write the plan to the plan log, in the configured log format
+void LogPlan(const ExecPlan& execPlan);
 
 #endif // TREE_NODE_H
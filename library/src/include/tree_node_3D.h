@@ -259,7 +259,7 @@ protected:
     }
 
 public:
-    bool CreateDevKernelArgs() override;
+    void CreateDevKernelArgs(kargs_arena& arena) override;
 };
 
 #endif // TREE_NODE_3D_H
@@ -73,6 +73,52 @@ public:
     bool try_fuse_pre_post_processing = false;
 };
 
+/*****************************************************
+ * CS_REAL_TRANSFORM_ODD
+ *****************************************************/
+class RealTransOddNode : public InternalNode
+{
+    friend class NodeFactory;
+
+protected:
+    explicit RealTransOddNode(TreeNode* p)
+        : InternalNode(p)
+    {
+        scheme = CS_REAL_TRANSFORM_ODD;
+    }
+#if !GENERIC_BUF_ASSIGMENT
+    void AssignBuffers_internal(TraverseState&   state,
+                                OperatingBuffer& flipIn,
+                                OperatingBuffer& flipOut,
+                                OperatingBuffer& obOutBuf) override;
+#endif
+    void AssignParams_internal() override;
+    void BuildTree_internal() override;
+};
+
+/*****************************************************
+ * CS_REAL_TRANSFORM_PAIR
+ *****************************************************/
+class RealTransPairNode : public InternalNode
+{
+    friend class NodeFactory;
+
+protected:
+    explicit RealTransPairNode(TreeNode* p)
+        : InternalNode(p)
+    {
+        scheme = CS_REAL_TRANSFORM_PAIR;
+    }
+#if !GENERIC_BUF_ASSIGMENT
+    void AssignBuffers_internal(TraverseState&   state,
+                                OperatingBuffer& flipIn,
+                                OperatingBuffer& flipOut,
+                                OperatingBuffer& obOutBuf) override;
+#endif
+    void AssignParams_internal() override;
+    void BuildTree_internal() override;
+};
+
 /*****************************************************
  * CS_REAL_2D_EVEN
  *****************************************************/
@@ -139,11 +185,38 @@ protected:
     void AssignParams_internal_TR_pairs();
 };
 
+/*****************************************************
+ * CS_REAL_TO_REAL
+ *****************************************************/
+class RealToRealNode : public InternalNode
+{
+    friend class NodeFactory;
+
+protected:
+    explicit RealToRealNode(TreeNode* p)
+        : InternalNode(p)
+    {
+        scheme = CS_REAL_TO_REAL;
+    }
+#if !GENERIC_BUF_ASSIGMENT
+    void AssignBuffers_internal(TraverseState&   state,
+                                OperatingBuffer& flipIn,
+                                OperatingBuffer& flipOut,
+                                OperatingBuffer& obOutBuf) override;
+#endif
+    void AssignParams_internal() override;
+    void BuildTree_internal() override;
+};
+
 /*****************************************************
  * CS_KERNEL_COPY_R_TO_CMPLX
  * CS_KERNEL_COPY_HERM_TO_CMPLX
  * CS_KERNEL_COPY_CMPLX_TO_HERM
  * CS_KERNEL_COPY_CMPLX_TO_R
+ * CS_KERNEL_PAIR_R_TO_CMPLX
+ * CS_KERNEL_PAIR_CMPLX_TO_HERM
+ * CS_KERNEL_PAIR_HERM_TO_CMPLX
+ * CS_KERNEL_PAIR_CMPLX_TO_R
  * CS_KERNEL_APPLY_CALLBACK
  *****************************************************/
 class RealTransDataCopyNode : public LeafNode
@@ -171,18 +244,20 @@ protected:
         * Buffer and ArrayType
         *********************/
         // the two r2c copy-head kernels MUST output to TEMP CMPLX buffer
-        if(scheme == CS_KERNEL_COPY_R_TO_CMPLX || scheme == CS_KERNEL_COPY_HERM_TO_CMPLX)
+        if(scheme == CS_KERNEL_COPY_R_TO_CMPLX || scheme == CS_KERNEL_COPY_HERM_TO_CMPLX
+           || scheme == CS_KERNEL_PAIR_R_TO_CMPLX || scheme == CS_KERNEL_PAIR_HERM_TO_CMPLX)
         {
             allowedOutBuf        = OB_TEMP_CMPLX_FOR_REAL | OB_TEMP;
             allowedOutArrayTypes = {rocfft_array_type_complex_interleaved};
         }
         // should be real, but could be treated as CI (the alias type)
-        else if(scheme == CS_KERNEL_COPY_CMPLX_TO_R || scheme == CS_KERNEL_APPLY_CALLBACK)
+        else if(scheme == CS_KERNEL_COPY_CMPLX_TO_R || scheme == CS_KERNEL_PAIR_CMPLX_TO_R
+                || scheme == CS_KERNEL_APPLY_CALLBACK)
         {
             allowedOutArrayTypes = {rocfft_array_type_real, rocfft_array_type_complex_interleaved};
         }
         // should be HI(or HP), but could be treated as CI(or HI) (the alias type)
-        else if(scheme == CS_KERNEL_COPY_CMPLX_TO_HERM)
+        else if(scheme == CS_KERNEL_COPY_CMPLX_TO_HERM || scheme == CS_KERNEL_PAIR_CMPLX_TO_HERM)
         {
             allowedOutArrayTypes = {rocfft_array_type_hermitian_interleaved,
                                     rocfft_array_type_complex_interleaved,
@@ -245,4 +320,45 @@ protected:
     void   SetupGPAndFnPtr_internal(DevFnCall& fnPtr, GridParam& gp) override;
 };
 
+/*****************************************************
+ * CS_KERNEL_R2R_PRE
+ * CS_KERNEL_R2R_POST
+ *****************************************************/
+class RealToRealKernelNode : public LeafNode
+{
+    friend class NodeFactory;
+
+private:
+    typedef std::map<ComputeScheme, DevFnCall> SchemeFnCall;
+    static const SchemeFnCall                  FnCallMap;
+
+protected:
+    RealToRealKernelNode(TreeNode* p, ComputeScheme s)
+        : LeafNode(p, s)
+    {
+        /************
+        * Placement
+        *************/
+        // input and output have different shapes
+        allowInplace = false;
+
+        /********************
+        * Buffer and ArrayType
+        *********************/
+        // pre-processing writes the FFT's contiguous input
+        if(scheme == CS_KERNEL_R2R_PRE)
+        {
+            allowedOutBuf        = OB_TEMP_CMPLX_FOR_REAL | OB_TEMP;
+            allowedOutArrayTypes = {rocfft_array_type_complex_interleaved};
+        }
+        // should be real, but could be treated as CI (the alias type)
+        else
+        {
+            allowedOutArrayTypes = {rocfft_array_type_real, rocfft_array_type_complex_interleaved};
+        }
+    }
+
+    void SetupGPAndFnPtr_internal(DevFnCall& fnPtr, GridParam& gp) override;
+};
+
 #endif // TREE_NODE_REAL_H
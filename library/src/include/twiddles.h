@@ -9,17 +9,190 @@
 #include "../../../shared/gpubuf.h"
 #include "arithmetic.h"
 #include "rocfft.h"
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <math.h>
 #include <numeric>
 #include <stdexcept>
 #include <string>
+#include <system_error>
+#include <thread>
 #include <tuple>
 #include <vector>
 
 static const size_t LTWD_BASE_DEFAULT       = 8;
 static const size_t LARGE_TWIDDLE_THRESHOLD = 4096;
 
+// Fold the twiddle exp(-2 * pi * i * num / den) into the first
+// octant.  The angle is (pi / 4) * (octant + r / den), and after
+// odd octants are reflected about pi / 4 the twiddle only needs
+// sin and cos of (pi / 4) * r / den, with r in [0, den].
+static inline void twiddle_fold(size_t num, size_t den, size_t& octant, size_t& r)
+{
+    num %= den;
+
+    octant = (8 * num) / den;
+    r      = 8 * num - octant * den;
+    if(octant & 1)
+        r = den - r;
+}
+
+// Rotate cos and sin of a first-octant angle back into the octant
+// it was folded from, and conjugate.
+template <typename T>
+static inline T twiddle_unfold(double c, double s, size_t octant)
+{
+    if(octant & 1)
+        std::swap(c, s);
+
+    T result;
+    switch(octant / 2)
+    {
+    case 0:
+        result.x = c;
+        result.y = -s;
+        break;
+    case 1:
+        result.x = -s;
+        result.y = -c;
+        break;
+    case 2:
+        result.x = -c;
+        result.y = s;
+        break;
+    default:
+        result.x = s;
+        result.y = c;
+        break;
+    }
+    return result;
+}
+
+// Twiddle exp(-2 * pi * i * num / den).  num is reduced modulo den
+// with integer math, and the angle is folded into the first octant
+// so that sin and cos are only ever evaluated on [0, pi/4], where
+// they are most accurate.
+template <typename T>
+static inline T twiddle_value(size_t num, size_t den)
+{
+    const double QUARTER_PI = 0.78539816339744830961566084581988;
+
+    size_t octant, r;
+    twiddle_fold(num, den, octant, r);
+
+    double psi = QUARTER_PI * static_cast<double>(r) / static_cast<double>(den);
+    return twiddle_unfold<T>(cos(psi), sin(psi), octant);
+}
+
+// Extra threads currently filling twiddle tables, summed over every
+// plan being created in the process.
+inline std::atomic<size_t>& twiddle_fill_threads()
+{
+    static std::atomic<size_t> threads{0};
+    return threads;
+}
+
+// Set table[i] = fn(i) for i in [0, count).  Large tables are split
+// into contiguous chunks that are generated on separate threads.
+// Concurrent plan creation shares one budget of hardware threads,
+// and chunks that can't get a thread are filled by the caller.
+template <typename T, typename Tfn>
+static inline void twiddle_fill(T* table, size_t count, Tfn fn)
+{
+    static const size_t MIN_ENTRIES_PER_THREAD = 32768;
+
+    size_t hw_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    size_t wanted     = std::min(hw_threads, count / MIN_ENTRIES_PER_THREAD);
+
+    // reserve extra threads, leaving one hardware thread for each
+    // caller
+    auto&  in_use = twiddle_fill_threads();
+    size_t extra  = 0;
+    if(wanted > 1)
+    {
+        size_t current = in_use.load();
+        do
+        {
+            size_t available = current + 1 < hw_threads ? hw_threads - 1 - current : 0;
+            extra            = std::min(wanted - 1, available);
+        } while(!in_use.compare_exchange_weak(current, current + extra));
+    }
+
+    size_t chunk = extra ? DivRoundingUp(count, extra + 1) : count;
+
+    auto fill_chunk = [=](size_t begin) {
+        size_t end = std::min(begin + chunk, count);
+        for(size_t i = begin; i < end; ++i)
+            table[i] = fn(i);
+    };
+
+    // failing to start a thread just leaves its chunk for this one
+    std::vector<std::thread> threads;
+    size_t                   begin = chunk;
+    try
+    {
+        for(; begin < count; begin += chunk)
+            threads.emplace_back(fill_chunk, begin);
+    }
+    catch(std::system_error&)
+    {
+    }
+    for(; begin < count; begin += chunk)
+        fill_chunk(begin);
+    fill_chunk(0);
+    for(auto& t : threads)
+        t.join();
+
+    in_use -= extra;
+}
+
+// Twiddles exp(-2 * pi * i * num / den) for a fixed den, for
+// filling tables of "count" entries.  Folding a numerator into the
+// first octant always gives an r that is a multiple of gcd(8, den),
+// so sin and cos are evaluated once for each of those and every
+// twiddle is a reflection of one of them.  If that wouldn't save
+// any evaluations, each twiddle is computed directly instead.
+template <typename T>
+class twiddle_octant
+{
+    size_t               den;
+    size_t               step;
+    std::vector<double2> sincos;
+
+public:
+    twiddle_octant(size_t _den, size_t count)
+        : den(_den)
+        , step(den % 8 == 0 ? 8 : den % 4 == 0 ? 4 : den % 2 == 0 ? 2 : 1)
+    {
+        size_t entries = den / step + 1;
+        if(step == 1 || entries >= count)
+            return;
+
+        static const double QUARTER_PI = 0.78539816339744830961566084581988;
+
+        sincos.resize(entries);
+        twiddle_fill(sincos.data(), entries, [this](size_t i) {
+            double  psi = QUARTER_PI * static_cast<double>(i * step) / static_cast<double>(den);
+            double2 cs;
+            cs.x = cos(psi);
+            cs.y = sin(psi);
+            return cs;
+        });
+    }
+
+    T operator()(size_t num) const
+    {
+        if(sincos.empty())
+            return twiddle_value<T>(num, den);
+
+        size_t octant, r;
+        twiddle_fold(num, den, octant, r);
+        const auto& cs = sincos[r / step];
+        return twiddle_unfold<T>(cs.x, cs.y, octant);
+    }
+};
+
 gpubuf twiddles_create(size_t                     N,
                        size_t                     length_limit,
                        rocfft_precision           precision,
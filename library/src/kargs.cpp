@@ -23,43 +23,19 @@
 #include "kargs.h"
 #include "rocfft_hip.h"
 
+#include <stdexcept>
+
 // malloc device buffer; copy host buffer to device buffer
-gpubuf_t<size_t> kargs_create(std::vector<size_t> length,
-                              std::vector<size_t> inStride,
-                              std::vector<size_t> outStride,
-                              size_t              iDist,
-                              size_t              oDist)
+void kargs_arena::upload()
 {
-    gpubuf_t<size_t> devk;
-    if(devk.alloc(3 * KERN_ARGS_ARRAY_WIDTH * sizeof(size_t)) != hipSuccess)
-        return devk;
-
-    size_t devkHost[3 * KERN_ARGS_ARRAY_WIDTH];
-
-    size_t i = 0;
-    while(i < 3 * KERN_ARGS_ARRAY_WIDTH)
-        devkHost[i++] = 0;
-
-    assert(length.size() == inStride.size());
-    assert(length.size() == outStride.size());
-
-    i = 0;
-    while(i < length.size())
-    {
-        devkHost[i + 0 * KERN_ARGS_ARRAY_WIDTH] = length[i];
-        devkHost[i + 1 * KERN_ARGS_ARRAY_WIDTH] = inStride[i];
-        devkHost[i + 2 * KERN_ARGS_ARRAY_WIDTH] = outStride[i];
-        i++;
-    }
+    if(host.empty())
+        return;
 
-    // NB: iDist is right after the last inStride[dim-1], i.e. inStride[dim] = batch-in-stride
-    //     oDist is right after the last outStride[dim-1], i.e. outStride[dim] = batch-out-stride
-    devkHost[i + 1 * KERN_ARGS_ARRAY_WIDTH] = iDist;
-    devkHost[i + 2 * KERN_ARGS_ARRAY_WIDTH] = oDist;
+    ++alloc_count;
+    if(device.alloc(size_bytes()) != hipSuccess)
+        throw std::runtime_error("failed to allocate kernel arguments");
 
-    if(hipMemcpy(
-           devk.data(), devkHost, 3 * KERN_ARGS_ARRAY_WIDTH * sizeof(size_t), hipMemcpyHostToDevice)
-       != hipSuccess)
-        devk.free();
-    return devk;
+    ++copy_count;
+    if(hipMemcpy(device.data(), host.data(), size_bytes(), hipMemcpyHostToDevice) != hipSuccess)
+        throw std::runtime_error("failed to copy kernel arguments");
 }
@@ -0,0 +1,280 @@
+/******************************************************************************
+* Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#include "multi_device.h"
+#include "rocfft_ostream.hpp"
+#include "statistics.h"
+
+#include <string>
+
+static void check(rocfft_status status, const char* what)
+{
+    if(status != rocfft_status_success)
+        throw std::runtime_error(std::string(what) + " failure");
+}
+
+static void check(hipError_t ret, const char* what)
+{
+    if(ret != hipSuccess)
+        throw std::runtime_error(std::string(what) + " failure");
+}
+
+multi_device_plan::multi_device_plan(const std::vector<int>&    device_ids,
+                                     const std::vector<size_t>& lengths,
+                                     rocfft_result_placement    placement,
+                                     rocfft_transform_type      transform_type,
+                                     rocfft_precision           precision)
+    : dec(md_decompose(lengths, device_ids.size()))
+    , element_size(2 * (precision == rocfft_precision_double ? sizeof(double) : sizeof(float)))
+    , inplace(placement == rocfft_placement_inplace)
+{
+    // the sub-plans are part of this plan
+    stat_sub_plan_scope sub_plans;
+
+    devices.resize(dec.devices());
+    try
+    {
+        for(size_t d = 0; d < devices.size(); ++d)
+        {
+            auto& dev = devices[d];
+            dev.id    = device_ids[d];
+            scoped_device current(dev.id);
+
+            // Let this device copy straight from its peers.  Copies
+            // between devices without peer access are staged by the
+            // runtime instead.
+            for(size_t peer = 0; peer < devices.size(); ++peer)
+            {
+                int can_access = 0;
+                if(peer == d
+                   || hipDeviceCanAccessPeer(&can_access, dev.id, device_ids[peer]) != hipSuccess
+                   || !can_access)
+                    continue;
+                auto ret = hipDeviceEnablePeerAccess(device_ids[peer], 0);
+                if(ret == hipErrorPeerAccessAlreadyEnabled)
+                    (void)hipGetLastError();
+                else
+                    check(ret, "hipDeviceEnablePeerAccess");
+            }
+
+            check(hipStreamCreateWithFlags(&dev.stream, hipStreamNonBlocking),
+                  "hipStreamCreateWithFlags");
+            check(hipEventCreateWithFlags(&dev.event, hipEventDisableTiming),
+                  "hipEventCreateWithFlags");
+
+            // step 1 transforms each row of the slab
+            check(rocfft_plan_create(&dev.slab_plan,
+                                     placement,
+                                     transform_type,
+                                     precision,
+                                     lengths.size() - 1,
+                                     lengths.data(),
+                                     dec.rows[d].count,
+                                     nullptr),
+                  "slab plan");
+
+            // step 3 transforms the device's columns in place
+            rocfft_plan_description column_desc = nullptr;
+            check(rocfft_plan_description_create(&column_desc), "plan description");
+            size_t stride = dec.cols[d].count;
+            auto   status
+                = rocfft_plan_description_set_data_layout(column_desc,
+                                                          rocfft_array_type_complex_interleaved,
+                                                          rocfft_array_type_complex_interleaved,
+                                                          nullptr,
+                                                          nullptr,
+                                                          1,
+                                                          &stride,
+                                                          1,
+                                                          1,
+                                                          &stride,
+                                                          1);
+            if(status == rocfft_status_success)
+                status = rocfft_plan_create(&dev.column_plan,
+                                            rocfft_placement_inplace,
+                                            transform_type,
+                                            precision,
+                                            1,
+                                            &lengths.back(),
+                                            dec.cols[d].count,
+                                            column_desc);
+            rocfft_plan_description_destroy(column_desc);
+            check(status, "column plan");
+
+            check(dev.columns.alloc(dec.column_elements(d) * element_size), "hipMalloc");
+
+            size_t slab_work   = 0;
+            size_t column_work = 0;
+            check(rocfft_plan_get_work_buffer_size(dev.slab_plan, &slab_work), "work buffer size");
+            check(rocfft_plan_get_work_buffer_size(dev.column_plan, &column_work),
+                  "work buffer size");
+            dev.work_bytes = std::max(slab_work, column_work);
+            if(dev.work_bytes)
+                check(dev.work.alloc(dev.work_bytes), "hipMalloc");
+
+            check(rocfft_execution_info_create(&dev.info), "execution info");
+            check(rocfft_execution_info_set_stream(dev.info, dev.stream), "execution info");
+            if(dev.work_bytes)
+                check(rocfft_execution_info_set_work_buffer(
+                          dev.info, dev.work.data(), dev.work_bytes),
+                      "execution info");
+        }
+    }
+    catch(...)
+    {
+        release();
+        throw;
+    }
+}
+
+multi_device_plan::~multi_device_plan()
+{
+    release();
+}
+
+void multi_device_plan::release()
+{
+    stat_sub_plan_scope sub_plans;
+
+    int previous = 0;
+    (void)hipGetDevice(&previous);
+    for(auto& dev : devices)
+    {
+        (void)hipSetDevice(dev.id);
+        if(dev.info)
+            rocfft_execution_info_destroy(dev.info);
+        if(dev.column_plan)
+            rocfft_plan_destroy(dev.column_plan);
+        if(dev.slab_plan)
+            rocfft_plan_destroy(dev.slab_plan);
+        dev.columns.free();
+        dev.work.free();
+        if(dev.event)
+            (void)hipEventDestroy(dev.event);
+        if(dev.stream)
+            (void)hipStreamDestroy(dev.stream);
+        dev = md_device();
+    }
+    (void)hipSetDevice(previous);
+}
+
+void multi_device_plan::exchange_barrier()
+{
+    for(auto& dev : devices)
+    {
+        scoped_device current(dev.id);
+        check(hipEventRecord(dev.event, dev.stream), "hipEventRecord");
+    }
+    for(auto& dev : devices)
+    {
+        scoped_device current(dev.id);
+        for(auto& other : devices)
+            if(&other != &dev)
+                check(hipStreamWaitEvent(dev.stream, other.event, 0), "hipStreamWaitEvent");
+    }
+}
+
+void multi_device_plan::exchange(const std::vector<md_copy>& copies,
+                                 const std::vector<void*>&   src,
+                                 const std::vector<void*>&   dst)
+{
+    // each copy runs on the stream of the device it writes to
+    for(const auto& copy : copies)
+    {
+        auto&         dst_dev = devices[copy.dst_device];
+        scoped_device current(dst_dev.id);
+
+        auto src_ptr
+            = static_cast<const char*>(src[copy.src_device]) + copy.src_offset * element_size;
+        auto dst_ptr = static_cast<char*>(dst[copy.dst_device]) + copy.dst_offset * element_size;
+        check(hipMemcpy2DAsync(dst_ptr,
+                               copy.dst_pitch * element_size,
+                               src_ptr,
+                               copy.src_pitch * element_size,
+                               copy.width * element_size,
+                               copy.height,
+                               hipMemcpyDeviceToDevice,
+                               dst_dev.stream),
+              "hipMemcpy2DAsync");
+    }
+}
+
+void multi_device_plan::execute(void* in_buffer[], void* out_buffer[], hipStream_t stream)
+{
+    // the devices' streams can't wait on the caller's stream, which
+    // may belong to another device, so wait for the input here
+    check(hipStreamSynchronize(stream), "hipStreamSynchronize");
+
+    rocfft_stats::get().exec.add(stat_sharded_counters::EXECUTIONS);
+    stat_sub_plan_scope sub_plans;
+
+    std::vector<void*> slabs(devices.size());
+    std::vector<void*> columns(devices.size());
+
+    // step 1: faster dimensions of each slab
+    for(size_t d = 0; d < devices.size(); ++d)
+    {
+        auto&         dev = devices[d];
+        scoped_device current(dev.id);
+
+        void* in[]  = {in_buffer[d]};
+        void* out[] = {out_buffer[d]};
+        check(rocfft_execute(dev.slab_plan, in, inplace ? nullptr : out, dev.info), "slab execute");
+        slabs[d]   = inplace ? in_buffer[d] : out_buffer[d];
+        columns[d] = dev.columns.data();
+    }
+
+    // step 2: slabs to columns
+    exchange_barrier();
+    exchange(dec.to_columns, slabs, columns);
+
+    // step 3: slowest dimension of each device's columns
+    for(size_t d = 0; d < devices.size(); ++d)
+    {
+        auto&         dev = devices[d];
+        scoped_device current(dev.id);
+
+        void* buf[] = {columns[d]};
+        check(rocfft_execute(dev.column_plan, buf, nullptr, dev.info), "column execute");
+    }
+
+    // step 4: columns back to slabs
+    exchange_barrier();
+    exchange(dec.to_slabs, columns, slabs);
+
+    for(auto& dev : devices)
+    {
+        scoped_device current(dev.id);
+        check(hipStreamSynchronize(dev.stream), "hipStreamSynchronize");
+    }
+}
+
+void multi_device_plan::print(rocfft_ostream& os) const
+{
+    os << "devices: " << devices.size() << std::endl;
+    for(size_t d = 0; d < devices.size(); ++d)
+    {
+        os << "device " << devices[d].id << ": rows " << dec.rows[d].offset << "-"
+           << dec.rows[d].offset + dec.rows[d].count - 1 << ", columns " << dec.cols[d].offset
+           << "-" << dec.cols[d].offset + dec.cols[d].count - 1 << std::endl;
+    }
+}
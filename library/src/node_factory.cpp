@@ -31,6 +31,7 @@
 #include "tree_node_real.h"
 
 #include <functional>
+#include <numeric>
 #include <set>
 
 // TODO:
@@ -211,6 +212,12 @@ std::unique_ptr<TreeNode> NodeFactory::CreateNodeFromScheme(ComputeScheme s, Tre
         return std::unique_ptr<Real2DEvenNode>(new Real2DEvenNode(parent));
     case CS_REAL_3D_EVEN:
         return std::unique_ptr<Real3DEvenNode>(new Real3DEvenNode(parent));
+    case CS_REAL_TRANSFORM_ODD:
+        return std::unique_ptr<RealTransOddNode>(new RealTransOddNode(parent));
+    case CS_REAL_TRANSFORM_PAIR:
+        return std::unique_ptr<RealTransPairNode>(new RealTransPairNode(parent));
+    case CS_REAL_TO_REAL:
+        return std::unique_ptr<RealToRealNode>(new RealToRealNode(parent));
     case CS_BLUESTEIN:
         return std::unique_ptr<BluesteinNode>(new BluesteinNode(parent));
     case CS_L1D_TRTRT:
@@ -266,8 +273,15 @@ std::unique_ptr<TreeNode> NodeFactory::CreateNodeFromScheme(ComputeScheme s, Tre
     case CS_KERNEL_COPY_HERM_TO_CMPLX:
     case CS_KERNEL_COPY_CMPLX_TO_HERM:
     case CS_KERNEL_COPY_CMPLX_TO_R:
+    case CS_KERNEL_PAIR_R_TO_CMPLX:
+    case CS_KERNEL_PAIR_CMPLX_TO_HERM:
+    case CS_KERNEL_PAIR_HERM_TO_CMPLX:
+    case CS_KERNEL_PAIR_CMPLX_TO_R:
     case CS_KERNEL_APPLY_CALLBACK:
         return std::unique_ptr<RealTransDataCopyNode>(new RealTransDataCopyNode(parent, s));
+    case CS_KERNEL_R2R_PRE:
+    case CS_KERNEL_R2R_POST:
+        return std::unique_ptr<RealToRealKernelNode>(new RealToRealKernelNode(parent, s));
     case CS_KERNEL_CHIRP:
     case CS_KERNEL_PAD_MUL:
     case CS_KERNEL_FFT_MUL:
@@ -318,7 +332,12 @@ std::unique_ptr<FuseShim> NodeFactory::CreateFuseShim(FuseType
 
 ComputeScheme NodeFactory::DecideNodeScheme(NodeMetaData& nodeData, TreeNode* parent)
 {
-    if((parent == nullptr)
+    if((parent == nullptr) && (nodeData.r2rType != R2RType::NONE))
+        return CS_REAL_TO_REAL;
+
+    // real-to-real plans are built on real-complex FFTs that are
+    // planned like root plans
+    if((parent == nullptr || parent->scheme == CS_REAL_TO_REAL)
        && ((nodeData.inArrayType == rocfft_array_type_real)
            || (nodeData.outArrayType == rocfft_array_type_real)))
     {
@@ -356,6 +375,28 @@ ComputeScheme NodeFactory::DecideRealScheme(NodeMetaData& nodeData)
             throw std::runtime_error("Invalid dimension");
         }
     }
+#ifdef ROCFFT_RUNTIME_COMPILE
+    // odd 1D lengths that fit in a single kernel can read and write
+    // the real data directly, instead of embedding it in a complex
+    // temp buffer.  the kernel is only ever runtime-compiled.
+    if(nodeData.dimension == 1 && nodeData.length[0] % 2 == 1
+       && nodeData.placement == rocfft_placement_notinplace
+       && function_pool::has_function(fpkey(nodeData.length[0], nodeData.precision)))
+        return CS_REAL_TRANSFORM_ODD;
+#endif
+    // with more than one transform, two real transforms can share one
+    // complex transform, halving the complex work and temp memory.
+    // packing and unpacking costs more than the plain embedding
+    // though, so only pair up transforms when there is enough work
+    // for the saving to show.
+    static const size_t REAL_PAIR_MIN_LENGTH   = 64;
+    static const size_t REAL_PAIR_MIN_ELEMENTS = 8192;
+
+    const size_t real_length = std::accumulate(
+        nodeData.length.begin(), nodeData.length.end(), size_t(1), std::multiplies<size_t>());
+    if(nodeData.batch >= 2 && real_length >= REAL_PAIR_MIN_LENGTH
+       && real_length * nodeData.batch >= REAL_PAIR_MIN_ELEMENTS)
+        return CS_REAL_TRANSFORM_PAIR;
     // Fallback method
     return CS_REAL_TRANSFORM_USING_CMPLX;
 }
@@ -21,6 +21,7 @@
 #include "plan.h"
 #include "arithmetic.h"
 #include "assignment_policy.h"
+#include "chrome_trace.h"
 #include "function_pool.h"
 #include "hip/hip_runtime_api.h"
 #include "logging.h"
@@ -29,9 +30,11 @@
 #include "rocfft.h"
 #include "rocfft_ostream.hpp"
 #include "rtc.h"
+#include "statistics.h"
 
 #include <algorithm>
 #include <assert.h>
+#include <atomic>
 #include <functional>
 #include <iterator>
 #include <map>
@@ -80,8 +83,19 @@ std::string PrintScheme(ComputeScheme cs)
            {ENUMSTR(CS_KERNEL_TRANSPOSE_CMPLX_TO_R)},
            {ENUMSTR(CS_REAL_2D_EVEN)},
            {ENUMSTR(CS_REAL_3D_EVEN)},
+           {ENUMSTR(CS_REAL_TRANSFORM_ODD)},
            {ENUMSTR(CS_KERNEL_APPLY_CALLBACK)},
 
+           {ENUMSTR(CS_REAL_TRANSFORM_PAIR)},
+           {ENUMSTR(CS_KERNEL_PAIR_R_TO_CMPLX)},
+           {ENUMSTR(CS_KERNEL_PAIR_CMPLX_TO_HERM)},
+           {ENUMSTR(CS_KERNEL_PAIR_HERM_TO_CMPLX)},
+           {ENUMSTR(CS_KERNEL_PAIR_CMPLX_TO_R)},
+
+           {ENUMSTR(CS_REAL_TO_REAL)},
+           {ENUMSTR(CS_KERNEL_R2R_PRE)},
+           {ENUMSTR(CS_KERNEL_R2R_POST)},
+
            {ENUMSTR(CS_BLUESTEIN)},
            {ENUMSTR(CS_KERNEL_CHIRP)},
            {ENUMSTR(CS_KERNEL_PAD_MUL)},
@@ -243,6 +257,37 @@ rocfft_status rocfft_plan_description_set_data_layout(rocfft_plan_description de
     return rocfft_status_success;
 }
 
+rocfft_status rocfft_plan_description_set_devices(rocfft_plan_description description,
+                                                  void*                   devices,
+                                                  size_t                  number_of_devices)
+{
+    log_trace(__func__,
+              "description",
+              description,
+              "devices",
+              devices,
+              "number_of_devices",
+              number_of_devices);
+    if(!description || (number_of_devices > 0 && !devices))
+        return rocfft_status_invalid_arg_value;
+
+    int device_count = 0;
+    if(number_of_devices > 0 && hipGetDeviceCount(&device_count) != hipSuccess)
+        return rocfft_status_failure;
+
+    const int*       ids = static_cast<const int*>(devices);
+    std::vector<int> list(ids, ids + number_of_devices);
+    for(size_t i = 0; i < list.size(); ++i)
+    {
+        if(list[i] < 0 || list[i] >= device_count)
+            return rocfft_status_invalid_arg_value;
+        if(std::find(list.begin(), list.begin() + i, list[i]) != list.begin() + i)
+            return rocfft_status_invalid_arg_value;
+    }
+    description->devices = std::move(list);
+    return rocfft_status_success;
+}
+
 rocfft_status rocfft_plan_description_create(rocfft_plan_description* description)
 {
     rocfft_plan_description desc = new rocfft_plan_description_t;
@@ -292,6 +337,136 @@ std::string rocfft_rider_command(rocfft_plan plan)
     return rider.str();
 }
 
+static R2RType R2RTypeFromTransformType(rocfft_transform_type type)
+{
+    switch(type)
+    {
+    case rocfft_transform_type_dct_1:
+        return R2RType::DCT_I;
+    case rocfft_transform_type_dct_2:
+        return R2RType::DCT_II;
+    case rocfft_transform_type_dct_3:
+        return R2RType::DCT_III;
+    case rocfft_transform_type_dct_4:
+        return R2RType::DCT_IV;
+    case rocfft_transform_type_dst_1:
+        return R2RType::DST_I;
+    case rocfft_transform_type_dst_2:
+        return R2RType::DST_II;
+    case rocfft_transform_type_dst_3:
+        return R2RType::DST_III;
+    case rocfft_transform_type_dst_4:
+        return R2RType::DST_IV;
+    default:
+        return R2RType::NONE;
+    }
+}
+
+// write the plan's phase timings to the timing log and Chrome trace
+static void LogPlanTiming(const ExecPlan& execPlan)
+{
+    if(!execPlan.timing)
+        return;
+    auto phases = execPlan.timing->get_phases();
+
+    if(LOG_CHROME_TRACE_ENABLED())
+    {
+        for(const auto& phase : phases)
+        {
+            json_object args;
+            args.field("plan", execPlan.id);
+            if(!phase.detail.empty())
+                args.field("detail", phase.detail);
+            chrome_trace::complete(
+                "plan", phase.name, phase.start, phase.ms, phase.tid, args.str());
+        }
+    }
+
+    if(!LOG_TIMING_ENABLED())
+        return;
+    auto& os = *LogSingleton::GetInstance().GetTimingOS();
+    if(LOG_JSONL_ENABLED())
+    {
+        std::string phases_json = "[";
+        for(size_t i = 0; i < phases.size(); ++i)
+        {
+            json_object phase;
+            phase.field("name", phases[i].name);
+            if(!phases[i].detail.empty())
+                phase.field("detail", phases[i].detail);
+            phase.field("duration_ms", phases[i].ms);
+            if(i > 0)
+                phases_json += ",";
+            phases_json += phase.str();
+        }
+        phases_json += "]";
+        log_record("plan_timing", execPlan.id).raw("phases", phases_json).write(os);
+    }
+    else
+    {
+        for(const auto& phase : phases)
+            log_arguments(os,
+                          ",",
+                          "plan",
+                          execPlan.id,
+                          "phase",
+                          phase.name,
+                          "detail",
+                          phase.detail,
+                          "duration_ms",
+                          phase.ms);
+    }
+}
+
+// Set up a plan that spans the description's devices.  Data on
+// each device is a slab of the slowest dimension, so only
+// contiguous, unbatched complex transforms are supported.
+static rocfft_status CreateMultiDevicePlan(rocfft_plan p)
+{
+    if(p->transformType != rocfft_transform_type_complex_forward
+       && p->transformType != rocfft_transform_type_complex_inverse)
+        return rocfft_status_invalid_array_type;
+    if(p->desc.inArrayType != rocfft_array_type_complex_interleaved
+       || p->desc.outArrayType != rocfft_array_type_complex_interleaved)
+        return rocfft_status_invalid_array_type;
+    if(p->rank < 2)
+        return rocfft_status_invalid_dimensions;
+    if(p->batch != 1)
+        return rocfft_status_invalid_arg_value;
+
+    size_t contiguous = 1;
+    for(size_t i = 0; i < p->rank; ++i)
+    {
+        if(p->desc.inStrides[i] != contiguous || p->desc.outStrides[i] != contiguous)
+            return rocfft_status_invalid_strides;
+        contiguous *= p->lengths[i];
+    }
+    if(p->desc.inDist != contiguous || p->desc.outDist != contiguous)
+        return rocfft_status_invalid_distance;
+    if(p->desc.inOffset[0] != 0 || p->desc.outOffset[0] != 0)
+        return rocfft_status_invalid_offset;
+
+    auto create_begin = std::chrono::steady_clock::now();
+    try
+    {
+        p->multiDevice = std::make_unique<multi_device_plan>(
+            p->desc.devices,
+            std::vector<size_t>(p->lengths.begin(), p->lengths.begin() + p->rank),
+            p->placement,
+            p->transformType,
+            p->precision);
+    }
+    catch(std::exception& e)
+    {
+        log_trace_error(__func__, e.what());
+        rocfft_stats::get().plan_create_failures.add();
+        return rocfft_status_failure;
+    }
+    rocfft_stats::get().plans_created.add();
+    rocfft_stats::get().plan_create.add(std::chrono::steady_clock::now() - create_begin);
+    return rocfft_status_success;
+}
+
 rocfft_status rocfft_plan_create_internal(rocfft_plan                   plan,
                                           const rocfft_result_placement placement,
                                           const rocfft_transform_type   transform_type,
@@ -350,12 +525,36 @@ rocfft_status rocfft_plan_create_internal(rocfft_plan                   plan,
                && (description->inArrayType != rocfft_array_type_hermitian_interleaved))
                 return rocfft_status_invalid_array_type;
             break;
+        case rocfft_transform_type_dct_1:
+        case rocfft_transform_type_dct_2:
+        case rocfft_transform_type_dct_3:
+        case rocfft_transform_type_dct_4:
+        case rocfft_transform_type_dst_1:
+        case rocfft_transform_type_dst_2:
+        case rocfft_transform_type_dst_3:
+        case rocfft_transform_type_dst_4:
+            // Input and output must both be real
+            if(description->inArrayType != rocfft_array_type_real
+               || description->outArrayType != rocfft_array_type_real)
+                return rocfft_status_invalid_array_type;
+            break;
         }
     }
 
     if(dimensions > 3)
         return rocfft_status_invalid_dimensions;
 
+    // DCT-I works on the even extension of length 2(N-1), which needs
+    // at least two points
+    if(transform_type == rocfft_transform_type_dct_1)
+    {
+        for(size_t i = 0; i < dimensions; ++i)
+        {
+            if(lengths[i] < 2)
+                return rocfft_status_invalid_dimensions;
+        }
+    }
+
     rocfft_plan p = plan;
     p->rank       = dimensions;
     p->lengths[0] = 1;
@@ -392,6 +591,17 @@ rocfft_status rocfft_plan_create_internal(rocfft_plan                   plan,
             p->desc.inArrayType  = rocfft_array_type_hermitian_interleaved;
             p->desc.outArrayType = rocfft_array_type_real;
             break;
+        case rocfft_transform_type_dct_1:
+        case rocfft_transform_type_dct_2:
+        case rocfft_transform_type_dct_3:
+        case rocfft_transform_type_dct_4:
+        case rocfft_transform_type_dst_1:
+        case rocfft_transform_type_dst_2:
+        case rocfft_transform_type_dst_3:
+        case rocfft_transform_type_dst_4:
+            p->desc.inArrayType  = rocfft_array_type_real;
+            p->desc.outArrayType = rocfft_array_type_real;
+            break;
         }
     }
 
@@ -490,7 +700,20 @@ rocfft_status rocfft_plan_create_internal(rocfft_plan                   plan,
         p->desc.outDist = p->lengths[p->rank - 1] * p->desc.outStrides[p->rank - 1];
     }
 
-    log_bench(rocfft_rider_command(p));
+    if(p->desc.devices.size() > 1)
+        return CreateMultiDevicePlan(p);
+
+    // plan ids start at 1, so that 0 can mean "no plan" in log records
+    static std::atomic<size_t> plan_count{0};
+    p->execPlan.id = ++plan_count;
+
+    log_bench(p->execPlan.id, rocfft_rider_command(p));
+
+    if(LOG_TIMING_ENABLED() || LOG_CHROME_TRACE_ENABLED())
+        p->execPlan.timing = std::make_shared<plan_timing>();
+    plan_timing_scope timing_scope(p->execPlan.timing.get());
+    phase_timer       total_timer("plan_create");
+    auto              create_begin = std::chrono::steady_clock::now();
 
     // construct the plan
     try
@@ -517,21 +740,34 @@ rocfft_status rocfft_plan_create_internal(rocfft_plan                   plan,
         else
             rootPlanData.direction = 1;
 
+        // the real-to-real plan decides the direction of each FFT it
+        // is built on
+        rootPlanData.r2rType = R2RTypeFromTransformType(plan->transformType);
+        if(rootPlanData.r2rType != R2RType::NONE)
+            rootPlanData.direction = -1;
+
         rootPlanData.inArrayType  = plan->desc.inArrayType;
         rootPlanData.outArrayType = plan->desc.outArrayType;
         rootPlanData.rootIsC2C    = (rootPlanData.inArrayType != rocfft_array_type_real)
                                  && (rootPlanData.outArrayType != rocfft_array_type_real);
 
         ExecPlan& execPlan = plan->execPlan;
-        int       deviceId = 0;
+        // a plan for one listed device is built on that device
+        std::unique_ptr<scoped_device> planDevice;
+        if(!plan->desc.devices.empty())
+            planDevice = std::make_unique<scoped_device>(plan->desc.devices.front());
+        int deviceId = 0;
         if(hipGetDevice(&deviceId) != hipSuccess)
         {
             throw std::runtime_error("hipGetDevice failed.");
         }
-        if(hipGetDeviceProperties(&(execPlan.deviceProp), deviceId) != hipSuccess)
         {
-            throw std::runtime_error("hipGetDeviceProperties failed for deviceId "
-                                     + std::to_string(deviceId));
+            phase_timer timer("device_properties");
+            if(hipGetDeviceProperties(&(execPlan.deviceProp), deviceId) != hipSuccess)
+            {
+                throw std::runtime_error("hipGetDeviceProperties failed for deviceId "
+                                         + std::to_string(deviceId));
+            }
         }
         rootPlanData.deviceProp = execPlan.deviceProp;
         execPlan.rootPlan       = NodeFactory::CreateExplicitNode(rootPlanData, nullptr);
@@ -563,7 +799,7 @@ rocfft_status rocfft_plan_create_internal(rocfft_plan                   plan,
         catch(std::exception&)
         {
             if(LOG_PLAN_ENABLED())
-                PrintNode(*LogSingleton::GetInstance().GetPlanOS(), execPlan);
+                LogPlan(execPlan);
             throw;
         }
 
@@ -572,14 +808,22 @@ rocfft_status rocfft_plan_create_internal(rocfft_plan                   plan,
 
             throw std::runtime_error("Unable to create execution plan.");
         }
+        total_timer.stop();
+        LogPlanTiming(execPlan);
+        if(!stat_sub_plan_scope::active())
+        {
+            rocfft_stats::get().plans_created.add();
+            rocfft_stats::get().plan_create.add(std::chrono::steady_clock::now() - create_begin);
+        }
         return rocfft_status_success;
     }
     catch(std::exception& e)
     {
-        if(LOG_TRACE_ENABLED())
-        {
-            (*LogSingleton::GetInstance().GetTraceOS()) << e.what() << std::endl;
-        }
+        log_trace_error(__func__, e.what());
+        total_timer.stop();
+        LogPlanTiming(p->execPlan);
+        if(!stat_sub_plan_scope::active())
+            rocfft_stats::get().plan_create_failures.add();
         return rocfft_status_failure;
     }
 }
@@ -637,8 +881,88 @@ rocfft_status rocfft_plan_create(rocfft_plan*                  plan,
                                        description);
 }
 
+rocfft_status rocfft_plan_create_grouped(rocfft_plan*                  plan,
+                                         const rocfft_result_placement placement,
+                                         const rocfft_transform_type   transform_type,
+                                         const rocfft_precision        precision,
+                                         const size_t                  number_of_problems,
+                                         const rocfft_grouped_problem* problems)
+{
+    rocfft_plan_allocate(plan);
+
+    log_trace(__func__,
+              "plan",
+              *plan,
+              "placement",
+              placement,
+              "transform_type",
+              transform_type,
+              "precision",
+              precision,
+              "number_of_problems",
+              number_of_problems);
+
+    if(transform_type != rocfft_transform_type_complex_forward
+       && transform_type != rocfft_transform_type_complex_inverse)
+        return rocfft_status_invalid_array_type;
+    if(number_of_problems == 0 || !problems)
+        return rocfft_status_invalid_arg_value;
+
+    std::vector<grouped_problem> group(number_of_problems);
+    for(size_t i = 0; i < number_of_problems; ++i)
+    {
+        const auto& in  = problems[i];
+        auto&       out = group[i];
+        if(in.length == 0 || in.batch == 0)
+            return rocfft_status_invalid_dimensions;
+
+        out.length    = in.length;
+        out.batch     = in.batch;
+        out.stride[0] = in.in_stride ? in.in_stride : 1;
+        out.stride[1] = in.out_stride ? in.out_stride : 1;
+        out.dist[0]   = in.in_distance ? in.in_distance : in.length * out.stride[0];
+        out.dist[1]   = in.out_distance ? in.out_distance : in.length * out.stride[1];
+        out.offset[0] = in.in_offset;
+        out.offset[1] = in.out_offset;
+
+        // in-place kernels only read the input problem table
+        if(placement == rocfft_placement_inplace)
+        {
+            if(out.stride[0] != out.stride[1])
+                return rocfft_status_invalid_strides;
+            if(out.dist[0] != out.dist[1])
+                return rocfft_status_invalid_distance;
+            if(out.offset[0] != out.offset[1])
+                return rocfft_status_invalid_offset;
+        }
+    }
+
+    rocfft_plan p     = *plan;
+    p->placement      = placement;
+    p->transformType  = transform_type;
+    p->precision      = precision;
+    p->base_type_size = (precision == rocfft_precision_double) ? sizeof(double) : sizeof(float);
+
+    auto create_begin = std::chrono::steady_clock::now();
+    try
+    {
+        p->grouped = std::make_unique<grouped_plan>(group, placement, transform_type, precision);
+    }
+    catch(std::exception& e)
+    {
+        log_trace_error(__func__, e.what());
+        rocfft_stats::get().plan_create_failures.add();
+        return rocfft_status_failure;
+    }
+    rocfft_stats::get().plans_created.add();
+    rocfft_stats::get().plan_create.add(std::chrono::steady_clock::now() - create_begin);
+    return rocfft_status_success;
+}
+
 rocfft_status rocfft_plan_destroy(rocfft_plan plan)
 {
+    if(plan && !stat_sub_plan_scope::active())
+        rocfft_stats::get().plans_destroyed.add();
     delete plan;
     return rocfft_status_success;
 }
@@ -653,6 +977,38 @@ rocfft_status rocfft_plan_get_work_buffer_size(const rocfft_plan plan, size_t* s
     return rocfft_status_success;
 }
 
+rocfft_status rocfft_plan_get_phase_count(const rocfft_plan plan, size_t* count)
+{
+    log_trace(__func__, "plan", plan);
+    if(!plan || !count)
+        return rocfft_status_invalid_arg_value;
+
+    *count = plan->execPlan.timing ? plan->execPlan.timing->phase_count() : 0;
+    return rocfft_status_success;
+}
+
+rocfft_status rocfft_plan_get_phase_timing(const rocfft_plan plan,
+                                           size_t            index,
+                                           const char**      name,
+                                           const char**      detail,
+                                           double*           milliseconds)
+{
+    log_trace(__func__, "plan", plan, "index", index);
+    if(!plan || !plan->execPlan.timing)
+        return rocfft_status_invalid_arg_value;
+
+    const plan_phase_t* phase = plan->execPlan.timing->phase(index);
+    if(!phase)
+        return rocfft_status_invalid_arg_value;
+    if(name)
+        *name = phase->name.c_str();
+    if(detail)
+        *detail = phase->detail.c_str();
+    if(milliseconds)
+        *milliseconds = phase->ms;
+    return rocfft_status_success;
+}
+
 rocfft_status rocfft_plan_get_print(const rocfft_plan plan)
 {
     log_trace(__func__, "plan", plan);
@@ -676,6 +1032,30 @@ rocfft_status rocfft_plan_get_print(const rocfft_plan plan)
     case rocfft_transform_type_real_inverse:
         rocfft_cout << "real inverse";
         break;
+    case rocfft_transform_type_dct_1:
+        rocfft_cout << "DCT-I";
+        break;
+    case rocfft_transform_type_dct_2:
+        rocfft_cout << "DCT-II";
+        break;
+    case rocfft_transform_type_dct_3:
+        rocfft_cout << "DCT-III";
+        break;
+    case rocfft_transform_type_dct_4:
+        rocfft_cout << "DCT-IV";
+        break;
+    case rocfft_transform_type_dst_1:
+        rocfft_cout << "DST-I";
+        break;
+    case rocfft_transform_type_dst_2:
+        rocfft_cout << "DST-II";
+        break;
+    case rocfft_transform_type_dst_3:
+        rocfft_cout << "DST-III";
+        break;
+    case rocfft_transform_type_dst_4:
+        rocfft_cout << "DST-IV";
+        break;
     }
     rocfft_cout << std::endl;
 
@@ -780,6 +1160,17 @@ rocfft_status rocfft_plan_get_print(const rocfft_plan plan)
     rocfft_cout << "scale: " << plan->desc.scale << std::endl;
     rocfft_cout << std::endl;
 
+    if(plan->multiDevice)
+    {
+        plan->multiDevice->print(rocfft_cout);
+        rocfft_cout << std::endl;
+    }
+    if(plan->grouped)
+    {
+        plan->grouped->print(rocfft_cout);
+        rocfft_cout << std::endl;
+    }
+
     return rocfft_status_success;
 }
 
@@ -853,6 +1244,7 @@ void TreeNode::CopyNodeData(const NodeMetaData& data)
     inArrayType  = data.inArrayType;
     outArrayType = data.outArrayType;
     deviceProp   = data.deviceProp;
+    r2rType      = data.r2rType;
 }
 
 bool TreeNode::isPlacementAllowed(rocfft_result_placement test_placement) const
@@ -1099,7 +1491,7 @@ void TreeNode::AssignBuffers(TraverseState&   state,
         SetInputBuffer(state);
 
     // Set flipIn, flipOut, and oboutBuf for the root node.
-    // Note: CS_REAL_TRANSFORM_USING_CMPLX and CS_BLUESTEIN would modify it
+    // Note: CS_REAL_TRANSFORM_USING_CMPLX, CS_REAL_TRANSFORM_PAIR and CS_BLUESTEIN would modify it
     //       Real-1D-Even, -2D-Even, -3D-Even would possibly modify it
     if(isRootNode())
     {
@@ -1566,6 +1958,15 @@ void TreeNode::Print(rocfft_ostream& os, const int indent) const
     case EmbeddedType::Real2C_POST:
         os << indentStr.c_str() << "EmbeddedType: Real2C_POST\n";
         break;
+    case EmbeddedType::Real2C_ODD:
+        os << indentStr.c_str() << "EmbeddedType: Real2C_ODD\n";
+        break;
+    case EmbeddedType::C2Real_ODD:
+        os << indentStr.c_str() << "EmbeddedType: C2Real_ODD\n";
+        break;
+    case EmbeddedType::Real2Real:
+        os << indentStr.c_str() << "EmbeddedType: Real2Real\n";
+        break;
     }
 
     os << indentStr.c_str() << "SBRC_Trans_Type: " << PrintSBRCTransposeType(sbrcTranstype).c_str();
@@ -1732,16 +2133,20 @@ void RuntimeCompilePlan(ExecPlan& execPlan)
 
 void ProcessNode(ExecPlan& execPlan)
 {
+    phase_timer build_timer("build_tree");
     execPlan.rootPlan->RecursiveBuildTree();
+    build_timer.stop();
 
     assert(execPlan.rootPlan->length.size() == execPlan.rootPlan->dimension);
     assert(execPlan.rootPlan->length.size() == execPlan.rootPlan->inStride.size());
     assert(execPlan.rootPlan->length.size() == execPlan.rootPlan->outStride.size());
 
     // collect leaf-nodes to execSeq and fuseShims
+    phase_timer collect_timer("collect_leaves");
     execPlan.rootPlan->CollectLeaves(execPlan.execSeq, execPlan.fuseShims);
     CheckFuseShimForArch(execPlan);
     OrderFuseShims(execPlan.execSeq, execPlan.fuseShims);
+    collect_timer.stop();
 
     // initialize root plan input/output location if not already done
     if(execPlan.rootPlan->obOut == OB_UNINIT)
@@ -1750,6 +2155,7 @@ void ProcessNode(ExecPlan& execPlan)
         execPlan.rootPlan->obIn
             = execPlan.rootPlan->placement == rocfft_placement_inplace ? OB_USER_OUT : OB_USER_IN;
 
+    phase_timer assign_timer("assign_buffers");
 #if GENERIC_BUF_ASSIGMENT
     // guarantee min buffers but possible less fusions
     // execPlan.assignOptStrategy = rocfft_optimize_min_buffer;
@@ -1769,8 +2175,10 @@ void ProcessNode(ExecPlan& execPlan)
                                                           execPlan.rootPlan->outArrayType);
     execPlan.rootPlan->AssignParams();
 #endif
+    assign_timer.stop();
 
     // Apply the fusion after buffer, strides are assigned
+    phase_timer fusion_timer("apply_fusion");
     execPlan.rootPlan->ApplyFusion();
 
     // collect the execSeq since we've fused some kernels
@@ -1779,22 +2187,32 @@ void ProcessNode(ExecPlan& execPlan)
     // So we also need to update the whole tree including internal nodes
     // NB: The order matters: assign param -> fusion -> refresh internal node param
     execPlan.rootPlan->RefreshTree();
+    fusion_timer.stop();
 
     // add padding if necessary
+    phase_timer pad_timer("pad_plan");
     policy.PadPlan(execPlan);
+    pad_timer.stop();
 
     // Check the buffer, param and tree integrity, Note we do this after fusion
+    phase_timer sanity_timer("sanity_check");
     execPlan.rootPlan->SanityCheck();
+    sanity_timer.stop();
 
     // get workBufSize..
     size_t tmpBufSize       = 0;
     size_t cmplxForRealSize = 0;
     size_t blueSize         = 0;
     size_t chirpSize        = 0;
+
+    phase_timer buffer_timer("determine_buffer_memory");
     execPlan.rootPlan->DetermineBufferMemory(tmpBufSize, cmplxForRealSize, blueSize, chirpSize);
+    buffer_timer.stop();
 
     // compile kernels for applicable nodes
+    phase_timer rtc_timer("runtime_compile");
     RuntimeCompilePlan(execPlan);
+    rtc_timer.stop();
 
     execPlan.workBufSize      = tmpBufSize + cmplxForRealSize + blueSize + chirpSize;
     execPlan.tmpWorkBufSize   = tmpBufSize;
@@ -1816,6 +2234,10 @@ void PrintNode(rocfft_ostream& os, const ExecPlan& execPlan)
     os << "Work buffer size: " << execPlan.workBufSize << std::endl;
     os << "Work buffer ratio: " << (double)execPlan.workBufSize / (double)N << std::endl;
     os << "Assignment strategy: " << PrintOptimizeStrategy(execPlan.assignOptStrategy) << std::endl;
+    if(execPlan.kernArgArena)
+        os << "Kernel argument bytes: " << execPlan.kernArgArena->size_bytes()
+           << ", allocations: " << execPlan.kernArgArena->alloc_count
+           << ", copies: " << execPlan.kernArgArena->copy_count << std::endl;
 
     if(execPlan.execSeq.size() > 1)
     {
@@ -1857,8 +2279,9 @@ void PrintNode(rocfft_ostream& os, const ExecPlan& execPlan)
     execPlan.rootPlan->Print(os, 0);
 
     os << "GridParams\n";
-    for(const auto& gp : execPlan.gridParam)
+    for(const auto& step : execPlan.launchProgram)
     {
+        const auto& gp = step.gridParam;
         os << "  b[" << gp.b_x << "," << gp.b_y << "," << gp.b_z << "] wgs[" << gp.wgs_x << ","
            << gp.wgs_y << "," << gp.wgs_z << "], dy_lds bytes " << gp.lds_bytes << "\n";
     }
@@ -1869,3 +2292,49 @@ void PrintNode(rocfft_ostream& os, const ExecPlan& execPlan)
        << std::endl
        << std::endl;
 }
+
+void LogPlan(const ExecPlan& execPlan)
+{
+    auto& os = *LogSingleton::GetInstance().GetPlanOS();
+    if(!LOG_JSONL_ENABLED())
+    {
+        PrintNode(os, execPlan);
+        return;
+    }
+
+    // one record for the whole plan, with the kernels it runs
+    std::string kernels = "[";
+    for(size_t i = 0; i < execPlan.execSeq.size(); ++i)
+    {
+        const TreeNode* node = execPlan.execSeq[i];
+
+        rocfft_ostream in_type, out_type;
+        in_type << node->inArrayType;
+        out_type << node->outArrayType;
+
+        json_object kernel;
+        kernel.field("scheme", PrintScheme(node->scheme))
+            .field("lengths", node->length)
+            .field("batch", node->batch)
+            .field("in_array_type", in_type.str())
+            .field("out_array_type", out_type.str())
+            .field("inplace", node->placement == rocfft_placement_inplace);
+        if(i > 0)
+            kernels += ",";
+        kernels += kernel.str();
+    }
+    kernels += "]";
+
+    rocfft_ostream precision;
+    precision << execPlan.rootPlan->precision;
+
+    log_record("plan", execPlan.id)
+        .field("scheme", PrintScheme(execPlan.rootPlan->scheme))
+        .field("lengths", execPlan.rootPlan->length)
+        .field("batch", execPlan.rootPlan->batch)
+        .field("precision", precision.str())
+        .field("work_buffer_size", execPlan.workBufSize)
+        .field("strategy", PrintOptimizeStrategy(execPlan.assignOptStrategy))
+        .raw("kernels", kernels)
+        .write(os);
+}
@@ -23,15 +23,19 @@
 #include <cstddef>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <numeric>
 #include <unordered_map>
 #include <vector>
 
 #include "rocfft.h"
 
+#include "chrome_trace.h"
+#include "graph_cache.h"
 #include "logging.h"
 #include "plan.h"
 #include "rtc.h"
+#include "statistics.h"
 #include "transform.h"
 
 #include "kernel_launch.h"
@@ -41,35 +45,151 @@
 
 #include "real2complex.h"
 
+#include "../../shared/array_predicate.h"
 #include "../../shared/environment.h"
 #include "../../shared/printbuffer.h"
 #include "../../shared/ptrdiff.h"
 #include "rocfft_hip.h"
 
+// planar callbacks are passed the kernels' own struct of plane
+// pointers, which must be laid out like the public one
+static_assert(sizeof(callback_planar_data<float>) == sizeof(rocfft_planar_float)
+                  && offsetof(callback_planar_data<float>, imag)
+                         == offsetof(rocfft_planar_float, imag),
+              "planar callback data layout mismatch");
+static_assert(sizeof(callback_planar_data<double>) == sizeof(rocfft_planar_double)
+                  && offsetof(callback_planar_data<double>, imag)
+                         == offsetof(rocfft_planar_double, imag),
+              "planar callback data layout mismatch");
+
+// Graph calls for graph_cache, through the HIP runtime.
+class hip_graph_ops : public graph_ops
+{
+public:
+    static hip_graph_ops& get()
+    {
+        static hip_graph_ops ops;
+        return ops;
+    }
+
+    bool begin_capture(hipStream_t stream) override
+    {
+        // kernel launches may make runtime calls that aren't
+        // otherwise allowed while capturing, e.g. to look up default
+        // callbacks
+        return hipStreamBeginCapture(stream, hipStreamCaptureModeRelaxed) == hipSuccess;
+    }
+    bool end_capture(hipStream_t stream, hipGraph_t& graph) override
+    {
+        return hipStreamEndCapture(stream, &graph) == hipSuccess && graph;
+    }
+    bool instantiate(hipGraph_t graph, hipGraphExec_t& exec) override
+    {
+        return hipGraphInstantiate(&exec, graph, nullptr, nullptr, 0) == hipSuccess;
+    }
+    bool update(hipGraphExec_t exec, hipGraph_t graph) override
+    {
+        hipGraphNode_t           error_node;
+        hipGraphExecUpdateResult result;
+        return hipGraphExecUpdate(exec, graph, &error_node, &result) == hipSuccess
+               && result == hipGraphExecUpdateSuccess;
+    }
+    bool launch(hipGraphExec_t exec, hipStream_t stream) override
+    {
+        return hipGraphLaunch(exec, stream) == hipSuccess;
+    }
+    void destroy_graph(hipGraph_t graph) override
+    {
+        (void)hipGraphDestroy(graph);
+    }
+    void destroy_exec(hipGraphExec_t exec) override
+    {
+        (void)hipGraphExecDestroy(exec);
+    }
+};
+
+// Work out everything about launching the plan's kernels that
+// doesn't depend on the arguments to rocfft_execute, so that
+// executing the plan only needs to fill in user pointers.
+static void BuildLaunchProgram(ExecPlan& execPlan)
+{
+    TreeNode* load_node             = nullptr;
+    TreeNode* store_node            = nullptr;
+    std::tie(load_node, store_node) = execPlan.get_load_store_nodes();
+
+    for(size_t i = 0; i < execPlan.execSeq.size(); ++i)
+    {
+        TreeNode*      node = execPlan.execSeq[i];
+        launch_step_t& step = execPlan.launchProgram[i];
+
+        step.node = node;
+        const size_t complexTSize = sizeof_precision(node->precision);
+        SetupLaunchPtrs(node->obIn,
+                        node->inArrayType,
+                        node->iOffset,
+                        execPlan.tmpWorkBufSize,
+                        execPlan.copyWorkBufSize,
+                        complexTSize,
+                        step.bufIn);
+        SetupLaunchPtrs(node->obOut,
+                        node->outArrayType,
+                        node->oOffset,
+                        execPlan.tmpWorkBufSize,
+                        execPlan.copyWorkBufSize,
+                        complexTSize,
+                        step.bufOut);
+
+        // runtime compilation has finished by now, so these don't wait
+        if(node->compiledKernel.valid())
+            step.compiled = node->compiledKernel.get().get();
+        if(node->compiledKernelWithCallbacks.valid())
+            step.compiledWithCallbacks = node->compiledKernelWithCallbacks.get().get();
+
+        if(node == load_node)
+            execPlan.loadStep = i;
+        if(node == store_node)
+            execPlan.storeStep = i;
+    }
+}
+
 // This function is called during creation of plan: enqueue the HIP kernels by function
 // pointers. Return true if everything goes well. Any internal device memory allocation
 // failure returns false right away.
 bool PlanPowX(ExecPlan& execPlan)
 {
+    // lay out every node's kernel arguments in one staging buffer,
+    // so they can be uploaded with a single allocation and copy
+    execPlan.kernArgArena = std::make_shared<kargs_arena>();
     for(const auto& node : execPlan.execSeq)
     {
+        phase_timer twiddle_timer("twiddles");
+        if(twiddle_timer.active())
+            twiddle_timer.set_detail(PrintScheme(node->scheme));
         if(node->CreateTwiddleTableResource() == false)
             return false;
+        twiddle_timer.stop();
 
-        if(node->CreateDevKernelArgs() == false)
-            return false;
+        node->CreateDevKernelArgs(*execPlan.kernArgArena);
     }
 
+    phase_timer kargs_timer("kernel_args_upload");
+    execPlan.kernArgArena->upload();
     for(const auto& node : execPlan.execSeq)
-    {
-        DevFnCall ptr = nullptr;
-        GridParam gp;
-
-        node->SetupGridParamAndFuncPtr(ptr, gp);
+        node->devKernArg = execPlan.kernArgArena->device_block(node->devKernArgOffset);
+    kargs_timer.stop();
 
-        execPlan.devFnCall.push_back(ptr);
-        execPlan.gridParam.push_back(gp);
+    phase_timer grid_timer("grid_params");
+    execPlan.launchProgram.resize(execPlan.execSeq.size());
+    for(size_t i = 0; i < execPlan.execSeq.size(); ++i)
+    {
+        auto& step = execPlan.launchProgram[i];
+        execPlan.execSeq[i]->SetupGridParamAndFuncPtr(step.fn, step.gridParam);
     }
+    grid_timer.stop();
+
+    phase_timer program_timer("launch_program");
+    BuildLaunchProgram(execPlan);
+    execPlan.graphs = std::make_shared<graph_cache>(hip_graph_ops::get());
 
     return true;
 }
@@ -146,6 +266,249 @@ static float max_memory_bandwidth_GB_per_s()
     return result;
 }
 
+// bytes read and written by a kernel
+static size_t kernel_data_size_bytes(const TreeNode& node)
+{
+    size_t in_size_bytes  = data_size_bytes(node.length, node.precision, node.inArrayType);
+    size_t out_size_bytes = data_size_bytes(node.length, node.precision, node.outArrayType);
+    return (in_size_bytes + out_size_bytes) * node.batch;
+}
+
+// write a kernel's execution time to the profile log
+static void log_kernel_profile(size_t                     plan_id,
+                               size_t                     kernel_index,
+                               ComputeScheme              scheme,
+                               const std::vector<size_t>& lengths,
+                               size_t                     batch,
+                               size_t                     total_size_bytes,
+                               float                      duration_ms,
+                               float                      max_memory_bw)
+{
+    auto exec_bw        = execution_bandwidth_GB_per_s(total_size_bytes, duration_ms);
+    auto efficiency_pct = 0.0;
+    if(max_memory_bw != 0.0)
+        efficiency_pct = 100.0 * exec_bw / max_memory_bw;
+    if(LOG_JSONL_ENABLED())
+        log_record("kernel", plan_id)
+            .field("kernel_index", kernel_index)
+            .field("scheme", PrintScheme(scheme))
+            .field("lengths", lengths)
+            .field("batch", batch)
+            .field("duration_ms", duration_ms)
+            .field("total_size_bytes", total_size_bytes)
+            .field("exec_GB_s", exec_bw)
+            .field("max_mem_GB_s", max_memory_bw)
+            .field("bw_efficiency_pct", efficiency_pct)
+            .write(*LogSingleton::GetInstance().GetProfileOS());
+    else
+        log_profile("TransformPowX",
+                    "scheme",
+                    PrintScheme(scheme),
+                    "duration_ms",
+                    duration_ms,
+                    "in_size",
+                    std::make_pair(static_cast<const size_t*>(lengths.data()), lengths.size()),
+                    "total_size_bytes",
+                    total_size_bytes,
+                    "exec_GB_s",
+                    exec_bw,
+                    "max_mem_GB_s",
+                    max_memory_bw,
+                    "bw_efficiency_pct",
+                    efficiency_pct);
+}
+
+// Profiling and Chrome tracing of kernels launched on user streams.
+// Waiting for each kernel as we do on the null stream would
+// serialize the user's stream, so instead each kernel is bracketed
+// by a pair of events from a pool, and its time is logged once the
+// events complete.  Finished kernels are checked for at the start of
+// each execution and at cleanup, so this never adds synchronization
+// to the stream.
+class async_profiler
+{
+public:
+    struct kernel_t
+    {
+        hipEvent_t          start;
+        hipEvent_t          stop;
+        size_t              plan_id;
+        size_t              kernel_index;
+        ComputeScheme       scheme;
+        std::vector<size_t> lengths;
+        size_t              batch;
+        size_t              total_size_bytes;
+        // write the kernel to the profile log
+        bool log_profile;
+        // JSON args for the kernel's Chrome trace event, or empty if
+        // the kernel isn't traced
+        std::string trace_args;
+    };
+
+    static async_profiler& get()
+    {
+        static async_profiler profiler;
+        return profiler;
+    }
+
+    // Get a pair of events to record around a kernel.  Returns false
+    // if too many kernels are already waiting to be resolved (e.g.
+    // the user's stream is far behind), in which case the kernel is
+    // not profiled.
+    bool acquire(hipEvent_t& start, hipEvent_t& stop)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(pending.size() >= MAX_PENDING)
+            return false;
+        if(!free_events.empty())
+        {
+            std::tie(start, stop) = free_events.back();
+            free_events.pop_back();
+            return true;
+        }
+        if(hipEventCreate(&start) != hipSuccess)
+            return false;
+        if(hipEventCreate(&stop) != hipSuccess)
+        {
+            (void)hipEventDestroy(start);
+            return false;
+        }
+        return true;
+    }
+
+    // queue a kernel whose events have been recorded
+    void enqueue(kernel_t&& kernel)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(std::move(kernel));
+    }
+
+    // Log the kernels that have finished, oldest first.  If 'wait',
+    // wait for all kernels to finish.
+    void resolve(bool wait)
+    {
+        std::vector<kernel_t> done;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::vector<kernel_t>       still_pending;
+            for(auto& kernel : pending)
+            {
+                if(wait)
+                    (void)hipEventSynchronize(kernel.stop);
+                if(hipEventQuery(kernel.stop) == hipSuccess)
+                    done.push_back(std::move(kernel));
+                else
+                    still_pending.push_back(std::move(kernel));
+            }
+            pending.swap(still_pending);
+        }
+        if(done.empty())
+            return;
+
+        float max_memory_bw = max_memory_bandwidth_GB_per_s();
+        for(auto& kernel : done)
+        {
+            float duration_ms = 0.0f;
+            if(hipEventElapsedTime(&duration_ms, kernel.start, kernel.stop) != hipSuccess)
+                continue;
+            if(kernel.log_profile)
+                log_kernel_profile(kernel.plan_id,
+                                   kernel.kernel_index,
+                                   kernel.scheme,
+                                   kernel.lengths,
+                                   kernel.batch,
+                                   kernel.total_size_bytes,
+                                   duration_ms,
+                                   max_memory_bw);
+            chrome_trace::clock::time_point begin;
+            if(!kernel.trace_args.empty() && kernel_begin(kernel.start, begin))
+                chrome_trace::complete("kernel",
+                                       PrintScheme(kernel.scheme),
+                                       begin,
+                                       duration_ms,
+                                       chrome_trace::GPU_STREAM_TID,
+                                       kernel.trace_args);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for(auto& kernel : done)
+            free_events.emplace_back(kernel.start, kernel.stop);
+    }
+
+    // log all outstanding kernels and destroy the pooled events
+    void cleanup()
+    {
+        resolve(true);
+        std::lock_guard<std::mutex> lock(mutex);
+        for(auto& events : free_events)
+        {
+            (void)hipEventDestroy(events.first);
+            (void)hipEventDestroy(events.second);
+        }
+        free_events.clear();
+        std::lock_guard<std::mutex> anchor_lock(anchor_mutex);
+        if(anchor)
+        {
+            (void)hipEventDestroy(anchor);
+            anchor = nullptr;
+        }
+    }
+
+private:
+    static const size_t MAX_PENDING = 4096;
+
+    std::mutex                                     mutex;
+    std::vector<kernel_t>                          pending;
+    std::vector<std::pair<hipEvent_t, hipEvent_t>> free_events;
+
+    // Event timings are only relative to other events, so traced
+    // kernels are placed on the host clock relative to an anchor
+    // event whose host time is known.  The anchor is recorded on a
+    // stream of its own, so that waiting for it doesn't wait for any
+    // of the user's work.
+    std::mutex                      anchor_mutex;
+    hipEvent_t                      anchor = nullptr;
+    chrome_trace::clock::time_point anchor_time;
+
+    // get the host time at which a kernel's start event completed
+    bool kernel_begin(hipEvent_t start, chrome_trace::clock::time_point& begin)
+    {
+        std::lock_guard<std::mutex> lock(anchor_mutex);
+        if(!anchor)
+        {
+            hipStream_t anchor_stream;
+            if(hipStreamCreateWithFlags(&anchor_stream, hipStreamNonBlocking) != hipSuccess)
+                return false;
+            bool recorded = hipEventCreate(&anchor) == hipSuccess
+                            && hipEventRecord(anchor, anchor_stream) == hipSuccess
+                            && hipEventSynchronize(anchor) == hipSuccess;
+            anchor_time = chrome_trace::clock::now();
+            (void)hipStreamDestroy(anchor_stream);
+            if(!recorded)
+            {
+                if(anchor)
+                    (void)hipEventDestroy(anchor);
+                anchor = nullptr;
+                return false;
+            }
+        }
+
+        // negative if the kernel started before the anchor
+        float since_anchor_ms = 0.0f;
+        if(hipEventElapsedTime(&since_anchor_ms, anchor, start) != hipSuccess)
+            return false;
+        begin = anchor_time
+                + std::chrono::duration_cast<chrome_trace::clock::duration>(
+                    std::chrono::duration<float, std::milli>(since_anchor_ms));
+        return true;
+    }
+};
+
+void ResolveKernelProfiles()
+{
+    async_profiler::get().cleanup();
+}
+
 // Print either an input or output buffer, given column-major dimensions
 void DebugPrintBuffer(rocfft_ostream&            stream,
                       rocfft_array_type          type,
@@ -273,13 +636,30 @@ void SetDefaultCallback(const TreeNode* node, const SetCallbackType& type, void*
 
     auto array_type = (type == SetCallbackType::LOAD) ? node->inArrayType : node->outArrayType;
 
-    // guaranteed to only have interleaved type by the caller (rocfft_execute)
     auto is_complex = (array_type == rocfft_array_type_complex_interleaved
                        || array_type == rocfft_array_type_hermitian_interleaved)
                           ? true
                           : false;
+    // planar kernels call callbacks with the planar signature
+    auto is_planar = array_type_is_planar(array_type);
 
-    if(is_complex && type == SetCallbackType::LOAD)
+    if(is_planar && type == SetCallbackType::LOAD)
+    {
+        result = (node->precision == rocfft_precision_single)
+                     ? hipMemcpyFromSymbol(
+                         cb, HIP_SYMBOL(load_cb_default_planar_float2), sizeof(void*))
+                     : hipMemcpyFromSymbol(
+                         cb, HIP_SYMBOL(load_cb_default_planar_double2), sizeof(void*));
+    }
+    else if(is_planar && type == SetCallbackType::STORE)
+    {
+        result = (node->precision == rocfft_precision_single)
+                     ? hipMemcpyFromSymbol(
+                         cb, HIP_SYMBOL(store_cb_default_planar_float2), sizeof(void*))
+                     : hipMemcpyFromSymbol(
+                         cb, HIP_SYMBOL(store_cb_default_planar_double2), sizeof(void*));
+    }
+    else if(is_complex && type == SetCallbackType::LOAD)
     {
         result = (node->precision == rocfft_precision_single)
                      ? hipMemcpyFromSymbol(cb, HIP_SYMBOL(load_cb_default_float2), sizeof(void*))
@@ -308,207 +688,152 @@ void SetDefaultCallback(const TreeNode* node, const SetCallbackType& type, void*
         throw std::runtime_error("hipMemcpyFromSymbol failure");
 }
 
-// Internal plan executor.
-// For in-place transforms, in_buffer == out_buffer.
-void TransformPowX(const ExecPlan&       execPlan,
-                   void*                 in_buffer[],
-                   void*                 out_buffer[],
-                   rocfft_execution_info info)
+// arguments of a kernel's Chrome trace events
+static std::string kernel_trace_args(const ExecPlan& execPlan, size_t kernel_index)
 {
-    assert(execPlan.execSeq.size() == execPlan.devFnCall.size());
-    assert(execPlan.execSeq.size() == execPlan.gridParam.size());
+    const TreeNode* node = execPlan.execSeq[kernel_index];
+
+    json_object args;
+    args.field("plan", execPlan.id)
+        .field("kernel_index", kernel_index)
+        .field("lengths", node->length)
+        .field("batch", node->batch);
+    return args.str();
+}
+
+// Launch the plan's kernels.  'capturing' is true if the launches
+// may be captured into a graph, where events recorded to time
+// kernels asynchronously would never complete on their own.
+static void LaunchPowX(const ExecPlan&       execPlan,
+                       void*                 in_buffer[],
+                       void*                 out_buffer[],
+                       rocfft_execution_info info,
+                       bool                  capturing)
+{
+    assert(execPlan.execSeq.size() == execPlan.launchProgram.size());
 
     // we can log profile information if we're on the null stream,
     // since we will be able to wait for the transform to finish
     bool            emit_profile_log  = LOG_PROFILE_ENABLED() && !info->rocfft_stream;
     bool            emit_kernelio_log = LOG_KERNELIO_ENABLED();
+    bool            emit_chrome_trace = LOG_CHROME_TRACE_ENABLED();
     rocfft_ostream* kernelio_stream   = nullptr;
     float           max_memory_bw     = 0.0;
     hipEvent_t      start, stop;
-    if(emit_profile_log)
+
+    // The Chrome trace shows kernel launches on the calling thread,
+    // and kernel execution on a GPU track.  Like profiling, this
+    // waits for each kernel to finish on the null stream (with
+    // hipEventSynchronize after every kernel), so tracing makes
+    // null-stream executions synchronous.  Kernels on user streams
+    // are traced asynchronously instead.
+    bool trace_gpu    = emit_chrome_trace && !info->rocfft_stream;
+    bool time_kernels = emit_profile_log || trace_gpu;
+    if(time_kernels)
     {
         if(hipEventCreate(&start) != hipSuccess || hipEventCreate(&stop) != hipSuccess)
             throw std::runtime_error("hipEventCreate failure");
-        max_memory_bw = max_memory_bandwidth_GB_per_s();
     }
+    if(emit_profile_log)
+        max_memory_bw = max_memory_bandwidth_GB_per_s();
 
-    // assign callbacks to the node that are actually doing the
-    // loading and storing to/from global memory
-    TreeNode* load_node             = nullptr;
-    TreeNode* store_node            = nullptr;
-    std::tie(load_node, store_node) = execPlan.get_load_store_nodes();
-
-    load_node->callbacks.load_cb_fn        = info->callbacks.load_cb_fn;
-    load_node->callbacks.load_cb_data      = info->callbacks.load_cb_data;
-    load_node->callbacks.load_cb_lds_bytes = info->callbacks.load_cb_lds_bytes;
+    // kernels on user streams are profiled and traced
+    // asynchronously; log any that have finished since the last
+    // execution
+    bool profile_async
+        = (LOG_PROFILE_ENABLED() || emit_chrome_trace) && info->rocfft_stream && !capturing;
 
-    store_node->callbacks.store_cb_fn        = info->callbacks.store_cb_fn;
-    store_node->callbacks.store_cb_data      = info->callbacks.store_cb_data;
-    store_node->callbacks.store_cb_lds_bytes = info->callbacks.store_cb_lds_bytes;
+    bool record_kernel_events
+        = info->events && info->events->mode == rocfft_event_mode_per_kernel;
+    if(LOG_PROFILE_ENABLED() || emit_chrome_trace)
+        async_profiler::get().resolve(false);
 
-    for(size_t i = 0; i < execPlan.execSeq.size(); i++)
+    for(size_t i = 0; i < execPlan.launchProgram.size(); i++)
     {
-        DeviceCallIn data;
-        data.node          = execPlan.execSeq[i];
-        data.rocfft_stream = (info == nullptr) ? 0 : info->rocfft_stream;
-        data.deviceProp    = execPlan.deviceProp;
+        const launch_step_t& step = execPlan.launchProgram[i];
 
-        // Size of complex type
-        const size_t complexTSize = (data.node->precision == rocfft_precision_single)
-                                        ? sizeof(float) * 2
-                                        : sizeof(double) * 2;
+        DeviceCallIn data;
+        ResolveLaunchStep(step,
+                          &execPlan.deviceProp,
+                          info->rocfft_stream,
+                          in_buffer,
+                          out_buffer,
+                          info->workBuffer,
+                          data);
 
-        switch(data.node->obIn)
+        // give callbacks to the kernels that are actually doing the
+        // loading and storing to/from global memory
+        if(i == execPlan.loadStep)
         {
-        case OB_USER_IN:
-            data.bufIn[0] = in_buffer[0];
-            if(data.node->inArrayType == rocfft_array_type_complex_planar
-               || data.node->inArrayType == rocfft_array_type_hermitian_planar)
-            {
-                data.bufIn[1] = in_buffer[1];
-            }
-            break;
-        case OB_USER_OUT:
-            data.bufIn[0] = out_buffer[0];
-            if(data.node->inArrayType == rocfft_array_type_complex_planar
-               || data.node->inArrayType == rocfft_array_type_hermitian_planar)
-            {
-                data.bufIn[1] = out_buffer[1];
-            }
-            break;
-        case OB_TEMP:
-            data.bufIn[0] = info->workBuffer;
-            if(data.node->inArrayType == rocfft_array_type_complex_planar
-               || data.node->inArrayType == rocfft_array_type_hermitian_planar)
-            {
-                // Assume planar using the same extra size of memory as
-                // interleaved format, and we just need to split it for
-                // planar.
-                data.bufIn[1]
-                    = (void*)((char*)info->workBuffer + execPlan.tmpWorkBufSize * complexTSize / 2);
-            }
-            break;
-        case OB_TEMP_CMPLX_FOR_REAL:
-            data.bufIn[0]
-                = (void*)((char*)info->workBuffer + execPlan.tmpWorkBufSize * complexTSize);
-            // TODO: Can we use this in planar as well ??
-            // if(data.node->inArrayType == rocfft_array_type_complex_planar
-            //    || data.node->inArrayType == rocfft_array_type_hermitian_planar)
-            // {
-            //     data.bufIn[1] = (void*)((char*)info->workBuffer
-            //                             + (execPlan.tmpWorkBufSize + execPlan.copyWorkBufSize / 2)
-            //                                   * complexTSize);
-            // }
-            break;
-        case OB_TEMP_BLUESTEIN:
-            data.bufIn[0] = (void*)((char*)info->workBuffer
-                                    + (execPlan.tmpWorkBufSize + execPlan.copyWorkBufSize
-                                       + data.node->iOffset)
-                                          * complexTSize);
-            // Bluestein mul-kernels (3 types) work well for CI->CI
-            // so we only consider CI->CI now
-            break;
-        case OB_UNINIT:
-            rocfft_cerr << "Error: operating buffer not initialized for kernel!\n";
-            assert(data.node->obIn != OB_UNINIT);
-            break;
-        default:
-            rocfft_cerr << "Error: operating buffer not specified for kernel!\n";
-            assert(false);
+            data.callbacks.load_cb_fn        = info->callbacks.load_cb_fn;
+            data.callbacks.load_cb_data      = info->callbacks.load_cb_data;
+            data.callbacks.load_cb_lds_bytes = info->callbacks.load_cb_lds_bytes;
         }
-
-        switch(data.node->obOut)
+        if(i == execPlan.storeStep)
         {
-        case OB_USER_IN:
-            data.bufOut[0] = in_buffer[0];
-            if(data.node->outArrayType == rocfft_array_type_complex_planar
-               || data.node->outArrayType == rocfft_array_type_hermitian_planar)
-            {
-                data.bufOut[1] = in_buffer[1];
-            }
-            break;
-        case OB_USER_OUT:
-            data.bufOut[0] = out_buffer[0];
-            if(data.node->outArrayType == rocfft_array_type_complex_planar
-               || data.node->outArrayType == rocfft_array_type_hermitian_planar)
-            {
-                data.bufOut[1] = out_buffer[1];
-            }
-            break;
-        case OB_TEMP:
-            data.bufOut[0] = info->workBuffer;
-            if(data.node->outArrayType == rocfft_array_type_complex_planar
-               || data.node->outArrayType == rocfft_array_type_hermitian_planar)
-            {
-                // assume planar using the same extra size of memory as
-                // interleaved format, and we just need to split it for
-                // planar.
-                data.bufOut[1]
-                    = (void*)((char*)info->workBuffer + execPlan.tmpWorkBufSize * complexTSize / 2);
-            }
-            break;
-        case OB_TEMP_CMPLX_FOR_REAL:
-            data.bufOut[0]
-                = (void*)((char*)info->workBuffer + execPlan.tmpWorkBufSize * complexTSize);
-            // TODO: Can we use this in planar as well ??
-            // if(data.node->outArrayType == rocfft_array_type_complex_planar
-            //    || data.node->outArrayType == rocfft_array_type_hermitian_planar)
-            // {
-            //     data.bufOut[1] = (void*)((char*)info->workBuffer
-            //                              + (execPlan.tmpWorkBufSize + execPlan.copyWorkBufSize / 2)
-            //                                    * complexTSize);
-            // }
-            break;
-        case OB_TEMP_BLUESTEIN:
-            data.bufOut[0] = (void*)((char*)info->workBuffer
-                                     + (execPlan.tmpWorkBufSize + execPlan.copyWorkBufSize
-                                        + data.node->oOffset)
-                                           * complexTSize);
-            // Bluestein mul-kernels (3 types) work well for CI->CI
-            // so we only consider CI->CI now
-            break;
-        default:
-            assert(false);
+            data.callbacks.store_cb_fn        = info->callbacks.store_cb_fn;
+            data.callbacks.store_cb_data      = info->callbacks.store_cb_data;
+            data.callbacks.store_cb_lds_bytes = info->callbacks.store_cb_lds_bytes;
         }
 
         // if callbacks are enabled, make sure load_cb_fn and store_cb_fn are not nullptrs
-        if((data.node->callbacks.load_cb_fn == nullptr
-            && data.node->callbacks.store_cb_fn != nullptr))
+        if((data.callbacks.load_cb_fn == nullptr && data.callbacks.store_cb_fn != nullptr))
         {
             // set default load callback
-            SetDefaultCallback(data.node, SetCallbackType::LOAD, &data.node->callbacks.load_cb_fn);
+            SetDefaultCallback(data.node, SetCallbackType::LOAD, &data.callbacks.load_cb_fn);
         }
-        else if((data.node->callbacks.load_cb_fn != nullptr
-                 && data.node->callbacks.store_cb_fn == nullptr))
+        else if((data.callbacks.load_cb_fn != nullptr && data.callbacks.store_cb_fn == nullptr))
         {
             // set default store callback
-            SetDefaultCallback(
-                data.node, SetCallbackType::STORE, &data.node->callbacks.store_cb_fn);
+            SetDefaultCallback(data.node, SetCallbackType::STORE, &data.callbacks.store_cb_fn);
         }
 
-        data.gridParam = execPlan.gridParam[i];
-
         if(emit_kernelio_log)
         {
             kernelio_stream = LogSingleton::GetInstance().GetKernelIOOS();
-            *kernelio_stream << "--- --- kernel " << i << " (" << PrintScheme(data.node->scheme)
-                             << ") input:" << std::endl;
-
             if(hipDeviceSynchronize() != hipSuccess)
                 throw std::runtime_error("hipDeviceSynchronize failure");
-            DebugPrintBuffer(*kernelio_stream,
-                             data.node->inArrayType,
-                             data.node->precision,
-                             data.bufIn,
-                             data.node->length,
-                             data.node->inStride,
-                             data.node->iDist,
-                             data.node->iOffset,
-                             data.node->batch);
+            if(LOG_JSONL_ENABLED())
+            {
+                rocfft_ostream input;
+                DebugPrintBuffer(input,
+                                 data.node->inArrayType,
+                                 data.node->precision,
+                                 data.bufIn,
+                                 data.node->length,
+                                 data.node->inStride,
+                                 data.node->iDist,
+                                 data.node->iOffset,
+                                 data.node->batch);
+                log_record("kernel_input", execPlan.id)
+                    .field("kernel_index", i)
+                    .field("scheme", PrintScheme(data.node->scheme))
+                    .field("data", input.str())
+                    .write(*kernelio_stream);
+            }
+            else
+            {
+                *kernelio_stream << "--- --- kernel " << i << " ("
+                                 << PrintScheme(data.node->scheme) << ") input:" << std::endl;
+                DebugPrintBuffer(*kernelio_stream,
+                                 data.node->inArrayType,
+                                 data.node->precision,
+                                 data.bufIn,
+                                 data.node->length,
+                                 data.node->inStride,
+                                 data.node->iDist,
+                                 data.node->iOffset,
+                                 data.node->batch);
+            }
         }
 
-        DevFnCall fn = execPlan.devFnCall[i];
-        if(fn || data.node->compiledKernel.get())
+        // choose which compiled kernel to run
+        RTCKernel* localCompiledKernel = data.get_callback_type() == CallbackType::NONE
+                                             ? step.compiled
+                                             : step.compiledWithCallbacks;
+
+        DevFnCall fn = step.fn;
+        if(fn || step.compiled)
         {
 #ifdef REF_DEBUG
             rocfft_cout << "\n---------------------------------------------\n";
@@ -542,72 +867,104 @@ void TransformPowX(const ExecPlan&       execPlan,
 #endif
 
             // execution kernel:
-            if(emit_profile_log)
+            if(time_kernels)
                 if(hipEventRecord(start) != hipSuccess)
                     throw std::runtime_error("hipEventRecord failure");
 
             DeviceCallOut back;
 
-            // give callback parameters to kernel launcher
-            data.callbacks = execPlan.execSeq[i]->callbacks;
-
-            // choose which compiled kernel to run
-            RTCKernel* localCompiledKernel
-                = data.get_callback_type() == CallbackType::NONE
-                      ? data.node->compiledKernel.get().get()
-                      : data.node->compiledKernelWithCallbacks.get().get();
-
             // skip apply callback kernel if there's no callback
             if(data.node->scheme != CS_KERNEL_APPLY_CALLBACK
                || data.get_callback_type() != CallbackType::NONE)
             {
+                hipEvent_t async_start, async_stop;
+                bool       async_timed
+                    = profile_async && async_profiler::get().acquire(async_start, async_stop);
+                if(async_timed)
+                    if(hipEventRecord(async_start, data.rocfft_stream) != hipSuccess)
+                        throw std::runtime_error("hipEventRecord failure");
+
+                chrome_trace::clock::time_point launch_begin;
+                if(emit_chrome_trace)
+                    launch_begin = chrome_trace::clock::now();
                 if(localCompiledKernel)
                     localCompiledKernel->launch(data);
                 else
                     fn(&data, &back);
+                if(record_kernel_events)
+                    info->events->record(data.rocfft_stream);
+
+                if(async_timed)
+                {
+                    if(hipEventRecord(async_stop, data.rocfft_stream) != hipSuccess)
+                        throw std::runtime_error("hipEventRecord failure");
+                    async_profiler::get().enqueue(
+                        {async_start,
+                         async_stop,
+                         execPlan.id,
+                         i,
+                         data.node->scheme,
+                         data.node->length,
+                         data.node->batch,
+                         kernel_data_size_bytes(*data.node),
+                         LOG_PROFILE_ENABLED(),
+                         emit_chrome_trace ? kernel_trace_args(execPlan, i) : std::string()});
+                }
+
+                if(emit_chrome_trace)
+                {
+                    std::chrono::duration<double, std::milli> launch_ms
+                        = chrome_trace::clock::now() - launch_begin;
+                    chrome_trace::complete("launch",
+                                           PrintScheme(data.node->scheme),
+                                           launch_begin,
+                                           launch_ms.count(),
+                                           log_thread_id(),
+                                           kernel_trace_args(execPlan, i));
+                }
             }
-            if(emit_profile_log)
+            if(time_kernels)
                 if(hipEventRecord(stop) != hipSuccess)
                     throw std::runtime_error("hipEventRecord failure");
 
             // If we were on the null stream, measure elapsed time
             // and emit profile logging.  If a stream was given, we
-            // can't wait for the transform to finish, so we can't
-            // emit any information.
-            if(emit_profile_log)
+            // can't wait for the transform to finish, so the kernel
+            // was timed asynchronously above instead.
+            float duration_ms = 0.0f;
+            if(time_kernels)
             {
                 if(hipEventSynchronize(stop) != hipSuccess)
                     throw std::runtime_error("hipEventSynchronize failure");
-                size_t in_size_bytes = data_size_bytes(
-                    data.node->length, data.node->precision, data.node->inArrayType);
-                size_t out_size_bytes = data_size_bytes(
-                    data.node->length, data.node->precision, data.node->outArrayType);
-                size_t total_size_bytes = (in_size_bytes + out_size_bytes) * data.node->batch;
-
-                float duration_ms = 0.0f;
+                auto gpu_end = chrome_trace::clock::now();
                 if(hipEventElapsedTime(&duration_ms, start, stop) != hipSuccess)
                     throw std::runtime_error("hipEventElapsedTime failure");
-                auto exec_bw        = execution_bandwidth_GB_per_s(total_size_bytes, duration_ms);
-                auto efficiency_pct = 0.0;
-                if(max_memory_bw != 0.0)
-                    efficiency_pct = 100.0 * exec_bw / max_memory_bw;
-                log_profile(__func__,
-                            "scheme",
-                            PrintScheme(execPlan.execSeq[i]->scheme),
-                            "duration_ms",
-                            duration_ms,
-                            "in_size",
-                            std::make_pair(static_cast<const size_t*>(data.node->length.data()),
-                                           data.node->length.size()),
-                            "total_size_bytes",
-                            total_size_bytes,
-                            "exec_GB_s",
-                            exec_bw,
-                            "max_mem_GB_s",
-                            max_memory_bw,
-                            "bw_efficiency_pct",
-                            efficiency_pct);
+
+                // we only know when the kernel finished to within the
+                // latency of the synchronize, so show it on the GPU
+                // track as ending when the synchronize returned
+                if(trace_gpu)
+                {
+                    auto gpu_begin = gpu_end
+                                     - std::chrono::duration_cast<chrome_trace::clock::duration>(
+                                         std::chrono::duration<float, std::milli>(duration_ms));
+                    chrome_trace::complete("kernel",
+                                           PrintScheme(data.node->scheme),
+                                           gpu_begin,
+                                           duration_ms,
+                                           chrome_trace::GPU_TID,
+                                           kernel_trace_args(execPlan, i));
+                }
             }
+            if(emit_profile_log)
+                log_kernel_profile(execPlan.id,
+                                   i,
+                                   data.node->scheme,
+                                   data.node->length,
+                                   data.node->batch,
+                                   kernel_data_size_bytes(*data.node),
+                                   duration_ms,
+                                   max_memory_bw);
 
 #ifdef REF_DEBUG
             refLibOp.VerifyResult(&data);
@@ -623,34 +980,153 @@ void TransformPowX(const ExecPlan&       execPlan,
             hipError_t err = hipPeekAtLastError();
             if(err != hipSuccess)
             {
-                *kernelio_stream << "Error: " << hipGetErrorName(err) << ", "
-                                 << hipGetErrorString(err) << std::endl;
+                if(LOG_JSONL_ENABLED())
+                    log_record("error", execPlan.id)
+                        .field("kernel_index", i)
+                        .field("scheme", PrintScheme(data.node->scheme))
+                        .field("what", hipGetErrorName(err))
+                        .field("detail", hipGetErrorString(err))
+                        .write(*kernelio_stream);
+                else
+                    *kernelio_stream << "Error: " << hipGetErrorName(err) << ", "
+                                     << hipGetErrorString(err) << std::endl;
                 exit(-1);
             }
             if(hipDeviceSynchronize() != hipSuccess)
                 throw std::runtime_error("hipDeviceSynchronize failure");
-            *kernelio_stream << "executed kernel " << i << " (" << PrintScheme(data.node->scheme)
-                             << ")" << std::endl;
+            if(LOG_JSONL_ENABLED())
+                log_record("kernel_executed", execPlan.id)
+                    .field("kernel_index", i)
+                    .field("scheme", PrintScheme(data.node->scheme))
+                    .write(*kernelio_stream);
+            else
+                *kernelio_stream << "executed kernel " << i << " ("
+                                 << PrintScheme(data.node->scheme) << ")" << std::endl;
         }
     }
 
     if(emit_kernelio_log)
     {
-        *kernelio_stream << "final output:\n";
-        DebugPrintBuffer(*kernelio_stream,
-                         execPlan.rootPlan->outArrayType,
-                         execPlan.rootPlan->precision,
-                         out_buffer,
-                         execPlan.oLength,
-                         execPlan.rootPlan->outStride,
-                         execPlan.rootPlan->oDist,
-                         execPlan.rootPlan->oOffset,
-                         execPlan.rootPlan->batch);
-        *kernelio_stream << std::endl;
+        if(LOG_JSONL_ENABLED())
+        {
+            rocfft_ostream output;
+            DebugPrintBuffer(output,
+                             execPlan.rootPlan->outArrayType,
+                             execPlan.rootPlan->precision,
+                             out_buffer,
+                             execPlan.oLength,
+                             execPlan.rootPlan->outStride,
+                             execPlan.rootPlan->oDist,
+                             execPlan.rootPlan->oOffset,
+                             execPlan.rootPlan->batch);
+            log_record("final_output", execPlan.id)
+                .field("data", output.str())
+                .write(*kernelio_stream);
+        }
+        else
+        {
+            *kernelio_stream << "final output:\n";
+            DebugPrintBuffer(*kernelio_stream,
+                             execPlan.rootPlan->outArrayType,
+                             execPlan.rootPlan->precision,
+                             out_buffer,
+                             execPlan.oLength,
+                             execPlan.rootPlan->outStride,
+                             execPlan.rootPlan->oDist,
+                             execPlan.rootPlan->oOffset,
+                             execPlan.rootPlan->batch);
+            *kernelio_stream << std::endl;
+        }
     }
-    if(emit_profile_log)
+    if(time_kernels)
     {
         (void)hipEventDestroy(start);
         (void)hipEventDestroy(stop);
     }
 }
+
+// Count an execution of the plan, and the kernels it launches.
+static void CountExecution(const ExecPlan& execPlan, rocfft_execution_info info)
+{
+    auto& exec_stats = rocfft_stats::get().exec;
+    if(!stat_sub_plan_scope::active())
+    {
+        exec_stats.add(stat_sharded_counters::EXECUTIONS);
+        exec_stats.add(stat_sharded_counters::scheme_executions(execPlan.rootPlan->scheme));
+    }
+
+    for(size_t i = 0; i < execPlan.launchProgram.size(); ++i)
+    {
+        const launch_step_t& step = execPlan.launchProgram[i];
+        if(!step.fn && !step.compiled)
+            continue;
+        // apply callback kernels only run if there's a callback
+        bool callbacks = (i == execPlan.loadStep && info->callbacks.load_cb_fn)
+                         || (i == execPlan.storeStep && info->callbacks.store_cb_fn);
+        if(step.node->scheme == CS_KERNEL_APPLY_CALLBACK && !callbacks)
+            continue;
+        exec_stats.add(stat_sharded_counters::KERNEL_LAUNCHES);
+        exec_stats.add(stat_sharded_counters::scheme_launches(step.node->scheme));
+    }
+}
+
+// Internal plan executor.
+// For in-place transforms, in_buffer == out_buffer.
+void TransformPowX(const ExecPlan&       execPlan,
+                   void*                 in_buffer[],
+                   void*                 out_buffer[],
+                   rocfft_execution_info info)
+{
+    auto exec_begin = chrome_trace::clock::now();
+    CountExecution(execPlan, info);
+
+    // events from the last execution are reused
+    execution_events* events = info->events.get();
+    if(events)
+        events->count = 0;
+
+    // logging that waits for kernels to finish can't be captured
+    // into a graph, and nor can events that belong to one execution
+    bool use_graph = info->graphReplay && execPlan.graphs && !LOG_PROFILE_ENABLED()
+                     && !LOG_KERNELIO_ENABLED()
+                     && !(events && events->mode == rocfft_event_mode_per_kernel);
+
+    const char* graph_result = nullptr;
+    if(use_graph)
+    {
+        graph_key key;
+        key.in_buffer[0]  = in_buffer[0];
+        key.out_buffer[0] = out_buffer[0];
+        // interleaved buffers only need one pointer
+        if(array_type_is_planar(execPlan.rootPlan->inArrayType))
+            key.in_buffer[1] = in_buffer[1];
+        if(array_type_is_planar(execPlan.rootPlan->outArrayType))
+            key.out_buffer[1] = out_buffer[1];
+        key.work_buffer = info->workBuffer;
+        key.stream      = info->rocfft_stream;
+        key.callbacks   = info->callbacks;
+
+        auto result = execPlan.graphs->execute(
+            key, [&]() { LaunchPowX(execPlan, in_buffer, out_buffer, info, true); });
+
+        static const char* result_names[] = {"replayed", "updated", "captured", "eager"};
+        graph_result                      = result_names[result];
+    }
+    else
+        LaunchPowX(execPlan, in_buffer, out_buffer, info, false);
+
+    if(events && events->mode == rocfft_event_mode_completion)
+        events->record(info->rocfft_stream);
+
+    if(LOG_CHROME_TRACE_ENABLED())
+    {
+        std::chrono::duration<double, std::milli> exec_ms = chrome_trace::clock::now() - exec_begin;
+
+        json_object args;
+        args.field("plan", execPlan.id);
+        if(graph_result)
+            args.field("graph", graph_result);
+        chrome_trace::complete(
+            "execute", "rocfft_execute", exec_begin, exec_ms.count(), log_thread_id(), args.str());
+    }
+}
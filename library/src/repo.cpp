@@ -20,11 +20,14 @@
 * THE SOFTWARE.
 *******************************************************************************/
 
+#include <algorithm>
 #include <assert.h>
+#include <future>
 #include <iostream>
 #include <numeric>
 #include <vector>
 
+#include "../../shared/environment.h"
 #include "logging.h"
 #include "node_factory.h"
 #include "plan.h"
@@ -34,49 +37,153 @@
 
 // Implementation of Class Repo
 
-std::mutex        Repo::mtx;
-std::atomic<bool> Repo::repoDestroyed(false);
+std::mutex          Repo::mtx;
+std::atomic<bool>   Repo::repoDestroyed(false);
+std::atomic<size_t> Repo::resident_tables(0);
+std::atomic<size_t> Repo::resident_bytes(0);
+
+Repo::Repo()
+{
+    auto budget = rocfft_getenv("ROCFFT_TWIDDLE_CACHE_BYTES");
+    if(!budget.empty())
+    {
+        try
+        {
+            unused_budget = std::stoull(budget);
+        }
+        catch(std::exception&)
+        {
+            // leave the default budget if the variable is garbage
+        }
+    }
+}
 
 template <typename KeyType>
 std::pair<void*, size_t>
-    Repo::GetTwiddlesInternal(KeyType                                             key,
-                              std::map<KeyType, std::pair<gpubuf, unsigned int>>& twiddles,
-                              std::map<void*, KeyType>&                           twiddles_reverse,
-                              std::function<gpubuf()>                             create_twiddle)
+    Repo::GetTwiddlesInternal(std::unique_lock<std::mutex>&    lock,
+                              KeyType                          key,
+                              std::map<KeyType, repo_entry_t>& twiddles,
+                              std::map<void*, KeyType>&        twiddles_reverse,
+                              std::function<gpubuf()>          create_twiddle)
 {
     if(repoDestroyed)
     {
         throw std::runtime_error("Repo prematurely destroyed.");
     }
 
+    Repo& repo = Repo::GetRepo();
+
     // see if the repo has already stored the plan or not
     if(hipGetDevice(&key.deviceId) != hipSuccess)
     {
         throw std::runtime_error("hipGetDevice failed.");
     }
 
+    // look for an exact match first, then for a finished table that
+    // subsumes the one we want
     auto it = twiddles.find(key);
+    if(it == twiddles.end())
+        it = std::find_if(twiddles.begin(), twiddles.end(), [&](const auto& t) {
+            return !t.second.creating && t.first.subsumes(key);
+        });
     if(it != twiddles.end())
     {
-        // already had this length
-        it->second.second += 1;
-        return {it->second.first.data(), it->second.first.size()};
+        // already had this table
+        auto& entry = it->second;
+        if(entry.refcount == 0)
+        {
+            // table was being kept warm, and is now in use again
+            repo.unused.erase(entry.unused_pos);
+            repo.unused_bytes -= entry.buf.size();
+        }
+        entry.refcount += 1;
+        repo.hits += 1;
+        if(entry.creating)
+        {
+            // another thread is creating this table - wait for it
+            // without blocking other keys.  This throws if creation
+            // failed.
+            auto ready = entry.ready;
+            lock.unlock();
+            return ready.get();
+        }
+        size_t size
+            = key.elements() ? key.elements() * sizeof_precision(key.precision) : entry.buf.size();
+        return {entry.buf.data(), size};
+    }
+
+    // otherwise, need to allocate.  Leave a placeholder so other
+    // threads wanting the same key wait for this creation, and create
+    // the table without holding the lock.
+    repo.misses += 1;
+    std::promise<std::pair<void*, size_t>> promise;
+    repo_entry_t                           placeholder;
+    placeholder.refcount = 1;
+    placeholder.creating = true;
+    placeholder.ready    = promise.get_future().share();
+    twiddles.emplace(key, std::move(placeholder));
+    lock.unlock();
+
+    gpubuf             buf;
+    std::exception_ptr error;
+    try
+    {
+        try
+        {
+            buf = create_twiddle();
+        }
+        catch(std::exception&)
+        {
+            // device memory might be taken up by unused tables - free
+            // them and try once more
+            lock.lock();
+            bool have_unused = !repo.unused.empty();
+            repo.EvictUnused(0);
+            lock.unlock();
+            if(!have_unused)
+                throw;
+            buf = create_twiddle();
+        }
+    }
+    catch(...)
+    {
+        error = std::current_exception();
     }
 
-    // otherwise, need to allocate
-    auto buf = create_twiddle();
+    lock.lock();
+    // Clear() leaves tables that are being created alone, so the
+    // placeholder must still be here
+    it = twiddles.find(key);
+    assert(it != twiddles.end() && it->second.creating);
+
     // if allocation failed, don't update maps
-    if(buf.data() == nullptr)
+    if(error || buf.data() == nullptr)
+    {
+        twiddles.erase(it);
+        if(error)
+        {
+            promise.set_exception(error);
+            std::rethrow_exception(error);
+        }
+        promise.set_value({nullptr, 0});
         return {nullptr, 0};
-    it = twiddles.insert({key, std::make_pair(std::move(buf), 1)}).first;
-    twiddles_reverse.insert({it->second.first.data(), key});
-    return {it->second.first.data(), it->second.first.size()};
+    }
+
+    auto& entry    = it->second;
+    entry.buf      = std::move(buf);
+    entry.creating = false;
+    twiddles_reverse.insert({entry.buf.data(), key});
+    resident_tables.fetch_add(1, std::memory_order_relaxed);
+    resident_bytes.fetch_add(entry.buf.size(), std::memory_order_relaxed);
+    std::pair<void*, size_t> result{entry.buf.data(), entry.buf.size()};
+    promise.set_value(result);
+    return result;
 }
 
 template <typename KeyType>
-void Repo::ReleaseTwiddlesInternal(void*                                               ptr,
-                                   std::map<KeyType, std::pair<gpubuf, unsigned int>>& twiddles,
-                                   std::map<void*, KeyType>& twiddles_reverse)
+void Repo::ReleaseTwiddlesInternal(void*                            ptr,
+                                   std::map<KeyType, repo_entry_t>& twiddles,
+                                   std::map<void*, KeyType>&        twiddles_reverse)
 {
     if(repoDestroyed)
     {
@@ -93,12 +200,47 @@ void Repo::ReleaseTwiddlesInternal(void*
         twiddles_reverse.erase(reverse_it);
         return;
     }
-    forward_it->second.second -= 1;
-    if(forward_it->second.second == 0)
+    auto& entry = forward_it->second;
+    entry.refcount -= 1;
+    if(entry.refcount == 0)
+    {
+        // keep the table warm, then trim unused tables to the budget
+        Repo& repo       = Repo::GetRepo();
+        entry.unused_pos = repo.unused.insert(repo.unused.begin(), ptr);
+        repo.unused_bytes += entry.buf.size();
+        repo.EvictUnused(repo.unused_budget);
+    }
+}
+
+template <typename KeyType>
+bool Repo::EvictInternal(void*                            ptr,
+                         std::map<KeyType, repo_entry_t>& twiddles,
+                         std::map<void*, KeyType>&        twiddles_reverse)
+{
+    auto reverse_it = twiddles_reverse.find(ptr);
+    if(reverse_it == twiddles_reverse.end())
+        return false;
+    auto forward_it = twiddles.find(reverse_it->second);
+    if(forward_it != twiddles.end())
     {
+        unused_bytes -= forward_it->second.buf.size();
+        resident_tables.fetch_sub(1, std::memory_order_relaxed);
+        resident_bytes.fetch_sub(forward_it->second.buf.size(), std::memory_order_relaxed);
         // remove from both maps
         twiddles.erase(forward_it);
-        twiddles_reverse.erase(reverse_it);
+    }
+    twiddles_reverse.erase(reverse_it);
+    return true;
+}
+
+void Repo::EvictUnused(size_t budget)
+{
+    while(unused_bytes > budget && !unused.empty())
+    {
+        void* ptr = unused.back();
+        unused.pop_back();
+        if(!EvictInternal(ptr, twiddles_1D, twiddles_1D_reverse))
+            EvictInternal(ptr, twiddles_2D, twiddles_2D_reverse);
     }
 }
 
@@ -109,11 +251,11 @@ std::pair<void*, size_t> Repo::GetTwiddles1D(size_t                     length,
                                              bool                       attach_halfN,
                                              const std::vector<size_t>& radices)
 {
-    std::lock_guard<std::mutex> lck(mtx);
-    Repo&                       repo = Repo::GetRepo();
+    std::unique_lock<std::mutex> lock(mtx);
+    Repo&                        repo = Repo::GetRepo();
 
     repo_key_1D_t key{length, length_limit, precision, largeTwdBase, attach_halfN, radices};
-    return GetTwiddlesInternal(key, repo.twiddles_1D, repo.twiddles_1D_reverse, [&]() {
+    return GetTwiddlesInternal(lock, key, repo.twiddles_1D, repo.twiddles_1D_reverse, [&]() {
         return twiddles_create(
             length, length_limit, precision, largeTwdBase, attach_halfN, radices);
     });
@@ -122,11 +264,11 @@ std::pair<void*, size_t> Repo::GetTwiddles1D(size_t                     length,
 std::pair<void*, size_t>
     Repo::GetTwiddles2D(size_t length0, size_t length1, rocfft_precision precision)
 {
-    std::lock_guard<std::mutex> lck(mtx);
-    Repo&                       repo = Repo::GetRepo();
+    std::unique_lock<std::mutex> lock(mtx);
+    Repo&                        repo = Repo::GetRepo();
 
     repo_key_2D_t key{length0, length1, precision};
-    return GetTwiddlesInternal(key, repo.twiddles_2D, repo.twiddles_2D_reverse, [&]() {
+    return GetTwiddlesInternal(lock, key, repo.twiddles_2D, repo.twiddles_2D_reverse, [&]() {
         return twiddles_create_2D(length0, length1, precision);
     });
 }
@@ -153,6 +295,104 @@ void Repo::Clear()
     if(repoDestroyed)
         return;
     Repo& repo = Repo::GetRepo();
-    repo.twiddles_1D.clear();
-    repo.twiddles_2D.clear();
+
+    // tables being created by other threads are left alone - the
+    // creating thread still needs to find its placeholder
+    auto clear_finished = [](auto& twiddles) {
+        for(auto it = twiddles.begin(); it != twiddles.end();)
+        {
+            if(it->second.creating)
+                ++it;
+            else
+                it = twiddles.erase(it);
+        }
+    };
+    clear_finished(repo.twiddles_1D);
+    clear_finished(repo.twiddles_2D);
+    repo.twiddles_1D_reverse.clear();
+    repo.twiddles_2D_reverse.clear();
+    repo.unused.clear();
+    repo.unused_bytes = 0;
+    // only tables still being created are left, and those aren't
+    // counted until they're finished
+    resident_tables.store(0, std::memory_order_relaxed);
+    resident_bytes.store(0, std::memory_order_relaxed);
+}
+
+void Repo::SetUnusedBudget(size_t budget)
+{
+    std::lock_guard<std::mutex> lck(mtx);
+    if(repoDestroyed)
+        return;
+    Repo& repo         = Repo::GetRepo();
+    repo.unused_budget = budget;
+    repo.EvictUnused(budget);
+}
+
+void Repo::GetUsage(size_t& budget,
+                    size_t& used_bytes,
+                    size_t& unused_bytes,
+                    size_t& tables,
+                    size_t& hits,
+                    size_t& misses)
+{
+    std::lock_guard<std::mutex> lck(mtx);
+    budget = used_bytes = unused_bytes = tables = hits = misses = 0;
+    if(repoDestroyed)
+        return;
+    Repo& repo = Repo::GetRepo();
+
+    size_t total = 0;
+    for(const auto& t : repo.twiddles_1D)
+        total += t.second.buf.size();
+    for(const auto& t : repo.twiddles_2D)
+        total += t.second.buf.size();
+
+    budget       = repo.unused_budget;
+    used_bytes   = total - repo.unused_bytes;
+    unused_bytes = repo.unused_bytes;
+    tables       = repo.twiddles_1D.size() + repo.twiddles_2D.size();
+    hits         = repo.hits;
+    misses       = repo.misses;
+}
+
+rocfft_status rocfft_twiddle_cache_set_budget(size_t budget_bytes)
+{
+    try
+    {
+        Repo::SetUnusedBudget(budget_bytes);
+    }
+    catch(...)
+    {
+        return rocfft_status_failure;
+    }
+    return rocfft_status_success;
+}
+
+rocfft_status rocfft_twiddle_cache_get_usage(size_t* budget_bytes,
+                                             size_t* used_bytes,
+                                             size_t* unused_bytes,
+                                             size_t* hits,
+                                             size_t* misses)
+{
+    size_t budget, used, unused, tables, nhits, nmisses;
+    try
+    {
+        Repo::GetUsage(budget, used, unused, tables, nhits, nmisses);
+    }
+    catch(...)
+    {
+        return rocfft_status_failure;
+    }
+    if(budget_bytes)
+        *budget_bytes = budget;
+    if(used_bytes)
+        *used_bytes = used;
+    if(unused_bytes)
+        *unused_bytes = unused;
+    if(hits)
+        *hits = nhits;
+    if(misses)
+        *misses = nmisses;
+    return rocfft_status_success;
 }
@@ -24,6 +24,9 @@
 static int rocfft_abort_once();
 
 #include "rocfft_ostream.hpp"
+#include "../../shared/environment.h"
+#include <algorithm>
+#include <chrono>
 #include <csignal>
 #include <fcntl.h>
 #include <iostream>
@@ -33,8 +36,12 @@ static int rocfft_abort_once();
 #endif
 
 // static data
-std::unique_ptr<rocfft_ostream::worker_map_t> rocfft_ostream::worker_map;
-std::unique_ptr<std::recursive_mutex>         rocfft_ostream::worker_map_mutex;
+std::unique_ptr<rocfft_ostream::worker_map_t>    rocfft_ostream::worker_map;
+std::unique_ptr<rocfft_ostream::worker_fd_map_t> rocfft_ostream::worker_fd_map;
+std::unique_ptr<std::shared_timed_mutex>         rocfft_ostream::worker_map_mutex;
+std::atomic<size_t>                              rocfft_ostream::log_generation{0};
+std::atomic<size_t>                              rocfft_ostream::dropped_count{0};
+bool                                             rocfft_ostream::hold_writes = false;
 
 /***********************************************************************
  * rocfft_ostream functions                                           *
@@ -80,7 +87,7 @@ extern "C" void rocfft_abort()
 }
 
 // Get worker for writing to a file descriptor
-std::shared_ptr<rocfft_ostream::worker> rocfft_ostream::get_worker(int fd)
+std::shared_ptr<rocfft_ostream::worker> rocfft_ostream::get_worker(int fd, bool remember_fd)
 {
     // For a file descriptor indicating an error, return a nullptr
     if(fd == -1)
@@ -90,6 +97,15 @@ std::shared_ptr<rocfft_ostream::worker> rocfft_ostream::get_worker(int fd)
     if(!worker_map_mutex || !worker_map)
         return nullptr;
 
+    // Fast path: this descriptor has been looked up before
+    if(remember_fd)
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(*worker_map_mutex);
+        auto                                      found = worker_fd_map->find(fd);
+        if(found != worker_fd_map->end())
+            return found->second;
+    }
+
     // C++ allows type punning of common initial sequences
     union
     {
@@ -130,32 +146,59 @@ std::shared_ptr<rocfft_ostream::worker> rocfft_ostream::get_worker(int fd)
     }
 #endif
 
-    // Lock the map from file_id -> std::shared_ptr<rocfft_ostream::worker>
-    std::lock_guard<std::recursive_mutex> lock(*worker_map_mutex);
+    const file_id_t id        = file_id;
+    auto            find_file = [&]() -> std::shared_ptr<worker> {
+        auto found = worker_map->find(id);
+        if(found == worker_map->end())
+            return nullptr;
+        if(remember_fd)
+            (*worker_fd_map)[fd] = found->second;
+        return found->second;
+    };
+
+    // Look for an existing worker for this file
+    {
+        std::lock_guard<std::shared_timed_mutex> lock(*worker_map_mutex);
+        if(!worker_map)
+            return nullptr;
+        auto existing = find_file();
+        if(existing)
+            return existing;
+    }
 
-    // Insert a nullptr map element if file_id doesn't exist in map already
-    // worker_ptr is a reference to the std::shared_ptr<rocfft_ostream::worker>
-    auto& worker_ptr = worker_map->emplace(file_id, nullptr).first->second;
+    // Create the worker without holding the lock, since failing to
+    // create it aborts, and aborting cleans up the worker map
+    auto new_worker = std::make_shared<worker>(fd);
 
-    // If a new entry was inserted, or an old entry is empty, create new worker
-    if(!worker_ptr)
-        worker_ptr = std::make_shared<worker>(fd);
+    std::lock_guard<std::shared_timed_mutex> lock(*worker_map_mutex);
+    if(!worker_map)
+        return nullptr;
+
+    // Another thread may have created a worker for the same file in
+    // the meantime - use that one instead
+    auto existing = find_file();
+    if(existing)
+        return existing;
 
-    // Return the existing or new worker matching the file
-    return worker_ptr;
+    worker_map->emplace(id, new_worker);
+    if(remember_fd)
+        (*worker_fd_map)[fd] = new_worker;
+    return new_worker;
 }
 
 // Construct rocfft_ostream from a file descriptor
 rocfft_ostream::rocfft_ostream(int fd)
-    : worker_ptr(get_worker(fd))
+    : worker_ptr(get_worker(fd, true))
 {
 }
 
 // Construct rocfft_ostream from a filename opened for writing with truncation
 rocfft_ostream::rocfft_ostream(const char* filename)
 {
+    // the descriptor is closed right away, and its number may be
+    // reused for another file, so don't remember it
     int fd     = OPEN(filename);
-    worker_ptr = get_worker(fd);
+    worker_ptr = get_worker(fd, false);
     if(!worker_ptr)
     {
         std::cerr << "Cannot open " << filename << std::endl;
@@ -178,9 +221,12 @@ void rocfft_ostream::flush()
         // The contents of the string buffer
         auto str = os.str();
 
-        // Empty string buffers kill the worker thread, so they are not flushed here
         if(str.size())
-            worker_ptr->send(std::move(str));
+        {
+            if(!ring.get())
+                ring = worker_ptr->add_ring();
+            worker_ptr->send(*ring.get(), std::move(str));
+        }
 
         // Clear the string buffer
         clear();
@@ -191,18 +237,32 @@ void rocfft_ostream::setup()
 {
     if(worker_map_mutex && worker_map)
         return;
-    worker_map_mutex = std::make_unique<std::recursive_mutex>();
+    worker_map_mutex = std::make_unique<std::shared_timed_mutex>();
     worker_map       = std::make_unique<worker_map_t>();
+    worker_fd_map    = std::make_unique<worker_fd_map_t>();
+    hold_writes      = !rocfft_getenv("ROCFFT_LOG_HOLD_WRITES").empty();
+    log_generation.fetch_add(1, std::memory_order_acq_rel);
 }
 
 void rocfft_ostream::cleanup()
 {
     if(worker_map_mutex && worker_map)
     {
-        std::lock_guard<std::recursive_mutex> lock(*worker_map_mutex);
+        std::lock_guard<std::shared_timed_mutex> lock(*worker_map_mutex);
+
+        // Streams may outlive the map (e.g. thread-local streams), so
+        // make sure everything they have sent so far gets written
+        for(auto& w : *worker_map)
+        {
+            w.second->release();
+            w.second->drain();
+        }
+
         worker_map.reset();
+        worker_fd_map.reset();
     }
     worker_map_mutex.reset();
+    log_generation.fetch_add(1, std::memory_order_acq_rel);
 }
 
 /***********************************************************************
@@ -291,82 +351,177 @@ rocfft_ostream& operator<<(rocfft_ostream& os, std::ostream& (*pf)(std::ostream&
  * rocfft_ostream::worker functions handle logging in a single thread *
  ***********************************************************************/
 
-// Send a string to the worker thread for this stream's device/inode
-// Empty strings tell the worker thread to exit
-void rocfft_ostream::worker::send(std::string str)
+bool rocfft_ostream::worker::ring::push(uint64_t timestamp, std::string&& str)
+{
+    size_t t = tail.load(std::memory_order_relaxed);
+    size_t h = head.load(std::memory_order_acquire);
+    if(t - h == max_records)
+        return false;
+    // always accept a record into an empty ring, so that one record
+    // larger than the byte limit can still be written
+    size_t size = str.size();
+    if(t != h && bytes.load(std::memory_order_relaxed) + size > max_bytes)
+        return false;
+
+    auto& record     = records[t % max_records];
+    record.timestamp = timestamp;
+    record.str       = std::move(str);
+    bytes.fetch_add(size, std::memory_order_relaxed);
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+bool rocfft_ostream::worker::ring::pop(record_t& record)
 {
-    // task_t consists of string and promise
-    // std::move transfers ownership of str and promise to task
-    task_t worker_task(std::move(str));
+    size_t h = head.load(std::memory_order_relaxed);
+    if(h == tail.load(std::memory_order_acquire))
+        return false;
+
+    auto& front = records[h % max_records];
+    record      = std::move(front);
+    front.str   = std::string();
+    bytes.fetch_sub(record.str.size(), std::memory_order_relaxed);
+    head.store(h + 1, std::memory_order_release);
+    return true;
+}
 
-    // The future indicating when the operation has completed
-    auto future = worker_task.get_future();
+std::shared_ptr<rocfft_ostream::worker::ring> rocfft_ostream::worker::add_ring()
+{
+    auto                        r = std::make_shared<ring>();
+    std::lock_guard<std::mutex> lock(rings_mutex);
+    rings.push_back(r);
+    return r;
+}
 
-    // Submit the task to the worker assigned to this device/inode
-    // Hold mutex for as short as possible, to reduce contention
+// Queue a string for the worker thread for this stream's device/inode
+void rocfft_ostream::worker::send(ring& r, std::string&& str)
+{
+    auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now().time_since_epoch())
+                         .count();
+    if(!r.push(timestamp, std::move(str)))
     {
-        std::lock_guard<std::mutex> lock(mutex);
-        queue.push(std::move(worker_task));
+        // The ring is full, so write it out here unless another
+        // thread is already writing.  The record is only dropped
+        // while the file is busy, which means the writer can't keep
+        // up with the rate records are produced.
+        std::unique_lock<std::mutex> write_lock(write_mutex, std::try_to_lock);
+        if(!write_lock.owns_lock())
+        {
+            dropped_count.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        drain_locked();
+        // an empty ring always accepts a record
+        r.push(timestamp, std::move(str));
+        return;
     }
-    // no lock needed for notification
-    cond.notify_one();
 
-    // Wait for the task to be completed, to ensure flushed IO
-#ifdef WIN32
-    // NOTE: this is a hack to avoid hangs at shutdown
-    //
-    // cppcheck-suppress accessMoved
-    if(worker_task.size())
-#endif
-        future.get();
+    // only wake the worker if it doesn't already have work pending,
+    // so a burst of records costs one wakeup
+    if(!pending.exchange(true, std::memory_order_acq_rel))
+        cond.notify_one();
 }
 
-// Worker thread which serializes data to be written to a device/inode
-void rocfft_ostream::worker::thread_function()
+// Write out all queued records, oldest first
+void rocfft_ostream::worker::drain()
 {
-    // Clear any errors in the FILE
-    clearerr(file);
-
-    // Lock the mutex in preparation for cond.wait
-    std::unique_lock<std::mutex> lock(mutex);
+    std::lock_guard<std::mutex> write_lock(write_mutex);
+    drain_locked();
+}
 
-    while(true)
+void rocfft_ostream::worker::release()
+{
     {
-        // Wait for any data, ignoring spurious wakeups, locks lock on continue
-        cond.wait(lock, [&] { return !queue.empty(); });
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        holding = false;
+    }
+    cond.notify_all();
+}
 
-        // With the mutex locked, get and pop data from the front of queue
-        task_t task = std::move(queue.front());
-        queue.pop();
+void rocfft_ostream::worker::drain_locked()
+{
+    std::vector<std::shared_ptr<ring>> current;
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex);
+        current = rings;
+    }
 
-        // Temporarily unlock queue mutex, unblocking other threads
-        lock.unlock();
+    // check for closed rings before draining them, so that a ring is
+    // only forgotten after its last record has been taken
+    std::vector<ring*>          finished;
+    std::vector<ring::record_t> batch;
+    ring::record_t              record;
+    for(auto& r : current)
+    {
+        if(r->closed.load(std::memory_order_acquire))
+            finished.push_back(r.get());
+        while(r->pop(record))
+            batch.push_back(std::move(record));
+    }
 
-        // An empty message indicates the closing of the stream
-        if(!task.size())
-        {
-            // Tell future to wake
-            task.set_value();
-            break;
-        }
+    // each ring is already in order, so a stable sort merges them
+    std::stable_sort(batch.begin(), batch.end(), [](const auto& a, const auto& b) {
+        return a.timestamp < b.timestamp;
+    });
 
-        // Write the data
-        fwrite(task.data(), 1, task.size(), file);
+    if(!write_failed && !batch.empty())
+    {
+        for(const auto& rec : batch)
+            fwrite(rec.str.data(), 1, rec.str.size(), file);
 
         // Detect any error and flush the C FILE stream
         if(ferror(file) || fflush(file))
         {
             perror("Error writing log file");
-
-            // Tell future to wake up
-            task.set_value();
-            break;
+            write_failed = true;
         }
+    }
+
+    if(!finished.empty())
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex);
+        rings.erase(std::remove_if(rings.begin(),
+                                   rings.end(),
+                                   [&](const std::shared_ptr<ring>& r) {
+                                       return std::find(finished.begin(), finished.end(), r.get())
+                                              != finished.end();
+                                   }),
+                    rings.end());
+    }
+}
+
+// Worker thread which serializes data to be written to a device/inode
+void rocfft_ostream::worker::thread_function()
+{
+    // Clear any errors in the FILE
+    clearerr(file);
+
+    std::unique_lock<std::mutex> lock(wake_mutex);
 
-        // Promise that the data has been written
-        task.set_value();
+    // Hold the file until released, so that nobody can write it
+    if(holding)
+    {
+        lock.unlock();
+        std::unique_lock<std::mutex> write_lock(write_mutex);
+        lock.lock();
+        held = true;
+        cond.notify_all();
+        cond.wait(lock, [&] { return stop || !holding; });
+    }
 
-        // Re-lock the mutex in preparation for cond.wait
+    while(!stop)
+    {
+        // Producers notify without holding the mutex, so a wakeup can
+        // be missed - the timeout bounds how long records can wait
+        cond.wait_for(lock, std::chrono::milliseconds(50), [&] {
+            return stop || pending.load(std::memory_order_acquire);
+        });
+        pending.store(false, std::memory_order_release);
+
+        // Unlock while writing, so stop requests aren't blocked
+        lock.unlock();
+        drain();
         lock.lock();
     }
 }
@@ -389,16 +544,28 @@ rocfft_ostream::worker::worker(int fd)
     }
 
     // Create a worker thread, capturing *this
-    thread = std::thread([=] { thread_function(); });
+    holding = hold_writes;
+    thread  = std::thread([=] { thread_function(); });
 
-    // Detatch from the worker thread
-    thread.detach();
+    // Wait for a holding thread to take the file, so that nothing
+    // gets written before then
+    std::unique_lock<std::mutex> lock(wake_mutex);
+    cond.wait(lock, [&] { return held || !holding; });
 }
 
 rocfft_ostream::worker::~worker()
 {
-    // Tell worker thread to exit, by sending it an empty string
-    send({});
+    // Tell worker thread to exit and wait for it
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        stop = true;
+    }
+    cond.notify_all();
+    if(thread.joinable())
+        thread.join();
+
+    // Write whatever arrived after the thread's last drain
+    drain();
 
     // Close the FILE
     if(file)
@@ -422,6 +589,30 @@ rocfft_ostream& operator<<(rocfft_ostream& os, rocfft_transform_type type)
     case rocfft_transform_type_real_inverse:
         os << "real_inverse";
         break;
+    case rocfft_transform_type_dct_1:
+        os << "dct_1";
+        break;
+    case rocfft_transform_type_dct_2:
+        os << "dct_2";
+        break;
+    case rocfft_transform_type_dct_3:
+        os << "dct_3";
+        break;
+    case rocfft_transform_type_dct_4:
+        os << "dct_4";
+        break;
+    case rocfft_transform_type_dst_1:
+        os << "dst_1";
+        break;
+    case rocfft_transform_type_dst_2:
+        os << "dst_2";
+        break;
+    case rocfft_transform_type_dst_3:
+        os << "dst_3";
+        break;
+    case rocfft_transform_type_dst_4:
+        os << "dst_4";
+        break;
     }
     return os;
 }
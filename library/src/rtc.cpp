@@ -31,21 +31,52 @@ using namespace std::placeholders;
 
 #include "device/generator/stockham_gen_cc.h"
 #include "device/generator/stockham_gen_cr.h"
+#include "device/generator/stockham_gen_grouped.h"
+#include "device/generator/stockham_gen_r2r.h"
 #include "device/generator/stockham_gen_rc.h"
 #include "device/generator/stockham_gen_rr.h"
 
 #include "device/generator/stockham_gen_2d.h"
 
+#include "device/generator/transpose_gen.h"
+
 #include "device/kernel-generator-embed.h"
 #include "function_pool.h"
 #include "kernel_launch.h"
 #include "logging.h"
 #include "plan.h"
 #include "rtccache.h"
+#include "statistics.h"
 #include "tree_node.h"
 
 #include <chrono>
 
+static std::string r2r_type_name(R2RType type)
+{
+    switch(type)
+    {
+    case R2RType::DCT_I:
+        return "dct1";
+    case R2RType::DCT_II:
+        return "dct2";
+    case R2RType::DCT_III:
+        return "dct3";
+    case R2RType::DCT_IV:
+        return "dct4";
+    case R2RType::DST_I:
+        return "dst1";
+    case R2RType::DST_II:
+        return "dst2";
+    case R2RType::DST_III:
+        return "dst3";
+    case R2RType::DST_IV:
+        return "dst4";
+    case R2RType::NONE:
+        break;
+    }
+    throw std::runtime_error("real-to-real kernel needs a transform type");
+}
+
 // generate name for RTC stockham kernel
 //
 // NOTE: this is the key for finding kernels in the cache, so distinct
@@ -171,7 +202,18 @@ std::string stockham_rtc_kernel_name(const TreeNode&     node,
     case EmbeddedType::Real2C_POST:
         kernel_name += "_R2C";
         break;
+    case EmbeddedType::Real2C_ODD:
+        kernel_name += "_R2C_odd";
+        break;
+    case EmbeddedType::C2Real_ODD:
+        kernel_name += "_C2R_odd";
+        break;
+    case EmbeddedType::Real2Real:
+        kernel_name += "_R2R_" + r2r_type_name(node.r2rType) + "_n" + std::to_string(node.r2rLength);
+        break;
     }
+    if(node.grouped)
+        kernel_name += "_grouped";
     if(enable_callbacks)
         kernel_name += "_CB";
     return kernel_name;
@@ -199,7 +241,11 @@ std::string stockham_rtc(StockhamGeneratorSpecs& specs,
     else
     {
         std::unique_ptr<StockhamKernel> kernel;
-        if(node.scheme == CS_KERNEL_STOCKHAM)
+        if(node.scheme == CS_KERNEL_STOCKHAM && node.grouped)
+            kernel = std::make_unique<StockhamKernelGrouped>(specs);
+        else if(node.scheme == CS_KERNEL_STOCKHAM && node.ebtype == EmbeddedType::Real2Real)
+            kernel = std::make_unique<StockhamKernelR2R>(specs, node.r2rType, node.r2rLength);
+        else if(node.scheme == CS_KERNEL_STOCKHAM)
             kernel = std::make_unique<StockhamKernelRR>(specs);
         else if(node.scheme == CS_KERNEL_STOCKHAM_BLOCK_CC)
             kernel = std::make_unique<StockhamKernelCC>(specs);
@@ -240,11 +286,19 @@ std::string stockham_rtc(StockhamGeneratorSpecs& specs,
             *global = make_planar(*global, "buf_in");
         if(array_type_is_planar(node.outArrayType))
             *global = make_planar(*global, "buf_out");
+        // odd-length real and real-to-real kernels read or write
+        // real data directly
+        if(node.ebtype == EmbeddedType::Real2C_ODD || node.ebtype == EmbeddedType::Real2Real)
+            *global = make_real(*global, "buf_in");
+        if(node.ebtype == EmbeddedType::C2Real_ODD || node.ebtype == EmbeddedType::Real2Real)
+            *global = make_real(*global, "buf_out");
     }
     else
     {
         if(array_type_is_planar(node.inArrayType))
             *global = make_planar(*global, "buf");
+        if(node.ebtype == EmbeddedType::Real2Real)
+            *global = make_real(*global, "buf");
     }
 
     // start off with includes
@@ -252,6 +306,7 @@ std::string stockham_rtc(StockhamGeneratorSpecs& specs,
     // callbacks are always potentially enabled, and activated by
     // checking the enable_callbacks variable later
     src += "#define ROCFFT_CALLBACKS_ENABLED\n";
+    src += twiddle_math_h;
     src += common_h;
     src += callback_h;
     src += butterfly_constant_h;
@@ -290,6 +345,15 @@ std::string stockham_rtc(StockhamGeneratorSpecs& specs,
     case EmbeddedType::C2Real_PRE:
         src += "static const EmbeddedType ebtype = EmbeddedType::C2Real_PRE;\n";
         break;
+    case EmbeddedType::Real2C_ODD:
+        src += "static const EmbeddedType ebtype = EmbeddedType::Real2C_ODD;\n";
+        break;
+    case EmbeddedType::C2Real_ODD:
+        src += "static const EmbeddedType ebtype = EmbeddedType::C2Real_ODD;\n";
+        break;
+    case EmbeddedType::Real2Real:
+        src += "static const EmbeddedType ebtype = EmbeddedType::Real2Real;\n";
+        break;
     }
 
     // SBRC-specific template parameters that are ignored for other kernels
@@ -342,6 +406,95 @@ std::string stockham_rtc(StockhamGeneratorSpecs& specs,
     return src;
 }
 
+// generate name for RTC transpose kernel
+//
+// NOTE: this is the key for finding kernels in the cache, so distinct
+// kernels *MUST* have unique names.
+std::string transpose_rtc_kernel_name(const TreeNode&                node,
+                                      const TransposeGeneratorSpecs& specs,
+                                      bool                           enable_callbacks)
+{
+    std::string kernel_name = "transpose_rtc";
+
+    kernel_name += "_tile" + std::to_string(specs.tile_x) + "x" + std::to_string(specs.tile_y);
+    if(node.precision == rocfft_precision_single)
+        kernel_name += "_sp";
+    else
+        kernel_name += "_dp";
+    if(array_type_is_planar(node.inArrayType))
+        kernel_name += "_inplanar";
+    if(array_type_is_planar(node.outArrayType))
+        kernel_name += "_outplanar";
+    if(specs.large_twiddle_steps)
+    {
+        kernel_name += "_twl" + std::to_string(specs.large_twiddle_steps);
+        if(node.direction == -1)
+            kernel_name += "_fwd";
+    }
+    kernel_name += "_batch" + std::to_string(specs.batch_stride_index);
+    if(specs.tile_aligned)
+        kernel_name += "_aligned";
+    if(specs.unit_stride)
+        kernel_name += "_unitstride";
+    if(specs.diagonal)
+        kernel_name += "_diag";
+    if(enable_callbacks)
+        kernel_name += "_CB";
+    return kernel_name;
+}
+
+std::string transpose_rtc(const TransposeGeneratorSpecs& specs,
+                          const std::string&             kernel_name,
+                          TreeNode&                      node,
+                          bool                           enable_callbacks)
+{
+    TransposeKernel kernel(specs);
+    auto            global = kernel.generate_global_function();
+
+    // generated function defaults to forward interleaved.  adjust
+    // for direction and format - transposes are always out-of-place.
+    if(node.direction == 1)
+        global = make_inverse(global);
+    if(array_type_is_planar(node.inArrayType))
+        global = make_planar(global, "buf_in");
+    if(array_type_is_planar(node.outArrayType))
+        global = make_planar(global, "buf_out");
+
+    std::string src = "// ROCFFT_RTC_BEGIN " + kernel_name + "\n";
+    src += "#define ROCFFT_CALLBACKS_ENABLED\n";
+    src += twiddle_math_h;
+    src += common_h;
+    src += callback_h;
+    src += butterfly_constant_h;
+    src += rocfft_butterfly_template_h;
+    src += rtc_workarounds_h;
+
+    // make_rtc removes templates from global function - add typedefs
+    // and constants to replace them
+    switch(node.precision)
+    {
+    case rocfft_precision_single:
+        src += "typedef float2 scalar_type;\n";
+        break;
+    case rocfft_precision_double:
+        src += "typedef double2 scalar_type;\n";
+        break;
+    }
+    if(enable_callbacks)
+        src += "static const CallbackType cbtype = CallbackType::USER_LOAD_STORE;\n";
+    else
+        src += "static const CallbackType cbtype = CallbackType::NONE;\n";
+
+    // transposes use a large twiddle table of 256-entry steps
+    src += "static const size_t large_twiddle_base = 8;\n";
+    src += "static const size_t large_twiddle_steps = "
+           + std::to_string(specs.large_twiddle_steps) + ";\n";
+
+    src += make_rtc(global, kernel_name).render();
+    src += "// ROCFFT_RTC_END " + kernel_name + "\n";
+    return src;
+}
+
 RTCKernel::RTCKernel(const std::string& kernel_name, const std::vector<char>& code)
 {
     if(hipModuleLoadData(&module, code.data()) != hipSuccess)
@@ -351,9 +504,9 @@ RTCKernel::RTCKernel(const std::string& kernel_name, const std::vector<char>& co
         throw std::runtime_error("failed to get function");
 }
 
-void RTCKernel::launch(DeviceCallIn& data)
+// push stockham kernel arguments in an array of 64-bit values
+static std::vector<void*> stockham_kargs(DeviceCallIn& data)
 {
-    // arguments get pushed in an array of 64-bit values
     std::vector<void*> kargs;
 
     // twiddles
@@ -390,6 +543,81 @@ void RTCKernel::launch(DeviceCallIn& data)
         if(array_type_is_planar(data.node->outArrayType))
             kargs.push_back(data.bufOut[1]);
     }
+    return kargs;
+}
+
+// push grouped stockham kernel arguments in an array of 64-bit
+// values.  The node's device kernel arguments are its problem
+// tables: one record per block for input, then for output.
+static std::vector<void*> grouped_kargs(DeviceCallIn& data)
+{
+    std::vector<void*> kargs;
+
+    kargs.push_back(data.node->twiddles);
+    kargs.push_back(data.node->devKernArg);
+    if(data.node->placement == rocfft_placement_notinplace)
+        kargs.push_back(data.node->devKernArg + data.gridParam.b_x * GROUPED_RECORD_WIDTH);
+    kargs.push_back(reinterpret_cast<void*>(data.node->lds_padding));
+    // callback params
+    kargs.push_back(data.callbacks.load_cb_fn);
+    kargs.push_back(data.callbacks.load_cb_data);
+    kargs.push_back(reinterpret_cast<void*>(data.callbacks.load_cb_lds_bytes));
+    kargs.push_back(data.callbacks.store_cb_fn);
+    kargs.push_back(data.callbacks.store_cb_data);
+
+    kargs.push_back(data.bufIn[0]);
+    if(data.node->placement == rocfft_placement_notinplace)
+        kargs.push_back(data.bufOut[0]);
+    return kargs;
+}
+
+// push transpose kernel arguments in an array of 64-bit values
+static std::vector<void*> transpose_kargs(DeviceCallIn& data)
+{
+    auto& node = static_cast<TransposeNode&>(*data.node);
+    auto  dims = node.GetMatrixDims();
+
+    std::vector<void*> kargs;
+    kargs.push_back(node.twiddles_large);
+    kargs.push_back(kargs_stride_in(node.devKernArg));
+    kargs.push_back(kargs_stride_out(node.devKernArg));
+    kargs.push_back(reinterpret_cast<void*>(dims.ld_in));
+    kargs.push_back(reinterpret_cast<void*>(dims.ld_out));
+    kargs.push_back(reinterpret_cast<void*>(dims.m));
+    kargs.push_back(reinterpret_cast<void*>(dims.n));
+    // callback params
+    kargs.push_back(data.callbacks.load_cb_fn);
+    kargs.push_back(data.callbacks.load_cb_data);
+    kargs.push_back(reinterpret_cast<void*>(data.callbacks.load_cb_lds_bytes));
+    kargs.push_back(data.callbacks.store_cb_fn);
+    kargs.push_back(data.callbacks.store_cb_data);
+
+    // buffer pointers - transposes are always out-of-place
+    kargs.push_back(data.bufIn[0]);
+    if(array_type_is_planar(node.inArrayType))
+        kargs.push_back(data.bufIn[1]);
+    kargs.push_back(data.bufOut[0]);
+    if(array_type_is_planar(node.outArrayType))
+        kargs.push_back(data.bufOut[1]);
+    return kargs;
+}
+
+void RTCKernel::launch(DeviceCallIn& data)
+{
+    // arguments get pushed in an array of 64-bit values
+    std::vector<void*> kargs;
+
+    switch(data.node->scheme)
+    {
+    case CS_KERNEL_TRANSPOSE:
+    case CS_KERNEL_TRANSPOSE_XY_Z:
+    case CS_KERNEL_TRANSPOSE_Z_XY:
+        kargs = transpose_kargs(data);
+        break;
+    default:
+        kargs = data.node->grouped ? grouped_kargs(data) : stockham_kargs(data);
+        break;
+    }
 
     auto  size     = sizeof(kargs.size() * sizeof(void*));
     void* config[] = {HIP_LAUNCH_PARAM_BUFFER_POINTER,
@@ -408,7 +636,7 @@ void RTCKernel::launch(DeviceCallIn& data)
                              gp.wgs_y,
                              gp.wgs_z,
                              gp.lds_bytes,
-                             nullptr,
+                             data.rocfft_stream,
                              nullptr,
                              config)
        != hipSuccess)
@@ -445,6 +673,18 @@ static RTCProcessType get_rtc_process_type()
     return RTCProcessType::DEFAULT;
 }
 
+// log the result of looking up a kernel in the RTC cache
+static void log_rtc_cache(const std::string& kernel_name, const char* result)
+{
+    if(!LOG_RTC_ENABLED())
+        return;
+    auto& os = *LogSingleton::GetInstance().GetRTCOS();
+    if(LOG_JSONL_ENABLED())
+        log_record("rtc_cache").field("kernel", kernel_name).field("result", result).write(os);
+    else
+        os << "// cache " << result << " for " << kernel_name << std::endl;
+}
+
 std::shared_future<std::unique_ptr<RTCKernel>>
     RTCKernel::runtime_compile(TreeNode& node, const std::string& gpu_arch, bool enable_callbacks)
 {
@@ -454,6 +694,8 @@ std::shared_future<std::unique_ptr<RTCKernel>>
     std::unique_ptr<StockhamGeneratorSpecs> specs;
     std::unique_ptr<StockhamGeneratorSpecs> specs2d;
 
+    std::unique_ptr<TransposeGeneratorSpecs> transpose_specs;
+
     SBRC_TRANSPOSE_TYPE transpose_type = NONE;
 
     // SBRC variants look in the function pool for plain BLOCK_RC to
@@ -478,8 +720,9 @@ std::shared_future<std::unique_ptr<RTCKernel>>
         // the generator as-is
         key              = fpkey(node.length[0], node.precision, pool_scheme);
         FFTKernel kernel = pool.get_kernel(key);
-        // already precompiled?
-        if(kernel.device_function)
+        // already precompiled?  odd-length real, real-to-real and
+        // grouped kernels are only ever runtime-compiled.
+        if(kernel.device_function && !ebtype_is_rtc_only(node.ebtype) && !node.grouped)
         {
             std::promise<std::unique_ptr<RTCKernel>> p;
             p.set_value(nullptr);
@@ -508,6 +751,7 @@ std::shared_future<std::unique_ptr<RTCKernel>>
         specs->threads_per_transform = kernel.threads_per_transform[0];
         specs->half_lds              = kernel.half_lds;
         specs->direct_to_reg         = kernel.direct_to_reg;
+        specs->shfl_exchange         = kernel.shfl_exchange;
         break;
     }
     case CS_KERNEL_2D_SINGLE:
@@ -560,6 +804,34 @@ std::shared_future<std::unique_ptr<RTCKernel>>
         specs2d->half_lds              = kernel.half_lds;
         break;
     }
+    case CS_KERNEL_TRANSPOSE:
+    case CS_KERNEL_TRANSPOSE_XY_Z:
+    case CS_KERNEL_TRANSPOSE_Z_XY:
+    {
+        auto& transpose = static_cast<TransposeNode&>(node);
+        auto  tile      = transpose.TileDims();
+        auto  dims      = transpose.GetMatrixDims();
+
+        // ahead-of-time compiled transposes cover every combination
+        // of parameters for the default tile.  we also need a
+        // precompiled kernel for more than 3 steps of large twiddle.
+        if(tile == transpose.DefaultTileDims() || transpose.LargeTwiddleSteps() > 3)
+        {
+            std::promise<std::unique_ptr<RTCKernel>> p;
+            p.set_value(nullptr);
+            return p.get_future();
+        }
+
+        transpose_specs                      = std::make_unique<TransposeGeneratorSpecs>();
+        transpose_specs->tile_x              = tile.first;
+        transpose_specs->tile_y              = tile.second;
+        transpose_specs->large_twiddle_steps = transpose.LargeTwiddleSteps();
+        transpose_specs->batch_stride_index  = dims.batchStrideIdx;
+        transpose_specs->tile_aligned = dims.m % tile.first == 0 && dims.n % tile.first == 0;
+        transpose_specs->unit_stride  = node.inStride[0] == 1 && node.outStride[0] == 1;
+        transpose_specs->diagonal     = transpose.UseDiagonal();
+        break;
+    }
     default:
     {
         std::promise<std::unique_ptr<RTCKernel>> p;
@@ -568,7 +840,11 @@ std::shared_future<std::unique_ptr<RTCKernel>>
     }
     }
 
-    std::string kernel_name = stockham_rtc_kernel_name(node, transpose_type, enable_callbacks);
+    std::string kernel_name;
+    if(transpose_specs)
+        kernel_name = transpose_rtc_kernel_name(node, *transpose_specs, enable_callbacks);
+    else
+        kernel_name = stockham_rtc_kernel_name(node, transpose_type, enable_callbacks);
 
     // check the cache
     std::vector<char> code;
@@ -584,6 +860,9 @@ std::shared_future<std::unique_ptr<RTCKernel>>
     std::vector<char> generator_sum_vec(generator_sum, generator_sum + generator_sum_bytes);
     if(RTCCache::single)
     {
+        phase_timer lookup_timer("rtc_lookup");
+        if(lookup_timer.active())
+            lookup_timer.set_detail(std::string(kernel_name));
         code = RTCCache::single->get_code_object(
             kernel_name, gpu_arch, hip_version, generator_sum_vec);
     }
@@ -593,13 +872,13 @@ std::shared_future<std::unique_ptr<RTCKernel>>
         // cache hit
         try
         {
-            if(LOG_RTC_ENABLED())
-            {
-                (*LogSingleton::GetInstance().GetRTCOS())
-                    << "// cache hit for " << kernel_name << std::endl;
-            }
+            log_rtc_cache(kernel_name, "hit");
+            phase_timer load_timer("rtc_load");
+            if(load_timer.active())
+                load_timer.set_detail(std::string(kernel_name));
             std::promise<std::unique_ptr<RTCKernel>> p;
             p.set_value(std::unique_ptr<RTCKernel>(new RTCKernel(kernel_name, code)));
+            rocfft_stats::get().rtc_cache_hits.add();
             return p.get_future();
         }
         catch(std::exception&)
@@ -607,44 +886,74 @@ std::shared_future<std::unique_ptr<RTCKernel>>
             // if for some reason the cached object was not
             // usable, fall through to generating the source and
             // recompiling
-            if(LOG_RTC_ENABLED())
-            {
-                (*LogSingleton::GetInstance().GetRTCOS())
-                    << "// cache unusable for " << kernel_name << std::endl;
-            }
+            log_rtc_cache(kernel_name, "unusable");
         }
     }
+    else if(LOG_RTC_ENABLED() && LOG_JSONL_ENABLED())
+    {
+        // text logs only note misses by the source that follows
+        log_record("rtc_cache")
+            .field("kernel", kernel_name)
+            .field("result", "miss")
+            .write(*LogSingleton::GetInstance().GetRTCOS());
+    }
 
     // otherwise, we did not find a cached code object, and need to
     // compile the source
+    rocfft_stats::get().rtc_cache_misses.add();
+
+    // the compile runs on another thread, so tell it explicitly
+    // where to record phase timings.  The plan waits for all of its
+    // compiles, so the timing outlives this thread.
+    plan_timing* timing = plan_timing::current();
 
     // compile to code object
     return std::async(
-        std::launch::async, [=, &node, specs = move(specs), specs2d = move(specs2d)]() {
-            auto generate_begin = std::chrono::steady_clock::now();
-            auto kernel_src     = stockham_rtc(*specs,
-                                           specs2d ? *specs2d : *specs,
-                                           kernel_name,
-                                           node,
-                                           transpose_type,
-                                           enable_callbacks);
-            auto generate_end   = std::chrono::steady_clock::now();
+        std::launch::async,
+        [=,
+         &node,
+         specs           = move(specs),
+         specs2d         = move(specs2d),
+         transpose_specs = move(transpose_specs)]() {
+            auto        generate_begin = std::chrono::steady_clock::now();
+            std::string kernel_src;
+            if(transpose_specs)
+                kernel_src = transpose_rtc(*transpose_specs, kernel_name, node, enable_callbacks);
+            else
+                kernel_src = stockham_rtc(*specs,
+                                          specs2d ? *specs2d : *specs,
+                                          kernel_name,
+                                          node,
+                                          transpose_type,
+                                          enable_callbacks);
+            auto generate_end = std::chrono::steady_clock::now();
+
+            if(timing)
+                timing->add("rtc_generate", std::string(kernel_name), generate_begin, generate_end);
 
             if(LOG_RTC_ENABLED())
             {
                 std::chrono::duration<float, std::milli> generate_ms
                     = generate_end - generate_begin;
 
-                (*LogSingleton::GetInstance().GetRTCOS())
-                    << kernel_src << "// " << kernel_name
-                    << " generate duration: " << static_cast<int>(generate_ms.count()) << " ms"
-                    << std::endl;
+                auto& os = *LogSingleton::GetInstance().GetRTCOS();
+                if(LOG_JSONL_ENABLED())
+                    log_record("rtc_generate")
+                        .field("kernel", kernel_name)
+                        .field("duration_ms", generate_ms.count())
+                        .field("source", kernel_src)
+                        .write(os);
+                else
+                    os << kernel_src << "// " << kernel_name << " generate duration: "
+                       << static_cast<int>(generate_ms.count()) << " ms" << std::endl;
             }
 
             std::vector<char> code;
             // try to set compile_begin time right when we're really
             // about to compile (i.e. after acquiring any locks)
             std::chrono::time_point<std::chrono::steady_clock> compile_begin;
+            // whether the compile ran in the helper process
+            bool compiled_in_subprocess = false;
 
             RTCProcessType process_type = get_rtc_process_type();
             switch(process_type)
@@ -654,7 +963,8 @@ std::shared_future<std::unique_ptr<RTCKernel>>
                 compile_begin = std::chrono::steady_clock::now();
                 try
                 {
-                    code = compile_subprocess(kernel_src);
+                    code                   = compile_subprocess(kernel_src);
+                    compiled_in_subprocess = true;
                     break;
                 }
                 catch(std::exception&)
@@ -685,8 +995,9 @@ std::shared_future<std::unique_ptr<RTCKernel>>
                     // couldn't acquire lock, so try instead in a subprocess
                     try
                     {
-                        compile_begin = std::chrono::steady_clock::now();
-                        code          = compile_subprocess(kernel_src);
+                        compile_begin          = std::chrono::steady_clock::now();
+                        code                   = compile_subprocess(kernel_src);
+                        compiled_in_subprocess = true;
                     }
                     catch(std::exception&)
                     {
@@ -702,14 +1013,29 @@ std::shared_future<std::unique_ptr<RTCKernel>>
             }
             auto compile_end = std::chrono::steady_clock::now();
 
+            rocfft_stats::get().rtc_compiles.add();
+            rocfft_stats::get().rtc_compile.add(compile_end - compile_begin);
+
+            if(timing)
+                timing->add("rtc_compile",
+                            kernel_name + (compiled_in_subprocess ? "; subprocess" : ""),
+                            compile_begin,
+                            compile_end);
+
             if(LOG_RTC_ENABLED())
             {
                 std::chrono::duration<float, std::milli> compile_ms = compile_end - compile_begin;
 
-                (*LogSingleton::GetInstance().GetRTCOS())
-                    << "// " << kernel_name
-                    << " compile duration: " << static_cast<int>(compile_ms.count()) << " ms\n"
-                    << std::endl;
+                auto& os = *LogSingleton::GetInstance().GetRTCOS();
+                if(LOG_JSONL_ENABLED())
+                    log_record("rtc_compile")
+                        .field("kernel", kernel_name)
+                        .field("duration_ms", compile_ms.count())
+                        .write(os);
+                else
+                    os << "// " << kernel_name << " compile duration: "
+                       << static_cast<int>(compile_ms.count()) << " ms\n"
+                       << std::endl;
             }
 
             if(RTCCache::single)
@@ -717,6 +1043,9 @@ std::shared_future<std::unique_ptr<RTCKernel>>
                 RTCCache::single->store_code_object(
                     kernel_name, gpu_arch, hip_version, generator_sum_vec, code);
             }
+            phase_timer load_timer("rtc_load", timing);
+            if(load_timer.active())
+                load_timer.set_detail(std::string(kernel_name));
             return std::unique_ptr<RTCKernel>(new RTCKernel(kernel_name, code));
         });
 #else
@@ -220,8 +220,16 @@ void RTCCache::store_code_object(const std::string&       kernel_name,
         std::cerr << "Error: failed to store code object for " << kernel_name << std::endl;
         // some kind of problem storing the row?  log it
         if(LOG_RTC_ENABLED())
-            (*LogSingleton::GetInstance().GetRTCOS())
-                << "Error: failed to store code object for " << kernel_name << std::flush;
+        {
+            auto& os = *LogSingleton::GetInstance().GetRTCOS();
+            if(LOG_JSONL_ENABLED())
+                log_record("rtc_cache")
+                    .field("kernel", kernel_name)
+                    .field("result", "store_failed")
+                    .write(os);
+            else
+                os << "Error: failed to store code object for " << kernel_name << std::flush;
+        }
     }
     sqlite3_reset(s);
 }
@@ -0,0 +1,156 @@
+/******************************************************************************
+* Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#include "statistics.h"
+#include "logging.h"
+#include "repo.h"
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+void rocfft_stats::reset()
+{
+    plans_created.reset();
+    plan_create_failures.reset();
+    plans_destroyed.reset();
+    plan_create.reset();
+
+    rtc_cache_hits.reset();
+    rtc_cache_misses.reset();
+    rtc_compiles.reset();
+    rtc_compile.reset();
+
+    work_buffer_allocs.reset();
+    work_buffer_bytes.reset();
+
+    exec.reset();
+}
+
+// fill in every field of the current struct
+static rocfft_status get_statistics(rocfft_statistics* stats)
+{
+    auto& s = rocfft_stats::get();
+
+    stats->plans_created        = s.plans_created.get();
+    stats->plan_create_failures = s.plan_create_failures.get();
+    stats->plans_destroyed      = s.plans_destroyed.get();
+    stats->plan_create_ms       = s.plan_create.total_ms();
+    s.plan_create.get(stats->plan_create_histogram);
+
+    stats->rtc_cache_hits   = s.rtc_cache_hits.get();
+    stats->rtc_cache_misses = s.rtc_cache_misses.get();
+    stats->rtc_compiles     = s.rtc_compiles.get();
+    stats->rtc_compile_ms   = s.rtc_compile.total_ms();
+    s.rtc_compile.get(stats->rtc_compile_histogram);
+
+    // read without the repo's lock, so polling doesn't wait on
+    // plans creating twiddle tables
+    Repo::GetResident(stats->twiddle_tables, stats->twiddle_bytes);
+
+    stats->work_buffer_allocs = s.work_buffer_allocs.get();
+    stats->work_buffer_bytes  = s.work_buffer_bytes.get();
+
+    stats->executions      = s.exec.get(stat_sharded_counters::EXECUTIONS);
+    stats->kernel_launches = s.exec.get(stat_sharded_counters::KERNEL_LAUNCHES);
+
+    stats->log_records_dropped = rocfft_ostream::dropped_records();
+    return rocfft_status_success;
+}
+
+rocfft_status rocfft_get_statistics(rocfft_statistics* stats)
+{
+    log_trace(__func__, "stats", stats);
+    if(!stats)
+        return rocfft_status_invalid_arg_value;
+
+    // a struct from an older header is a prefix of this one
+    const size_t struct_size = stats->struct_size;
+    if(struct_size <= offsetof(rocfft_statistics, plans_created)
+       || struct_size > sizeof(rocfft_statistics))
+        return rocfft_status_invalid_arg_value;
+
+    rocfft_statistics all    = {};
+    auto              status = get_statistics(&all);
+    if(status != rocfft_status_success)
+        return status;
+    memcpy(stats, &all, struct_size);
+    stats->struct_size = struct_size;
+    return rocfft_status_success;
+}
+
+rocfft_status rocfft_get_scheme_statistics(size_t*      num_schemes,
+                                           const char** schemes,
+                                           size_t*      executions,
+                                           size_t*      kernel_launches)
+{
+    log_trace(__func__,
+              "num_schemes",
+              num_schemes,
+              "schemes",
+              schemes,
+              "executions",
+              executions,
+              "kernel_launches",
+              kernel_launches);
+    if(!num_schemes)
+        return rocfft_status_invalid_arg_value;
+
+    // names need to outlive the call, so build them once
+    static const std::vector<std::string> names = []() {
+        std::vector<std::string> names;
+        for(size_t i = 0; i < stat_sharded_counters::NUM_SCHEMES; ++i)
+            names.push_back(PrintScheme(static_cast<ComputeScheme>(i)));
+        return names;
+    }();
+
+    if(!schemes && !executions && !kernel_launches)
+    {
+        *num_schemes = names.size();
+        return rocfft_status_success;
+    }
+    if(*num_schemes < names.size())
+        return rocfft_status_invalid_arg_value;
+    *num_schemes = names.size();
+
+    auto& exec = rocfft_stats::get().exec;
+    for(size_t i = 0; i < names.size(); ++i)
+    {
+        auto scheme = static_cast<ComputeScheme>(i);
+        if(schemes)
+            schemes[i] = names[i].c_str();
+        if(executions)
+            executions[i] = exec.get(stat_sharded_counters::scheme_executions(scheme));
+        if(kernel_launches)
+            kernel_launches[i] = exec.get(stat_sharded_counters::scheme_launches(scheme));
+    }
+    return rocfft_status_success;
+}
+
+rocfft_status rocfft_reset_statistics()
+{
+    log_trace(__func__);
+    rocfft_stats::get().reset();
+    rocfft_ostream::reset_dropped_records();
+    return rocfft_status_success;
+}
@@ -23,14 +23,73 @@
 #include <cassert>
 #include <cstdlib>
 #include <iostream>
+#include <mutex>
 #include <vector>
 
 #include "../../shared/array_predicate.h"
 #include "logging.h"
 #include "plan.h"
 #include "rocfft.h"
+#include "statistics.h"
 #include "transform.h"
 
+// Events not owned by any execution info.  They're created without
+// timing, which makes recording them cheaper.
+static std::mutex              event_pool_mutex;
+static std::vector<hipEvent_t> event_pool;
+// false once rocfft_cleanup has released the pool, until events are
+// needed again.  Events given back while it's closed would never be
+// destroyed, so they're destroyed right away instead.
+static bool event_pool_open = true;
+
+static hipEvent_t acquire_event()
+{
+    {
+        std::lock_guard<std::mutex> lock(event_pool_mutex);
+        event_pool_open = true;
+        if(!event_pool.empty())
+        {
+            auto event = event_pool.back();
+            event_pool.pop_back();
+            return event;
+        }
+    }
+    hipEvent_t event;
+    if(hipEventCreateWithFlags(&event, hipEventDisableTiming) != hipSuccess)
+        throw std::runtime_error("hipEventCreateWithFlags failure");
+    return event;
+}
+
+execution_events::~execution_events()
+{
+    std::lock_guard<std::mutex> lock(event_pool_mutex);
+    if(event_pool_open)
+        event_pool.insert(event_pool.end(), events.begin(), events.end());
+    else
+    {
+        for(auto event : events)
+            (void)hipEventDestroy(event);
+    }
+}
+
+void execution_events::record(hipStream_t stream)
+{
+    if(count == events.size())
+        events.push_back(acquire_event());
+    if(hipEventRecord(events[count], stream) != hipSuccess)
+        throw std::runtime_error("hipEventRecord failure");
+    ++count;
+}
+
+void ReleaseExecutionEvents()
+{
+    std::lock_guard<std::mutex> lock(event_pool_mutex);
+    for(auto event : event_pool)
+        (void)hipEventDestroy(event);
+    event_pool.clear();
+    event_pool_open = false;
+}
+
 rocfft_status rocfft_execution_info_create(rocfft_execution_info* info)
 {
     rocfft_execution_info einfo = new rocfft_execution_info_t;
@@ -69,6 +128,64 @@ rocfft_status rocfft_execution_info_set_stream(rocfft_execution_info info, void*
     return rocfft_status_success;
 }
 
+rocfft_status rocfft_execution_info_set_graph_replay(rocfft_execution_info info, int enable)
+{
+    log_trace(__func__, "info", info, "enable", enable);
+    if(!info)
+        return rocfft_status_invalid_arg_value;
+    info->graphReplay = enable != 0;
+    return rocfft_status_success;
+}
+
+rocfft_status rocfft_execution_info_set_event_mode(rocfft_execution_info info,
+                                                   rocfft_event_mode     mode)
+{
+    log_trace(__func__, "info", info, "mode", mode);
+    if(!info)
+        return rocfft_status_invalid_arg_value;
+    switch(mode)
+    {
+    case rocfft_event_mode_none:
+    case rocfft_event_mode_completion:
+    case rocfft_event_mode_per_kernel:
+        break;
+    default:
+        return rocfft_status_invalid_arg_value;
+    }
+
+    if(!info->events)
+    {
+        if(mode == rocfft_event_mode_none)
+            return rocfft_status_success;
+        info->events = std::make_shared<execution_events>();
+    }
+    info->events->mode = mode;
+    return rocfft_status_success;
+}
+
+rocfft_status rocfft_execution_info_get_events(const rocfft_execution_info info,
+                                               void**                      events,
+                                               size_t*                     number_of_events)
+{
+    log_trace(__func__, "info", info, "events", events, "number_of_events", number_of_events);
+    if(!info || !number_of_events)
+        return rocfft_status_invalid_arg_value;
+
+    size_t count = info->events ? info->events->count : 0;
+    if(!events)
+    {
+        *number_of_events = count;
+        return rocfft_status_success;
+    }
+    if(*number_of_events < count)
+        return rocfft_status_invalid_arg_value;
+
+    *number_of_events = count;
+    for(size_t i = 0; i < count; ++i)
+        events[i] = info->events->events[i];
+    return rocfft_status_success;
+}
+
 rocfft_status rocfft_execution_info_set_load_callback(rocfft_execution_info info,
                                                       void**                cb_functions,
                                                       void**                cb_data,
@@ -113,14 +230,72 @@ rocfft_status rocfft_execute(const rocfft_plan     plan,
         return rocfft_status_failure;
     const ExecPlan& execPlan = plan->execPlan;
 
-    if(LOG_PLAN_ENABLED())
-        PrintNode(*LogSingleton::GetInstance().GetPlanOS(), execPlan);
-
     // tolerate user not providing an execution_info
     rocfft_execution_info_t exec_info;
     if(info)
         exec_info = *info;
 
+    // multi-device plans bring their own work buffers, and are
+    // finished by the time execute returns.  Their sub-plans can't
+    // take callbacks or the caller's work buffer, which is only on
+    // one device.
+    if(plan->multiDevice)
+    {
+        if(exec_info.callbacks.load_cb_fn || exec_info.callbacks.store_cb_fn)
+            return rocfft_status_invalid_arg_value;
+        if(exec_info.workBuffer)
+            return rocfft_status_invalid_work_buffer;
+        try
+        {
+            plan->multiDevice->execute(
+                in_buffer,
+                (plan->placement == rocfft_placement_inplace) ? in_buffer : out_buffer,
+                exec_info.rocfft_stream);
+            if(exec_info.events)
+            {
+                exec_info.events->count = 0;
+                if(exec_info.events->mode != rocfft_event_mode_none)
+                    exec_info.events->record(exec_info.rocfft_stream);
+            }
+        }
+        catch(std::exception& e)
+        {
+            log_trace_error(__func__, e.what());
+            return rocfft_status_failure;
+        }
+        return rocfft_status_success;
+    }
+
+    // grouped plans need no work buffer, and run asynchronously on
+    // the user's stream.  Their kernels don't take callbacks.
+    if(plan->grouped)
+    {
+        if(exec_info.callbacks.load_cb_fn || exec_info.callbacks.store_cb_fn)
+            return rocfft_status_invalid_arg_value;
+        try
+        {
+            plan->grouped->execute(
+                in_buffer,
+                (plan->placement == rocfft_placement_inplace) ? in_buffer : out_buffer,
+                exec_info.rocfft_stream);
+            if(exec_info.events)
+            {
+                exec_info.events->count = 0;
+                if(exec_info.events->mode != rocfft_event_mode_none)
+                    exec_info.events->record(exec_info.rocfft_stream);
+            }
+        }
+        catch(std::exception& e)
+        {
+            log_trace_error(__func__, e.what());
+            return rocfft_status_failure;
+        }
+        return rocfft_status_success;
+    }
+
+    if(LOG_PLAN_ENABLED())
+        LogPlan(execPlan);
+
     gpubuf autoAllocWorkBuf;
 
     if(execPlan.workBufSize > 0)
@@ -131,6 +306,8 @@ rocfft_status rocfft_execute(const rocfft_plan     plan,
             // user didn't provide a buffer, alloc one now
             if(autoAllocWorkBuf.alloc(requiredWorkBufBytes) != hipSuccess)
                 return rocfft_status_failure;
+            rocfft_stats::get().work_buffer_allocs.add();
+            rocfft_stats::get().work_buffer_bytes.add(requiredWorkBufBytes);
             exec_info.workBufferSize = requiredWorkBufBytes;
             exec_info.workBuffer     = autoAllocWorkBuf.data();
         }
@@ -139,12 +316,6 @@ rocfft_status rocfft_execute(const rocfft_plan     plan,
             return rocfft_status_invalid_work_buffer;
     }
 
-    // Callbacks do not currently support planar format
-    if((array_type_is_planar(execPlan.rootPlan->inArrayType)
-        || array_type_is_planar(execPlan.rootPlan->outArrayType))
-       && (exec_info.callbacks.load_cb_fn || exec_info.callbacks.store_cb_fn))
-        return rocfft_status_failure;
-
     try
     {
         TransformPowX(execPlan,
@@ -154,10 +325,7 @@ rocfft_status rocfft_execute(const rocfft_plan     plan,
     }
     catch(std::exception& e)
     {
-        if(LOG_TRACE_ENABLED())
-        {
-            (*LogSingleton::GetInstance().GetTraceOS()) << e.what() << std::endl;
-        }
+        log_trace_error(__func__, e.what());
         return rocfft_status_failure;
     }
 
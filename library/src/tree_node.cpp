@@ -19,6 +19,7 @@
 // THE SOFTWARE.
 
 #include "tree_node.h"
+#include "arithmetic.h"
 #include "function_pool.h"
 #include "kernel_launch.h"
 #include "repo.h"
@@ -130,10 +131,10 @@ void LeafNode::SanityCheck()
     TreeNode::SanityCheck();
 }
 
-bool LeafNode::CreateDevKernelArgs()
+void LeafNode::CreateDevKernelArgs(kargs_arena& arena)
 {
-    devKernArg = kargs_create(length, inStride, outStride, iDist, oDist);
-    return (devKernArg != nullptr);
+    devKernArgOffset = arena.reserve(KERN_ARGS_BLOCK_SIZE);
+    kargs_fill(arena.host_block(devKernArgOffset), length, inStride, outStride, iDist, oDist);
 }
 
 bool LeafNode::CreateTwiddleTableResource()
@@ -179,6 +180,11 @@ void LeafNode::SetupGridParamAndFuncPtr(DevFnCall& fnPtr, GridParam& gp)
 
             if(kernel.half_lds && (!double_half_lds_alloc))
                 gp.lds_bytes /= 2;
+
+            // exchanges between passes are done with cross-lane
+            // shuffles, so the kernel doesn't touch LDS at all
+            if(kernel.shfl_exchange)
+                gp.lds_bytes = 0;
         }
     }
     return;
@@ -191,13 +197,110 @@ void LeafNode::SetupGridParamAndFuncPtr(DevFnCall& fnPtr, GridParam& gp)
  *****************************************************/
 void TransposeNode::SetupGPAndFnPtr_internal(DevFnCall& fnPtr, GridParam& gp)
 {
-    fnPtr    = &FN_PRFX(transpose_var2);
-    gp.wgs_x = (precision == rocfft_precision_single) ? 32 : 64;
-    gp.wgs_y = (precision == rocfft_precision_single) ? 32 : 16;
+    fnPtr = &FN_PRFX(transpose_var2);
+
+    // the ahead-of-time launcher sets up its own grid, so these are
+    // only used to launch runtime-compiled transposes
+    std::tie(gp.wgs_x, gp.wgs_y) = TileDims();
+
+    auto dims = GetMatrixDims();
+    gp.b_x    = DivRoundingUp<size_t>(dims.n, gp.wgs_x);
+    gp.b_y    = DivRoundingUp<size_t>(dims.m, gp.wgs_x);
+    gp.b_z    = dims.count;
 
     return;
 }
 
+TransposeNode::MatrixDims TransposeNode::GetMatrixDims() const
+{
+    MatrixDims dims;
+    dims.m              = length[1];
+    dims.n              = length[0];
+    dims.batchStrideIdx = 2;
+    if(scheme == CS_KERNEL_TRANSPOSE_XY_Z)
+    {
+        dims.m              = length[2];
+        dims.n              = length[0] * length[1];
+        dims.batchStrideIdx = 3;
+    }
+    else if(scheme == CS_KERNEL_TRANSPOSE_Z_XY)
+    {
+        dims.m              = length[1] * length[2];
+        dims.n              = length[0];
+        dims.batchStrideIdx = 3;
+    }
+
+    // if we only have 2 stride values then this must be a 2D
+    // transform, but let's make sure we're not reading past the end
+    // of the stride vectors.
+    dims.ld_in  = scheme == CS_KERNEL_TRANSPOSE_XY_Z ? inStride[2] : inStride[1];
+    dims.ld_out = (scheme != CS_KERNEL_TRANSPOSE_Z_XY || outStride.size() < 3) ? outStride[1]
+                                                                                : outStride[2];
+
+    dims.count = batch;
+    for(size_t i = dims.batchStrideIdx; i < length.size(); ++i)
+        dims.count *= length[i];
+    return dims;
+}
+
+size_t TransposeNode::LargeTwiddleSteps() const
+{
+    if(large1D > (size_t)256 * 256 * 256 * 256)
+        throw std::runtime_error("large1D twiddle size too large");
+    if(large1D > (size_t)256 * 256 * 256)
+        return 4;
+    if(large1D > (size_t)256 * 256)
+        return 3;
+    if(large1D > (size_t)256)
+        return 2;
+    if(large1D > 0)
+        return 1;
+    return 0;
+}
+
+bool TransposeNode::UseDiagonal() const
+{
+    // diagonal transpose is not friendly to XY_Z pow-of-2 cases on
+    // these archs
+    if((is_device_gcn_arch(deviceProp, "gfx908") || is_device_gcn_arch(deviceProp, "gfx90a"))
+       && scheme == CS_KERNEL_TRANSPOSE_XY_Z)
+        return false;
+    return (GetMatrixDims().m % 256) == 0 && (outStride[1] % 256 == 0);
+}
+
+std::pair<unsigned int, unsigned int> TransposeNode::TileDims() const
+{
+    // Each thread block works on a tile_x * tile_x tile with at most
+    // 1024 threads, and the tile (plus a column of padding) must fit
+    // in 64 KiB of LDS.
+    static const unsigned int MAX_THREADS    = 1024;
+    static const size_t       LDS_BYTE_LIMIT = 64 * 1024;
+    static const unsigned int MIN_TILE       = 16;
+
+    const size_t elem_bytes = sizeof_precision(precision);
+    const auto   dims       = GetMatrixDims();
+    unsigned int tile_x     = 64;
+    while(tile_x > MIN_TILE && tile_x * (tile_x + 1) * elem_bytes > LDS_BYTE_LIMIT)
+        tile_x /= 2;
+
+    // Prefer the largest tile that evenly divides the matrix, so
+    // that the kernel needs no bounds checks.
+    unsigned int aligned_x = tile_x;
+    while(aligned_x >= MIN_TILE && (dims.m % aligned_x || dims.n % aligned_x))
+        aligned_x /= 2;
+
+    if(aligned_x >= MIN_TILE)
+        tile_x = aligned_x;
+    else
+    {
+        // Otherwise, don't launch mostly-empty tiles for skinny
+        // matrices.
+        while(tile_x > MIN_TILE && tile_x >= 2 * std::min(dims.m, dims.n))
+            tile_x /= 2;
+    }
+    return {tile_x, std::min(tile_x, MAX_THREADS / tile_x)};
+}
+
 void TreeNode::SetTransposeOutputLength()
 {
     switch(scheme)
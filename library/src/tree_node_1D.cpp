@@ -831,7 +831,9 @@ void Stockham1DNode::SetupGPAndFnPtr_internal(DevFnCall& fnPtr, GridParam& gp)
         batch_accum *= length[j];
 
     auto kernel = function_pool::get_kernel(fpkey(length[0], precision));
-    fnPtr       = kernel.device_function;
+    // odd-length real and real-to-real kernels are runtime-compiled
+    // only
+    fnPtr = ebtype_is_rtc_only(ebtype) ? nullptr : kernel.device_function;
 
     if(ebtype != EmbeddedType::NONE)
         lds_padding = 1;
@@ -852,7 +854,10 @@ void Stockham1DNode::SetupGPAndFnPtr_internal(DevFnCall& fnPtr, GridParam& gp)
 
 bool Stockham1DNode::CreateTwiddleTableResource()
 {
-    twd_attach_halfN = (ebtype != EmbeddedType::NONE);
+    // odd-length real and real-to-real kernels do a full-length
+    // transform, so they don't need the half-length post/pre-processing
+    // twiddles
+    twd_attach_halfN = (ebtype != EmbeddedType::NONE && !ebtype_is_rtc_only(ebtype));
     return LeafNode::CreateTwiddleTableResource();
 }
 
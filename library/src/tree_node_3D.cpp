@@ -799,7 +799,7 @@ void RealCmplxTransZ_XYNode::SetupGPAndFnPtr_internal(DevFnCall& fnPtr, GridPara
     gp.wgs_x      = kernel.workgroup_size;
 }
 
-bool RealCmplxTransZ_XYNode::CreateDevKernelArgs()
+void RealCmplxTransZ_XYNode::CreateDevKernelArgs(kargs_arena& arena)
 {
     // We have a case where this 3D kernel is shoehorned into a 2D plan.
     // If so, add a third dimension when creating kernel args.
@@ -809,5 +809,5 @@ bool RealCmplxTransZ_XYNode::CreateDevKernelArgs()
         inStride.push_back(inStride.back());
         outStride.push_back(outStride.back());
     }
-    return SBRCTranspose3DNode::CreateDevKernelArgs();
+    SBRCTranspose3DNode::CreateDevKernelArgs(arena);
 }
@@ -232,6 +232,5 @@ void BluesteinComponentNode::SetupGPAndFnPtr_internal(DevFnCall& fnPtr, GridPara
 {
     gp.wgs_x = 64;
     fnPtr    = (scheme == CS_KERNEL_CHIRP) ? &FN_PRFX(chirp) : &FN_PRFX(mul);
-
     return;
 }
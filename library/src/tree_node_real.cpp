@@ -156,15 +156,20 @@ void RealTransCmplxNode::BuildTree_internal()
     childNodes.emplace_back(std::move(copyTailPlan));
 }
 
-void RealTransCmplxNode::AssignParams_internal()
+// assign params for a plan that copies the user's data into a
+// contiguous complex temp buffer, does a complex FFT there, and then
+// copies the result out again
+static void AssignParams_cmplx_temp(TreeNode& node)
 {
-    assert(childNodes.size() == 3);
-    auto& copyHeadPlan = childNodes[0];
-    auto& fftPlan      = childNodes[1];
-    auto& copyTailPlan = childNodes[2];
+    assert(node.childNodes.size() == 3);
+    auto& copyHeadPlan = node.childNodes[0];
+    auto& fftPlan      = node.childNodes[1];
+    auto& copyTailPlan = node.childNodes[2];
 
-    copyHeadPlan->inStride = inStride;
-    copyHeadPlan->iDist    = iDist;
+    const auto& length = node.length;
+
+    copyHeadPlan->inStride = node.inStride;
+    copyHeadPlan->iDist    = node.iDist;
 
     copyHeadPlan->outStride.push_back(1);
     copyHeadPlan->oDist = copyHeadPlan->outputLength.empty() ? copyHeadPlan->length[0]
@@ -185,8 +190,13 @@ void RealTransCmplxNode::AssignParams_internal()
     copyTailPlan->inStride = fftPlan->outStride;
     copyTailPlan->iDist    = fftPlan->oDist;
 
-    copyTailPlan->outStride = outStride;
-    copyTailPlan->oDist     = oDist;
+    copyTailPlan->outStride = node.outStride;
+    copyTailPlan->oDist     = node.oDist;
+}
+
+void RealTransCmplxNode::AssignParams_internal()
+{
+    AssignParams_cmplx_temp(*this);
 }
 
 #if !GENERIC_BUF_ASSIGMENT
@@ -475,9 +485,11 @@ void RealTransEvenNode::AssignParams_internal()
         assert(fftPlan->length.size() == fftPlan->inStride.size());
         assert(fftPlan->length.size() == fftPlan->outStride.size());
 
-        // we apply callbacks on the root plan's output
+        // we apply callbacks on the root plan's output.  a
+        // real-to-real plan uses this node on its own temp data, so
+        // stop below that.
         TreeNode* rootPlan = this;
-        while(rootPlan->parent != nullptr)
+        while(rootPlan->parent != nullptr && rootPlan->parent->scheme != CS_REAL_TO_REAL)
             rootPlan = rootPlan->parent;
 
         auto& applyCallback      = childNodes.back();
@@ -596,6 +608,612 @@ void RealTransEvenNode::AssignBuffers_internal(TraverseState&   state,
 }
 #endif
 
+/*****************************************************
+ * CS_REAL_TRANSFORM_ODD
+ *****************************************************/
+void RealTransOddNode::BuildTree_internal()
+{
+    // Odd lengths can't be computed as a half-length complex
+    // transform.  Instead, one kernel does the full-length complex
+    // transform in LDS, loading the real input directly (R2C) or
+    // rebuilding the full row from the Hermitian half (C2R), so
+    // neither side needs a complex temp buffer.
+    assert(length[0] % 2 == 1);
+
+    const std::vector<size_t>* realLength    = nullptr;
+    const std::vector<size_t>* complexLength = nullptr;
+    set_complex_length(*this, realLength, complexLength);
+
+    auto fftPlan       = NodeFactory::CreateNodeFromScheme(CS_KERNEL_STOCKHAM, this);
+    fftPlan->dimension = dimension;
+    fftPlan->length    = *realLength;
+
+    // real and complex sides have different layouts, so the kernel
+    // can't work in-place
+    fftPlan->allowInplace = false;
+
+    // insert a node that's prepared to apply the user's callback,
+    // since the FFT kernel accesses the real data directly
+    auto applyCallback       = NodeFactory::CreateNodeFromScheme(CS_KERNEL_APPLY_CALLBACK, this);
+    applyCallback->dimension = dimension;
+    applyCallback->length    = *realLength;
+
+    if(direction == -1)
+    {
+        fftPlan->ebtype       = EmbeddedType::Real2C_ODD;
+        fftPlan->outputLength = *complexLength;
+
+        childNodes.emplace_back(std::move(applyCallback));
+        childNodes.emplace_back(std::move(fftPlan));
+    }
+    else
+    {
+        fftPlan->ebtype = EmbeddedType::C2Real_ODD;
+
+        childNodes.emplace_back(std::move(fftPlan));
+        childNodes.emplace_back(std::move(applyCallback));
+    }
+}
+
+void RealTransOddNode::AssignParams_internal()
+{
+    assert(childNodes.size() == 2);
+
+    auto& fftPlan       = direction == -1 ? childNodes[1] : childNodes[0];
+    auto& applyCallback = direction == -1 ? childNodes[0] : childNodes[1];
+
+    // the FFT kernel reads and writes the user's data in its own
+    // units, so it takes the strides as given
+    fftPlan->inStride  = inStride;
+    fftPlan->iDist     = iDist;
+    fftPlan->outStride = outStride;
+    fftPlan->oDist     = oDist;
+
+    // callbacks are applied in-place on the real side
+    applyCallback->inStride  = direction == -1 ? inStride : outStride;
+    applyCallback->iDist     = direction == -1 ? iDist : oDist;
+    applyCallback->outStride = applyCallback->inStride;
+    applyCallback->oDist     = applyCallback->iDist;
+}
+
+#if !GENERIC_BUF_ASSIGMENT
+void RealTransOddNode::AssignBuffers_internal(TraverseState&   state,
+                                              OperatingBuffer& flipIn,
+                                              OperatingBuffer& flipOut,
+                                              OperatingBuffer& obOutBuf)
+{
+    if(direction == -1)
+    {
+        // apply callback
+        childNodes[0]->SetInputBuffer(state);
+        childNodes[0]->obOut        = obIn;
+        childNodes[0]->inArrayType  = rocfft_array_type_real;
+        childNodes[0]->outArrayType = rocfft_array_type_real;
+
+        // FFT kernel goes straight from input to output
+        childNodes[1]->SetInputBuffer(state);
+        childNodes[1]->obOut        = obOut;
+        childNodes[1]->inArrayType  = inArrayType;
+        childNodes[1]->outArrayType = outArrayType;
+    }
+    else
+    {
+        // FFT kernel goes straight from input to output
+        childNodes[0]->SetInputBuffer(state);
+        childNodes[0]->obOut        = obOut;
+        childNodes[0]->inArrayType  = inArrayType;
+        childNodes[0]->outArrayType = outArrayType;
+
+        // apply callback
+        childNodes[1]->obIn         = obOut;
+        childNodes[1]->obOut        = obOut;
+        childNodes[1]->inArrayType  = rocfft_array_type_real;
+        childNodes[1]->outArrayType = rocfft_array_type_real;
+    }
+}
+#endif
+
+/*****************************************************
+ * CS_REAL_TRANSFORM_PAIR
+ *****************************************************/
+void RealTransPairNode::BuildTree_internal()
+{
+    // Like CS_REAL_TRANSFORM_USING_CMPLX, but pack pairs of real
+    // batch elements as the real and imaginary parts of one complex
+    // batch element, so the complex transform only does half the
+    // batch.  An odd batch leaves the last pair half empty.
+    //
+    // The children work on pairs, so their batch counts pairs.
+    assert(batch >= 2);
+    bool   r2c   = inArrayType == rocfft_array_type_real;
+    size_t pairs = (batch + 1) / 2;
+
+    const std::vector<size_t>* realLength    = nullptr;
+    const std::vector<size_t>* complexLength = nullptr;
+    set_complex_length(*this, realLength, complexLength);
+
+    auto packPlan = NodeFactory::CreateNodeFromScheme(
+        (r2c ? CS_KERNEL_PAIR_R_TO_CMPLX : CS_KERNEL_PAIR_HERM_TO_CMPLX), this);
+    packPlan->dimension = dimension;
+    packPlan->length    = length;
+    packPlan->batch     = pairs;
+    if(!r2c)
+        packPlan->outputLength = *realLength;
+    childNodes.emplace_back(std::move(packPlan));
+
+    // complex fft
+    NodeMetaData fftPlanData(this);
+    fftPlanData.dimension = dimension;
+    fftPlanData.length    = *realLength;
+    fftPlanData.batch     = pairs;
+    auto fftPlan          = NodeFactory::CreateExplicitNode(fftPlanData, this);
+    fftPlan->RecursiveBuildTree();
+
+    // NB:
+    //   The unpack kernel allows only CI type, so the previous kernel should output CI type
+    fftPlan->GetLastLeaf()->allowedOutArrayTypes = {rocfft_array_type_complex_interleaved};
+    childNodes.emplace_back(std::move(fftPlan));
+
+    auto unpackPlan = NodeFactory::CreateNodeFromScheme(
+        (r2c ? CS_KERNEL_PAIR_CMPLX_TO_HERM : CS_KERNEL_PAIR_CMPLX_TO_R), this);
+    unpackPlan->dimension = dimension;
+    unpackPlan->length    = *realLength;
+    unpackPlan->batch     = pairs;
+    if(r2c)
+        unpackPlan->outputLength = *complexLength;
+    childNodes.emplace_back(std::move(unpackPlan));
+}
+
+void RealTransPairNode::AssignParams_internal()
+{
+    AssignParams_cmplx_temp(*this);
+}
+
+#if !GENERIC_BUF_ASSIGMENT
+void RealTransPairNode::AssignBuffers_internal(TraverseState&   state,
+                                               OperatingBuffer& flipIn,
+                                               OperatingBuffer& flipOut,
+                                               OperatingBuffer& obOutBuf)
+{
+    assert(isRootNode());
+    // init flipIn, Out, obOutBuf, this must be a first non-trivial node
+    flipIn   = OB_TEMP_CMPLX_FOR_REAL;
+    flipOut  = OB_TEMP;
+    obOutBuf = OB_TEMP_CMPLX_FOR_REAL;
+
+    assert(childNodes.size() == 3);
+    assert((direction == -1 && childNodes[0]->scheme == CS_KERNEL_PAIR_R_TO_CMPLX)
+           || (direction == 1 && childNodes[0]->scheme == CS_KERNEL_PAIR_HERM_TO_CMPLX));
+
+    obOut = OB_USER_OUT;
+
+    childNodes[0]->SetInputBuffer(state);
+    childNodes[0]->obOut        = OB_TEMP_CMPLX_FOR_REAL;
+    childNodes[0]->inArrayType  = inArrayType;
+    childNodes[0]->outArrayType = rocfft_array_type_complex_interleaved;
+
+    childNodes[1]->SetInputBuffer(state);
+    childNodes[1]->obOut       = flipIn;
+    childNodes[1]->inArrayType = rocfft_array_type_complex_interleaved;
+    childNodes[1]->AssignBuffers(state, flipIn, flipOut, obOutBuf);
+
+    assert((direction == -1 && childNodes[2]->scheme == CS_KERNEL_PAIR_CMPLX_TO_HERM)
+           || (direction == 1 && childNodes[2]->scheme == CS_KERNEL_PAIR_CMPLX_TO_R));
+    childNodes[2]->SetInputBuffer(state);
+    childNodes[2]->obOut        = obOut;
+    childNodes[2]->inArrayType  = rocfft_array_type_complex_interleaved;
+    childNodes[2]->outArrayType = outArrayType;
+}
+#endif
+
+/*****************************************************
+ * CS_REAL_TO_REAL
+ *****************************************************/
+
+// length of the FFT used for a real-to-real transform of length N
+static size_t r2r_fft_length(R2RType type, size_t N)
+{
+    switch(type)
+    {
+    case R2RType::DCT_I:
+        return 2 * (N - 1);
+    case R2RType::DST_I:
+        return 2 * (N + 1);
+    case R2RType::DCT_IV:
+    case R2RType::DST_IV:
+        return N % 2 == 0 ? N / 2 : 2 * N;
+    default:
+        return N;
+    }
+}
+
+// types I and II are computed with a R2C FFT, type III with a C2R
+// FFT, and type IV with a C2C FFT
+static bool r2r_fft_is_r2c(R2RType type)
+{
+    return type == R2RType::DCT_I || type == R2RType::DST_I || type == R2RType::DCT_II
+           || type == R2RType::DST_II;
+}
+
+static bool r2r_fft_is_c2r(R2RType type)
+{
+    return type == R2RType::DCT_III || type == R2RType::DST_III;
+}
+
+// distance between the FFT's input and output batches, each in
+// units of their own type.  real sides are padded so the FFT could
+// also run in-place.
+static void r2r_fft_dists(R2RType type, size_t fftLength, size_t& iDist, size_t& oDist)
+{
+    const size_t complexDist = fftLength / 2 + 1;
+    if(r2r_fft_is_r2c(type))
+    {
+        iDist = 2 * complexDist;
+        oDist = complexDist;
+    }
+    else if(r2r_fft_is_c2r(type))
+    {
+        iDist = complexDist;
+        oDist = 2 * complexDist;
+    }
+    else
+    {
+        iDist = fftLength;
+        oDist = fftLength;
+    }
+}
+
+// dimension order of the stage that transforms dimension d: d
+// first, followed by the other dimensions in order
+static std::vector<size_t> r2r_stage_order(size_t dims, size_t d)
+{
+    std::vector<size_t> order = {d};
+    for(size_t i = 0; i < dims; ++i)
+    {
+        if(i != d)
+            order.push_back(i);
+    }
+    return order;
+}
+
+static std::vector<size_t> r2r_permute(const std::vector<size_t>& v,
+                                       const std::vector<size_t>& order)
+{
+    std::vector<size_t> ret;
+    for(auto i : order)
+        ret.push_back(v[i]);
+    return ret;
+}
+
+// keep a subplan's output in temp buffers, since it works on
+// contiguous data that doesn't have the user's shape
+static void r2r_disallow_user_buffers(TreeNode& node)
+{
+    node.allowedOutBuf &= ~static_cast<size_t>(OB_USER_IN | OB_USER_OUT);
+    for(auto& child : node.childNodes)
+        r2r_disallow_user_buffers(*child);
+}
+
+// a stage can do its pre/post-processing in the FFT kernel's loads
+// and stores if the FFT is a single kernel.  the kernel is only ever
+// runtime-compiled.
+static bool r2r_stage_is_fused(size_t fftLength, rocfft_precision precision)
+{
+#ifdef ROCFFT_RUNTIME_COMPILE
+    return function_pool::has_function(fpkey(fftLength, precision));
+#else
+    return false;
+#endif
+}
+
+void RealToRealNode::BuildTree_internal()
+{
+    // DCT and DST are computed one dimension at a time.  If the FFT
+    // along a dimension fits in a single kernel, the dimension's stage
+    // is just that kernel: it reads the real data along the
+    // dimension, reorders and twiddles it as it loads it, does the
+    // FFT, and writes the real result as it stores it.
+    //
+    // Fusing into the first and last kernels of an FFT that needs
+    // more than one kernel is not done yet.  Those stages, and every
+    // stage in builds without runtime compilation, are three
+    // children:
+    //
+    // - a pre-processing kernel that reads the real data along the
+    //   dimension, reorders and twiddles it, and writes it
+    //   contiguously as the FFT's input
+    // - a real or complex 1D FFT, with every other dimension folded
+    //   into its batch
+    // - a post-processing kernel that twiddles the FFT's output and
+    //   writes the real result with the other dimensions' strides
+    //
+    // Stages put the transformed dimension first, so they only ever
+    // work along their fastest dimension.
+    assert(r2rType != R2RType::NONE);
+
+    for(size_t d = 0; d < length.size(); ++d)
+    {
+        const auto order       = r2r_stage_order(length.size(), d);
+        const auto stageLength = r2r_permute(length, order);
+        const auto fftLength   = r2r_fft_length(r2rType, stageLength[0]);
+
+        if(r2r_stage_is_fused(fftLength, precision))
+        {
+            auto fftPlan       = NodeFactory::CreateNodeFromScheme(CS_KERNEL_STOCKHAM, this);
+            fftPlan->dimension = dimension;
+            fftPlan->length    = stageLength;
+            fftPlan->length[0] = fftLength;
+            fftPlan->direction = r2r_fft_is_c2r(r2rType) ? 1 : -1;
+            fftPlan->ebtype    = EmbeddedType::Real2Real;
+            fftPlan->r2rType   = r2rType;
+            fftPlan->r2rLength = stageLength[0];
+            // the output has the plan's shape, which buffer assignment
+            // needs to know to fit it into user buffers
+            fftPlan->outputLength = length;
+            // should be real, but could be treated as CI (the alias type)
+            fftPlan->allowedOutArrayTypes
+                = {rocfft_array_type_real, rocfft_array_type_complex_interleaved};
+            childNodes.emplace_back(std::move(fftPlan));
+            continue;
+        }
+
+        size_t otherDims = 1;
+        for(size_t i = 1; i < stageLength.size(); ++i)
+            otherDims *= stageLength[i];
+
+        size_t fftIDist = 0;
+        size_t fftODist = 0;
+        r2r_fft_dists(r2rType, fftLength, fftIDist, fftODist);
+
+        auto prePlan       = NodeFactory::CreateNodeFromScheme(CS_KERNEL_R2R_PRE, this);
+        prePlan->dimension = dimension;
+        prePlan->length    = stageLength;
+        prePlan->r2rType   = r2rType;
+        // number of FFT input elements written per transform
+        prePlan->outputLength    = stageLength;
+        prePlan->outputLength[0] = r2r_fft_is_r2c(r2rType) ? fftLength : fftIDist;
+        childNodes.emplace_back(std::move(prePlan));
+
+        NodeMetaData fftPlanData(this);
+        fftPlanData.dimension    = 1;
+        fftPlanData.length       = {fftLength};
+        fftPlanData.batch        = batch * otherDims;
+        fftPlanData.inStride     = {1};
+        fftPlanData.outStride    = {1};
+        fftPlanData.iDist        = fftIDist;
+        fftPlanData.oDist        = fftODist;
+        fftPlanData.placement    = rocfft_placement_notinplace;
+        fftPlanData.direction    = r2r_fft_is_c2r(r2rType) ? 1 : -1;
+        fftPlanData.inArrayType  = rocfft_array_type_complex_interleaved;
+        fftPlanData.outArrayType = rocfft_array_type_complex_interleaved;
+        if(r2r_fft_is_r2c(r2rType))
+        {
+            fftPlanData.inArrayType  = rocfft_array_type_real;
+            fftPlanData.outArrayType = rocfft_array_type_hermitian_interleaved;
+        }
+        else if(r2r_fft_is_c2r(r2rType))
+        {
+            fftPlanData.inArrayType  = rocfft_array_type_hermitian_interleaved;
+            fftPlanData.outArrayType = rocfft_array_type_real;
+        }
+        auto fftPlan = NodeFactory::CreateExplicitNode(fftPlanData, this);
+        fftPlan->RecursiveBuildTree();
+        r2r_disallow_user_buffers(*fftPlan);
+        childNodes.emplace_back(std::move(fftPlan));
+
+        auto postPlan       = NodeFactory::CreateNodeFromScheme(CS_KERNEL_R2R_POST, this);
+        postPlan->dimension = dimension;
+        postPlan->length    = stageLength;
+        postPlan->r2rType   = r2rType;
+        // the output has the plan's shape, which buffer assignment
+        // needs to know to fit it into user buffers
+        postPlan->outputLength = length;
+        childNodes.emplace_back(std::move(postPlan));
+    }
+
+    // the pre/post-processing kernels apply the user's callbacks, but
+    // fused stages access the real data directly.  insert nodes
+    // that are prepared to apply the callbacks around them instead.
+    auto applyCallback = [this]() {
+        auto node       = NodeFactory::CreateNodeFromScheme(CS_KERNEL_APPLY_CALLBACK, this);
+        node->dimension = dimension;
+        node->length    = length;
+        return node;
+    };
+    if(childNodes.back()->ebtype == EmbeddedType::Real2Real)
+        childNodes.emplace_back(applyCallback());
+    if(childNodes.front()->ebtype == EmbeddedType::Real2Real)
+        childNodes.insert(childNodes.begin(), applyCallback());
+}
+
+// number of children that make up a stage starting at node
+static size_t r2r_stage_size(const TreeNode& node)
+{
+    return node.ebtype == EmbeddedType::Real2Real ? 1 : 3;
+}
+
+void RealToRealNode::AssignParams_internal()
+{
+    // callbacks are applied in-place on the user's data
+    size_t first = 0;
+    size_t last  = childNodes.size();
+    if(childNodes.front()->scheme == CS_KERNEL_APPLY_CALLBACK)
+    {
+        auto& applyCallback      = childNodes.front();
+        applyCallback->inStride  = inStride;
+        applyCallback->iDist     = iDist;
+        applyCallback->outStride = inStride;
+        applyCallback->oDist     = iDist;
+        ++first;
+    }
+    if(childNodes.back()->scheme == CS_KERNEL_APPLY_CALLBACK)
+    {
+        auto& applyCallback      = childNodes.back();
+        applyCallback->inStride  = outStride;
+        applyCallback->iDist     = oDist;
+        applyCallback->outStride = outStride;
+        applyCallback->oDist     = oDist;
+        --last;
+    }
+
+    // layout of the data read by the current stage, in the plan's
+    // dimension order
+    auto   srcStride = inStride;
+    size_t srcDist   = iDist;
+
+    size_t stage = first;
+    for(size_t d = 0; d < length.size(); ++d)
+    {
+        assert(stage < last);
+        const auto order     = r2r_stage_order(length.size(), d);
+        const auto stageSize = r2r_stage_size(*childNodes[stage]);
+        auto&      writer    = childNodes[stage + stageSize - 1];
+
+        // the last stage writes the user's output.  earlier stages
+        // write whichever buffer was assigned, in that buffer's
+        // layout.
+        std::vector<size_t> dstStride;
+        size_t              dstDist = 0;
+        if(d == length.size() - 1 || writer->obOut == OB_USER_OUT)
+        {
+            dstStride = outStride;
+            dstDist   = oDist;
+        }
+        else if(writer->obOut == OB_USER_IN)
+        {
+            dstStride = inStride;
+            dstDist   = iDist;
+        }
+        else
+        {
+            dstDist = 1;
+            for(auto len : length)
+            {
+                dstStride.push_back(dstDist);
+                dstDist *= len;
+            }
+        }
+
+        if(stageSize == 1)
+        {
+            // fused stages read and write real data in the layouts
+            // given, one row of the FFT's length at a time
+            writer->inStride  = r2r_permute(srcStride, order);
+            writer->iDist     = srcDist;
+            writer->outStride = r2r_permute(dstStride, order);
+            writer->oDist     = dstDist;
+        }
+        else
+        {
+            auto& prePlan  = childNodes[stage];
+            auto& fftPlan  = childNodes[stage + 1];
+            auto& postPlan = childNodes[stage + 2];
+
+            const auto fftLength = fftPlan->length[0];
+
+            size_t fftIDist = 0;
+            size_t fftODist = 0;
+            r2r_fft_dists(r2rType, fftLength, fftIDist, fftODist);
+
+            prePlan->inStride = r2r_permute(srcStride, order);
+            prePlan->iDist    = srcDist;
+
+            prePlan->outStride.push_back(1);
+            prePlan->oDist = fftIDist;
+            for(size_t i = 1; i < prePlan->length.size(); ++i)
+            {
+                prePlan->outStride.push_back(prePlan->oDist);
+                prePlan->oDist *= prePlan->length[i];
+            }
+
+            fftPlan->inStride  = {1};
+            fftPlan->iDist     = fftIDist;
+            fftPlan->outStride = {1};
+            fftPlan->oDist     = fftODist;
+            fftPlan->AssignParams();
+
+            postPlan->inStride.push_back(1);
+            postPlan->iDist = fftODist;
+            for(size_t i = 1; i < postPlan->length.size(); ++i)
+            {
+                postPlan->inStride.push_back(postPlan->iDist);
+                postPlan->iDist *= postPlan->length[i];
+            }
+
+            postPlan->outStride = r2r_permute(dstStride, order);
+            postPlan->oDist     = dstDist;
+        }
+
+        srcStride = dstStride;
+        srcDist   = dstDist;
+        stage += stageSize;
+    }
+    assert(stage == last);
+}
+
+#if !GENERIC_BUF_ASSIGMENT
+void RealToRealNode::AssignBuffers_internal(TraverseState&   state,
+                                            OperatingBuffer& flipIn,
+                                            OperatingBuffer& flipOut,
+                                            OperatingBuffer& obOutBuf)
+{
+    assert(isRootNode());
+    // init flipIn, Out, obOutBuf, this must be a first non-trivial node
+    flipIn   = OB_TEMP_CMPLX_FOR_REAL;
+    flipOut  = OB_TEMP;
+    obOutBuf = OB_TEMP_CMPLX_FOR_REAL;
+
+    obOut = OB_USER_OUT;
+
+    // every stage goes from the user's output buffer, through the
+    // temp buffers, and back again.  fused stages go straight from
+    // one to the other.
+    for(size_t i = 0; i < childNodes.size();)
+    {
+        auto& node = childNodes[i];
+        if(node->scheme == CS_KERNEL_APPLY_CALLBACK)
+        {
+            // applied in-place, on the input before the first stage
+            // and on the output after the last
+            if(i == 0)
+                node->SetInputBuffer(state);
+            else
+                node->obIn = obOut;
+            node->obOut        = node->obIn;
+            node->inArrayType  = rocfft_array_type_real;
+            node->outArrayType = rocfft_array_type_real;
+            ++i;
+            continue;
+        }
+        if(node->ebtype == EmbeddedType::Real2Real)
+        {
+            node->SetInputBuffer(state);
+            node->obOut        = obOut;
+            node->inArrayType  = rocfft_array_type_real;
+            node->outArrayType = rocfft_array_type_real;
+            ++i;
+            continue;
+        }
+
+        childNodes[i]->SetInputBuffer(state);
+        childNodes[i]->obOut        = OB_TEMP_CMPLX_FOR_REAL;
+        childNodes[i]->inArrayType  = rocfft_array_type_real;
+        childNodes[i]->outArrayType = rocfft_array_type_complex_interleaved;
+
+        childNodes[i + 1]->SetInputBuffer(state);
+        childNodes[i + 1]->obOut       = flipIn;
+        childNodes[i + 1]->inArrayType = rocfft_array_type_complex_interleaved;
+        childNodes[i + 1]->AssignBuffers(state, flipIn, flipOut, obOutBuf);
+
+        childNodes[i + 2]->SetInputBuffer(state);
+        childNodes[i + 2]->obOut        = obOut;
+        childNodes[i + 2]->inArrayType  = rocfft_array_type_complex_interleaved;
+        childNodes[i + 2]->outArrayType = rocfft_array_type_real;
+        i += 3;
+    }
+}
+#endif
+
 /*****************************************************
  * CS_REAL_2D_EVEN
  *****************************************************/
@@ -1726,6 +2344,10 @@ void Real3DEvenNode::AssignBuffers_internal(TraverseState&   state,
  * CS_KERNEL_COPY_HERM_TO_CMPLX
  * CS_KERNEL_COPY_CMPLX_TO_HERM
  * CS_KERNEL_COPY_CMPLX_TO_R
+ * CS_KERNEL_PAIR_R_TO_CMPLX
+ * CS_KERNEL_PAIR_CMPLX_TO_HERM
+ * CS_KERNEL_PAIR_HERM_TO_CMPLX
+ * CS_KERNEL_PAIR_CMPLX_TO_R
  * CS_KERNEL_APPLY_CALLBACK
  * NOTE- Temp Complex Buffer implements interleaved only
  *****************************************************/
@@ -1734,7 +2356,11 @@ RealTransDataCopyNode::SchemeFnCall const RealTransDataCopyNode::FnCallMap
        {CS_KERNEL_COPY_R_TO_CMPLX, &real2complex},
        {CS_KERNEL_COPY_CMPLX_TO_R, &complex2real},
        {CS_KERNEL_COPY_HERM_TO_CMPLX, &hermitian2complex},
-       {CS_KERNEL_COPY_CMPLX_TO_HERM, &complex2hermitian}};
+       {CS_KERNEL_COPY_CMPLX_TO_HERM, &complex2hermitian},
+       {CS_KERNEL_PAIR_R_TO_CMPLX, &real2complex_pair},
+       {CS_KERNEL_PAIR_CMPLX_TO_HERM, &complex2hermitian_pair},
+       {CS_KERNEL_PAIR_HERM_TO_CMPLX, &hermitian2complex_pair},
+       {CS_KERNEL_PAIR_CMPLX_TO_R, &complex2real_pair}};
 
 void RealTransDataCopyNode::SetupGPAndFnPtr_internal(DevFnCall& fnPtr, GridParam& gp)
 {
@@ -1793,3 +2419,17 @@ void PrePostKernelNode::SetupGPAndFnPtr_internal(DevFnCall& fnPtr, GridParam& gp
 
     return;
 }
+
+/*****************************************************
+ * CS_KERNEL_R2R_PRE
+ * CS_KERNEL_R2R_POST
+ *****************************************************/
+RealToRealKernelNode::SchemeFnCall const RealToRealKernelNode::FnCallMap
+    = {{CS_KERNEL_R2R_PRE, &r2r_pre}, {CS_KERNEL_R2R_POST, &r2r_post}};
+
+void RealToRealKernelNode::SetupGPAndFnPtr_internal(DevFnCall& fnPtr, GridParam& gp)
+{
+    fnPtr = FnCallMap.at(scheme);
+    // launch dimensions are decided by the kernel launcher
+    return;
+}
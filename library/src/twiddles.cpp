@@ -22,6 +22,7 @@
 
 #include "twiddles.h"
 #include "function_pool.h"
+#include "plan_timing.h"
 #include "rocfft_hip.h"
 
 // Twiddle factors table
@@ -43,7 +44,6 @@ public:
         // cosine, sine arrays. T is float2 or double2, wc.x stores cosine,
         // wc.y stores sine
         std::vector<T> wc(length_limit);
-        const double   TWO_PI = -6.283185307179586476925286766559;
 
         // Make sure the radices vector multiplication product up to N
         assert(N
@@ -59,24 +59,16 @@ public:
         {
             L *= radix;
 
-            // Twiddle factors
-            for(size_t k = 0; k < (L / radix) && nt < length_limit; k++)
-            {
-                double theta = TWO_PI * (k) / (L);
-
-                for(size_t j = 1; j < radix && nt < length_limit; j++)
-                {
-                    double c = cos((j)*theta);
-                    double s = sin((j)*theta);
-
-                    // if (fabs(c) < 1.0E-12)    c = 0.0;
-                    // if (fabs(s) < 1.0E-12)    s = 0.0;
-
-                    wc[nt].x = c;
-                    wc[nt].y = s;
-                    nt++;
-                }
-            }
+            // Twiddle factors exp(-2 * pi * i * k * j / L), for k in
+            // [0, L / radix) and j in [1, radix)
+            size_t            count = std::min((L / radix) * (radix - 1), length_limit - nt);
+            twiddle_octant<T> twiddle(L, count);
+            twiddle_fill(wc.data() + nt, count, [&](size_t i) {
+                size_t k = i / (radix - 1);
+                size_t j = i % (radix - 1) + 1;
+                return twiddle(k * j);
+            });
+            nt += count;
         } // end of for radices
 
         return wc;
@@ -87,19 +79,11 @@ public:
         // cosine, sine arrays. T is float2 or double2, wc.x stores cosine,
         // wc.y stores sine
         std::vector<T> wc(length_limit);
-        const double   TWO_PI = -6.283185307179586476925286766559;
 
         // Generate the table
-        size_t nt = 0;
-        for(size_t i = 0; i < N && nt < length_limit; i++)
-        {
-            double c = cos(TWO_PI * i / N);
-            double s = sin(TWO_PI * i / N);
-
-            wc[nt].x = c;
-            wc[nt].y = s;
-            nt++;
-        }
+        size_t            count = std::min(N, length_limit);
+        twiddle_octant<T> twiddle(N, count);
+        twiddle_fill(wc.data(), count, [&](size_t i) { return twiddle(i); });
 
         return wc;
     }
@@ -109,34 +93,18 @@ public:
     // Pre/post processing requires a table that's a quarter of the
     // real length, but N here is our complex length.  So half-N is
     // what we need.
-    void AttachHalfNTable(const std::vector<T>& twtc, gpubuf& twts)
+    std::vector<T> AttachHalfNTable(const std::vector<T>& twtc)
     {
         size_t         half_N       = (N + 1) / 2;
         size_t         total_length = N + half_N;
         std::vector<T> twc_all(total_length);
         std::copy(twtc.begin(), twtc.end(), twc_all.begin());
 
-        const double TWO_PI = -6.283185307179586476925286766559;
-
         // Generate the table
-        size_t nt = N;
-        for(size_t i = 0; i < half_N; i++)
-        {
-            double c = cos(TWO_PI * i / (2 * N));
-            double s = sin(TWO_PI * i / (2 * N));
-
-            twc_all[nt].x = c;
-            twc_all[nt].y = s;
-            nt++;
-        }
+        twiddle_octant<T> twiddle(2 * N, half_N);
+        twiddle_fill(twc_all.data() + N, half_N, [&](size_t i) { return twiddle(i); });
 
-        if(twts.alloc(total_length * sizeof(T)) != hipSuccess)
-            throw std::runtime_error("unable to allocate twiddle length "
-                                     + std::to_string(total_length));
-        if(hipMemcpy(twts.data(), twc_all.data(), total_length * sizeof(T), hipMemcpyHostToDevice)
-           != hipSuccess)
-            throw std::runtime_error("failed to copy twiddle length "
-                                     + std::to_string(total_length));
+        return twc_all;
     }
 };
 
@@ -163,29 +131,17 @@ public:
     std::vector<T> GenerateTwiddleTable()
     {
         std::vector<T> wc(tableSize); // cosine, sine arrays
-        const double   TWO_PI = -6.283185307179586476925286766559;
-
-        // Generate the table
-        size_t nt  = 0;
-        double phi = TWO_PI / double(N);
-        for(size_t iY = 0; iY < Y; ++iY)
-        {
-            size_t i = static_cast<size_t>(1) << (iY * largeTwdBase);
-            for(size_t iX = 0; iX < X; ++iX)
-            {
-                size_t j = i * iX;
-
-                double c = cos(phi * j);
-                double s = sin(phi * j);
 
-                // if (fabs(c) < 1.0E-12)	c = 0.0;
-                // if (fabs(s) < 1.0E-12)	s = 0.0;
-
-                wc[nt].x = c;
-                wc[nt].y = s;
-                nt++;
-            }
-        } // end of for
+        // Generate the table.  Entry iX of row iY is the twiddle for
+        // iX * 2^(iY * largeTwdBase), which is reduced modulo N
+        // before multiplying so it can't overflow.
+        twiddle_octant<T> twiddle(N, tableSize);
+        twiddle_fill(wc.data(), tableSize, [&](size_t nt) {
+            size_t iY = nt / X;
+            size_t iX = nt % X;
+            size_t i  = (static_cast<size_t>(1) << (iY * largeTwdBase)) % N;
+            return twiddle(i * iX);
+        });
 
         return wc;
     }
@@ -201,7 +157,22 @@ gpubuf twiddles_create_pr(size_t                     N,
     if(largeTwdBase && length_limit)
         throw std::runtime_error("length-limited large twiddles are not supported");
 
-    gpubuf         twts; // device side
+    // say which table this is, if plan creation is being timed.
+    // Avoid commas, since the text timing log is comma-separated.
+    std::string detail;
+    if(plan_timing::current())
+    {
+        detail = "length " + std::to_string(N);
+        if(largeTwdBase)
+            detail += "; large base " + std::to_string(largeTwdBase);
+        if(length_limit)
+            detail += "; limit " + std::to_string(length_limit);
+        if(attach_halfN)
+            detail += "; half N";
+        detail += sizeof(T) == sizeof(float2) ? "; single" : "; double";
+    }
+
+    phase_timer    gen_timer("twiddle_host_gen");
     std::vector<T> twtc; // host side
     if((N <= LARGE_TWIDDLE_THRESHOLD) && largeTwdBase == 0)
     {
@@ -216,19 +187,7 @@ gpubuf twiddles_create_pr(size_t                     N,
         }
 
         if(attach_halfN)
-        {
-            twTable.AttachHalfNTable(twtc, twts);
-        }
-        else
-        {
-            if(twts.alloc(twtc.size() * sizeof(T)) != hipSuccess)
-                throw std::runtime_error("unable to allocate twiddle length "
-                                         + std::to_string(twtc.size()));
-            if(hipMemcpy(twts.data(), twtc.data(), twtc.size() * sizeof(T), hipMemcpyHostToDevice)
-               != hipSuccess)
-                throw std::runtime_error("failed to copy twiddle length "
-                                         + std::to_string(twtc.size()));
-        }
+            twtc = twTable.AttachHalfNTable(twtc);
     }
     else
     {
@@ -238,29 +197,27 @@ gpubuf twiddles_create_pr(size_t                     N,
         {
             TwiddleTable<T> twTable(N, length_limit);
             twtc = twTable.GenerateTwiddleTable();
-            if(twts.alloc(twtc.size() * sizeof(T)) != hipSuccess)
-                throw std::runtime_error("unable to allocate twiddle length "
-                                         + std::to_string(twtc.size()));
-            if(hipMemcpy(twts.data(), twtc.data(), twtc.size() * sizeof(T), hipMemcpyHostToDevice)
-               != hipSuccess)
-                throw std::runtime_error("failed to copy twiddle length "
-                                         + std::to_string(twtc.size()));
         }
         else
         {
             TwiddleTableLarge<T> twTable(N, largeTwdBase); // does not generate radices
 
             twtc = twTable.GenerateTwiddleTable(); // calculate twiddles on host side
-
-            if(twts.alloc(twtc.size() * sizeof(T)) != hipSuccess)
-                throw std::runtime_error("unable to allocate twiddle length "
-                                         + std::to_string(twtc.size()));
-            if(hipMemcpy(twts.data(), twtc.data(), twtc.size() * sizeof(T), hipMemcpyHostToDevice)
-               != hipSuccess)
-                throw std::runtime_error("failed to copy twiddle length "
-                                         + std::to_string(twtc.size()));
         }
     }
+    gen_timer.set_detail(std::string(detail));
+    gen_timer.stop();
+
+    phase_timer upload_timer("twiddle_upload");
+    upload_timer.set_detail(std::move(detail));
+
+    gpubuf twts; // device side
+    if(twts.alloc(twtc.size() * sizeof(T)) != hipSuccess)
+        throw std::runtime_error("unable to allocate twiddle length "
+                                 + std::to_string(twtc.size()));
+    if(hipMemcpy(twts.data(), twtc.data(), twtc.size() * sizeof(T), hipMemcpyHostToDevice)
+       != hipSuccess)
+        throw std::runtime_error("failed to copy twiddle length " + std::to_string(twtc.size()));
 
     return twts;
 }
@@ -302,6 +259,12 @@ gpubuf twiddles_create_2D_pr(size_t N1, size_t N2, rocfft_precision precision)
         N2 = 0;
     }
 
+    std::string detail;
+    if(plan_timing::current())
+        detail = "2D length " + std::to_string(N1) + "x" + std::to_string(N2)
+                 + (precision == rocfft_precision_single ? "; single" : "; double");
+
+    phase_timer     gen_timer("twiddle_host_gen");
     TwiddleTable<T> twTable1(N1, 0);
     TwiddleTable<T> twTable2(N2, 0);
 
@@ -311,6 +274,11 @@ gpubuf twiddles_create_2D_pr(size_t N1, size_t N2, rocfft_precision precision)
     {
         twtc2 = twTable2.GenerateTwiddleTable(radices2);
     }
+    gen_timer.set_detail(std::string(detail));
+    gen_timer.stop();
+
+    phase_timer upload_timer("twiddle_upload");
+    upload_timer.set_detail(std::move(detail));
 
     // glue those two twiddle tables together in one malloc that we
     // give to the kernel
@@ -0,0 +1,112 @@
+// Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Twiddle math that kernels compute on the fly.  It has no device
+// dependencies, so that host code like the tests can check it
+// directly.
+
+#ifndef ROCFFT_TWIDDLE_MATH_H
+#define ROCFFT_TWIDDLE_MATH_H
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__HIPCC__) || defined(__HIPCC_RTC__) || defined(__CUDACC__)
+#define TWIDDLE_MATH_HOST_DEVICE __host__ __device__
+#else
+#define TWIDDLE_MATH_HOST_DEVICE
+#endif
+
+static const double LIB_PI = 3.14159265358979323846;
+
+// sin and cos of pi * x
+TWIDDLE_MATH_HOST_DEVICE inline void lib_sincospi(float x, float* s, float* c)
+{
+#if defined(__HIP_DEVICE_COMPILE__) || defined(__CUDA_ARCH__)
+    sincospif(x, s, c);
+#else
+    *s = static_cast<float>(sin(LIB_PI * x));
+    *c = static_cast<float>(cos(LIB_PI * x));
+#endif
+}
+
+TWIDDLE_MATH_HOST_DEVICE inline void lib_sincospi(double x, double* s, double* c)
+{
+#if defined(__HIP_DEVICE_COMPILE__) || defined(__CUDA_ARCH__)
+    sincospi(x, s, c);
+#else
+    *s = sin(LIB_PI * x);
+    *c = cos(LIB_PI * x);
+#endif
+}
+
+// Twiddle exp(-i * pi * u^2 / N) that Bluestein's algorithm
+// multiplies element u of a length N forward transform by (inverse
+// transforms use the conjugate).  u^2 is reduced modulo 2N with
+// integer math, and the remaining angle is folded into the first
+// octant so that sincospi only ever sees arguments in [0, 1/4].
+template <typename Treal>
+TWIDDLE_MATH_HOST_DEVICE void chirp_twiddle(size_t u, size_t N, Treal* re, Treal* im)
+{
+    // angle is pi * k / N, in [0, 2 * pi)
+    size_t k = (u * u) % (2 * N);
+
+    // split the angle into a quadrant and an angle within the
+    // quadrant of pi * r / 2N, with r in [0, N)
+    size_t quadrant = (2 * k) / N;
+    size_t r        = 2 * k - quadrant * N;
+
+    // reflect the upper half of the quadrant about pi / 4
+    bool reflect = 2 * r > N;
+    if(reflect)
+        r = N - r;
+
+    Treal s, c;
+    lib_sincospi(static_cast<Treal>(r) / static_cast<Treal>(2 * N), &s, &c);
+    if(reflect)
+    {
+        Treal tmp = s;
+        s         = c;
+        c         = tmp;
+    }
+
+    // rotate back into the right quadrant and conjugate
+    switch(quadrant)
+    {
+    case 0:
+        *re = c;
+        *im = -s;
+        break;
+    case 1:
+        *re = -s;
+        *im = -c;
+        break;
+    case 2:
+        *re = -c;
+        *im = s;
+        break;
+    default:
+        *re = s;
+        *im = c;
+        break;
+    }
+}
+
+#endif